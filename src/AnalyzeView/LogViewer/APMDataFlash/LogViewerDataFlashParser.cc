@@ -5,15 +5,14 @@
 #include <QtCore/QByteArray>
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDateTime>
-#include <QtCore/QFile>
 #include <QtCore/QHash>
+#include <QtCore/QPair>
 #include <QtCore/QRegularExpression>
 #include <QtCore/QSet>
 #include <QtCore/QTimeZone>
 #include <QtCore/QVariantMap>
 
 #include <algorithm>
-#include <limits>
 
 namespace {
 
@@ -207,18 +206,123 @@ QString _ardupilotEventDescription(int eventId)
     }
 }
 
-double _extractTimestampSeconds(const QMap<QString, QVariant> &values)
+/// Where the samples of one message type live in its payload
+struct TopicLayout {
+    bool hasTimestamp = false;
+    LogFieldStore::FieldDecoder timestamp;
+    bool hasMetadata = false;       ///< Also parsed for parameters, messages, modes and events
+    bool registered = false;        ///< Fields were added to the store on the first message
+    int storeTopic = -1;
+    QStringList fieldNames;
+    QList<QPair<QString, LogFieldStore::FieldDecoder>> plottableFields;
+};
+
+bool _fieldDecoder(char formatChar, LogFieldStore::FieldDecoder &decoder)
 {
-    if (values.contains(QStringLiteral("TimeUS"))) {
-        return values.value(QStringLiteral("TimeUS")).toDouble() / 1000000.0;
+    // Same scaling as APMDataFlashUtility::parseValue
+    using VT = LogFieldStore::ValueType;
+    decoder.divisor = 1.0;
+    switch (formatChar) {
+    case 'b': decoder.type = VT::Int8;   break;
+    case 'B':
+    case 'M': decoder.type = VT::UInt8;  break;
+    case 'h': decoder.type = VT::Int16;  break;
+    case 'H': decoder.type = VT::UInt16; break;
+    case 'c': decoder.type = VT::Int16;  decoder.divisor = 100.0; break;
+    case 'C': decoder.type = VT::UInt16; decoder.divisor = 100.0; break;
+    case 'i': decoder.type = VT::Int32;  break;
+    case 'I': decoder.type = VT::UInt32; break;
+    case 'e': decoder.type = VT::Int32;  decoder.divisor = 100.0; break;
+    case 'E': decoder.type = VT::UInt32; decoder.divisor = 100.0; break;
+    case 'L': decoder.type = VT::Int32;  decoder.divisor = 1.0e7; break;
+    case 'f': decoder.type = VT::Float;  break;
+    case 'd': decoder.type = VT::Double; break;
+    case 'q': decoder.type = VT::Int64;  break;
+    case 'Q': decoder.type = VT::UInt64; break;
+    case 'g': decoder.type = VT::Half;   break;
+    default:
+        return false; // strings and arrays are not plottable
     }
-    if (values.contains(QStringLiteral("TimeMS"))) {
-        return values.value(QStringLiteral("TimeMS")).toDouble() / 1000.0;
+    return true;
+}
+
+TopicLayout _topicLayout(const APMDataFlashUtility::MessageFormat &fmt)
+{
+    TopicLayout layout;
+    LogFieldStore::FieldDecoder timeUS;
+    LogFieldStore::FieldDecoder timeMS;
+    LogFieldStore::FieldDecoder time;
+    bool hasTimeUS = false;
+    bool hasTimeMS = false;
+    bool hasTime = false;
+
+    const int payloadSize = fmt.length - 3;
+    int offset = 0;
+    for (int i = 0; i < fmt.format.length() && i < fmt.columns.size(); ++i) {
+        const char formatChar = fmt.format.at(i).toLatin1();
+        const int size = APMDataFlashUtility::formatCharSize(formatChar);
+        if (size == 0) {
+            continue;
+        }
+        if ((offset + size) > payloadSize) {
+            break;
+        }
+
+        const QString &column = fmt.columns.at(i);
+        const QString fieldName = fmt.name + QLatin1Char('.') + column;
+        layout.fieldNames.append(fieldName);
+
+        LogFieldStore::FieldDecoder decoder;
+        decoder.offset = offset;
+        if (_fieldDecoder(formatChar, decoder)) {
+            layout.plottableFields.append(qMakePair(fieldName, decoder));
+            if (column == QStringLiteral("TimeUS")) {
+                timeUS = decoder;
+                hasTimeUS = true;
+            } else if (column == QStringLiteral("TimeMS")) {
+                timeMS = decoder;
+                hasTimeMS = true;
+            } else if (column == QStringLiteral("Time")) {
+                time = decoder;
+                hasTime = true;
+            }
+        }
+        offset += size;
     }
-    if (values.contains(QStringLiteral("Time"))) {
-        return values.value(QStringLiteral("Time")).toDouble() / 1000.0;
+
+    // TimeUS is preferred over TimeMS over Time
+    if (hasTimeUS) {
+        layout.timestamp = timeUS;
+        layout.timestamp.divisor *= 1000000.0;
+    } else if (hasTimeMS || hasTime) {
+        layout.timestamp = hasTimeMS ? timeMS : time;
+        layout.timestamp.divisor *= 1000.0;
+    }
+    layout.hasTimestamp = hasTimeUS || hasTimeMS || hasTime;
+
+    return layout;
+}
+
+/// Adds the message at @a payloadOffset to its topic, registering the topic's fields on first use
+void _indexMessage(LogFieldStore &store, TopicLayout &layout, qint64 payloadOffset, QSet<QString> &fieldSet, QSet<QString> &plottableFieldSet)
+{
+    if (!layout.registered) {
+        layout.registered = true;
+        for (const QString &fieldName : layout.fieldNames) {
+            fieldSet.insert(fieldName);
+        }
+        if (layout.hasTimestamp) {
+            layout.storeTopic = store.addTopic(layout.timestamp);
+            for (const auto &field : layout.plottableFields) {
+                store.addField(field.first, layout.storeTopic, field.second);
+                plottableFieldSet.insert(field.first);
+            }
+        }
+    }
+
+    if (layout.storeTopic >= 0) {
+        store.addRecord(layout.storeTopic, payloadOffset);
     }
-    return -1.0;
 }
 
 void _appendEvent(QVariantList &events, double timestampSecs, const QString &type, const QString &description)
@@ -242,35 +346,13 @@ LogParseResult parseFile(const QString &filePath, const ProgressCallback &progre
     LogParseResult result;
     result.sourceType = LogParseResult::SourceType::APMDataFlash;
 
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly)) {
-        result.errorMessage = QCoreApplication::translate("LogFileParser", "Failed to open file");
-        return result;
-    }
-
-    const qint64 fileSize = file.size();
-    if (fileSize <= 0) {
-        result.errorMessage = QCoreApplication::translate("LogFileParser", "File is empty");
-        return result;
-    }
-    if (fileSize > std::numeric_limits<qsizetype>::max()) {
-        result.errorMessage = QCoreApplication::translate("LogFileParser", "File is too large to parse");
-        return result;
-    }
-
-    uchar *const mappedData = file.map(0, fileSize);
-    if (mappedData == nullptr) {
-        result.errorMessage = QCoreApplication::translate("LogFileParser", "Failed to memory-map file");
+    auto store = std::make_shared<LogFieldStore>();
+    if (!store->open(filePath, result.errorMessage)) {
         return result;
     }
 
-    struct ScopedUnmap {
-        QFile &file;
-        uchar *data = nullptr;
-        ~ScopedUnmap() { if (data) { file.unmap(data); } }
-    } scopedUnmap{file, mappedData};
-
-    const char *const raw = reinterpret_cast<const char *>(mappedData);
+    const qint64 fileSize = store->size();
+    const char *const raw = store->data();
 
     // Verify DataFlash magic
     if (fileSize < 3 ||
@@ -282,6 +364,14 @@ LogParseResult parseFile(const QString &filePath, const ProgressCallback &progre
 
     const QByteArray bytes = QByteArray::fromRawData(raw, static_cast<qsizetype>(fileSize));
 
+    static const QString kPARM = QStringLiteral("PARM");
+    static const QString kMSG  = QStringLiteral("MSG");
+    static const QString kMODE = QStringLiteral("MODE");
+    static const QString kERR  = QStringLiteral("ERR");
+    static const QString kEV   = QStringLiteral("EV");
+    static const QString kGPS  = QStringLiteral("GPS");
+    static const QString kGPS2 = QStringLiteral("GPS2");
+
     QMap<uint8_t, APMDataFlashUtility::MessageFormat> formats;
     if (!APMDataFlashUtility::parseFmtMessages(bytes.constData(), bytes.size(), formats)) {
         result.errorMessage = QCoreApplication::translate("LogFileParser", "No valid FMT messages were found");
@@ -296,35 +386,36 @@ LogParseResult parseFile(const QString &filePath, const ProgressCallback &progre
     double modeSegmentStartSecs = -1.0;
     QString currentModeName;
 
-    QHash<uint8_t, QHash<QString, QString>> fieldNameByCol;
-    fieldNameByCol.reserve(formats.size());
+    // Column layouts are resolved once per message type, so the indexing pass only has to read timestamps
+    QHash<uint8_t, TopicLayout> layouts;
+    layouts.reserve(formats.size());
     for (auto fmtIt = formats.cbegin(); fmtIt != formats.cend(); ++fmtIt) {
         const APMDataFlashUtility::MessageFormat &fmt = fmtIt.value();
-        QHash<QString, QString> &perCol = fieldNameByCol[fmtIt.key()];
-        perCol.reserve(fmt.columns.size());
-        for (const QString &col : fmt.columns) {
-            perCol.insert(col, fmt.name + QLatin1Char('.') + col);
-        }
+        TopicLayout layout = _topicLayout(fmt);
+        layout.hasMetadata = (fmt.name == kPARM) || (fmt.name == kMSG) || (fmt.name == kMODE) || (fmt.name == kERR) || (fmt.name == kEV);
+        layouts.insert(fmtIt.key(), layout);
     }
 
-    static const QString kPARM = QStringLiteral("PARM");
-    static const QString kMSG  = QStringLiteral("MSG");
-    static const QString kMODE = QStringLiteral("MODE");
-    static const QString kERR  = QStringLiteral("ERR");
-    static const QString kEV   = QStringLiteral("EV");
-    static const QString kGPS  = QStringLiteral("GPS");
-    static const QString kGPS2 = QStringLiteral("GPS2");
-
     APMDataFlashUtility::iterateMessages(bytes.constData(), bytes.size(), formats,
         [&](uint8_t msgType, const char *payload, int, const APMDataFlashUtility::MessageFormat &fmt) {
-        const QMap<QString, QVariant> values = APMDataFlashUtility::parseMessage(payload, fmt);
-        const double timestampSecs = _extractTimestampSeconds(values);
+        TopicLayout &layout = layouts[msgType];
+        const double timestampSecs = layout.hasTimestamp ? LogFieldStore::readValue(payload, layout.timestamp) : -1.0;
         if (timestampSecs >= 0.0) {
             if (minTimestampSecs < 0.0 || timestampSecs < minTimestampSecs) { minTimestampSecs = timestampSecs; }
             maxTimestampSecs = std::max(maxTimestampSecs, timestampSecs);
         }
 
-        if ((fmt.name == kGPS || fmt.name == kGPS2) && result.startTime.isNull()
+        // Only the messages which feed events, parameters and the start time are fully parsed here
+        const bool needsStartTime = (fmt.name == kGPS || fmt.name == kGPS2) && result.startTime.isNull();
+        if (!needsStartTime && !layout.hasMetadata) {
+            _indexMessage(*store, layout, payload - raw, fieldSet, plottableFieldSet);
+            result.sampleCount++;
+            return !cancelToken || !cancelToken->load(std::memory_order_relaxed);
+        }
+
+        const QMap<QString, QVariant> values = APMDataFlashUtility::parseMessage(payload, fmt);
+
+        if (needsStartTime
                 && values.contains(QStringLiteral("GWk")) && values.contains(QStringLiteral("GMS"))
                 && timestampSecs >= 0.0) {
             const int gwk = values.value(QStringLiteral("GWk")).toInt();
@@ -404,26 +495,9 @@ LogParseResult parseFile(const QString &filePath, const ProgressCallback &progre
                          _ardupilotEventDescription(eventId));
         }
 
+        _indexMessage(*store, layout, payload - raw, fieldSet, plottableFieldSet);
         result.sampleCount++;
 
-        const QHash<QString, QString> &perCol = fieldNameByCol[msgType];
-        const bool haveTimestamp = (timestampSecs >= 0.0);
-        for (auto it = values.cbegin(); it != values.cend(); ++it) {
-            const auto nameIt = perCol.constFind(it.key());
-            if (nameIt == perCol.constEnd()) { continue; }
-            const QString &fieldName = nameIt.value();
-            fieldSet.insert(fieldName);
-            if (!haveTimestamp) { continue; }
-            const int typeId = it.value().metaType().id();
-            const bool numeric =
-                (typeId == QMetaType::Int) || (typeId == QMetaType::UInt) ||
-                (typeId == QMetaType::LongLong) || (typeId == QMetaType::ULongLong) ||
-                (typeId == QMetaType::Float) || (typeId == QMetaType::Double);
-            if (numeric) {
-                result.fieldSamples[fieldName].append(QPointF(timestampSecs, it.value().toDouble()));
-                plottableFieldSet.insert(fieldName);
-            }
-        }
         return !cancelToken || !cancelToken->load(std::memory_order_relaxed);
     }, progressCallback);
 
@@ -445,6 +519,7 @@ LogParseResult parseFile(const QString &filePath, const ProgressCallback &progre
     std::sort(result.plottableFields.begin(), result.plottableFields.end());
     result.minTimestamp = minTimestampSecs;
     result.maxTimestamp = maxTimestampSecs;
+    result.fieldStore = store;
     result.ok = true;
     return result;
 }
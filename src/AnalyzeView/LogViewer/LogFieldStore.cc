@@ -0,0 +1,244 @@
+#include "LogFieldStore.h"
+
+#include "APMDataFlashUtility.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QtEndian>
+
+#include <limits>
+
+QGC_LOGGING_CATEGORY(LogFieldStoreLog, "AnalyzeView.LogFieldStore")
+
+namespace {
+
+/// Floats only hold 24 bits of mantissa, so wider types are stored relative to their first sample.
+bool _needsValueBase(LogFieldStore::ValueType type)
+{
+    using VT = LogFieldStore::ValueType;
+    switch (type) {
+    case VT::Int32:
+    case VT::UInt32:
+    case VT::Int64:
+    case VT::UInt64:
+    case VT::Double:
+        return true;
+    default:
+        return false;
+    }
+}
+
+} // namespace
+
+LogFieldStore::~LogFieldStore()
+{
+    if (_data) {
+        (void) _file.unmap(reinterpret_cast<uchar *>(const_cast<char *>(_data)));
+    }
+}
+
+bool LogFieldStore::open(const QString &filePath, QString &errorMessage)
+{
+    _file.setFileName(filePath);
+    if (!_file.open(QIODevice::ReadOnly)) {
+        errorMessage = QCoreApplication::translate("LogFileParser", "Failed to open file");
+        return false;
+    }
+
+    const qint64 fileSize = _file.size();
+    if (fileSize <= 0) {
+        errorMessage = QCoreApplication::translate("LogFileParser", "File is empty");
+        return false;
+    }
+    if (fileSize > std::numeric_limits<qsizetype>::max()) {
+        errorMessage = QCoreApplication::translate("LogFileParser", "File is too large to parse");
+        return false;
+    }
+
+    uchar *const mappedData = _file.map(0, fileSize);
+    if (mappedData == nullptr) {
+        errorMessage = QCoreApplication::translate("LogFileParser", "Failed to memory-map file");
+        return false;
+    }
+
+    _data = reinterpret_cast<const char *>(mappedData);
+    _size = fileSize;
+    return true;
+}
+
+int LogFieldStore::addTopic(const FieldDecoder &timestamp)
+{
+    Topic topic;
+    topic.timestamp = timestamp;
+    _topics.append(topic);
+    return static_cast<int>(_topics.size() - 1);
+}
+
+void LogFieldStore::addField(const QString &fieldName, int topic, const FieldDecoder &decoder)
+{
+    _fields.insert(fieldName, Field{ topic, decoder });
+}
+
+qint64 LogFieldStore::addSpilledPayload(const char *payload, qsizetype size)
+{
+    const qint64 offset = _size + _spill.size();
+    _spill.append(payload, size);
+    return offset;
+}
+
+qsizetype LogFieldStore::valueSize(ValueType type)
+{
+    switch (type) {
+    case ValueType::Int8:
+    case ValueType::UInt8:
+        return 1;
+    case ValueType::Int16:
+    case ValueType::UInt16:
+    case ValueType::Half:
+        return 2;
+    case ValueType::Int32:
+    case ValueType::UInt32:
+    case ValueType::Float:
+        return 4;
+    case ValueType::Int64:
+    case ValueType::UInt64:
+    case ValueType::Double:
+        return 8;
+    }
+
+    return 0;
+}
+
+double LogFieldStore::readValue(const char *payload, const FieldDecoder &decoder)
+{
+    // Both log formats are little-endian; qFromLittleEndian also handles the unaligned payloads
+    const char *const src = payload + decoder.offset;
+    double value = 0.0;
+    switch (decoder.type) {
+    case ValueType::Int8:
+        value = static_cast<qint8>(*src);
+        break;
+    case ValueType::UInt8:
+        value = static_cast<quint8>(*src);
+        break;
+    case ValueType::Int16:
+        value = qFromLittleEndian<qint16>(src);
+        break;
+    case ValueType::UInt16:
+        value = qFromLittleEndian<quint16>(src);
+        break;
+    case ValueType::Int32:
+        value = qFromLittleEndian<qint32>(src);
+        break;
+    case ValueType::UInt32:
+        value = qFromLittleEndian<quint32>(src);
+        break;
+    case ValueType::Int64:
+        value = static_cast<double>(qFromLittleEndian<qint64>(src));
+        break;
+    case ValueType::UInt64:
+        value = static_cast<double>(qFromLittleEndian<quint64>(src));
+        break;
+    case ValueType::Float:
+        value = qFromLittleEndian<float>(src);
+        break;
+    case ValueType::Double:
+        value = qFromLittleEndian<double>(src);
+        break;
+    case ValueType::Half:
+        value = APMDataFlashUtility::halfToFloat(qFromLittleEndian<quint16>(src));
+        break;
+    }
+
+    return (decoder.divisor != 1.0) ? (value / decoder.divisor) : value;
+}
+
+qsizetype LogFieldStore::sampleCount(const QString &fieldName) const
+{
+    const auto it = _fields.constFind(fieldName);
+    if (it == _fields.cend()) {
+        return 0;
+    }
+
+    return _topics[it->topic].recordOffsets.size();
+}
+
+LogFieldStore::ColumnPtr LogFieldStore::column(const QString &fieldName)
+{
+    const auto cacheIt = _cache.find(fieldName);
+    if (cacheIt != _cache.end()) {
+        _lru.splice(_lru.begin(), _lru, cacheIt->lru);
+        return cacheIt->column;
+    }
+
+    const auto fieldIt = _fields.constFind(fieldName);
+    if (fieldIt == _fields.cend()) {
+        return nullptr;
+    }
+
+    const ColumnPtr column = _decode(fieldIt.value());
+
+    CacheEntry entry;
+    entry.column = column;
+    // Shared timestamps are counted by every column using them, so the limit is an upper bound
+    entry.bytes = (column->timestamps.size() * static_cast<qint64>(sizeof(double)))
+                + (column->values.size() * static_cast<qint64>(sizeof(float)));
+    _lru.push_front(fieldName);
+    entry.lru = _lru.begin();
+    _cache.insert(fieldName, entry);
+    _cachedBytes += entry.bytes;
+
+    _evict();
+
+    return column;
+}
+
+void LogFieldStore::setCacheLimitBytes(qint64 bytes)
+{
+    _cacheLimitBytes = bytes;
+    _evict();
+}
+
+LogFieldStore::ColumnPtr LogFieldStore::_decode(const Field &field)
+{
+    Topic &topic = _topics[field.topic];
+    const QList<qint64> &offsets = topic.recordOffsets;
+
+    auto column = std::make_shared<Column>();
+
+    const ColumnPtr sibling = topic.lastDecoded.lock();
+    if (sibling && (sibling->timestamps.size() == offsets.size())) {
+        column->timestamps = sibling->timestamps;
+    } else {
+        column->timestamps.resize(offsets.size());
+        double *const timestamps = column->timestamps.data();
+        for (qsizetype i = 0; i < offsets.size(); i++) {
+            timestamps[i] = readValue(recordData(offsets[i]), topic.timestamp);
+        }
+    }
+
+    column->values.resize(offsets.size());
+    if (!offsets.isEmpty() && _needsValueBase(field.decoder.type)) {
+        column->valueBase = readValue(recordData(offsets.first()), field.decoder);
+    }
+
+    float *const values = column->values.data();
+    const double valueBase = column->valueBase;
+    for (qsizetype i = 0; i < offsets.size(); i++) {
+        values[i] = static_cast<float>(readValue(recordData(offsets[i]), field.decoder) - valueBase);
+    }
+
+    topic.lastDecoded = column;
+    return column;
+}
+
+void LogFieldStore::_evict()
+{
+    while ((_cachedBytes > _cacheLimitBytes) && (_lru.size() > 1)) {
+        const auto it = _cache.find(_lru.back());
+        _cachedBytes -= it->bytes;
+        qCDebug(LogFieldStoreLog) << "Evicting" << it.key() << it->bytes << "bytes";
+        _cache.erase(it);
+        _lru.pop_back();
+    }
+}
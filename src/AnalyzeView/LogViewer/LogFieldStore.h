@@ -0,0 +1,154 @@
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QPointF>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVector>
+
+#include <list>
+#include <memory>
+
+/// \brief Columnar, lazily decoded field samples of a memory-mapped log file.
+///
+/// Parsers make a single pass over the mapped file and only record, per topic (message type), the payload
+/// offset of every timestamped message plus how each field is laid out in that payload. A field is decoded
+/// into separate timestamp and value arrays the first time it is asked for. Decoded columns are kept in an
+/// LRU cache bounded by cacheLimitBytes(), so the resident size no longer grows with the size of the log.
+///
+/// The index is built on the parse thread; afterwards the store must only be used from one thread at a time.
+class LogFieldStore
+{
+public:
+    enum class ValueType : quint8 {
+        Int8,
+        UInt8,
+        Int16,
+        UInt16,
+        Int32,
+        UInt32,
+        Int64,
+        UInt64,
+        Float,
+        Double,
+        Half,       ///< IEEE 754 binary16
+    };
+
+    /// Location and encoding of a value inside a message payload. The decoded value is raw / divisor.
+    struct FieldDecoder
+    {
+        qint32 offset = 0;
+        ValueType type = ValueType::Float;
+        double divisor = 1.0;
+    };
+
+    /// Decoded samples of one field. Timestamps are shared by all decoded columns of a topic.
+    struct Column
+    {
+        QVector<double> timestamps;     ///< Seconds
+        QVector<float> values;          ///< Relative to valueBase
+        double valueBase = 0.0;         ///< Keeps doubles and wide integers (e.g. lat/lon) precise as floats
+
+        qsizetype size() const { return values.size(); }
+        bool isEmpty() const { return values.isEmpty(); }
+        double timeAt(qsizetype index) const { return timestamps[index]; }
+        double valueAt(qsizetype index) const { return valueBase + static_cast<double>(values[index]); }
+        QPointF pointAt(qsizetype index) const { return QPointF(timeAt(index), valueAt(index)); }
+    };
+    using ColumnPtr = std::shared_ptr<const Column>;
+
+    LogFieldStore() = default;
+    ~LogFieldStore();
+
+    LogFieldStore(const LogFieldStore &) = delete;
+    LogFieldStore &operator=(const LogFieldStore &) = delete;
+
+    /// Memory-maps @a filePath. @return false: @a errorMessage is set
+    bool open(const QString &filePath, QString &errorMessage);
+
+    const char *data() const { return _data; }
+    qint64 size() const { return _size; }
+
+    // ------------------------------------------------------------------
+    // Indexing, used by the parsers
+
+    /// @param timestamp Decodes the timestamp of a record of this topic in seconds
+    /// @return Topic id
+    int addTopic(const FieldDecoder &timestamp);
+    void addField(const QString &fieldName, int topic, const FieldDecoder &decoder);
+    void addRecord(int topic, qint64 payloadOffset) { _topics[topic].recordOffsets.append(payloadOffset); }
+
+    /// Keeps a copy of a payload which could not be indexed in place, e.g. one recovered from a corrupt
+    /// region by a streaming reader. @return Offset to pass to addRecord()
+    qint64 addSpilledPayload(const char *payload, qsizetype size);
+
+    /// @return Payload at an offset passed to addRecord()
+    const char *recordData(qint64 payloadOffset) const
+    {
+        return (payloadOffset < _size) ? (_data + payloadOffset) : (_spill.constData() + (payloadOffset - _size));
+    }
+
+    static double readValue(const char *payload, const FieldDecoder &decoder);
+    static qsizetype valueSize(ValueType type);
+
+    // ------------------------------------------------------------------
+    // Access
+
+    bool hasField(const QString &fieldName) const { return _fields.contains(fieldName); }
+    QStringList fieldNames() const { return _fields.keys(); }
+
+    /// @return Number of samples of @a fieldName, without decoding it
+    qsizetype sampleCount(const QString &fieldName) const;
+
+    /// Decodes @a fieldName on first use. @return nullptr: unknown field
+    ColumnPtr column(const QString &fieldName);
+
+    qint64 cacheLimitBytes() const { return _cacheLimitBytes; }
+    /// Evicts least recently used columns until the cache fits. The most recent column is always kept.
+    void setCacheLimitBytes(qint64 bytes);
+    qint64 cachedBytes() const { return _cachedBytes; }
+    qsizetype cachedColumnCount() const { return _cache.size(); }
+    bool isCached(const QString &fieldName) const { return _cache.contains(fieldName); }
+
+    static constexpr qint64 kDefaultCacheLimitBytes = 256 * 1024 * 1024;
+
+private:
+    struct Topic
+    {
+        FieldDecoder timestamp;
+        QList<qint64> recordOffsets;
+        std::weak_ptr<const Column> lastDecoded;    ///< Source of shared timestamps while any column is alive
+    };
+
+    struct Field
+    {
+        int topic = 0;
+        FieldDecoder decoder;
+    };
+
+    struct CacheEntry
+    {
+        ColumnPtr column;
+        qint64 bytes = 0;
+        std::list<QString>::iterator lru;
+    };
+
+    ColumnPtr _decode(const Field &field);
+    void _evict();
+
+    QFile _file;
+    const char *_data = nullptr;
+    qint64 _size = 0;
+    QByteArray _spill;
+
+    QList<Topic> _topics;
+    QHash<QString, Field> _fields;
+
+    QHash<QString, CacheEntry> _cache;
+    std::list<QString> _lru;                ///< Most recently used first
+    qint64 _cachedBytes = 0;
+    qint64 _cacheLimitBytes = kDefaultCacheLimitBytes;
+};
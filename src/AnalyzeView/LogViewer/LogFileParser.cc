@@ -42,6 +42,11 @@ LogParseResult _parseFile(const QString &filePath, const ProgressCallback &progr
     return result;
 }
 
+LogFieldStore::ColumnPtr _column(const std::shared_ptr<LogFieldStore> &store, const QString &fieldName)
+{
+    return store ? store->column(fieldName) : nullptr;
+}
+
 } // namespace
 
 // ============================================================================
@@ -160,7 +165,7 @@ void LogFileParser::_applyResult(const LogParseResult &result)
             _modeNames.append(mode);
         }
     }
-    _fieldSamples = result.fieldSamples;
+    _fieldStore = result.fieldStore;
     _sampleCount = result.sampleCount;
     _detectedVehicleType = result.detectedVehicleType;
     emit availableFieldsChanged();
@@ -213,7 +218,7 @@ void LogFileParser::clear()
     if (!_detectedVehicleType.isEmpty()) { _detectedVehicleType.clear(); emit detectedVehicleTypeChanged(); }
     if (!_plottableFields.isEmpty()) { _plottableFields.clear(); emit plottableFieldsChanged(); }
 
-    _fieldSamples.clear();
+    _fieldStore.reset();
     _gpsLatField.clear();
     _gpsLonField.clear();
     _gpsAltField.clear();
@@ -230,41 +235,35 @@ void LogFileParser::clear()
 QVariantList LogFileParser::fieldSamples(const QString &fieldName) const
 {
     QVariantList output;
-    const auto it = _fieldSamples.constFind(fieldName);
-    if (it == _fieldSamples.cend()) { return output; }
-    const QVector<QPointF> &points = it.value();
-    output.reserve(points.size());
-    for (const QPointF &p : points) { output.append(p); }
+    const LogFieldStore::ColumnPtr column = _column(_fieldStore, fieldName);
+    if (!column) { return output; }
+    output.reserve(column->size());
+    for (qsizetype i = 0; i < column->size(); ++i) { output.append(column->pointAt(i)); }
     return output;
 }
 
 QVariantMap LogFileParser::fieldMinMax(const QString &fieldName) const
 {
-    const auto it = _fieldSamples.constFind(fieldName);
-    if (it == _fieldSamples.cend() || it->isEmpty()) { return {}; }
-    const QVector<QPointF> &points = it.value();
-    double minY = std::numeric_limits<double>::max();
-    double maxY = std::numeric_limits<double>::lowest();
-    for (const QPointF &p : points) {
-        if (p.y() < minY) minY = p.y();
-        if (p.y() > maxY) maxY = p.y();
-    }
-    return QVariantMap{{QStringLiteral("min"), minY}, {QStringLiteral("max"), maxY}};
+    const LogFieldStore::ColumnPtr column = _column(_fieldStore, fieldName);
+    if (!column || column->isEmpty()) { return {}; }
+    const auto [minIt, maxIt] = std::minmax_element(column->values.cbegin(), column->values.cend());
+    return QVariantMap{{QStringLiteral("min"), column->valueBase + *minIt}, {QStringLiteral("max"), column->valueBase + *maxIt}};
 }
 
 QVariantList LogFileParser::fieldSamplesFiltered(const QString &fieldName, double minX, double maxX, int pixelWidth) const
 {
     QVariantList output;
-    const auto it = _fieldSamples.constFind(fieldName);
-    if (it == _fieldSamples.cend() || pixelWidth <= 0 || maxX <= minX) { return output; }
+    if (pixelWidth <= 0 || maxX <= minX) { return output; }
+    const LogFieldStore::ColumnPtr column = _column(_fieldStore, fieldName);
+    if (!column) { return output; }
 
-    const QVector<QPointF> &points = it.value();
+    const QVector<double> &times = column->timestamps;
+    const QVector<float> &values = column->values;
 
     // Find the slice within [minX, maxX]
-    const auto sliceBegin = std::lower_bound(points.cbegin(), points.cend(), minX,
-        [](const QPointF &p, double t) { return p.x() < t; });
-    const auto sliceEnd = std::upper_bound(sliceBegin, points.cend(), maxX,
-        [](double t, const QPointF &p) { return t < p.x(); });
+    const auto sliceBegin = std::lower_bound(times.cbegin(), times.cend(), minX);
+    const auto sliceEnd = std::upper_bound(sliceBegin, times.cend(), maxX);
+    const qsizetype first = std::distance(times.cbegin(), sliceBegin);
 
     const qsizetype sliceCount = std::distance(sliceBegin, sliceEnd);
     if (sliceCount == 0) { return output; }
@@ -272,7 +271,7 @@ QVariantList LogFileParser::fieldSamplesFiltered(const QString &fieldName, doubl
     // If already sparse enough, return slice as-is
     if (sliceCount <= 4 * pixelWidth) {
         output.reserve(sliceCount);
-        for (auto jt = sliceBegin; jt != sliceEnd; ++jt) { output.append(*jt); }
+        for (qsizetype i = first; i < first + sliceCount; ++i) { output.append(column->pointAt(i)); }
         return output;
     }
 
@@ -300,15 +299,15 @@ QVariantList LogFileParser::fieldSamplesFiltered(const QString &fieldName, doubl
         qsizetype prev = -1;
         for (qsizetype idx : indices) {
             if (idx != prev) {
-                output.append(*(sliceBegin + idx));
+                output.append(column->pointAt(idx));
                 prev = idx;
             }
         }
     };
 
-    for (qsizetype i = 0; i < sliceCount; ++i) {
-        const QPointF &p = *(sliceBegin + i);
-        const int col = std::clamp(columnOf(p.x()), 0, pixelWidth - 1);
+    // Values share the column's base, so comparing the stored floats is enough
+    for (qsizetype i = first; i < first + sliceCount; ++i) {
+        const int col = std::clamp(columnOf(times[i]), 0, pixelWidth - 1);
         if (col != curCol) {
             flush();
             curCol   = col;
@@ -316,8 +315,8 @@ QVariantList LogFileParser::fieldSamplesFiltered(const QString &fieldName, doubl
             minIdx   = i;
             maxIdx   = i;
         } else {
-            if (p.y() < (sliceBegin + minIdx)->y()) minIdx = i;
-            if (p.y() > (sliceBegin + maxIdx)->y()) maxIdx = i;
+            if (values[i] < values[minIdx]) minIdx = i;
+            if (values[i] > values[maxIdx]) maxIdx = i;
         }
         lastIdx = i;
     }
@@ -328,20 +327,19 @@ QVariantList LogFileParser::fieldSamplesFiltered(const QString &fieldName, doubl
 
 double LogFileParser::fieldValueAt(const QString &fieldName, double timestampSeconds) const
 {
-    const auto it = _fieldSamples.constFind(fieldName);
-    if (it == _fieldSamples.cend() || it->isEmpty()) {
+    const LogFieldStore::ColumnPtr column = _column(_fieldStore, fieldName);
+    if (!column || column->isEmpty()) {
         return std::numeric_limits<double>::quiet_NaN();
     }
-    const QVector<QPointF> &points = it.value();
-    const auto lower = std::lower_bound(points.cbegin(), points.cend(), timestampSeconds,
-        [](const QPointF &p, double t) { return p.x() < t; });
+    const QVector<double> &times = column->timestamps;
+    const auto lower = std::lower_bound(times.cbegin(), times.cend(), timestampSeconds);
 
-    if (lower == points.cbegin()) { return lower->y(); }
-    if (lower == points.cend()) { return points.constLast().y(); }
+    if (lower == times.cbegin()) { return column->valueAt(0); }
+    if (lower == times.cend()) { return column->valueAt(column->size() - 1); }
 
-    const auto prev = std::prev(lower);
-    return (std::fabs(prev->x() - timestampSeconds) <= std::fabs(lower->x() - timestampSeconds))
-        ? prev->y() : lower->y();
+    const qsizetype index = std::distance(times.cbegin(), lower);
+    return (std::fabs(times[index - 1] - timestampSeconds) <= std::fabs(times[index] - timestampSeconds))
+        ? column->valueAt(index - 1) : column->valueAt(index);
 }
 
 QString LogFileParser::modeColor(const QString &modeName) const
@@ -417,24 +415,18 @@ QVariantMap LogFileParser::gpsCoordAt(double timestampSeconds) const
         return {};
     }
 
-    const auto latIt = _fieldSamples.constFind(_gpsLatField);
-    const auto lonIt = _fieldSamples.constFind(_gpsLonField);
-    if (latIt == _fieldSamples.cend() || lonIt == _fieldSamples.cend()) {
-        return {};
-    }
-
-    const QVector<QPointF> &latPts = latIt.value();
-    const QVector<QPointF> &lonPts = lonIt.value();
-    if (latPts.isEmpty() || lonPts.isEmpty()) {
+    const LogFieldStore::ColumnPtr latPts = _column(_fieldStore, _gpsLatField);
+    const LogFieldStore::ColumnPtr lonPts = _column(_fieldStore, _gpsLonField);
+    if (!latPts || !lonPts || latPts->isEmpty() || lonPts->isEmpty()) {
         return {};
     }
 
     // Binary search for the sample with timestamp closest to timestampSeconds.
     int lo = 0;
-    int hi = latPts.size() - 1;
+    int hi = latPts->size() - 1;
     while (lo < hi) {
         const int mid = (lo + hi) / 2;
-        if (latPts[mid].x() < timestampSeconds) {
+        if (latPts->timeAt(mid) < timestampSeconds) {
             lo = mid + 1;
         } else {
             hi = mid;
@@ -442,17 +434,17 @@ QVariantMap LogFileParser::gpsCoordAt(double timestampSeconds) const
     }
     // lo is the first index >= timestampSeconds; compare with lo-1.
     if (lo > 0) {
-        const double dPrev = timestampSeconds - latPts[lo - 1].x();
-        const double dCurr = latPts[lo].x() - timestampSeconds;
+        const double dPrev = timestampSeconds - latPts->timeAt(lo - 1);
+        const double dCurr = latPts->timeAt(lo) - timestampSeconds;
         if (dPrev < dCurr) {
             --lo;
         }
     }
 
-    const int lonIdx = std::min(lo, static_cast<int>(lonPts.size()) - 1);
+    const int lonIdx = std::min(lo, static_cast<int>(lonPts->size()) - 1);
     QVariantMap coord;
-    coord[QStringLiteral("latitude")]  = latPts[lo].y();
-    coord[QStringLiteral("longitude")] = lonPts[lonIdx].y();
+    coord[QStringLiteral("latitude")]  = latPts->valueAt(lo);
+    coord[QStringLiteral("longitude")] = lonPts->valueAt(lonIdx);
     return coord;
 }
 
@@ -487,44 +479,40 @@ QVariantList LogFileParser::gpsPath() const
     };
 
     for (const auto &c : candidates) {
-        const auto latIt = _fieldSamples.constFind(QLatin1String(c.latField));
-        const auto lonIt = _fieldSamples.constFind(QLatin1String(c.lonField));
-        if (latIt == _fieldSamples.cend() || lonIt == _fieldSamples.cend()) {
+        // Checked before decoding so missing candidates cost nothing
+        if (!_fieldStore || (_fieldStore->sampleCount(QLatin1String(c.latField)) == 0) || (_fieldStore->sampleCount(QLatin1String(c.lonField)) == 0)) {
             continue;
         }
 
-        const QVector<QPointF> &latPts = latIt.value();
-        const QVector<QPointF> &lonPts = lonIt.value();
-        if (latPts.isEmpty() || lonPts.isEmpty()) {
-            continue;
-        }
+        const LogFieldStore::ColumnPtr latPts = _fieldStore->column(QLatin1String(c.latField));
+        const LogFieldStore::ColumnPtr lonPts = _fieldStore->column(QLatin1String(c.lonField));
 
         // Resolve optional status field (same message, same sample count as lat/lon).
-        const QVector<QPointF> *statusPts = nullptr;
+        LogFieldStore::ColumnPtr statusPts;
         if (c.statusField) {
-            const auto statusIt = _fieldSamples.constFind(QLatin1String(c.statusField));
-            if (statusIt != _fieldSamples.cend() && !statusIt.value().isEmpty()) {
-                statusPts = &statusIt.value();
+            statusPts = _fieldStore->column(QLatin1String(c.statusField));
+            if (statusPts && statusPts->isEmpty()) {
+                statusPts.reset();
             }
         }
 
         qCDebug(LogFileParserLog) << "gpsPath: found candidate" << c.latField
-            << "samples:" << latPts.size()
-            << "first lat:" << latPts.first().y()
-            << "first lon:" << lonPts.first().y();
+            << "samples:" << latPts->size()
+            << "first lat:" << latPts->valueAt(0)
+            << "first lon:" << lonPts->valueAt(0);
 
         QVariantList path;
-        const int n = std::min(latPts.size(), lonPts.size());
+        const int n = static_cast<int>(std::min(latPts->size(), lonPts->size()));
         path.reserve(n);
 
         for (int i = 0; i < n; i++) {
             // Skip samples that don't have a valid GPS fix.
-            if (statusPts && i < statusPts->size() && (*statusPts)[i].y() < c.statusMinValue) {
+            if (statusPts && i < statusPts->size() && statusPts->valueAt(i) < c.statusMinValue) {
                 continue;
             }
 
-            const double lat = latPts[i].y();
-            const double lon = lonPts[i].y();
+            const double lat = latPts->valueAt(i);
+            const double lon = lonPts->valueAt(i);
 
             if (lat < -90.0 || lat > 90.0 || lon < -180.0 || lon > 180.0
                     || (qFuzzyIsNull(lat) && qFuzzyIsNull(lon))) {
@@ -544,8 +532,7 @@ QVariantList LogFileParser::gpsPath() const
             // Only cache the alt field if it actually exists and has samples;
             // otherwise the altitude chart would be shown with no data.
             const QLatin1String altField(c.altField);
-            const auto altIt = _fieldSamples.constFind(altField);
-            _gpsAltField = (altIt != _fieldSamples.cend() && !altIt.value().isEmpty()) ? altField : QLatin1String{};
+            _gpsAltField = (_fieldStore->sampleCount(altField) > 0) ? altField : QLatin1String{};
             return path;
         }
 
@@ -553,11 +540,10 @@ QVariantList LogFileParser::gpsPath() const
     }
 
     qCDebug(LogFileParserLog) << "gpsPath: no GPS data found; available fields containing 'lat' or 'lon':";
-    for (auto it = _fieldSamples.cbegin(); it != _fieldSamples.cend(); ++it) {
-        const QString &fn = it.key();
+    const QStringList fieldNames = _fieldStore ? _fieldStore->fieldNames() : QStringList();
+    for (const QString &fn : fieldNames) {
         if (fn.contains(QLatin1String("lat"), Qt::CaseInsensitive) || fn.contains(QLatin1String("lon"), Qt::CaseInsensitive)) {
-            qCDebug(LogFileParserLog) << " " << fn << "samples:" << it.value().size()
-                << (it.value().isEmpty() ? 0.0 : it.value().first().y());
+            qCDebug(LogFileParserLog) << " " << fn << "samples:" << _fieldStore->sampleCount(fn);
         }
     }
     return {};
@@ -2,19 +2,19 @@
 
 #include <QtCore/QHash>
 #include <QtCore/QObject>
-#include <QtCore/QPointF>
 #include <QtCore/QString>
 #include <QtCore/QStringList>
 #include <QtCore/QVariant>
 #include <QtCore/QVariantList>
 #include <QtCore/QDateTime>
-#include <QtCore/QVector>
 #include <QtCore/QtGlobal>
 #include <QtQmlIntegration/QtQmlIntegration>
 
 #include <atomic>
 #include <memory>
 
+class LogFieldStore;
+
 /// \brief Unified log file parser for both DataFlash (.bin/.log) and PX4 ULog (.ulg) files.
 ///
 /// Dispatches by file extension, verifies the header magic bytes match the expected
@@ -22,7 +22,7 @@
 /// viewer UI consumes identically for both formats:
 ///
 ///  - availableFields / plottableFields — two-level "Type.Field" hierarchy
-///  - fieldSamples(name) — time-series (QPointF) for charting
+///  - fieldSamples(name) — time-series (QPointF) for charting, decoded on first use
 ///  - modeSegments — flight-mode bands for the chart timeline
 ///  - events — timestamped events / errors / warnings
 ///  - parameters — parameter name/value pairs from the log
@@ -100,6 +100,9 @@ class LogFileParser : public QObject
     /// Returns an empty map if GPS data is not available.
     Q_INVOKABLE QVariantMap gpsCoordAt(double timestampSeconds) const;
 
+    /// Columnar field samples of the parsed log, nullptr until a parse completed
+    LogFieldStore *fieldStore() const { return _fieldStore.get(); }
+
 signals:
     void parseCompleteChanged();
     void parseErrorChanged();
@@ -133,7 +136,7 @@ class LogFileParser : public QObject
     QVariantList _modeSegments;
     QVariantList _dropouts;
     QString _detectedVehicleType;
-    QHash<QString, QVector<QPointF>> _fieldSamples;
+    std::shared_ptr<LogFieldStore> _fieldStore;
     double _minTimestamp = -1.0;
     double _maxTimestamp = -1.0;
     int _sampleCount = 0;
@@ -5,11 +5,30 @@
 #include <QtCore/QCoreApplication>
 #include "ULogFullHandler.h"
 
-#include <QtCore/QFile>
+#include <QtCore/QtEndian>
+
+#include <algorithm>
 
 #include <ulog_cpp/reader.hpp>
 
-#include <limits>
+namespace {
+
+constexpr qint64 kMessageHeaderSize = 3;    // uint16 msg_size, uint8 msg_type
+constexpr qint64 kDataMsgIdSize = 2;
+constexpr char kDataMessageType = 'D';
+
+bool _isKnownMessageType(char msgType)
+{
+    switch (msgType) {
+    case 'A': case 'B': case 'C': case 'D': case 'F': case 'I': case 'L':
+    case 'M': case 'O': case 'P': case 'Q': case 'R': case 'S':
+        return true;
+    default:
+        return false;
+    }
+}
+
+} // namespace
 
 namespace ULogParser {
 
@@ -17,35 +36,13 @@ LogParseResult parseFile(const QString &filePath, const ProgressCallback &progre
 {
     LogParseResult result;
 
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly)) {
-        result.errorMessage = QCoreApplication::translate("LogFileParser", "Failed to open file");
-        return result;
-    }
-
-    const qint64 fileSize = file.size();
-    if (fileSize <= 0) {
-        result.errorMessage = QCoreApplication::translate("LogFileParser", "File is empty");
-        return result;
-    }
-    if (fileSize > std::numeric_limits<qsizetype>::max()) {
-        result.errorMessage = QCoreApplication::translate("LogFileParser", "File is too large to parse");
-        return result;
-    }
-
-    uchar *const mappedData = file.map(0, fileSize);
-    if (mappedData == nullptr) {
-        result.errorMessage = QCoreApplication::translate("LogFileParser", "Failed to memory-map file");
+    auto store = std::make_shared<LogFieldStore>();
+    if (!store->open(filePath, result.errorMessage)) {
         return result;
     }
 
-    struct ScopedUnmap {
-        QFile &file;
-        uchar *data = nullptr;
-        ~ScopedUnmap() { if (data) { file.unmap(data); } }
-    } scopedUnmap{file, mappedData};
-
-    const char *const raw = reinterpret_cast<const char *>(mappedData);
+    const qint64 fileSize = store->size();
+    const char *const raw = store->data();
 
     // Verify ULog magic
     if (!PX4ULogUtility::isValidHeader(raw, fileSize)) {
@@ -53,24 +50,73 @@ LogParseResult parseFile(const QString &filePath, const ProgressCallback &progre
         return result;
     }
 
+    result.fieldStore = store;
     auto handler = std::make_shared<ULogFullHandler>(result, progressCallback);
     ulog_cpp::Reader reader(handler);
 
+    const auto feed = [&reader, raw](qint64 offset, qint64 count) {
+        reader.readChunk(reinterpret_cast<const uint8_t *>(raw) + offset, static_cast<size_t>(count));
+    };
+    const auto isCanceled = [&cancelToken]() {
+        return cancelToken && cancelToken->load(std::memory_order_relaxed);
+    };
+
     static constexpr qint64 kChunkSize = 64 * 1024;
-    qint64 offset = 0;
+
+    // Walk the message framing here so data messages are indexed in place instead of being copied and
+    // decoded by the reader. Everything else, and anything after a corrupt message, still goes through
+    // the reader which knows how to resynchronize.
+    qint64 offset = std::min<qint64>(PX4ULogUtility::kHeaderSize, fileSize);
+    feed(0, offset);
+    qint64 nextProgressOffset = offset + kChunkSize;
     while (offset < fileSize) {
+        if (offset >= nextProgressOffset) {
+            if (isCanceled()) {
+                return result;  // cancelled; result.ok is false, discarded by requestId guard
+            }
+            if (progressCallback) {
+                progressCallback(static_cast<float>(offset) / static_cast<float>(fileSize));
+            }
+            nextProgressOffset = offset + kChunkSize;
+        }
+
         const qint64 remaining = fileSize - offset;
-        const qint64 chunk = (remaining < kChunkSize) ? remaining : kChunkSize;
-        reader.readChunk(reinterpret_cast<const uint8_t *>(raw) + offset, static_cast<size_t>(chunk));
+        const qint64 messageSize = (remaining >= kMessageHeaderSize)
+            ? (kMessageHeaderSize + qFromLittleEndian<quint16>(raw + offset))
+            : remaining;
+        const char messageType = (remaining >= kMessageHeaderSize) ? raw[offset + 2] : 0;
+
+        if ((messageSize > remaining) || !_isKnownMessageType(messageType)) {
+            break;
+        }
+
+        if ((messageType == kDataMessageType) && handler->isHeaderComplete() && (messageSize >= (kMessageHeaderSize + kDataMsgIdSize))) {
+            const uint16_t msgId = qFromLittleEndian<quint16>(raw + offset + kMessageHeaderSize);
+            const qint64 payloadOffset = offset + kMessageHeaderSize + kDataMsgIdSize;
+            handler->indexData(msgId, payloadOffset, messageSize - kMessageHeaderSize - kDataMsgIdSize);
+        } else {
+            feed(offset, messageSize);
+        }
+        offset += messageSize;
+    }
+
+    // Corrupt or truncated tail
+    while (offset < fileSize) {
+        const qint64 chunk = std::min(fileSize - offset, kChunkSize);
+        feed(offset, chunk);
         offset += chunk;
-        if (cancelToken && cancelToken->load(std::memory_order_relaxed)) {
-            return result;  // cancelled; result.ok is false, discarded by requestId guard
+        if (isCanceled()) {
+            return result;
         }
         if (progressCallback) {
             progressCallback(static_cast<float>(offset) / static_cast<float>(fileSize));
         }
     }
 
+    if (progressCallback) {
+        progressCallback(1.f);
+    }
+
     if (handler->hadFatalError()) {
         if (result.errorMessage.isEmpty()) {
             result.errorMessage = QCoreApplication::translate("LogFileParser", "Fatal error while parsing ULog file");
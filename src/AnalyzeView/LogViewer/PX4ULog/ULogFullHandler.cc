@@ -5,6 +5,7 @@
 
 #include <QtCore/QStringList>
 #include <QtCore/QTimeZone>
+#include <QtCore/QtEndian>
 
 #include <algorithm>
 #include <stdexcept>
@@ -45,34 +46,41 @@ QString _px4NavStateName(int state)
     }
 }
 
-bool _isNumericScalarField(const ulog_cpp::Field &field)
+/// Maps numeric scalar fields to their store decoder; arrays, strings and nested types are not plottable.
+bool _fieldDecoder(const ulog_cpp::Field &field, LogFieldStore::FieldDecoder &decoder)
 {
     if (field.arrayLength() >= 0) {
         return false; // arrays excluded from plottable fields
     }
+
     using BT = ulog_cpp::Field::BasicType;
+    using VT = LogFieldStore::ValueType;
     switch (field.type().type) {
-    case BT::INT8:
-    case BT::UINT8:
-    case BT::INT16:
-    case BT::UINT16:
-    case BT::INT32:
-    case BT::UINT32:
-    case BT::INT64:
-    case BT::UINT64:
-    case BT::FLOAT:
-    case BT::DOUBLE:
-    case BT::BOOL:
-        return true;
+    case BT::INT8:   decoder.type = VT::Int8;   break;
+    case BT::UINT8:  decoder.type = VT::UInt8;  break;
+    case BT::INT16:  decoder.type = VT::Int16;  break;
+    case BT::UINT16: decoder.type = VT::UInt16; break;
+    case BT::INT32:  decoder.type = VT::Int32;  break;
+    case BT::UINT32: decoder.type = VT::UInt32; break;
+    case BT::INT64:  decoder.type = VT::Int64;  break;
+    case BT::UINT64: decoder.type = VT::UInt64; break;
+    case BT::FLOAT:  decoder.type = VT::Float;  break;
+    case BT::DOUBLE: decoder.type = VT::Double; break;
+    case BT::BOOL:   decoder.type = VT::UInt8;  break;
     default:
         return false;
     }
+
+    decoder.offset = field.offsetInMessage();
+    decoder.divisor = 1.0;
+    return true;
 }
 
 } // namespace
 
 ULogFullHandler::ULogFullHandler(LogParseResult &result, const ProgressCallback &/*progressCallback*/)
     : _result(result)
+    , _store(*result.fieldStore)
 {
 }
 
@@ -114,87 +122,134 @@ void ULogFullHandler::headerComplete()
 }
 
 void ULogFullHandler::data(const ulog_cpp::Data &data)
+{
+    // Only reached for data the caller could not index in place (see indexData), so keep a copy
+    const std::vector<uint8_t> &payload = data.data();
+    if (!_headerComplete || payload.empty()) {
+        return;
+    }
+
+    const qint64 payloadOffset = _store.addSpilledPayload(reinterpret_cast<const char *>(payload.data()), static_cast<qsizetype>(payload.size()));
+    indexData(data.msgId(), payloadOffset, static_cast<qsizetype>(payload.size()));
+}
+
+void ULogFullHandler::indexData(uint16_t msgId, qint64 payloadOffset, qsizetype payloadSize)
 {
     if (!_headerComplete) {
         return;
     }
 
-    const auto it = _subscriptions.find(data.msgId());
-    if (it == _subscriptions.cend()) {
+    const auto it = _subscriptions.find(msgId);
+    if (it == _subscriptions.end()) {
         return;
     }
 
-    const SubscriptionInfo &sub = it->second;
+    SubscriptionInfo &sub = it->second;
     if (!sub.format) {
         return;
     }
 
-    try {
-        const ulog_cpp::TypedDataView view(data, *sub.format);
-
-        // Extract timestamp (ULog convention: field named "timestamp", unit µs)
-        double timestampSecs = -1.0;
-        if (sub.format->fieldMap().count("timestamp") > 0) {
-            const uint64_t tsUs = view.at("timestamp").as<uint64_t>();
-            timestampSecs = static_cast<double>(tsUs) / 1e6;
-            _lastTimestampSecs = timestampSecs;
-        }
+    if (!sub.registered) {
+        _registerSubscription(sub);
+    }
+
+    if (payloadSize < sub.requiredSize) {
+        qCWarning(ULogFullHandlerLog) << "Truncated data message for" << QString::fromStdString(sub.topicName) << payloadSize << "bytes";
+        return;
+    }
+
+    const char *const payload = _store.recordData(payloadOffset);
+
+    // Extract timestamp (ULog convention: field named "timestamp", unit µs)
+    double timestampSecs = -1.0;
+    if (sub.timestampOffset >= 0) {
+        const uint64_t tsUs = qFromLittleEndian<quint64>(payload + sub.timestampOffset);
+        timestampSecs = static_cast<double>(tsUs) / 1e6;
+        _lastTimestampSecs = timestampSecs;
 
         // Extract GPS UTC start time from first valid sensor_gps/vehicle_gps_position sample.
         // Define QGC_NO_LOG_START_TIME at build time to suppress this for UI testing.
 #ifndef QGC_NO_LOG_START_TIME
-        if (_result.startTime.isNull() && timestampSecs >= 0.0) {
-            if ((sub.topicName == "sensor_gps" || sub.topicName == "vehicle_gps_position")
-                    && sub.format->fieldMap().count("time_utc_usec") > 0) {
-                const uint64_t utcUsec = view.at("time_utc_usec").as<uint64_t>();
-                const uint64_t tsUs   = view.at("timestamp").as<uint64_t>();
-                if (utcUsec > 0 && utcUsec >= tsUs) {
-                    const qint64 startMs = static_cast<qint64>((utcUsec - tsUs) / 1000);
-                    _result.startTime = QDateTime::fromMSecsSinceEpoch(startMs, QTimeZone::utc());
-                }
+        if (_result.startTime.isNull() && (sub.utcOffset >= 0)) {
+            const uint64_t utcUsec = qFromLittleEndian<quint64>(payload + sub.utcOffset);
+            if (utcUsec > 0 && utcUsec >= tsUs) {
+                const qint64 startMs = static_cast<qint64>((utcUsec - tsUs) / 1000);
+                _result.startTime = QDateTime::fromMSecsSinceEpoch(startMs, QTimeZone::utc());
             }
         }
 #endif // QGC_NO_LOG_START_TIME
+    }
 
-        // Field name: "topic_name.field" or "topic_name[N].field" for multi-instance
-        const QString prefix = (sub.multiId > 0)
-            ? QStringLiteral("%1[%2].").arg(QString::fromStdString(sub.topicName)).arg(sub.multiId)
-            : QString::fromStdString(sub.topicName) + QLatin1Char('.');
+    if (sub.storeTopic >= 0) {
+        _store.addRecord(sub.storeTopic, payloadOffset);
+    }
 
-        for (const auto &field : sub.format->fields()) {
-            // Skip padding fields and the timestamp itself
-            if (field->name().rfind("_padding", 0) == 0) {
-                continue;
-            }
-            if (field->name() == "timestamp") {
-                continue;
-            }
-            if (!field->definitionResolved()) {
-                continue;
-            }
+    _result.sampleCount++;
 
-            const QString fieldName = prefix + QString::fromStdString(field->name());
-            _fieldSet.insert(fieldName);
+    if (timestampSecs >= 0.0) {
+        if (_result.minTimestamp < 0.0 || timestampSecs < _result.minTimestamp) {
+            _result.minTimestamp = timestampSecs;
+        }
+        _result.maxTimestamp = std::max(_result.maxTimestamp, timestampSecs);
+    }
+}
+
+void ULogFullHandler::_registerSubscription(SubscriptionInfo &sub)
+{
+    sub.registered = true;
+
+    const auto &fieldMap = sub.format->fieldMap();
+    const auto timestampIt = fieldMap.find("timestamp");
+    if ((timestampIt != fieldMap.cend()) && timestampIt->second->definitionResolved()) {
+        const ulog_cpp::Field &timestampField = *timestampIt->second;
+        LogFieldStore::FieldDecoder decoder;
+        if (_fieldDecoder(timestampField, decoder) && (decoder.type == LogFieldStore::ValueType::UInt64)) {
+            decoder.divisor = 1e6;
+            sub.timestampOffset = decoder.offset;
+            sub.storeTopic = _store.addTopic(decoder);
+            sub.requiredSize = decoder.offset + LogFieldStore::valueSize(decoder.type);
+        }
+    }
 
-            if (!_isNumericScalarField(*field) || timestampSecs < 0.0) {
-                continue;
+    if ((sub.timestampOffset >= 0) && ((sub.topicName == "sensor_gps") || (sub.topicName == "vehicle_gps_position"))) {
+        const auto utcIt = fieldMap.find("time_utc_usec");
+        if ((utcIt != fieldMap.cend()) && utcIt->second->definitionResolved()) {
+            LogFieldStore::FieldDecoder decoder;
+            if (_fieldDecoder(*utcIt->second, decoder) && (decoder.type == LogFieldStore::ValueType::UInt64)) {
+                sub.utcOffset = decoder.offset;
+                sub.requiredSize = std::max(sub.requiredSize, decoder.offset + LogFieldStore::valueSize(decoder.type));
             }
+        }
+    }
 
-            const double value = view.at(field).as<double>();
-            _result.fieldSamples[fieldName].append(QPointF(timestampSecs, value));
-            _plottableFieldSet.insert(fieldName);
+    // Field name: "topic_name.field" or "topic_name[N].field" for multi-instance
+    const QString prefix = (sub.multiId > 0)
+        ? QStringLiteral("%1[%2].").arg(QString::fromStdString(sub.topicName)).arg(sub.multiId)
+        : QString::fromStdString(sub.topicName) + QLatin1Char('.');
+
+    for (const auto &field : sub.format->fields()) {
+        // Skip padding fields and the timestamp itself
+        if (field->name().rfind("_padding", 0) == 0) {
+            continue;
+        }
+        if (field->name() == "timestamp") {
+            continue;
+        }
+        if (!field->definitionResolved()) {
+            continue;
         }
 
-        _result.sampleCount++;
+        const QString fieldName = prefix + QString::fromStdString(field->name());
+        _fieldSet.insert(fieldName);
 
-        if (timestampSecs >= 0.0) {
-            if (_result.minTimestamp < 0.0 || timestampSecs < _result.minTimestamp) {
-                _result.minTimestamp = timestampSecs;
-            }
-            _result.maxTimestamp = std::max(_result.maxTimestamp, timestampSecs);
+        LogFieldStore::FieldDecoder decoder;
+        if ((sub.storeTopic < 0) || !_fieldDecoder(*field, decoder)) {
+            continue;
         }
-    } catch (const std::exception &e) {
-        qCWarning(ULogFullHandlerLog) << "Failed to decode data message:" << e.what();
+
+        _store.addField(fieldName, sub.storeTopic, decoder);
+        _plottableFieldSet.insert(fieldName);
+        sub.requiredSize = std::max(sub.requiredSize, decoder.offset + LogFieldStore::valueSize(decoder.type));
     }
 }
 
@@ -293,9 +348,9 @@ void ULogFullHandler::finalize()
 {
     // Detect vehicle type from vehicle_status.vehicle_type
     // PX4 vehicle_type enum: 0=Unknown, 1=Rotary Wing, 2=Fixed Wing, 3=Rover, 4=Airship
-    const auto vehicleTypeIt = _result.fieldSamples.constFind(QStringLiteral("vehicle_status.vehicle_type"));
-    if (vehicleTypeIt != _result.fieldSamples.cend() && !vehicleTypeIt->isEmpty()) {
-        const int vtype = static_cast<int>(vehicleTypeIt->first().y());
+    const LogFieldStore::ColumnPtr vehicleType = _store.column(QStringLiteral("vehicle_status.vehicle_type"));
+    if (vehicleType && !vehicleType->isEmpty()) {
+        const int vtype = static_cast<int>(vehicleType->valueAt(0));
         switch (vtype) {
         case 1: _result.detectedVehicleType = QStringLiteral("Multirotor/Helicopter"); break;
         case 2: _result.detectedVehicleType = QStringLiteral("Fixed Wing");            break;
@@ -307,14 +362,14 @@ void ULogFullHandler::finalize()
 
     // Derive mode segments from vehicle_status.nav_state samples.
     // nav_state is a uint8_t mapped to the PX4 navigation_state enum.
-    const auto navStateIt = _result.fieldSamples.constFind(QStringLiteral("vehicle_status.nav_state"));
-    if (navStateIt != _result.fieldSamples.cend()) {
-        const QVector<QPointF> &samples = navStateIt.value();
+    const LogFieldStore::ColumnPtr navStates = _store.column(QStringLiteral("vehicle_status.nav_state"));
+    if (navStates) {
         int lastNavState = -1;
         double segmentStart = -1.0;
         QString segmentMode;
 
-        for (const QPointF &pt : samples) {
+        for (qsizetype i = 0; i < navStates->size(); i++) {
+            const QPointF pt = navStates->pointAt(i);
             const int navState = static_cast<int>(pt.y());
             if (navState != lastNavState) {
                 // Close the previous segment
@@ -19,8 +19,9 @@ struct LogParseResult;
 
 /// \brief Full-scan ULog DataHandlerInterface implementation.
 ///
-/// Streams through a ULog file in a single pass, collecting signal samples,
-/// parameters, log messages, events, and dropouts into a LogParseResult.
+/// Streams through a ULog file in a single pass, indexing data messages into
+/// the result's LogFieldStore and collecting parameters, log messages, events,
+/// and dropouts into a LogParseResult. Field values are not decoded here.
 /// Call finalize() after parsing to build mode segments and sort signal lists.
 ///
 class ULogFullHandler final : public ulog_cpp::DataHandlerInterface
@@ -39,6 +40,10 @@ class ULogFullHandler final : public ulog_cpp::DataHandlerInterface
     void parameterDefault(const ulog_cpp::ParameterDefault &parameter_default) override;
     void dropout(const ulog_cpp::Dropout &dropout) override;
 
+    /// Indexes a data message located by the caller's own framing walk, without copying it.
+    /// @param payloadOffset Offset of the payload (after msg_id) in the store's mapped file
+    void indexData(uint16_t msgId, qint64 payloadOffset, qsizetype payloadSize);
+
     bool hadFatalError() const { return _hadFatalError; }
     bool isHeaderComplete() const { return _headerComplete; }
 
@@ -47,14 +52,22 @@ class ULogFullHandler final : public ulog_cpp::DataHandlerInterface
     void finalize();
 
 private:
-    LogParseResult &_result;
-
     struct SubscriptionInfo {
         std::shared_ptr<ulog_cpp::MessageFormat> format;
         uint8_t multiId{0};
         std::string topicName;
+        bool registered{false};         ///< Fields were added to the store
+        int storeTopic{-1};             ///< -1: no timestamp field, samples are not plottable
+        qint32 timestampOffset{-1};
+        qint32 utcOffset{-1};           ///< time_utc_usec of GPS topics, used for the log start time
+        qsizetype requiredSize{0};      ///< Shorter payloads can not be decoded
     };
 
+    void _registerSubscription(SubscriptionInfo &sub);
+
+    LogParseResult &_result;
+    LogFieldStore &_store;
+
     std::map<std::string, std::shared_ptr<ulog_cpp::MessageFormat>> _formats;
     std::map<uint16_t, SubscriptionInfo> _subscriptions;
     QSet<QString> _fieldSet;
@@ -3,7 +3,9 @@
 #include "LinkManager.h"
 #include "AppMessages.h"
 #include "QGCApplication.h"
+#include "MavlinkSettings.h"
 #include "QGCLoggingCategory.h"
+#include "SettingsManager.h"
 #include "SigningController.h"
 
 #include <QtQml/QQmlEngine>
@@ -63,6 +65,8 @@ bool LinkInterface::_allocateMavlinkChannel()
     _signingController = std::make_unique<SigningController>(static_cast<mavlink_channel_t>(_mavlinkChannel));
     _signingController->clearSigning();
 
+    _frameParser = std::make_shared<MAVLinkFrameParser>(_mavlinkChannel, _signingController.get());
+
     qCDebug(LinkInterfaceLog) << "SigningController created for channel" << _mavlinkChannel
                               << (isSecureConnection() ? "(secure)" : "(will auto-detect)");
 
@@ -77,6 +81,12 @@ void LinkInterface::_freeMavlinkChannel()
         return;
     }
 
+    // A worker thread may still hold the parser; detach it before the signing controller it points at goes away.
+    if (_frameParser) {
+        _frameParser->detach();
+        _frameParser.reset();
+    }
+
     // Destroy the controller before freeing the channel so it can flush the final timestamp.
     _signingController.reset();
 
@@ -92,8 +102,12 @@ void LinkInterface::_freeMavlinkChannel()
 
 void LinkInterface::writeBytesThreadSafe(const char *bytes, int length)
 {
-    const QByteArray data(bytes, length);
-    (void) QMetaObject::invokeMethod(this, "_writeBytes", Qt::AutoConnection, data);
+    writeBytesThreadSafe(QByteArray(bytes, length));
+}
+
+void LinkInterface::writeBytesThreadSafe(const QByteArray &bytes)
+{
+    (void) QMetaObject::invokeMethod(this, "_writeBytes", Qt::AutoConnection, bytes);
 }
 
 void LinkInterface::sendMessageThreadSafe(mavlink_message_t &message)
@@ -110,6 +124,11 @@ void LinkInterface::sendMessageThreadSafe(mavlink_message_t &message)
     writeBytesThreadSafe(reinterpret_cast<const char *>(buffer), len);
 }
 
+bool LinkInterface::linkThreadParsingEnabled()
+{
+    return SettingsManager::instance()->mavlinkSettings()->linkThreadParsing()->rawValue().toBool();
+}
+
 void LinkInterface::removeVehicleReference()
 {
     if (_vehicleReferenceCount != 0) {
@@ -6,6 +6,7 @@
 #include <memory>
 
 #include "LinkConfiguration.h"
+#include "MAVLinkFrameParser.h"
 #include "MAVLinkMessageType.h"
 
 class LinkManager;
@@ -36,6 +37,8 @@ class LinkInterface : public QObject
     bool decodedFirstMavlinkPacket() const { return _decodedFirstMavlinkPacket; }
     void setDecodedFirstMavlinkPacket(bool decodedFirstMavlinkPacket) { _decodedFirstMavlinkPacket = decodedFirstMavlinkPacket; }
     void writeBytesThreadSafe(const char *bytes, int length);
+    /// Shares @a bytes instead of copying, so one buffer can be written to several links.
+    void writeBytesThreadSafe(const QByteArray &bytes);
     /// Single message-level send chokepoint: re-signs (if signing is active), serializes, then writes. All
     /// outbound mavlink_message_t sends must route through here so signing can't be bypassed.
     void sendMessageThreadSafe(mavlink_message_t &message);
@@ -57,8 +60,18 @@ class LinkInterface : public QObject
     SigningController* signing() { return _signingController.get(); }
     const SigningController* signing() const { return _signingController.get(); }
 
+    /// Frame parser for this link's channel. Non-null after channel allocation. Shared so link worker threads
+    /// can keep parsing safely while the link is torn down.
+    std::shared_ptr<MAVLinkFrameParser> frameParser() const { return _frameParser; }
+
+    /// True when links should parse MAVLink on their worker thread and emit messagesReceived instead of
+    /// bytesReceived. Only links which own a worker thread honour it.
+    static bool linkThreadParsingEnabled();
+
 signals:
     void bytesReceived(LinkInterface *link, const QByteArray &data);
+    /// Frames already parsed on the link worker thread (see linkThreadParsingEnabled)
+    void messagesReceived(LinkInterface *link, const MAVLinkFrameBatch &batch);
     void bytesSent(LinkInterface *link, const QByteArray &data);
     void connected();
     void disconnected();
@@ -96,6 +109,8 @@ private slots:
     /// Must `reset()` in `_freeMavlinkChannel` before LinkManager frees the channel so the
     /// controller can flush the final timestamp.
     std::unique_ptr<SigningController> _signingController;
+    /// Must be detached in `_freeMavlinkChannel` before the signing controller is destroyed.
+    std::shared_ptr<MAVLinkFrameParser> _frameParser;
 };
 
 typedef std::shared_ptr<LinkInterface> SharedLinkInterfacePtr;
@@ -49,6 +49,7 @@ LinkManager::LinkManager(QObject *parent)
 
     (void) qRegisterMetaType<QAbstractSocket::SocketError>("QAbstractSocket::SocketError");
     (void) qRegisterMetaType<LinkInterface*>("LinkInterface*");
+    (void) qRegisterMetaType<MAVLinkFrameBatch>("MAVLinkFrameBatch");
 #ifndef QGC_NO_SERIAL_LINK
     (void) qRegisterMetaType<QGCSerialPortInfo>("QGCSerialPortInfo");
 #endif
@@ -175,6 +176,7 @@ bool LinkManager::createConnectedLink(SharedLinkConfigurationPtr &config)
     // Set up signal connections before adding to list, so link is fully initialized
     (void) connect(link.get(), &LinkInterface::communicationError, this, &LinkManager::_communicationError);
     (void) connect(link.get(), &LinkInterface::bytesReceived, MAVLinkProtocol::instance(), &MAVLinkProtocol::receiveBytes);
+    (void) connect(link.get(), &LinkInterface::messagesReceived, MAVLinkProtocol::instance(), &MAVLinkProtocol::receiveMessages);
     (void) connect(link.get(), &LinkInterface::bytesSent, MAVLinkProtocol::instance(), &MAVLinkProtocol::logSentBytes);
     (void) connect(link.get(), &LinkInterface::connected, this, &LinkManager::_linkConnected);
     (void) connect(link.get(), &LinkInterface::disconnected, this, &LinkManager::_linkDisconnected);
@@ -185,6 +187,7 @@ bool LinkManager::createConnectedLink(SharedLinkConfigurationPtr &config)
     if (!link->_connect()) {
         (void) disconnect(link.get(), &LinkInterface::communicationError, this, &LinkManager::_communicationError);
         (void) disconnect(link.get(), &LinkInterface::bytesReceived, MAVLinkProtocol::instance(), &MAVLinkProtocol::receiveBytes);
+        (void) disconnect(link.get(), &LinkInterface::messagesReceived, MAVLinkProtocol::instance(), &MAVLinkProtocol::receiveMessages);
         (void) disconnect(link.get(), &LinkInterface::bytesSent, MAVLinkProtocol::instance(), &MAVLinkProtocol::logSentBytes);
         (void) disconnect(link.get(), &LinkInterface::disconnected, this, &LinkManager::_linkDisconnected);
         link->_freeMavlinkChannel();
@@ -196,6 +199,7 @@ bool LinkManager::createConnectedLink(SharedLinkConfigurationPtr &config)
         QMutexLocker locker(&_linksMutex);
         _rgLinks.append(link);
     }
+    MAVLinkProtocol::instance()->registerLink(link);
     config->setLink(link);
 
     return true;
@@ -295,13 +299,19 @@ void LinkManager::_linkDisconnected()
         return;
     }
 
+    MAVLinkProtocol::instance()->unregisterLink(link);
+
     if (config) {
         config->noteDisconnected();
         config->setLink(nullptr);
+        if (config->isForwarding()) {
+            emit mavlinkForwardingLinksChanged();
+        }
     }
 
     (void) disconnect(link, &LinkInterface::communicationError, this, &LinkManager::_communicationError);
     (void) disconnect(link, &LinkInterface::bytesReceived, MAVLinkProtocol::instance(), &MAVLinkProtocol::receiveBytes);
+    (void) disconnect(link, &LinkInterface::messagesReceived, MAVLinkProtocol::instance(), &MAVLinkProtocol::receiveMessages);
     (void) disconnect(link, &LinkInterface::bytesSent, MAVLinkProtocol::instance(), &MAVLinkProtocol::logSentBytes);
     (void) disconnect(link, &LinkInterface::connected, this, &LinkManager::_linkConnected);
     (void) disconnect(link, &LinkInterface::disconnected, this, &LinkManager::_linkDisconnected);
@@ -768,6 +778,7 @@ void LinkManager::_createDynamicForwardLink(const char *linkName, const QString
     createConnectedLink(config);
 
     qCDebug(LinkManagerLog) << "New dynamic MAVLink forwarding port added:" << linkName << " hostname:" << hostName;
+    emit mavlinkForwardingLinksChanged();
 }
 
 bool LinkManager::isLinkUSBDirect([[maybe_unused]] const LinkInterface *link)
@@ -115,6 +115,8 @@ class LinkManager : public QObject
 
 signals:
     void mavlinkSupportForwardingEnabledChanged();
+    /// A forwarding link was created or removed
+    void mavlinkForwardingLinksChanged();
     void isBluetoothAvailableChanged();
 
 private slots:
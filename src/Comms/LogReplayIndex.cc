@@ -0,0 +1,249 @@
+#include "LogReplayIndex.h"
+#include "MAVLinkLib.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QDataStream>
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+#include <QtCore/QtEndian>
+
+#include <algorithm>
+
+QGC_LOGGING_CATEGORY(LogReplayIndexLog, "Comms.LogReplayIndex")
+
+namespace {
+
+/// MAVLink framing on private buffers, so an index can be built on any thread without a channel.
+class FrameScanner
+{
+public:
+    /// @return true: @a c completed a valid frame
+    bool push(uint8_t c)
+    {
+        const uint8_t framing = mavlink_frame_char_buffer(&_rxMessage, &_rxStatus, c, &_message, &_status);
+        if ((framing == MAVLINK_FRAMING_BAD_CRC) || (framing == MAVLINK_FRAMING_BAD_SIGNATURE)) {
+            // Same recovery as mavlink_parse_char
+            _rxStatus.msg_received = MAVLINK_FRAMING_INCOMPLETE;
+            _rxStatus.parse_state = MAVLINK_PARSE_STATE_IDLE;
+            if (c == MAVLINK_STX) {
+                _rxStatus.parse_state = MAVLINK_PARSE_STATE_GOT_STX;
+                _rxMessage.len = 0;
+                mavlink_start_checksum(&_rxMessage);
+            }
+            return false;
+        }
+
+        return (framing == MAVLINK_FRAMING_OK);
+    }
+
+private:
+    mavlink_message_t _rxMessage{};
+    mavlink_status_t _rxStatus{};
+    mavlink_message_t _message{};
+    mavlink_status_t _status{};
+};
+
+struct CacheKey
+{
+    qint64 logSize = 0;
+    qint64 logModifiedMSecs = 0;
+};
+
+CacheKey cacheKeyForLog(const QString &logFilename)
+{
+    const QFileInfo info(logFilename);
+    return { info.size(), info.lastModified().toMSecsSinceEpoch() };
+}
+
+} // namespace
+
+qsizetype LogReplayIndex::entryIndexForTime(quint64 timestampUSecs) const
+{
+    const auto it = std::upper_bound(_entries.cbegin(), _entries.cend(), timestampUSecs, [](quint64 time, const Entry &entry) {
+        return time < entry.timestampUSecs;
+    });
+
+    return qMax(static_cast<qsizetype>(std::distance(_entries.cbegin(), it)) - 1, static_cast<qsizetype>(0));
+}
+
+qsizetype LogReplayIndex::entryIndexBeforeOffset(qint64 offset) const
+{
+    const auto it = std::lower_bound(_entries.cbegin(), _entries.cend(), offset, [](const Entry &entry, qint64 value) {
+        return entry.offset < value;
+    });
+
+    return qMax(static_cast<qsizetype>(std::distance(_entries.cbegin(), it)) - 1, static_cast<qsizetype>(0));
+}
+
+void LogReplayIndex::_addFrame(quint64 timestampUSecs, qint64 offset)
+{
+    if (_frameCount == 0) {
+        _startTimeUSecs = timestampUSecs;
+    }
+    _endTimeUSecs = timestampUSecs;
+    _frameCount++;
+
+    // Entry timestamps must increase for the binary search, so out of order records never start an entry
+    if (_entries.isEmpty() || (timestampUSecs >= (_entries.constLast().timestampUSecs + kEntryIntervalUSecs))) {
+        _entries.append({ timestampUSecs, offset });
+    }
+}
+
+LogReplayIndex LogReplayIndex::build(const QString &logFilename, const std::function<bool()> &isCanceled)
+{
+    QFile file(logFilename);
+    if (!file.open(QFile::ReadOnly)) {
+        qCWarning(LogReplayIndexLog) << "Unable to open" << logFilename << file.errorString();
+        return LogReplayIndex();
+    }
+
+    LogReplayIndex index;
+    FrameScanner scanner;
+    char timestamp[kTimestampSize];
+    qint64 timestampBytes = 0;
+    qint64 recordOffset = 0;
+    quint64 recordTimeUSecs = 0;
+
+    // Same record framing as LogReplayWorker: a timestamp, then bytes until a frame completes
+    QByteArray chunk(kReadChunkSize, Qt::Uninitialized);
+    qint64 chunkOffset = 0;
+    while (true) {
+        if (isCanceled && isCanceled()) {
+            qCDebug(LogReplayIndexLog) << "Canceled" << logFilename;
+            return LogReplayIndex();
+        }
+
+        const qint64 count = file.read(chunk.data(), chunk.size());
+        if (count <= 0) {
+            break;
+        }
+
+        const char *const data = chunk.constData();
+        for (qint64 i = 0; i < count; i++) {
+            if (timestampBytes < kTimestampSize) {
+                if (timestampBytes == 0) {
+                    recordOffset = chunkOffset + i;
+                }
+                timestamp[timestampBytes++] = data[i];
+                if (timestampBytes == kTimestampSize) {
+                    recordTimeUSecs = parseTimestamp(QByteArrayView(timestamp, kTimestampSize));
+                }
+                continue;
+            }
+
+            if (scanner.push(static_cast<uint8_t>(data[i]))) {
+                index._addFrame(recordTimeUSecs, recordOffset);
+                timestampBytes = 0;
+            }
+        }
+
+        chunkOffset += count;
+    }
+
+    qCDebug(LogReplayIndexLog) << "Indexed" << logFilename << "frames:" << index._frameCount << "entries:" << index._entries.size();
+
+    return index;
+}
+
+QString LogReplayIndex::cacheFilename(const QString &logFilename)
+{
+    return logFilename + QStringLiteral(".qgcidx");
+}
+
+LogReplayIndex LogReplayIndex::load(const QString &logFilename)
+{
+    QFile file(cacheFilename(logFilename));
+    if (!file.open(QFile::ReadOnly)) {
+        return LogReplayIndex();
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    CacheKey key;
+    stream >> magic >> version >> key.logSize >> key.logModifiedMSecs;
+    if ((magic != kCacheMagic) || (version != kCacheVersion)) {
+        qCDebug(LogReplayIndexLog) << "Ignoring cache with unknown format" << file.fileName();
+        return LogReplayIndex();
+    }
+
+    const CacheKey current = cacheKeyForLog(logFilename);
+    if ((key.logSize != current.logSize) || (key.logModifiedMSecs != current.logModifiedMSecs)) {
+        qCDebug(LogReplayIndexLog) << "Ignoring stale cache" << file.fileName();
+        return LogReplayIndex();
+    }
+
+    LogReplayIndex index;
+    quint32 entryCount = 0;
+    stream >> index._startTimeUSecs >> index._endTimeUSecs >> index._frameCount >> entryCount;
+
+    // The count comes from the file, a corrupt one must not turn into a huge allocation
+    constexpr qint64 kEntryStreamSize = sizeof(quint64) + sizeof(qint64);
+    const qint64 maxEntryCount = (file.size() - file.pos()) / kEntryStreamSize;
+    if (entryCount > maxEntryCount) {
+        qCWarning(LogReplayIndexLog) << "Ignoring truncated cache" << file.fileName();
+        return LogReplayIndex();
+    }
+    index._entries.reserve(entryCount);
+    for (quint32 i = 0; (i < entryCount) && (stream.status() == QDataStream::Ok); i++) {
+        Entry entry;
+        stream >> entry.timestampUSecs >> entry.offset;
+        index._entries.append(entry);
+    }
+
+    if ((stream.status() != QDataStream::Ok) || (index._entries.size() != static_cast<qsizetype>(entryCount))) {
+        qCWarning(LogReplayIndexLog) << "Ignoring truncated cache" << file.fileName();
+        return LogReplayIndex();
+    }
+
+    return index;
+}
+
+bool LogReplayIndex::save(const QString &logFilename) const
+{
+    // QSaveFile: a crash while writing must not leave a truncated index behind
+    QSaveFile file(cacheFilename(logFilename));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCDebug(LogReplayIndexLog) << "Unable to write cache" << file.fileName() << file.errorString();
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    const CacheKey key = cacheKeyForLog(logFilename);
+    stream << kCacheMagic << kCacheVersion << key.logSize << key.logModifiedMSecs;
+    stream << _startTimeUSecs << _endTimeUSecs << _frameCount << static_cast<quint32>(_entries.size());
+    for (const Entry &entry : _entries) {
+        stream << entry.timestampUSecs << entry.offset;
+    }
+
+    if ((stream.status() != QDataStream::Ok) || !file.commit()) {
+        qCDebug(LogReplayIndexLog) << "Unable to write cache" << file.fileName() << file.errorString();
+        return false;
+    }
+
+    return true;
+}
+
+quint64 LogReplayIndex::parseTimestamp(QByteArrayView bytes)
+{
+    // Truncated log files can produce a short read; never read past the buffer.
+    if (bytes.size() < kTimestampSize) {
+        return 0;
+    }
+
+    const quint64 currentTimestamp = static_cast<quint64>(QDateTime::currentMSecsSinceEpoch()) * 1000;
+    // qFromBigEndian(const void *src) handles unaligned reads; dereferencing a
+    // cast pointer here would be a misaligned load (UB).
+    quint64 timestamp = qFromBigEndian<quint64>(bytes.data());
+    if (timestamp > currentTimestamp) {
+        timestamp = qbswap(timestamp);
+    }
+
+    return timestamp;
+}
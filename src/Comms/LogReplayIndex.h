@@ -0,0 +1,62 @@
+#pragma once
+
+#include <QtCore/QByteArrayView>
+#include <QtCore/QList>
+#include <QtCore/QString>
+
+#include <functional>
+
+/// \brief Sparse timestamp -> file offset index of a telemetry log (.tlog).
+///
+/// A tlog is a sequence of records, each a big-endian microsecond timestamp followed by one MAVLink frame.
+/// The index keeps the offset of one record per kEntryIntervalUSecs of log time, so a seek is a binary
+/// search followed by a short forward scan. It is built once per log and cached next to it.
+class LogReplayIndex
+{
+public:
+    struct Entry
+    {
+        quint64 timestampUSecs = 0;
+        qint64 offset = 0;          ///< Start of the record, i.e. of its timestamp
+    };
+
+    bool isValid() const { return !_entries.isEmpty(); }
+    quint64 startTimeUSecs() const { return _startTimeUSecs; }
+    quint64 endTimeUSecs() const { return _endTimeUSecs; }
+    qint64 frameCount() const { return _frameCount; }
+    const QList<Entry> &entries() const { return _entries; }
+
+    /// @return Index of the last entry at or before @a timestampUSecs, 0 if the time precedes the log
+    qsizetype entryIndexForTime(quint64 timestampUSecs) const;
+
+    /// @return Index of the last entry which starts before @a offset, 0 if there is none
+    qsizetype entryIndexBeforeOffset(qint64 offset) const;
+
+    /// Scans @a logFilename. @a isCanceled is polled between reads.
+    /// @return Invalid index: log could not be read, has no complete frame or the scan was canceled
+    static LogReplayIndex build(const QString &logFilename, const std::function<bool()> &isCanceled = {});
+
+    /// @return Cached index for @a logFilename, invalid if there is none or the log changed since
+    static LogReplayIndex load(const QString &logFilename);
+    bool save(const QString &logFilename) const;
+
+    static QString cacheFilename(const QString &logFilename);
+
+    /// Decodes a record timestamp. Logs written with the wrong byte order are detected and swapped.
+    static quint64 parseTimestamp(QByteArrayView bytes);
+
+    static constexpr qint64 kTimestampSize = sizeof(quint64);
+    static constexpr quint64 kEntryIntervalUSecs = 250000;
+
+private:
+    void _addFrame(quint64 timestampUSecs, qint64 offset);
+
+    QList<Entry> _entries;
+    quint64 _startTimeUSecs = 0;
+    quint64 _endTimeUSecs = 0;
+    qint64 _frameCount = 0;
+
+    static constexpr quint32 kCacheMagic = 0x51494458;     ///< "QIDX"
+    static constexpr quint32 kCacheVersion = 1;
+    static constexpr qint64 kReadChunkSize = 1024 * 1024;
+};
@@ -5,8 +5,9 @@
 #include "MultiVehicleManager.h"
 #include "QGCLoggingCategory.h"
 
+#include <QtConcurrent/QtConcurrentRun>
 #include <QtCore/QFileInfo>
-#include <QtCore/QtEndian>
+#include <QtCore/QPromise>
 #include <QtCore/QThread>
 #include <QtCore/QTimer>
 
@@ -133,6 +134,9 @@ void LogReplayWorker::disconnectFromLog()
         _readTickTimer->stop();
     }
 
+    _cancelIndexBuild();
+    _index = LogReplayIndex();
+
     if (_logFile.isOpen()) {
         _logFile.close();
     }
@@ -157,6 +161,9 @@ void LogReplayWorker::play()
 
     _playbackStartTimeMSecs = static_cast<quint64>(QDateTime::currentMSecsSinceEpoch());
     _playbackStartLogTimeUSecs = _logCurrentTimeUSecs;
+    _rateMessages = 0;
+    _rateTimer.start();
+    _progressTimer.start();
     _readTickTimer->start(1);
 
     emit playbackStarted();
@@ -180,6 +187,36 @@ void LogReplayWorker::setPlaybackSpeed(qreal playbackSpeed)
     _readTickTimer->start(1);
 }
 
+void LogReplayWorker::setAsFastAsPossible(bool asFastAsPossible)
+{
+    if (asFastAsPossible == _asFastAsPossible) {
+        return;
+    }
+
+    _asFastAsPossible = asFastAsPossible;
+
+    // Paced playback continues from wherever the fast replay got to
+    _playbackStartTimeMSecs = static_cast<quint64>(QDateTime::currentMSecsSinceEpoch());
+    _playbackStartLogTimeUSecs = _logCurrentTimeUSecs;
+    if (isPlaying()) {
+        _readTickTimer->start(0);
+    }
+}
+
+void LogReplayWorker::chunkConsumed()
+{
+    if (_chunksInFlight.fetch_sub(1, std::memory_order_acq_rel) == kMaxChunksInFlight) {
+        (void) QMetaObject::invokeMethod(this, &LogReplayWorker::_resumeAfterBackpressure, Qt::QueuedConnection);
+    }
+}
+
+void LogReplayWorker::_resumeAfterBackpressure()
+{
+    if (_asFastAsPossible && isPlaying()) {
+        _readTickTimer->start(0);
+    }
+}
+
 void LogReplayWorker::movePlayhead(qreal percentComplete)
 {
     if (isPlaying()) {
@@ -191,6 +228,14 @@ void LogReplayWorker::movePlayhead(qreal percentComplete)
 
     percentComplete = qBound(0., percentComplete, 100.);
     const qreal percentCompleteMult = percentComplete / 100.0;
+
+    if (_index.isValid()) {
+        _seekToLogTime(_logStartTimeUSecs + static_cast<quint64>(percentCompleteMult * _logDurationUSecs));
+        _signalPlayheadMoved();
+        return;
+    }
+
+    // No index yet: estimate the offset from the percentage and correct it once
     const qint64 newFilePos = static_cast<qint64>(percentCompleteMult * static_cast<qreal>(_logFile.size()));
     if (!_logFile.seek(newFilePos)) {
         emit errorOccurred(tr("Unable to seek to new position"));
@@ -217,6 +262,167 @@ void LogReplayWorker::movePlayhead(qreal percentComplete)
     emit playbackPercentCompleteChanged(percentComplete);
 }
 
+void LogReplayWorker::stepForward()
+{
+    if (isPlaying()) {
+        pause();
+    }
+
+    if (_logFile.atEnd()) {
+        emit playbackAtEnd();
+        return;
+    }
+
+    QByteArray bytes;
+    const quint64 nextTimeUSecs = _readNextMavlinkMessage(bytes);
+    _emitData(bytes);
+
+    if (_logFile.atEnd()) {
+        emit playbackAtEnd();
+    } else {
+        _logCurrentTimeUSecs = nextTimeUSecs;
+    }
+
+    _signalPlayheadMoved();
+}
+
+void LogReplayWorker::stepBackward()
+{
+    if (!_index.isValid()) {
+        qCDebug(LogReplayLinkLog) << "Log index not ready, unable to step backward";
+        return;
+    }
+
+    if (isPlaying()) {
+        pause();
+    }
+
+    // The playhead is at the frame after the one played last, so replay the frame before that one
+    if (_seekToRecord(_recordOffsetBefore(_currentRecordOffset(), 2))) {
+        stepForward();
+    }
+}
+
+void LogReplayWorker::_seekToLogTime(quint64 logTimeUSecs)
+{
+    const LogReplayIndex::Entry entry = _index.entries().at(_index.entryIndexForTime(logTimeUSecs));
+    if (!_seekToRecord(entry.offset)) {
+        return;
+    }
+
+    // Short scan from the entry to the first frame at or after the requested time
+    while (_logCurrentTimeUSecs < logTimeUSecs) {
+        const qint64 recordOffset = _currentRecordOffset();
+
+        QByteArray bytes;
+        const quint64 nextTimeUSecs = _readNextMavlinkMessage(bytes);
+        if (_logFile.atEnd()) {
+            // Stay on the last frame rather than at the end, where play() would restart the log
+            (void) _seekToRecord(recordOffset);
+            break;
+        }
+
+        _logCurrentTimeUSecs = nextTimeUSecs;
+    }
+}
+
+bool LogReplayWorker::_seekToRecord(qint64 recordOffset)
+{
+    if (!_logFile.seek(recordOffset)) {
+        emit errorOccurred(tr("Unable to seek to new position"));
+        return false;
+    }
+
+    // Leaves the file positioned at the start of the record's frame
+    _logCurrentTimeUSecs = _parseTimestamp(_logFile.read(kTimestamp));
+    mavlink_reset_channel_status(_mavlinkChannel);
+
+    return true;
+}
+
+qint64 LogReplayWorker::_currentRecordOffset() const
+{
+    return qMax(_logFile.pos() - static_cast<qint64>(kTimestamp), static_cast<qint64>(0));
+}
+
+qint64 LogReplayWorker::_recordOffsetBefore(qint64 recordOffset, int count)
+{
+    const QList<LogReplayIndex::Entry> &entries = _index.entries();
+
+    qsizetype entryIndex = _index.entryIndexBeforeOffset(recordOffset);
+    while (true) {
+        QList<qint64> offsets;
+        if (!_seekToRecord(entries.at(entryIndex).offset)) {
+            return recordOffset;
+        }
+
+        while (_currentRecordOffset() < recordOffset) {
+            offsets.append(_currentRecordOffset());
+
+            QByteArray bytes;
+            (void) _readNextMavlinkMessage(bytes);
+            if (_logFile.atEnd()) {
+                break;
+            }
+        }
+
+        if ((offsets.size() >= count) || (entryIndex == 0)) {
+            return offsets.isEmpty() ? entries.constFirst().offset : offsets.at(qMax(offsets.size() - count, static_cast<qsizetype>(0)));
+        }
+
+        // Not enough frames since the closest entry, widen the scan to the previous one
+        entryIndex--;
+    }
+}
+
+void LogReplayWorker::_signalPlayheadMoved()
+{
+    _signalCurrentLogTimeSecs();
+    emit playbackPercentCompleteChanged((static_cast<qreal>(_logCurrentTimeUSecs - _logStartTimeUSecs) / static_cast<qreal>(_logDurationUSecs)) * 100);
+}
+
+void LogReplayWorker::_startIndexBuild()
+{
+    if (!_indexWatcher) {
+        _indexWatcher = new QFutureWatcher<LogReplayIndex>(this);
+        (void) connect(_indexWatcher, &QFutureWatcher<LogReplayIndex>::finished, this, &LogReplayWorker::_indexBuilt);
+    }
+
+    const QString logFilename = _logReplayConfig->logFilename();
+    _indexWatcher->setFuture(QtConcurrent::run([logFilename](QPromise<LogReplayIndex> &promise) {
+        const LogReplayIndex index = LogReplayIndex::build(logFilename, [&promise]() { return promise.isCanceled(); });
+        if (index.isValid()) {
+            // Failing to write the cache (e.g. read-only log directory) only costs a rebuild next time
+            (void) index.save(logFilename);
+        }
+        promise.addResult(index);
+    }));
+}
+
+void LogReplayWorker::_cancelIndexBuild()
+{
+    if (_indexWatcher && _indexWatcher->isRunning()) {
+        _indexWatcher->cancel();
+        _indexWatcher->waitForFinished();
+    }
+}
+
+void LogReplayWorker::_indexBuilt()
+{
+    if (!_isConnected || _indexWatcher->isCanceled() || (_indexWatcher->future().resultCount() == 0)) {
+        return;
+    }
+
+    const LogReplayIndex index = _indexWatcher->result();
+    if (!index.isValid()) {
+        qCWarning(LogReplayLinkLog) << "Unable to index log, seeking falls back to estimates";
+        return;
+    }
+
+    _index = index;
+    emit indexReady();
+}
+
 void LogReplayWorker::_resetPlaybackToBeginning()
 {
     if (_logFile.isOpen()) {
@@ -232,12 +438,18 @@ void LogReplayWorker::_resetPlaybackToBeginning()
 
 void LogReplayWorker::_readNextLogEntry()
 {
+    if (_asFastAsPossible) {
+        _readNextChunk();
+        return;
+    }
+
     int timeToNextExecutionMSecs = 0;
     while (timeToNextExecutionMSecs < 3) {
         QByteArray bytes;
-        bytes.reserve(_logFile.bytesAvailable());
+        bytes.reserve(MAVLINK_MAX_PACKET_LEN);
         const qint64 nextTimeUSecs = _readNextMavlinkMessage(bytes);
-        emit dataReceived(bytes);
+        _emitData(bytes);
+        _countMessages(1);
         emit playbackPercentCompleteChanged((static_cast<float>(_logCurrentTimeUSecs - _logStartTimeUSecs) / static_cast<float>(_logDurationUSecs)) * 100);
 
         if (_logFile.atEnd()) {
@@ -259,6 +471,73 @@ void LogReplayWorker::_readNextLogEntry()
     _readTickTimer->start(timeToNextExecutionMSecs);
 }
 
+void LogReplayWorker::_readNextChunk()
+{
+    if (_chunksInFlight.load(std::memory_order_acquire) >= kMaxChunksInFlight) {
+        // chunkConsumed() wakes us up once the receiving side catches up
+        _readTickTimer->start(kBackpressurePollMSecs);
+        return;
+    }
+
+    // Many messages per chunk so queued signal overhead stays small relative to the work per message
+    QByteArray chunk;
+    chunk.reserve(kFastReplayChunkBytes + MAVLINK_MAX_PACKET_LEN);
+    quint64 messageCount = 0;
+    bool atEnd = false;
+    QByteArray bytes;
+    while (chunk.size() < kFastReplayChunkBytes) {
+        const quint64 nextTimeUSecs = _readNextMavlinkMessage(bytes);
+        (void) chunk.append(bytes);
+        messageCount++;
+
+        if (_logFile.atEnd()) {
+            atEnd = true;
+            break;
+        }
+
+        _logCurrentTimeUSecs = nextTimeUSecs;
+    }
+
+    _emitData(chunk);
+    _countMessages(messageCount);
+
+    if (atEnd || (_progressTimer.elapsed() >= kFastReplayProgressMSecs)) {
+        _signalPlayheadMoved();
+        (void) _progressTimer.restart();
+    }
+
+    if (atEnd) {
+        // Short logs can finish within a millisecond
+        const qint64 elapsedNSecs = _rateTimer.nsecsElapsed();
+        if ((_rateMessages > 0) && (elapsedNSecs > 0)) {
+            emit messagesPerSecondChanged((_rateMessages * 1e9) / elapsedNSecs);
+        }
+        pause();
+        emit playbackAtEnd();
+        return;
+    }
+
+    _readTickTimer->start(0);
+}
+
+void LogReplayWorker::_emitData(const QByteArray &bytes)
+{
+    (void) _chunksInFlight.fetch_add(1, std::memory_order_acq_rel);
+    emit dataReceived(bytes);
+}
+
+void LogReplayWorker::_countMessages(quint64 count)
+{
+    _rateMessages += count;
+
+    const qint64 elapsedMSecs = _rateTimer.elapsed();
+    if (elapsedMSecs >= kRateIntervalMSecs) {
+        emit messagesPerSecondChanged((_rateMessages * 1000.) / elapsedMSecs);
+        _rateMessages = 0;
+        (void) _rateTimer.restart();
+    }
+}
+
 void LogReplayWorker::_signalCurrentLogTimeSecs()
 {
     emit currentLogTimeSecs((_logCurrentTimeUSecs - _logStartTimeUSecs) / 1000000);
@@ -283,10 +562,14 @@ bool LogReplayWorker::_loadLogFile()
     logFileInfo.setFile(logFilename);
     _logFileSize = logFileInfo.size();
 
+    // A cached index saves scanning the whole log for its end time
+    _index = LogReplayIndex::load(logFilename);
+
     const quint64 startTimeUSecs = _parseTimestamp(_logFile.read(kTimestamp));
-    const quint64 endTimeUSecs = _findLastTimestamp();
+    const quint64 endTimeUSecs = _index.isValid() ? _index.endTimeUSecs() : _findLastTimestamp();
     if (endTimeUSecs <= startTimeUSecs) {
         _logFile.close();
+        _index = LogReplayIndex();
         emit errorOccurred(tr("The log file '%1' is corrupt or empty.").arg(logFilename));
         return false;
     }
@@ -303,25 +586,18 @@ bool LogReplayWorker::_loadLogFile()
     const quint64 logDurationSecondsTotal = _logDurationUSecs / 1000000;
     emit logFileStats(logDurationSecondsTotal);
 
+    if (_index.isValid()) {
+        emit indexReady();
+    } else {
+        _startIndexBuild();
+    }
+
     return true;
 }
 
 quint64 LogReplayWorker::_parseTimestamp(const QByteArray &bytes)
 {
-    // Truncated log files can produce a short read; never read past the buffer.
-    if (bytes.size() < static_cast<qsizetype>(sizeof(quint64))) {
-        return 0;
-    }
-
-    const quint64 currentTimestamp = static_cast<quint64>(QDateTime::currentMSecsSinceEpoch()) * 1000;
-    // qFromBigEndian(const void *src) handles unaligned reads; dereferencing a
-    // cast pointer here would be a misaligned load (UB).
-    quint64 timestamp = qFromBigEndian<quint64>(bytes.constData());
-    if (timestamp > currentTimestamp) {
-        timestamp = qbswap(timestamp);
-    }
-
-    return timestamp;
+    return LogReplayIndex::parseTimestamp(bytes);
 }
 
 quint64 LogReplayWorker::_readNextMavlinkMessage(QByteArray &bytes)
@@ -443,6 +719,7 @@ LogReplayLink::LogReplayLink(SharedLinkConfigurationPtr &config, QObject *parent
     (void) connect(_worker, &LogReplayWorker::playbackPaused, this, &LogReplayLink::playbackPaused, Qt::QueuedConnection);
     (void) connect(_worker, &LogReplayWorker::playbackPercentCompleteChanged, this, &LogReplayLink::playbackPercentCompleteChanged, Qt::QueuedConnection);
     (void) connect(_worker, &LogReplayWorker::currentLogTimeSecs, this, &LogReplayLink::currentLogTimeSecs, Qt::QueuedConnection);
+    (void) connect(_worker, &LogReplayWorker::messagesPerSecondChanged, this, &LogReplayLink::messagesPerSecondChanged, Qt::QueuedConnection);
     (void) connect(_worker, &LogReplayWorker::disconnected, this, &LogReplayLink::disconnected, Qt::QueuedConnection);
 
     _workerThread->start();
@@ -501,7 +778,9 @@ void LogReplayLink::_onErrorOccurred(const QString &errorString)
 
 void LogReplayLink::_onDataReceived(const QByteArray &data)
 {
+    // MAVLinkProtocol and the vehicles process the bytes synchronously on this thread
     emit bytesReceived(this, data);
+    _worker->chunkConsumed();
 }
 
 bool LogReplayLink::isPlaying() const
@@ -524,7 +803,22 @@ void LogReplayLink::setPlaybackSpeed(qreal playbackSpeed)
     (void) QMetaObject::invokeMethod(_worker, "setPlaybackSpeed", Qt::QueuedConnection, playbackSpeed);
 }
 
+void LogReplayLink::setAsFastAsPossible(bool asFastAsPossible)
+{
+    (void) QMetaObject::invokeMethod(_worker, "setAsFastAsPossible", Qt::QueuedConnection, asFastAsPossible);
+}
+
 void LogReplayLink::movePlayhead(qreal percentComplete)
 {
     (void) QMetaObject::invokeMethod(_worker, "movePlayhead", Qt::QueuedConnection, percentComplete);
 }
+
+void LogReplayLink::stepForward()
+{
+    (void) QMetaObject::invokeMethod(_worker, "stepForward", Qt::QueuedConnection);
+}
+
+void LogReplayLink::stepBackward()
+{
+    (void) QMetaObject::invokeMethod(_worker, "stepBackward", Qt::QueuedConnection);
+}
@@ -2,9 +2,12 @@
 
 #include "LinkConfiguration.h"
 #include "LinkInterface.h"
+#include "LogReplayIndex.h"
 #include "QGCMAVLinkTypes.h"
 
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QFile>
+#include <QtCore/QFutureWatcher>
 #include <QtQmlIntegration/QtQmlIntegration>
 
 #include <atomic>
@@ -55,6 +58,13 @@ class LogReplayWorker : public QObject
 
     bool isConnected() const { return _isConnected; }
     bool isPlaying() const;
+    /// true: seeks are exact and frames can be stepped backwards
+    bool hasIndex() const { return _index.isValid(); }
+    bool asFastAsPossible() const { return _asFastAsPossible; }
+
+    /// Called once a dataReceived chunk went through the protocol. Thread-safe.
+    /// Bounds how far as-fast-as-possible replay may run ahead of the receiving side.
+    void chunkConsumed();
 
 signals:
     void connected();
@@ -67,6 +77,8 @@ class LogReplayWorker : public QObject
     void playbackAtEnd();
     void playbackPercentCompleteChanged(qreal percentComplete);
     void currentLogTimeSecs(uint32_t secs);
+    void indexReady();
+    void messagesPerSecondChanged(qreal messagesPerSecond);
 
 public slots:
     void setup();
@@ -75,12 +87,30 @@ public slots:
     void play();
     void pause();
     void setPlaybackSpeed(qreal playbackSpeed);
+    /// true: ignore log timestamps and replay as fast as the receiving side consumes the messages
+    void setAsFastAsPossible(bool asFastAsPossible);
     void movePlayhead(qreal percentComplete);
+    /// Pauses and plays the next frame
+    void stepForward();
+    /// Pauses and plays the frame before the one played last. Requires the index.
+    void stepBackward();
 
 private slots:
     void _readNextLogEntry();
+    void _indexBuilt();
+    void _resumeAfterBackpressure();
 
 private:
+    void _readNextChunk();
+    void _emitData(const QByteArray &bytes);
+    void _countMessages(quint64 count);
+    void _startIndexBuild();
+    void _cancelIndexBuild();
+    bool _seekToRecord(qint64 recordOffset);
+    void _seekToLogTime(quint64 logTimeUSecs);
+    qint64 _currentRecordOffset() const;
+    qint64 _recordOffsetBefore(qint64 recordOffset, int count);
+    void _signalPlayheadMoved();
     quint64 _parseTimestamp(const QByteArray &bytes);
     quint64 _seekToNextMavlinkMessage(mavlink_message_t &nextMsg);
     quint64 _findLastTimestamp();
@@ -107,7 +137,21 @@ private slots:
     QFile _logFile;
     quint64 _logFileSize = 0;
 
+    LogReplayIndex _index;
+    QFutureWatcher<LogReplayIndex> *_indexWatcher = nullptr;
+
+    bool _asFastAsPossible = false;
+    std::atomic<int> _chunksInFlight{0};   ///< dataReceived emitted but not yet consumed
+    quint64 _rateMessages = 0;
+    QElapsedTimer _rateTimer;
+    QElapsedTimer _progressTimer;
+
     static constexpr size_t kTimestamp = sizeof(quint64);
+    static constexpr int kMaxChunksInFlight = 4;
+    static constexpr qsizetype kFastReplayChunkBytes = 64 * 1024;
+    static constexpr int kBackpressurePollMSecs = 5;        ///< Fallback in case a chunkConsumed wakeup is missed
+    static constexpr int kFastReplayProgressMSecs = 100;    ///< Progress signal rate limit while replaying as fast as possible
+    static constexpr int kRateIntervalMSecs = 1000;
 };
 
 /*===========================================================================*/
@@ -128,7 +172,10 @@ class LogReplayLink : public LinkInterface
     void play();
     void pause();
     void setPlaybackSpeed(qreal playbackSpeed);
+    void setAsFastAsPossible(bool asFastAsPossible);
     void movePlayhead(qreal percentComplete);
+    void stepForward();
+    void stepBackward();
 
 signals:
     void logFileStats(uint32_t logDurationSecs);
@@ -137,6 +184,7 @@ class LogReplayLink : public LinkInterface
     void playbackAtEnd();
     void playbackPercentCompleteChanged(qreal percentComplete);
     void currentLogTimeSecs(uint32_t secs);
+    void messagesPerSecondChanged(qreal messagesPerSecond);
 
 private slots:
     void _writeBytes(const QByteArray &bytes) override { Q_UNUSED(bytes); }
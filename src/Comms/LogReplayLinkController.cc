@@ -35,6 +35,9 @@ void LogReplayLinkController::setLink(LogReplayLink *link)
         _totalTime.clear();
         emit totalTimeChanged(_totalTime);
 
+        _messagesPerSecond = 0;
+        emit messagesPerSecondChanged(_messagesPerSecond);
+
         _link = nullptr;
         emit linkChanged(_link);
     }
@@ -47,9 +50,15 @@ void LogReplayLinkController::setLink(LogReplayLink *link)
         (void) connect(_link, &LogReplayLink::playbackPaused, this, &LogReplayLinkController::_playbackPaused);
         (void) connect(_link, &LogReplayLink::playbackPercentCompleteChanged, this, &LogReplayLinkController::_playbackPercentCompleteChanged);
         (void) connect(_link, &LogReplayLink::currentLogTimeSecs, this, &LogReplayLinkController::_currentLogTimeSecs);
+        (void) connect(_link, &LogReplayLink::messagesPerSecondChanged, this, &LogReplayLinkController::_messagesPerSecondChanged);
         (void) connect(_link, &LogReplayLink::disconnected, this, &LogReplayLinkController::_linkDisconnected);
 
         (void) connect(this, &LogReplayLinkController::playbackSpeedChanged, _link, &LogReplayLink::setPlaybackSpeed);
+        (void) connect(this, &LogReplayLinkController::asFastAsPossibleChanged, _link, &LogReplayLink::setAsFastAsPossible);
+
+        if (_asFastAsPossible) {
+            _link->setAsFastAsPossible(true);
+        }
 
         emit linkChanged(_link);
     }
@@ -77,6 +86,24 @@ void LogReplayLinkController::setPercentComplete(qreal percentComplete) const
     _link->movePlayhead(percentComplete);
 }
 
+void LogReplayLinkController::stepForward() const
+{
+    if (!_link) {
+        return;
+    }
+
+    _link->stepForward();
+}
+
+void LogReplayLinkController::stepBackward() const
+{
+    if (!_link) {
+        return;
+    }
+
+    _link->stepBackward();
+}
+
 void LogReplayLinkController::_logFileStats(uint32_t logDurationSecs)
 {
     const QString totalTime = _secondsToHMS(logDurationSecs);
@@ -86,6 +113,14 @@ void LogReplayLinkController::_logFileStats(uint32_t logDurationSecs)
     }
 }
 
+void LogReplayLinkController::_messagesPerSecondChanged(qreal messagesPerSecond)
+{
+    if (messagesPerSecond != _messagesPerSecond) {
+        _messagesPerSecond = messagesPerSecond;
+        emit messagesPerSecondChanged(_messagesPerSecond);
+    }
+}
+
 void LogReplayLinkController::_playbackStarted()
 {
     if (!_isPlaying) {
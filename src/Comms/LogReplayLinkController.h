@@ -17,6 +17,8 @@ class LogReplayLinkController : public QObject
     Q_PROPERTY(QString          totalTime       MEMBER  _totalTime                                  NOTIFY totalTimeChanged)
     Q_PROPERTY(QString          playheadTime    MEMBER  _playheadTime                               NOTIFY playheadTimeChanged)
     Q_PROPERTY(qreal            playbackSpeed   MEMBER  _playbackSpeed                              NOTIFY playbackSpeedChanged)
+    Q_PROPERTY(bool             asFastAsPossible MEMBER _asFastAsPossible                           NOTIFY asFastAsPossibleChanged)
+    Q_PROPERTY(qreal            messagesPerSecond READ  messagesPerSecond                           NOTIFY messagesPerSecondChanged)
 
 public:
     explicit LogReplayLinkController(QObject *parent = nullptr);
@@ -31,9 +33,17 @@ class LogReplayLinkController : public QObject
     qreal percentComplete() const { return _percentComplete; }
     void setPercentComplete(qreal percentComplete) const;
 
+    /// Achieved replay rate, most useful with asFastAsPossible
+    qreal messagesPerSecond() const { return _messagesPerSecond; }
+
+    Q_INVOKABLE void stepForward() const;
+    Q_INVOKABLE void stepBackward() const;
+
 signals:
+    void asFastAsPossibleChanged(bool asFastAsPossible);
     void isPlayingChanged(bool isPlaying);
     void linkChanged(LogReplayLink *link);
+    void messagesPerSecondChanged(qreal messagesPerSecond);
     void percentCompleteChanged(qreal percentComplete);
     void playbackSpeedChanged(qreal playbackSpeed);
     void playheadTimeChanged(const QString &playheadTime);
@@ -43,6 +53,7 @@ private slots:
     void _currentLogTimeSecs(uint32_t secs);
     void _linkDisconnected() { setLink(nullptr); }
     void _logFileStats(uint32_t logDurationSecs);
+    void _messagesPerSecondChanged(qreal messagesPerSecond);
     void _playbackAtEnd();
     void _playbackPaused();
     void _playbackPercentCompleteChanged(qreal percentComplete);
@@ -58,6 +69,8 @@ private slots:
     qreal _percentComplete = 0;
     int64_t _playheadSecs = kNoPlayhead;
     qreal _playbackSpeed = 1;
+    bool _asFastAsPossible = false;
+    qreal _messagesPerSecond = 0;
     QString _playheadTime;
     QString _totalTime;
     QPointer<LogReplayLink> _link;
@@ -0,0 +1,115 @@
+#include "MAVLinkFrameParser.h"
+
+#include <QtCore/QMutexLocker>
+#include <cstring>
+
+#include "MAVLinkLib.h"
+#include "SigningController.h"
+
+MAVLinkFrameParser::MAVLinkFrameParser(uint8_t mavlinkChannel, SigningController* signing)
+    : _mavlinkChannel(mavlinkChannel), _signing(signing)
+{
+}
+
+void MAVLinkFrameParser::parse(const QByteArray& data, MAVLinkFrameBatch& batch)
+{
+    QMutexLocker locker(&_mutex);
+
+    if (_detached) {
+        return;
+    }
+
+    for (uint8_t byte : data) {
+        mavlink_message_t message{};
+        mavlink_status_t status{};
+
+        const uint8_t framing = mavlink_parse_char(_mavlinkChannel, byte, &message, &status);
+        if (framing == MAVLINK_FRAMING_OK || framing == MAVLINK_FRAMING_BAD_SIGNATURE) {
+            // Auto-detected key: reset sequence tracking so the key-install gap isn't counted as loss.
+            if (_signing && _signing->processFrame(framing == MAVLINK_FRAMING_OK, message)) {
+                _resetSequenceTrackingLocked();
+            }
+        }
+        if (framing != MAVLINK_FRAMING_OK) {
+            continue;
+        }
+
+        // v1/v2 share per-(sysid,compid) sequence counters; counting v1 makes every v2 appear lost. Skip v1 non-heartbeats.
+        // RADIO_STATUS is exempt: SiK radios always frame it as v1, so it is processed and never triggers the v1 warning.
+        const bool isV1 = (status.flags & MAVLINK_STATUS_FLAG_IN_MAVLINK1);
+        if (isV1 && (message.msgid != MAVLINK_MSG_ID_HEARTBEAT) && (message.msgid != MAVLINK_MSG_ID_RADIO_STATUS)) {
+            batch.v1TrafficDropped = true;
+            continue;
+        }
+
+        if (!isV1) {
+            batch.v2TrafficSeen = true;
+            _updateCounters(message, batch);
+        }
+
+        batch.messages.append(message);
+    }
+
+    batch.stats = _stats;
+}
+
+void MAVLinkFrameParser::_updateCounters(const mavlink_message_t& message, MAVLinkFrameBatch& batch)
+{
+    _stats.totalReceived++;
+    if ((_stats.totalReceived % kStatusInterval) == 0) {
+        batch.statusSysId = message.sysid;
+    }
+
+    uint8_t& lastSeq = _lastIndex[message.sysid][message.compid];
+
+    const QPair<uint8_t, uint8_t> key(message.sysid, message.compid);
+    uint8_t expectedSeq;
+    if (!_firstMessageSeen.contains(key)) {
+        _firstMessageSeen.insert(key);
+        expectedSeq = message.seq;
+    } else if (message.seq == lastSeq) {
+        // v1/v2 of the same message share sequence numbers — duplicate seq isn't loss.
+        return;
+    } else {
+        expectedSeq = lastSeq + 1;
+    }
+
+    uint64_t lostMessages;
+    if (message.seq >= expectedSeq) {
+        lostMessages = message.seq - expectedSeq;
+    } else {
+        lostMessages = static_cast<uint64_t>(message.seq) + 256ULL - expectedSeq;
+    }
+    _stats.totalLoss += lostMessages;
+
+    lastSeq = message.seq;
+
+    const uint64_t totalSent = _stats.totalReceived + _stats.totalLoss;
+    const float currentLossPercent = (static_cast<double>(_stats.totalLoss) / totalSent) * 100.0f;
+    _stats.runningLossPercent = (currentLossPercent + _stats.runningLossPercent) * 0.5f;
+}
+
+void MAVLinkFrameParser::resetStats()
+{
+    QMutexLocker locker(&_mutex);
+    _stats = MAVLinkChannelStats();
+}
+
+void MAVLinkFrameParser::resetSequenceTracking()
+{
+    QMutexLocker locker(&_mutex);
+    _resetSequenceTrackingLocked();
+}
+
+void MAVLinkFrameParser::_resetSequenceTrackingLocked()
+{
+    _firstMessageSeen.clear();
+    std::memset(_lastIndex, 0, sizeof(_lastIndex));
+}
+
+void MAVLinkFrameParser::detach()
+{
+    QMutexLocker locker(&_mutex);
+    _detached = true;
+    _signing = nullptr;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
+#include <QtCore/QMetaType>
+#include <QtCore/QMutex>
+#include <QtCore/QPair>
+#include <QtCore/QSet>
+
+#include "MAVLinkMessageType.h"
+
+class SigningController;
+
+/// Receive counters for one MAVLink channel.
+struct MAVLinkChannelStats
+{
+    uint64_t totalReceived = 0;
+    uint64_t totalLoss = 0;
+    float runningLossPercent = 0.f;
+};
+
+/// Whole frames parsed out of one chunk of link bytes, handed to MAVLinkProtocol in a single call.
+struct MAVLinkFrameBatch
+{
+    bool isEmpty() const { return messages.isEmpty() && !v1TrafficDropped; }
+
+    QList<mavlink_message_t> messages;
+    MAVLinkChannelStats stats;          ///< Channel counters after the last message of the batch
+    int statusSysId = -1;               ///< >= 0: link status is due, reported for this sysid
+    bool v1TrafficDropped = false;      ///< Non-exempt MAVLink v1 frames were dropped
+    bool v2TrafficSeen = false;
+};
+Q_DECLARE_METATYPE(MAVLinkFrameBatch)
+
+/// \brief Turns raw link bytes into whole MAVLink frames for a single channel.
+///
+/// Owns the channel's sequence and loss tracking. Thread-safe: a link worker thread may parse while the
+/// main thread resets tracking.
+class MAVLinkFrameParser
+{
+public:
+    MAVLinkFrameParser(uint8_t mavlinkChannel, SigningController* signing);
+
+    /// Appends the frames completed by @a data to @a batch.
+    void parse(const QByteArray& data, MAVLinkFrameBatch& batch);
+
+    void resetStats();
+
+    /// Reset sequence tracking so signing transitions don't inflate loss counters.
+    void resetSequenceTracking();
+
+    /// Stop parsing. Must be called before the channel and signing controller are released, since worker
+    /// threads may still hold a reference to the parser.
+    void detach();
+
+private:
+    void _updateCounters(const mavlink_message_t& message, MAVLinkFrameBatch& batch);
+    void _resetSequenceTrackingLocked();
+
+    QMutex _mutex;
+    const uint8_t _mavlinkChannel;
+    SigningController* _signing = nullptr;
+    bool _detached = false;
+
+    /// Per-(sysid, compid) last sequence ID
+    uint8_t _lastIndex[256][256]{};
+    QSet<QPair<uint8_t, uint8_t>> _firstMessageSeen;
+    MAVLinkChannelStats _stats;
+
+    static constexpr uint64_t kStatusInterval = 31;
+};
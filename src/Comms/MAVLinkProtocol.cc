@@ -8,7 +8,6 @@
 #include <QtCore/QSettings>
 #include <QtCore/QStandardPaths>
 #include <QtCore/QTimer>
-#include <cstring>
 
 #include "AppMessages.h"
 #include "AppSettings.h"
@@ -16,20 +15,24 @@
 #include "MAVLinkLib.h"
 #include "LinkInterface.h"
 #include "MAVLinkSigning.h"
-#include "SigningController.h"
 #include "MavlinkSettings.h"
 #include "MultiVehicleManager.h"
 #include "QGCFileHelper.h"
 #include "QGCLoggingCategory.h"
 #include "QmlObjectListModel.h"
 #include "SettingsManager.h"
+#include "TelemetryLogWriter.h"
 
 QGC_LOGGING_CATEGORY(MAVLinkProtocolLog, "Comms.MAVLinkProtocol")
 
 Q_APPLICATION_STATIC(MAVLinkProtocol, _mavlinkProtocolInstance);
 
-MAVLinkProtocol::MAVLinkProtocol(QObject* parent) : QObject(parent), _tempLogFile(new QFile(this))
+MAVLinkProtocol::MAVLinkProtocol(QObject* parent) : QObject(parent), _tempLogWriter(new TelemetryLogWriter(this))
 {
+    (void)connect(_tempLogWriter, &TelemetryLogWriter::errorOccurred, this, &MAVLinkProtocol::_logWriteError);
+    (void)connect(_tempLogWriter, &TelemetryLogWriter::backpressureChanged, this,
+                  &MAVLinkProtocol::_logWriterBackpressureChanged);
+
     qCDebug(MAVLinkProtocolLog) << this;
 }
 
@@ -54,15 +57,21 @@ void MAVLinkProtocol::init()
     (void)connect(MultiVehicleManager::instance(), &MultiVehicleManager::vehicleRemoved, this,
                   &MAVLinkProtocol::_vehicleCountChanged);
 
+    (void)connect(SettingsManager::instance()->mavlinkSettings()->forwardMavlink(), &Fact::rawValueChanged, this,
+                  &MAVLinkProtocol::_invalidateForwardingTargets);
+    (void)connect(LinkManager::instance(), &LinkManager::mavlinkSupportForwardingEnabledChanged, this,
+                  &MAVLinkProtocol::_invalidateForwardingTargets);
+    (void)connect(LinkManager::instance(), &LinkManager::mavlinkForwardingLinksChanged, this,
+                  &MAVLinkProtocol::_invalidateForwardingTargets);
+
     _initialized = true;
 }
 
 void MAVLinkProtocol::resetMetadataForLink(LinkInterface* link)
 {
-    const uint8_t channel = link->mavlinkChannel();
-    _totalReceiveCounter[channel] = 0;
-    _totalLossCounter[channel] = 0;
-    _runningLossPercent[channel] = 0.f;
+    if (const std::shared_ptr<MAVLinkFrameParser> parser = link->frameParser()) {
+        parser->resetStats();
+    }
 
     link->setDecodedFirstMavlinkPacket(false);
 }
@@ -70,116 +79,103 @@ void MAVLinkProtocol::resetMetadataForLink(LinkInterface* link)
 void MAVLinkProtocol::resetSequenceTracking(LinkInterface* link)
 {
     // Clear per-(sysid,compid) sequence state so next packet isn't counted as a gap.
-    const uint8_t channel = link->mavlinkChannel();
-    _firstMessageSeen[channel].clear();
-    std::memset(_lastIndex[channel], 0, sizeof(_lastIndex[channel]));
+    if (const std::shared_ptr<MAVLinkFrameParser> parser = link->frameParser()) {
+        parser->resetSequenceTracking();
+    }
 }
 
 void MAVLinkProtocol::logSentBytes(const LinkInterface* link, const QByteArray& data)
 {
     Q_UNUSED(link);
 
-    if (_logSuspendError || _logSuspendReplay || !_tempLogFile->isOpen()) {
+    if (_logSuspendError || _logSuspendReplay || !_tempLogWriter->isOpen()) {
         return;
     }
 
-    const quint64 time = static_cast<quint64>(QDateTime::currentMSecsSinceEpoch() * 1000);
-    uint8_t bytes_time[sizeof(quint64)]{};
-    qToBigEndian(time, bytes_time);
+    const quint64 timestamp = static_cast<quint64>(QDateTime::currentMSecsSinceEpoch() * 1000);
+    (void)_tempLogWriter->append(timestamp, data);
+}
 
-    QByteArray logData = data;
-    QByteArray timeData = QByteArray::fromRawData(reinterpret_cast<const char*>(bytes_time), sizeof(bytes_time));
-    (void)logData.prepend(timeData);
-    if (_tempLogFile->write(logData) != logData.length()) {
-        const QString message = QStringLiteral("MAVLink Logging failed. Could not write to file %1, logging disabled.")
-                                    .arg(_tempLogFile->fileName());
-        QGC::showAppMessage(message, getName());
-        _stopLogging();
-        _logSuspendError = true;
+void MAVLinkProtocol::registerLink(const SharedLinkInterfacePtr& link)
+{
+    _activeLinks.insert(link.get(), link);
+}
+
+void MAVLinkProtocol::unregisterLink(const LinkInterface* link)
+{
+    (void)_activeLinks.remove(link);
+}
+
+SharedLinkInterfacePtr MAVLinkProtocol::_activeLink(const LinkInterface* link) const
+{
+    // Never dereference link here: queued signals can still arrive after it was destroyed
+    const auto it = _activeLinks.constFind(link);
+    if (it == _activeLinks.constEnd()) {
+        return nullptr;
     }
+
+    return it->lock();
 }
 
 void MAVLinkProtocol::receiveBytes(LinkInterface* link, const QByteArray& data)
 {
-    const SharedLinkInterfacePtr linkPtr = LinkManager::instance()->sharedLinkInterfacePointerForLink(link);
+    const SharedLinkInterfacePtr linkPtr = _activeLink(link);
     if (!linkPtr) {
         qCDebug(MAVLinkProtocolLog) << "receiveBytes: link gone!" << data.size() << "bytes arrived too late";
         return;
     }
 
-    for (uint8_t byte : data) {
-        const uint8_t mavlinkChannel = link->mavlinkChannel();
-        mavlink_message_t message{};
-        mavlink_status_t status{};
-
-        const uint8_t framing = mavlink_parse_char(mavlinkChannel, byte, &message, &status);
-        if (framing == MAVLINK_FRAMING_OK || framing == MAVLINK_FRAMING_BAD_SIGNATURE) {
-            if (SigningController* const sigCtrl = link->signing()) {
-                // Auto-detected key: reset sequence tracking so the key-install gap isn't counted as loss.
-                if (sigCtrl->processFrame(framing == MAVLINK_FRAMING_OK, message)) {
-                    resetSequenceTracking(link);
-                }
-            }
-        }
-        if (framing != MAVLINK_FRAMING_OK) {
-            continue;
-        }
-
-        // v1/v2 share per-(sysid,compid) sequence counters; counting v1 makes every v2 appear lost. Skip v1 non-heartbeats.
-        // RADIO_STATUS is exempt: SiK radios always frame it as v1, so it is processed and never triggers the v1 warning.
-        const bool isV1 = (status.flags & MAVLINK_STATUS_FLAG_IN_MAVLINK1);
-        if (isV1 && (message.msgid != MAVLINK_MSG_ID_HEARTBEAT) && (message.msgid != MAVLINK_MSG_ID_RADIO_STATUS)) {
-            link->reportMavlinkV1Traffic();
-            continue;
-        }
-
-        if (!isV1) {
-            link->reportMavlinkV2Traffic();
-            _updateCounters(mavlinkChannel, message);
-        }
-        if (!linkPtr->linkConfiguration()->isForwarding()) {
-            _forward(message);
-            _forwardSupport(message);
-        }
-        _logData(link, message);
-
-        if (!_updateStatus(link, linkPtr, mavlinkChannel, message)) {
-            break;
-        }
+    const std::shared_ptr<MAVLinkFrameParser> parser = link->frameParser();
+    if (!parser) {
+        return;
     }
+
+    MAVLinkFrameBatch batch;
+    parser->parse(data, batch);
+    _processBatch(link, linkPtr, batch);
 }
 
-void MAVLinkProtocol::_updateCounters(uint8_t mavlinkChannel, const mavlink_message_t& message)
+void MAVLinkProtocol::receiveMessages(LinkInterface* link, const MAVLinkFrameBatch& batch)
 {
-    _totalReceiveCounter[mavlinkChannel]++;
+    const SharedLinkInterfacePtr linkPtr = _activeLink(link);
+    if (!linkPtr) {
+        qCDebug(MAVLinkProtocolLog) << "receiveMessages: link gone!" << batch.messages.size() << "messages arrived too late";
+        return;
+    }
 
-    uint8_t& lastSeq = _lastIndex[mavlinkChannel][message.sysid][message.compid];
+    _processBatch(link, linkPtr, batch);
+}
 
-    const QPair<uint8_t, uint8_t> key(message.sysid, message.compid);
-    uint8_t expectedSeq;
-    if (!_firstMessageSeen[mavlinkChannel].contains(key)) {
-        _firstMessageSeen[mavlinkChannel].insert(key);
-        expectedSeq = message.seq;
-    } else if (message.seq == lastSeq) {
-        // v1/v2 of the same message share sequence numbers — duplicate seq isn't loss.
-        return;
-    } else {
-        expectedSeq = lastSeq + 1;
+void MAVLinkProtocol::_processBatch(LinkInterface* link, const SharedLinkInterfacePtr& linkPtr,
+                                    const MAVLinkFrameBatch& batch)
+{
+    if (batch.v1TrafficDropped) {
+        link->reportMavlinkV1Traffic();
+    }
+    if (batch.v2TrafficSeen) {
+        link->reportMavlinkV2Traffic();
     }
 
-    uint64_t lostMessages;
-    if (message.seq >= expectedSeq) {
-        lostMessages = message.seq - expectedSeq;
-    } else {
-        lostMessages = static_cast<uint64_t>(message.seq) + 256ULL - expectedSeq;
+    if (batch.statusSysId >= 0) {
+        const MAVLinkChannelStats& stats = batch.stats;
+        emit mavlinkMessageStatus(batch.statusSysId, stats.totalReceived + stats.totalLoss, stats.totalReceived,
+                                  stats.totalLoss, stats.runningLossPercent);
     }
-    _totalLossCounter[mavlinkChannel] += lostMessages;
 
-    lastSeq = message.seq;
+    const bool forward = !linkPtr->linkConfiguration()->isForwarding();
+    for (const mavlink_message_t& message : batch.messages) {
+        if (forward) {
+            _forward(message);
+        }
+        _logData(link, message);
+
+        emit messageReceived(link, message);
 
-    const uint64_t totalSent = _totalReceiveCounter[mavlinkChannel] + _totalLossCounter[mavlinkChannel];
-    const float currentLossPercent = (static_cast<double>(_totalLossCounter[mavlinkChannel]) / totalSent) * 100.0f;
-    _runningLossPercent[mavlinkChannel] = (currentLossPercent + _runningLossPercent[mavlinkChannel]) * 0.5f;
+        // A receiver disconnected the link; we hold the last reference.
+        if (linkPtr.use_count() == 1) {
+            break;
+        }
+    }
 }
 
 void MAVLinkProtocol::_forward(const mavlink_message_t& message)
@@ -188,59 +184,56 @@ void MAVLinkProtocol::_forward(const mavlink_message_t& message)
         return;
     }
 
-    if (!SettingsManager::instance()->mavlinkSettings()->forwardMavlink()->rawValue().toBool()) {
-        return;
+    if (!_forwardingTargetsValid) {
+        _updateForwardingTargets();
     }
-
-    SharedLinkInterfacePtr forwardingLink = LinkManager::instance()->mavlinkForwardingLink();
-    if (!forwardingLink) {
+    if (_forwardingTargets.isEmpty()) {
         return;
     }
 
     // Strip signature on forward: foreign key would BAD_SIGNATURE on downstream signing-aware parsers.
+    // Serialized once, every target shares the same buffer.
     const QByteArray bytes = MAVLinkSigning::serializeUnsignedCopy(message);
-    (void)forwardingLink->writeBytesThreadSafe(bytes.constData(), bytes.size());
+    for (const std::weak_ptr<LinkInterface>& target : std::as_const(_forwardingTargets)) {
+        if (const SharedLinkInterfacePtr link = target.lock()) {
+            link->writeBytesThreadSafe(bytes);
+        } else {
+            _forwardingTargetsValid = false;
+        }
+    }
 }
 
-void MAVLinkProtocol::_forwardSupport(const mavlink_message_t& message)
+void MAVLinkProtocol::_updateForwardingTargets()
 {
-    if (message.msgid == MAVLINK_MSG_ID_SETUP_SIGNING) {
-        return;
-    }
+    _forwardingTargets.clear();
 
-    if (!LinkManager::instance()->mavlinkSupportForwardingEnabled()) {
-        return;
+    if (SettingsManager::instance()->mavlinkSettings()->forwardMavlink()->rawValue().toBool()) {
+        if (const SharedLinkInterfacePtr forwardingLink = LinkManager::instance()->mavlinkForwardingLink()) {
+            _forwardingTargets.append(forwardingLink);
+        }
     }
 
-    SharedLinkInterfacePtr forwardingSupportLink = LinkManager::instance()->mavlinkForwardingSupportLink();
-    if (!forwardingSupportLink) {
-        return;
+    if (LinkManager::instance()->mavlinkSupportForwardingEnabled()) {
+        if (const SharedLinkInterfacePtr forwardingSupportLink = LinkManager::instance()->mavlinkForwardingSupportLink()) {
+            _forwardingTargets.append(forwardingSupportLink);
+        }
     }
 
-    const QByteArray bytes = MAVLinkSigning::serializeUnsignedCopy(message);
-    (void)forwardingSupportLink->writeBytesThreadSafe(bytes.constData(), bytes.size());
+    _forwardingTargetsValid = true;
+    qCDebug(MAVLinkProtocolLog) << "Forwarding targets:" << _forwardingTargets.count();
 }
 
 void MAVLinkProtocol::_logData(LinkInterface* link, const mavlink_message_t& message)
 {
-    if (!_logSuspendError && !_logSuspendReplay && _tempLogFile->isOpen()) {
+    if (!_logSuspendError && !_logSuspendReplay && _tempLogWriter->isOpen()) {
         // MAVLink spec §Logging: omit SETUP_SIGNING (contains secret key)
         if (message.msgid != MAVLINK_MSG_ID_SETUP_SIGNING) {
             // MAVLink spec §Logging: strip signature block from logged packets.
-            const QByteArray msgBytes = MAVLinkSigning::serializeUnsignedCopy(message);
+            uint8_t frame[MAVLINK_MAX_PACKET_LEN];
+            const uint16_t frameLength = MAVLinkSigning::serializeUnsignedCopy(message, frame);
             const quint64 timestamp = static_cast<quint64>(QDateTime::currentMSecsSinceEpoch() * 1000);
-            QByteArray log_data;
-            log_data.resize(static_cast<qsizetype>(sizeof(timestamp)) + msgBytes.size());
-            qToBigEndian(timestamp, reinterpret_cast<uint8_t*>(log_data.data()));
-            std::memcpy(log_data.data() + sizeof(timestamp), msgBytes.constData(), msgBytes.size());
-            if (_tempLogFile->write(log_data) != log_data.size()) {
-                const QString logErrorMessage =
-                    QStringLiteral("MAVLink Logging failed. Could not write to file %1, logging disabled.")
-                        .arg(_tempLogFile->fileName());
-                QGC::showAppMessage(logErrorMessage, getName());
-                _stopLogging();
-                _logSuspendError = true;
-            }
+            // A full buffer drops the frame; the writer reports backpressure and drop counts itself
+            (void)_tempLogWriter->append(timestamp, QByteArrayView(frame, frameLength));
         }
 
         if ((message.msgid == MAVLINK_MSG_ID_HEARTBEAT) && !_vehicleWasArmed) {
@@ -278,37 +271,20 @@ void MAVLinkProtocol::_logData(LinkInterface* link, const mavlink_message_t& mes
     }
 }
 
-bool MAVLinkProtocol::_updateStatus(LinkInterface* link, const SharedLinkInterfacePtr linkPtr, uint8_t mavlinkChannel,
-                                    const mavlink_message_t& message)
-{
-    if ((_totalReceiveCounter[mavlinkChannel] % 31) == 0) {
-        const uint64_t totalSent = _totalReceiveCounter[mavlinkChannel] + _totalLossCounter[mavlinkChannel];
-        emit mavlinkMessageStatus(message.sysid, totalSent, _totalReceiveCounter[mavlinkChannel],
-                                  _totalLossCounter[mavlinkChannel], _runningLossPercent[mavlinkChannel]);
-    }
-
-    emit messageReceived(link, message);
-
-    if (linkPtr.use_count() == 1) {
-        return false;
-    }
-
-    return true;
-}
-
 bool MAVLinkProtocol::_closeLogFile()
 {
-    if (!_tempLogFile->isOpen()) {
+    if (!_tempLogWriter->isOpen()) {
         return false;
     }
 
-    if (_tempLogFile->size() == 0) {
-        (void)_tempLogFile->remove();
+    // Flushes everything still buffered before returning
+    _tempLogWriter->close();
+
+    if (_tempLogWriter->stats().bytesWritten == 0) {
+        (void)QFile::remove(_tempLogWriter->fileName());
         return false;
     }
 
-    (void)_tempLogFile->flush();
-    _tempLogFile->close();
     return true;
 }
 
@@ -329,7 +305,7 @@ void MAVLinkProtocol::_startLogging()
     }
 #endif
 
-    if (_tempLogFile->isOpen()) {
+    if (_tempLogWriter->isOpen()) {
         return;
     }
 
@@ -346,35 +322,34 @@ void MAVLinkProtocol::_startLogging()
         return;
     }
 
-    _tempLogFile->setFileName(logPath);
-    if (!_tempLogFile->open(QIODevice::WriteOnly)) {
+    if (!_tempLogWriter->open(logPath)) {
         const QString message = QStringLiteral(
                                     "Opening Flight Data file for writing failed. "
                                     "Unable to write to %1. Please choose a different file location.")
-                                    .arg(_tempLogFile->fileName());
+                                    .arg(logPath);
         QGC::showAppMessage(message, getName());
-        _closeLogFile();
         _logSuspendError = true;
         return;
     }
 
-    qCDebug(MAVLinkProtocolLog) << "Temp log" << _tempLogFile->fileName();
+    qCDebug(MAVLinkProtocolLog) << "Temp log" << _tempLogWriter->fileName();
     (void)_checkTelemetrySavePath();
 
     _logSuspendError = false;
+    _logBackpressureReported = false;
 }
 
 void MAVLinkProtocol::_stopLogging()
 {
-    if (_tempLogFile->isOpen() && _closeLogFile()) {
+    if (_tempLogWriter->isOpen() && _closeLogFile()) {
         auto appSettings = SettingsManager::instance()->appSettings();
         auto mavlinkSettings = SettingsManager::instance()->mavlinkSettings();
         if ((_vehicleWasArmed || mavlinkSettings->telemetrySaveNotArmed()->rawValue().toBool()) &&
             mavlinkSettings->telemetrySave()->rawValue().toBool() &&
             !appSettings->disableAllPersistence()->rawValue().toBool()) {
-            _saveTelemetryLog(_tempLogFile->fileName());
+            _saveTelemetryLog(_tempLogWriter->fileName());
         } else {
-            (void)QFile::remove(_tempLogFile->fileName());
+            (void)QFile::remove(_tempLogWriter->fileName());
         }
     }
 
@@ -523,6 +498,34 @@ void MAVLinkProtocol::_vehicleCountChanged()
     }
 }
 
+void MAVLinkProtocol::_logWriteError(const QString& errorString)
+{
+    const QString message = QStringLiteral("MAVLink Logging failed. Could not write to file %1 (%2), logging disabled.")
+                                .arg(_tempLogWriter->fileName(), errorString);
+    QGC::showAppMessage(message, getName());
+    _stopLogging();
+    _logSuspendError = true;
+}
+
+void MAVLinkProtocol::_logWriterBackpressureChanged(bool backpressured)
+{
+    if (!backpressured) {
+        qCDebug(MAVLinkProtocolLog) << "Telemetry log writer caught up";
+        return;
+    }
+
+    // Frames are dropped rather than stalling the links, tell the user once per log
+    if (_logBackpressureReported) {
+        return;
+    }
+    _logBackpressureReported = true;
+
+    const QString message = QStringLiteral("Storage is not keeping up with MAVLink Logging. "
+                                           "Flight Data file %1 may be missing messages.")
+                                .arg(_tempLogWriter->fileName());
+    QGC::showAppMessage(message, getName());
+}
+
 int MAVLinkProtocol::getSystemId() const
 {
     return SettingsManager::instance()->mavlinkSettings()->gcsMavlinkSystemID()->rawValue().toInt();
@@ -1,16 +1,16 @@
 #pragma once
 
 #include <QtCore/QByteArray>
+#include <QtCore/QHash>
 #include <QtCore/QObject>
-#include <QtCore/QPair>
-#include <QtCore/QSet>
 #include <QtCore/QString>
 
 #include "LinkInterface.h"
 #include "MAVLinkEnums.h"
+#include "MAVLinkFrameParser.h"
 #include "MAVLinkMessageType.h"
 
-class QFile;
+class TelemetryLogWriter;
 
 /// \brief MAVLink micro air vehicle protocol reference implementation.
 ///
@@ -40,6 +40,10 @@ class MAVLinkProtocol : public QObject
 
     void suspendLogForReplay(bool suspend) { _logSuspendReplay = suspend; }
 
+    /// LinkManager registers each active link so the receive path can resolve it without locking LinkManager.
+    void registerLink(const SharedLinkInterfacePtr& link);
+    void unregisterLink(const LinkInterface* link);
+
     void checkForLostLogFiles();
 
 signals:
@@ -54,12 +58,17 @@ class MAVLinkProtocol : public QObject
 public slots:
     void receiveBytes(LinkInterface* link, const QByteArray& data);
 
+    /// Receives frames which were already parsed on the link's worker thread.
+    void receiveMessages(LinkInterface* link, const MAVLinkFrameBatch& batch);
+
     void logSentBytes(const LinkInterface* link, const QByteArray& data);
 
     static void deleteTempLogFiles();
 
 private slots:
     void _vehicleCountChanged();
+    void _logWriteError(const QString& errorString);
+    void _logWriterBackpressureChanged(bool backpressured);
 
 private:
     void _logData(LinkInterface* link, const mavlink_message_t& message);
@@ -68,30 +77,32 @@ private slots:
     void _stopLogging();
 
     void _forward(const mavlink_message_t& message);
-    void _forwardSupport(const mavlink_message_t& message);
+    void _updateForwardingTargets();
+    void _invalidateForwardingTargets() { _forwardingTargetsValid = false; }
 
-    void _updateCounters(uint8_t mavlinkChannel, const mavlink_message_t& message);
-    bool _updateStatus(LinkInterface* link, const SharedLinkInterfacePtr linkPtr, uint8_t mavlinkChannel,
-                       const mavlink_message_t& message);
+    void _processBatch(LinkInterface* link, const SharedLinkInterfacePtr& linkPtr, const MAVLinkFrameBatch& batch);
+
+    /// @return Owning pointer for an active link, nullptr if it has been removed
+    SharedLinkInterfacePtr _activeLink(const LinkInterface* link) const;
 
     void _saveTelemetryLog(const QString& tempLogfile);
     bool _checkTelemetrySavePath();
 
-    QFile* _tempLogFile = nullptr;
+    TelemetryLogWriter* _tempLogWriter = nullptr;
+
+    /// Weak handles to active links, keyed by raw pointer. Main thread only.
+    QHash<const LinkInterface*, std::weak_ptr<LinkInterface>> _activeLinks;
+
+    /// Forwarding and support-forwarding links, resolved lazily and invalidated when settings or links change
+    QList<std::weak_ptr<LinkInterface>> _forwardingTargets;
+    bool _forwardingTargetsValid = false;
 
     bool _logSuspendError = false;
+    /// Storage backpressure was already reported for the current log
+    bool _logBackpressureReported = false;
     bool _logSuspendReplay = false;
     bool _vehicleWasArmed = false;
 
-    /// Per-(channel, sysid, compid) last sequence ID. Channel-scoped so traffic on link A doesn't perturb expected
-    /// sequence on link B (which has independent sequence histories from the same vehicle).
-    uint8_t _lastIndex[MAVLINK_COMM_NUM_BUFFERS][256][256]{};
-
-    QSet<QPair<uint8_t, uint8_t>> _firstMessageSeen[MAVLINK_COMM_NUM_BUFFERS];
-    uint64_t _totalReceiveCounter[MAVLINK_COMM_NUM_BUFFERS]{};
-    uint64_t _totalLossCounter[MAVLINK_COMM_NUM_BUFFERS]{};
-    float _runningLossPercent[MAVLINK_COMM_NUM_BUFFERS]{};
-
     bool _initialized = false;
 
     static constexpr const char* _tempLogFileTemplate = "FlightDataXXXXXX";
@@ -49,6 +49,7 @@ class MockConfiguration : public LinkConfiguration
         OptionStayMavlinkV1       = 1 << 5,
         OptionAPMStartFreshParams = 1 << 6,
         OptionFtpCapability       = 1 << 7,
+        OptionNoFtpCapability     = 1 << 8,   ///< ArduPilot advertises MAVLink FTP unless this is set
     };
     Q_DECLARE_FLAGS(Options, Option)
     Q_FLAG(Options)
@@ -1598,6 +1598,8 @@ void MockLink::_paramRequestListWorker()
 
     if (((_failureMode == MockConfiguration::FailMissingParamOnInitialRequest) || (_failureMode == MockConfiguration::FailMissingParamOnAllRequests)) && (paramName == _failParam)) {
         qCDebug(MockLinkLog) << "Skipping param send:" << paramName;
+    } else if (_dropParamValue()) {
+        qCDebug(MockLinkLog) << "Dropping param send:" << paramName;
     } else {
         char paramId[MAVLINK_MSG_ID_PARAM_VALUE_LEN]{};
         mavlink_message_t responseMsg{};
@@ -1808,6 +1810,11 @@ void MockLink::_handleParamRequestRead(const mavlink_message_t &msg)
         return;
     }
 
+    if (_dropParamValue()) {
+        qCDebug(MockLinkLog) << "Dropping request read response" << paramId;
+        return;
+    }
+
     (void) mavlink_msg_param_value_pack_chan(
         _vehicleSystemId,
         componentId,                                               // component id
@@ -1822,6 +1829,37 @@ void MockLink::_handleParamRequestRead(const mavlink_message_t &msg)
     respondWithMavlinkMessage(responseMsg);
 }
 
+void MockLink::setParamValueLossPercent(int percent)
+{
+    QMutexLocker locker(&_paramValueLossMutex);
+    _paramValueLossPercent = qBound(0, percent, 100);
+    _paramValueLossSeed = 1;
+    _paramValueLossCount = 0;
+}
+
+int MockLink::paramValueLossCount() const
+{
+    QMutexLocker locker(&_paramValueLossMutex);
+    return _paramValueLossCount;
+}
+
+bool MockLink::_dropParamValue()
+{
+    QMutexLocker locker(&_paramValueLossMutex);
+    if (_paramValueLossPercent == 0) {
+        return false;
+    }
+
+    // Fixed seed LCG so a given loss rate drops the same share of messages on every run
+    _paramValueLossSeed = (_paramValueLossSeed * 1664525u) + 1013904223u;
+    if (((_paramValueLossSeed >> 16) % 100) >= static_cast<quint32>(_paramValueLossPercent)) {
+        return false;
+    }
+
+    _paramValueLossCount++;
+    return true;
+}
+
 void MockLink::_sendParamError(int componentId, const char *paramId, int16_t paramIndex, uint8_t errorCode)
 {
     mavlink_message_t responseMsg{};
@@ -2512,7 +2550,9 @@ MockLink *MockLink::_startMockLinkWorker(const QString &configName, MAV_AUTOPILO
     mockConfig->setPreloadMission(options.testFlag(MockConfiguration::OptionPreloadMission));
     mockConfig->setStayMavlinkV1(options.testFlag(MockConfiguration::OptionStayMavlinkV1));
     mockConfig->setApmStartFreshParams(options.testFlag(MockConfiguration::OptionAPMStartFreshParams));
-    mockConfig->setFtpCapability(options.testFlag(MockConfiguration::OptionFtpCapability));
+    // Like the real firmware, ArduPilot advertises MAVLink FTP and serves its parameters through it
+    const bool apmFtpCapability = (firmwareType == MAV_AUTOPILOT_ARDUPILOTMEGA) && !options.testFlag(MockConfiguration::OptionNoFtpCapability);
+    mockConfig->setFtpCapability(options.testFlag(MockConfiguration::OptionFtpCapability) || apmFtpCapability);
     mockConfig->setVideoStreamType(videoStreamType);
     mockConfig->setFailureMode(failureMode);
 
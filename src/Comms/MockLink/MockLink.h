@@ -161,6 +161,12 @@ class MockLink : public LinkInterface
 
     void setHashCheckNoResponse(bool noResponse) { _hashCheckNoResponse = noResponse; }
 
+    /// Drops a percentage of the PARAM_VALUE messages sent for PARAM_REQUEST_LIST and PARAM_REQUEST_READ,
+    /// simulating a lossy telemetry radio. The pattern is pseudo random and restarts with each call.
+    void setParamValueLossPercent(int percent);
+    /// Returns the number of PARAM_VALUE messages dropped since setParamValueLossPercent
+    int paramValueLossCount() const;
+
     /// Controls whether SYS_AUTOSTART is also reset when a MAV_CMD_PREFLIGHT_STORAGE
     /// param1=2 (reset params to defaults) command is received. Defaults to false so
     /// the simulated airframe doesn't change.
@@ -271,6 +277,8 @@ private slots:
     void _handleParamRequestList(const mavlink_message_t &msg);
     void _handleParamSet(const mavlink_message_t &msg);
     void _handleParamRequestRead(const mavlink_message_t &msg);
+    /// Returns true if the next PARAM_VALUE should be dropped to simulate link loss
+    bool _dropParamValue();
     void _handleFTP(const mavlink_message_t &msg);
     void _handleCommandLong(const mavlink_message_t &msg);
     void _handleCommandInt(const mavlink_message_t &msg);
@@ -444,6 +452,11 @@ private slots:
     ParamRequestReadFailureMode_t _paramRequestReadFailureMode = FailParamRequestReadNone;
     bool _paramRequestReadFailureFirstAttemptPending = false;
     bool _hashCheckNoResponse = false;
+    /// Protects the loss state, PARAM_VALUEs are sent from both the main thread and the param stream worker
+    mutable QMutex _paramValueLossMutex;
+    int _paramValueLossPercent = 0;
+    quint32 _paramValueLossSeed = 1;
+    int _paramValueLossCount = 0;
     int _hashCheckRequestCount = 0;
     bool _paramRequestListHashCheckSent = false;
     bool _resetSysAutostartOnParamReset = false;
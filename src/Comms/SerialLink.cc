@@ -354,8 +354,18 @@ void SerialWorker::_onPortDisconnected()
 void SerialWorker::_onPortReadyRead()
 {
     const QByteArray data = _port->readAll();
-    if (!data.isEmpty()) {
-        // qCDebug(SerialLinkLog) << data.size();
+    if (data.isEmpty()) {
+        return;
+    }
+
+    // qCDebug(SerialLinkLog) << data.size();
+    if (_frameParser) {
+        MAVLinkFrameBatch batch;
+        _frameParser->parse(data, batch);
+        if (!batch.isEmpty()) {
+            emit messagesReceived(batch);
+        }
+    } else {
         emit dataReceived(data);
     }
 }
@@ -437,6 +447,7 @@ SerialLink::SerialLink(SharedLinkConfigurationPtr &config, QObject *parent)
     (void) connect(_worker, &SerialWorker::connected, this, &SerialLink::_onConnected, Qt::QueuedConnection);
     (void) connect(_worker, &SerialWorker::disconnected, this, &SerialLink::_onDisconnected, Qt::QueuedConnection);
     (void) connect(_worker, &SerialWorker::dataReceived, this, &SerialLink::_onDataReceived, Qt::QueuedConnection);
+    (void) connect(_worker, &SerialWorker::messagesReceived, this, &SerialLink::_onMessagesReceived, Qt::QueuedConnection);
     (void) connect(_worker, &SerialWorker::dataSent, this, &SerialLink::_onDataSent, Qt::QueuedConnection);
     (void) connect(_worker, &SerialWorker::errorOccurred, this, &SerialLink::_onErrorOccurred, Qt::QueuedConnection);
 
@@ -465,6 +476,10 @@ bool SerialLink::isConnected() const
 
 bool SerialLink::_connect()
 {
+    if (linkThreadParsingEnabled()) {
+        _worker->setFrameParser(frameParser());
+    }
+
     return QMetaObject::invokeMethod(_worker, "connectToPort", Qt::QueuedConnection);
 }
 
@@ -499,6 +514,11 @@ void SerialLink::_onDataReceived(const QByteArray &data)
     emit bytesReceived(this, data);
 }
 
+void SerialLink::_onMessagesReceived(const MAVLinkFrameBatch &batch)
+{
+    emit messagesReceived(this, batch);
+}
+
 void SerialLink::_onDataSent(const QByteArray &data)
 {
     emit bytesSent(this, data);
@@ -108,10 +108,15 @@ class SerialWorker : public QObject
     bool isConnected() const;
     const QSerialPort *port() const { return _port; }
 
+    /// Parse received bytes on this thread and emit messagesReceived instead of dataReceived.
+    /// Must be set before connectToPort is invoked.
+    void setFrameParser(std::shared_ptr<MAVLinkFrameParser> parser) { _frameParser = std::move(parser); }
+
 signals:
     void connected();
     void disconnected();
     void dataReceived(const QByteArray &data);
+    void messagesReceived(const MAVLinkFrameBatch &batch);
     void dataSent(const QByteArray &data);
     void errorOccurred(const QString &errorString);
 
@@ -134,6 +139,7 @@ private slots:
     QSerialPort *_port = nullptr;
     QTimer *_timer = nullptr;
     bool _errorEmitted = false;
+    std::shared_ptr<MAVLinkFrameParser> _frameParser;
 };
 
 /*===========================================================================*/
@@ -158,6 +164,7 @@ private slots:
     void _onConnected();
     void _onDisconnected();
     void _onDataReceived(const QByteArray &data);
+    void _onMessagesReceived(const MAVLinkFrameBatch &batch);
     void _onDataSent(const QByteArray &data);
     void _onErrorOccurred(const QString &errorString);
 
@@ -223,7 +223,17 @@ void TCPWorker::_onSocketDisconnected()
 void TCPWorker::_onSocketReadyRead()
 {
     const QByteArray data = _socket->readAll();
-    if (!data.isEmpty()) {
+    if (data.isEmpty()) {
+        return;
+    }
+
+    if (_frameParser) {
+        MAVLinkFrameBatch batch;
+        _frameParser->parse(data, batch);
+        if (!batch.isEmpty()) {
+            emit messagesReceived(batch);
+        }
+    } else {
         emit dataReceived(data);
     }
 }
@@ -264,6 +274,7 @@ TCPLink::TCPLink(SharedLinkConfigurationPtr &config, QObject *parent)
     (void) connect(_worker, &TCPWorker::disconnected, this, &TCPLink::_onDisconnected, Qt::QueuedConnection);
     (void) connect(_worker, &TCPWorker::errorOccurred, this, &TCPLink::_onErrorOccurred, Qt::QueuedConnection);
     (void) connect(_worker, &TCPWorker::dataReceived, this, &TCPLink::_onDataReceived, Qt::QueuedConnection);
+    (void) connect(_worker, &TCPWorker::messagesReceived, this, &TCPLink::_onMessagesReceived, Qt::QueuedConnection);
     (void) connect(_worker, &TCPWorker::dataSent, this, &TCPLink::_onDataSent, Qt::QueuedConnection);
 
     _workerThread->start();
@@ -291,6 +302,10 @@ bool TCPLink::isConnected() const
 
 bool TCPLink::_connect()
 {
+    if (linkThreadParsingEnabled()) {
+        _worker->setFrameParser(frameParser());
+    }
+
     return QMetaObject::invokeMethod(_worker, "connectToHost", Qt::QueuedConnection);
 }
 
@@ -325,6 +340,11 @@ void TCPLink::_onDataReceived(const QByteArray &data)
     emit bytesReceived(this, data);
 }
 
+void TCPLink::_onMessagesReceived(const MAVLinkFrameBatch &batch)
+{
+    emit messagesReceived(this, batch);
+}
+
 void TCPLink::_onDataSent(const QByteArray &data)
 {
     emit bytesSent(this, data);
@@ -59,11 +59,16 @@ class TCPWorker : public QObject
 
     bool isConnected() const;
 
+    /// Parse received bytes on this thread and emit messagesReceived instead of dataReceived.
+    /// Must be set before connectToHost is invoked.
+    void setFrameParser(std::shared_ptr<MAVLinkFrameParser> parser) { _frameParser = std::move(parser); }
+
 signals:
     void connected();
     void disconnected();
     void errorOccurred(const QString &errorString);
     void dataReceived(const QByteArray &data);
+    void messagesReceived(const MAVLinkFrameBatch &batch);
     void dataSent(const QByteArray &data);
 
 public slots:
@@ -83,6 +88,7 @@ private slots:
     const TCPConfiguration *_config = nullptr;
     QTcpSocket *_socket = nullptr;
     std::atomic<bool> _errorEmitted{false};
+    std::shared_ptr<MAVLinkFrameParser> _frameParser;
 };
 
 /*===========================================================================*/
@@ -105,6 +111,7 @@ private slots:
     void _onDisconnected();
     void _onErrorOccurred(const QString &errorString);
     void _onDataReceived(const QByteArray &data);
+    void _onMessagesReceived(const MAVLinkFrameBatch &batch);
     void _onDataSent(const QByteArray &data);
 
 private:
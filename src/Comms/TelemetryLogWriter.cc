@@ -0,0 +1,271 @@
+#include "TelemetryLogWriter.h"
+
+#include <QtCore/QDeadlineTimer>
+#include <QtCore/QFile>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QThread>
+#include <QtCore/QtEndian>
+#include <cstring>
+
+#include "QGCLoggingCategory.h"
+
+QGC_LOGGING_CATEGORY(TelemetryLogWriterLog, "Comms.TelemetryLogWriter")
+
+TelemetryLogWriter::TelemetryLogWriter(QObject* parent)
+    : QObject(parent)
+{
+    qCDebug(TelemetryLogWriterLog) << this;
+}
+
+TelemetryLogWriter::~TelemetryLogWriter()
+{
+    close();
+
+    qCDebug(TelemetryLogWriterLog) << this;
+}
+
+void TelemetryLogWriter::setBufferCapacity(qsizetype bytes)
+{
+    if (_isOpen) {
+        qCWarning(TelemetryLogWriterLog) << "Buffer capacity can only be changed while closed";
+        return;
+    }
+
+    _ring.clear();
+    _ring.resize(bytes);
+}
+
+bool TelemetryLogWriter::open(const QString& filePath)
+{
+    close();
+
+    _fileName = filePath;
+    _file = std::make_unique<QFile>(filePath);
+    // Unbuffered: each group commit goes straight to the OS instead of being re-chunked by QFile
+    if (!_file->open(QIODevice::WriteOnly | QIODevice::Unbuffered)) {
+        const QMutexLocker locker(&_mutex);
+        _lastError = _file->errorString();
+        _file.reset();
+        return false;
+    }
+
+    {
+        const QMutexLocker locker(&_mutex);
+        if (_ring.isEmpty()) {
+            _ring.resize(kDefaultBufferCapacity);
+        }
+        _head = 0;
+        _tail = 0;
+        _buffered = 0;
+        _appendSeq = 0;
+        _writtenSeq = 0;
+        _flushRequested = false;
+        _quit = false;
+        _failed = false;
+        _stats = Stats();
+        _lastError.clear();
+        _backpressured.store(false, std::memory_order_relaxed);
+
+        _thread = QThread::create([this]() { _workerLoop(); });
+        _thread->setObjectName(QStringLiteral("TelemetryLogWriter"));
+        _thread->start(QThread::LowPriority);
+    }
+
+    _isOpen = true;
+    return true;
+}
+
+void TelemetryLogWriter::close()
+{
+    {
+        const QMutexLocker locker(&_mutex);
+        if (!_thread) {
+            return;
+        }
+        _quit = true;
+    }
+    _dataAvailable.wakeOne();
+
+    // The I/O thread drains the ring before exiting
+    _thread->wait();
+    delete _thread;
+    _thread = nullptr;
+
+    _file->close();
+    _file.reset();
+    _isOpen = false;
+
+    const Stats stats = this->stats();
+    qCDebug(TelemetryLogWriterLog) << "Closed" << _fileName
+                                   << "frames:" << stats.framesQueued
+                                   << "bytes:" << stats.bytesWritten
+                                   << "writes:" << stats.writeCalls
+                                   << "peak buffered:" << stats.peakBufferedBytes;
+    if (stats.framesDropped > 0) {
+        qCWarning(TelemetryLogWriterLog) << "Dropped" << stats.framesDropped << "frames, storage was too slow for" << _fileName;
+    }
+}
+
+QString TelemetryLogWriter::lastError() const
+{
+    const QMutexLocker locker(&_mutex);
+    return _lastError;
+}
+
+TelemetryLogWriter::Stats TelemetryLogWriter::stats() const
+{
+    const QMutexLocker locker(&_mutex);
+    return _stats;
+}
+
+bool TelemetryLogWriter::append(quint64 timestampUsecs, QByteArrayView frame)
+{
+    const qsizetype needed = static_cast<qsizetype>(sizeof(timestampUsecs)) + frame.size();
+
+    bool wake = false;
+    {
+        const QMutexLocker locker(&_mutex);
+        if (!_thread || _quit || _failed) {
+            return false;
+        }
+
+        if ((_ring.size() - _buffered) < needed) {
+            _stats.framesDropped++;
+            _updateBackpressureLocked();
+            return false;
+        }
+
+        uint8_t timestamp[sizeof(timestampUsecs)];
+        qToBigEndian(timestampUsecs, timestamp);
+        _copyIn(QByteArrayView(timestamp, sizeof(timestamp)));
+        _copyIn(frame);
+
+        _buffered += needed;
+        _appendSeq++;
+        _stats.framesQueued++;
+        _stats.peakBufferedBytes = qMax(_stats.peakBufferedBytes, static_cast<qint64>(_buffered));
+        _updateBackpressureLocked();
+
+        wake = (_buffered >= kGroupCommitBytes);
+    }
+
+    if (wake) {
+        _dataAvailable.wakeOne();
+    }
+
+    return true;
+}
+
+bool TelemetryLogWriter::flush(int timeoutMs)
+{
+    QMutexLocker locker(&_mutex);
+    if (!_thread) {
+        return true;
+    }
+
+    const quint64 target = _appendSeq;
+    _flushRequested = true;
+    _dataAvailable.wakeOne();
+
+    const QDeadlineTimer deadline(timeoutMs);
+    while ((_writtenSeq < target) && !_failed) {
+        if (!_dataWritten.wait(&_mutex, deadline)) {
+            return false;
+        }
+    }
+
+    return !_failed;
+}
+
+void TelemetryLogWriter::_copyIn(QByteArrayView bytes)
+{
+    // Caller guarantees there is room. Copies may wrap around the end of the ring.
+    const qsizetype firstLength = qMin(bytes.size(), _ring.size() - _tail);
+    (void) std::memcpy(_ring.data() + _tail, bytes.data(), firstLength);
+    if (firstLength < bytes.size()) {
+        (void) std::memcpy(_ring.data(), bytes.data() + firstLength, bytes.size() - firstLength);
+    }
+    _tail = (_tail + bytes.size()) % _ring.size();
+}
+
+void TelemetryLogWriter::_updateBackpressureLocked()
+{
+    const qsizetype percentFull = (_buffered * 100) / _ring.size();
+    const bool backpressured = _backpressured.load(std::memory_order_relaxed);
+
+    bool newState = backpressured;
+    if (!backpressured && (percentFull >= kBackpressureHighPercent)) {
+        newState = true;
+        qCWarning(TelemetryLogWriterLog) << "Storage is not keeping up," << _buffered << "bytes buffered for" << _fileName;
+    } else if (backpressured && (percentFull <= kBackpressureLowPercent)) {
+        newState = false;
+        qCDebug(TelemetryLogWriterLog) << "Backpressure cleared";
+    }
+
+    if (newState != backpressured) {
+        _backpressured.store(newState, std::memory_order_relaxed);
+        (void) QMetaObject::invokeMethod(this, [this, newState]() {
+            emit backpressureChanged(newState);
+        }, Qt::QueuedConnection);
+    }
+}
+
+void TelemetryLogWriter::_workerLoop()
+{
+    QMutexLocker locker(&_mutex);
+
+    while (true) {
+        // Group commit: wait for a worthwhile amount of data, a flush request, or the latency bound
+        while (!_quit && !_flushRequested && (_buffered < kGroupCommitBytes)) {
+            if (!_dataAvailable.wait(&_mutex, kMaxCommitLatencyMs)) {
+                break;
+            }
+        }
+
+        const qsizetype head = _head;
+        const qsizetype count = _buffered;
+        const quint64 seq = _appendSeq;
+        const bool quit = _quit;
+        _flushRequested = false;
+
+        if ((count > 0) && !_failed) {
+            // Producers only touch free space, so the buffered region can be written without the lock
+            locker.unlock();
+
+            const qsizetype firstLength = qMin(count, _ring.size() - head);
+            bool ok = (_file->write(_ring.constData() + head, firstLength) == firstLength);
+            if (ok && (firstLength < count)) {
+                ok = (_file->write(_ring.constData(), count - firstLength) == (count - firstLength));
+            }
+
+            locker.relock();
+
+            if (ok) {
+                _stats.bytesWritten += static_cast<quint64>(count);
+                _stats.writeCalls++;
+            } else {
+                _failed = true;
+                _lastError = _file->errorString();
+                qCWarning(TelemetryLogWriterLog) << "Write failed" << _fileName << _lastError;
+                (void) QMetaObject::invokeMethod(this, [this, error = _lastError]() {
+                    emit errorOccurred(error);
+                }, Qt::QueuedConnection);
+            }
+
+            _head = (head + count) % _ring.size();
+            _buffered -= count;
+            _updateBackpressureLocked();
+        } else if (_failed) {
+            // Nothing more can be written, discard so producers see a consistent state
+            _head = _tail;
+            _buffered = 0;
+        }
+
+        _writtenSeq = seq;
+        _dataWritten.wakeAll();
+
+        if (quit && ((_buffered == 0) || _failed)) {
+            break;
+        }
+    }
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QByteArrayView>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QWaitCondition>
+
+#include <atomic>
+#include <memory>
+
+class QFile;
+class QThread;
+
+/// \brief Writes timestamped MAVLink frames to a telemetry (.tlog) file from a dedicated I/O thread.
+///
+/// Producers copy already serialized frames into a fixed size ring buffer and return immediately. The I/O thread
+/// group-commits everything buffered in large writes, so a stalled storage device delays the file instead of the
+/// caller. When the ring is full new frames are dropped and counted rather than blocking the caller.
+class TelemetryLogWriter : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Stats
+    {
+        quint64 framesQueued = 0;
+        quint64 framesDropped = 0;      ///< Dropped because the ring buffer was full
+        quint64 bytesWritten = 0;
+        quint64 writeCalls = 0;         ///< Group commits performed
+        qint64 peakBufferedBytes = 0;   ///< Ring buffer high water mark
+    };
+
+    explicit TelemetryLogWriter(QObject* parent = nullptr);
+    ~TelemetryLogWriter() override;
+
+    /// Opens @a filePath for writing and starts the I/O thread.
+    /// @return false: file could not be opened, see lastError()
+    bool open(const QString& filePath);
+
+    /// Writes all buffered frames, closes the file and stops the I/O thread.
+    void close();
+
+    bool isOpen() const { return _isOpen; }
+    QString fileName() const { return _fileName; }
+    QString lastError() const;
+
+    /// Queues a frame prefixed with its big-endian @a timestampUsecs, in tlog format.
+    /// Thread-safe. @return false: frame was dropped
+    bool append(quint64 timestampUsecs, QByteArrayView frame);
+
+    /// Blocks until all frames queued so far have been handed to the OS.
+    /// @return false: timed out
+    bool flush(int timeoutMs = 5000);
+
+    Stats stats() const;
+
+    /// true: ring buffer is above the high water mark and the storage device is not keeping up
+    bool isBackpressured() const { return _backpressured.load(std::memory_order_relaxed); }
+
+    void setBufferCapacity(qsizetype bytes);
+    qsizetype bufferCapacity() const { return _ring.size(); }
+
+    static constexpr qsizetype kDefaultBufferCapacity = 4 * 1024 * 1024;
+    static constexpr qsizetype kGroupCommitBytes = 64 * 1024;   ///< Wake the I/O thread once this much is buffered
+    static constexpr int kMaxCommitLatencyMs = 250;             ///< Never leave frames buffered longer than this
+
+signals:
+    /// Emitted on the owner thread after a write failed. Buffered frames are discarded from then on.
+    void errorOccurred(const QString& errorString);
+    void backpressureChanged(bool backpressured);
+
+private:
+    void _workerLoop();
+    void _updateBackpressureLocked();
+    void _copyIn(QByteArrayView bytes);
+
+    mutable QMutex _mutex;
+    QWaitCondition _dataAvailable;      ///< Producer -> I/O thread
+    QWaitCondition _dataWritten;        ///< I/O thread -> flush()
+
+    QByteArray _ring;
+    qsizetype _head = 0;                ///< Next byte the I/O thread writes
+    qsizetype _tail = 0;                ///< Next free byte for producers
+    qsizetype _buffered = 0;
+    quint64 _appendSeq = 0;             ///< Frames appended, used to track flush progress
+    quint64 _writtenSeq = 0;
+    bool _flushRequested = false;
+    bool _quit = false;
+    bool _failed = false;
+
+    Stats _stats;
+    QString _lastError;
+    std::atomic<bool> _backpressured{false};
+
+    std::unique_ptr<QFile> _file;
+    QThread* _thread = nullptr;
+    QString _fileName;
+    bool _isOpen = false;
+
+    static constexpr int kBackpressureHighPercent = 75;
+    static constexpr int kBackpressureLowPercent = 25;
+};
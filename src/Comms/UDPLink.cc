@@ -4,10 +4,9 @@
 #include "QGCNetworkHelper.h"
 #include "SettingsManager.h"
 
-#include <QtCore/QMutexLocker>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QThread>
 #include <QtNetwork/QHostInfo>
-#include <QtNetwork/QNetworkDatagram>
 #include <QtNetwork/QNetworkInterface>
 #include <QtNetwork/QNetworkProxy>
 #include <QtNetwork/QUdpSocket>
@@ -17,6 +16,11 @@ QGC_LOGGING_CATEGORY(UDPLinkLog, "Comms.UDPLink")
 namespace {
     constexpr int BUFFER_TRIGGER_SIZE = 10 * 1024;
     constexpr int RECEIVE_TIME_LIMIT_MS = 50;
+    constexpr qsizetype MAX_DATAGRAM_SIZE = 65507;  // Largest IPv4 UDP payload
+    constexpr qsizetype TYPICAL_DATAGRAM_SIZE = 1500;  // Ethernet MTU, MAVLink datagrams are far smaller
+    // A buffer below the trigger has room for one more MTU sized datagram, larger ones grow it
+    constexpr qsizetype RECEIVE_BUFFER_CAPACITY = BUFFER_TRIGGER_SIZE + TYPICAL_DATAGRAM_SIZE;
+    constexpr qsizetype RECEIVE_BUFFER_POOL_SIZE = 4;
 
     bool containsTarget(const QList<std::shared_ptr<UDPClient>> &list, const QHostAddress &address, quint16 port)
     {
@@ -385,6 +389,8 @@ void UDPWorker::disconnectLink()
     _socket->close();
 
     _sessionTargets.clear();
+    _knownSenders.clear();
+    _lastSenderKey = 0;
 }
 
 void UDPWorker::writeData(const QByteArray &data)
@@ -394,8 +400,6 @@ void UDPWorker::writeData(const QByteArray &data)
         return;
     }
 
-    QMutexLocker locker(&_sessionTargetsMutex);
-
     // Send to all manually targeted systems
     for (const std::shared_ptr<UDPClient> &target : _udpConfig->targetHosts()) {
         if (target->address.isNull()) {
@@ -415,8 +419,6 @@ void UDPWorker::writeData(const QByteArray &data)
         }
     }
 
-    locker.unlock();
-
     emit dataSent(data);
 }
 
@@ -449,43 +451,111 @@ void UDPWorker::_onSocketReadyRead()
         return;
     }
 
-    QByteArray buffer;
-    buffer.reserve(BUFFER_TRIGGER_SIZE);
+    // Datagrams are read into one worst case sized scratch buffer and only their length is appended to a
+    // pooled buffer: no QNetworkDatagram and no per-datagram allocation
+    if (_datagramBuffer.size() != MAX_DATAGRAM_SIZE) {
+        _datagramBuffer.resize(MAX_DATAGRAM_SIZE);
+    }
+    QByteArray buffer = _takeReceiveBuffer();
     QElapsedTimer timer;
     timer.start();
     bool received = false;
     while (_socket->hasPendingDatagrams()) {
-        const QNetworkDatagram datagramIn = _socket->receiveDatagram();
-        if (datagramIn.isNull() || datagramIn.data().isEmpty()) {
+        QHostAddress senderAddress;
+        quint16 senderPort = 0;
+        const qint64 length = _socket->readDatagram(_datagramBuffer.data(), MAX_DATAGRAM_SIZE, &senderAddress, &senderPort);
+        if (length <= 0) {
             continue;
         }
+        buffer.append(_datagramBuffer.constData(), length);
 
-        (void) buffer.append(datagramIn.data());
+        _noteSender(senderAddress, senderPort);
 
         if ((buffer.size() > BUFFER_TRIGGER_SIZE) || (timer.elapsed() > RECEIVE_TIME_LIMIT_MS)) {
             received = true;
-            emit dataReceived(buffer);
-            buffer.clear();
+            _emitReceived(buffer);
+            _recycleReceiveBuffer(std::move(buffer));
+            buffer = _takeReceiveBuffer();
             (void) timer.restart();
         }
+    }
 
-        const bool ipLocal = datagramIn.senderAddress().isLoopback() || _localAddresses.contains(datagramIn.senderAddress());
-        const QHostAddress senderAddress = ipLocal ? QHostAddress(QHostAddress::SpecialAddress::LocalHost) : datagramIn.senderAddress();
+    if (!received && buffer.isEmpty()) {
+        qCWarning(UDPLinkLog) << "No Data Available to Read!";
+        _recycleReceiveBuffer(std::move(buffer));
+        return;
+    }
+
+    if (!buffer.isEmpty()) {
+        _emitReceived(buffer);
+    }
+    _recycleReceiveBuffer(std::move(buffer));
+}
+
+void UDPWorker::_noteSender(const QHostAddress &address, quint16 port)
+{
+    // Relayed SITL instances interleave their traffic, so the sender is looked up in a set rather than only
+    // compared against the previous one. The slow path only runs the first time an endpoint is seen.
+    const quint32 ipv4 = address.toIPv4Address();
+    const quint64 key = (static_cast<quint64>(ipv4) << 16) | port;
+    if ((ipv4 != 0) && ((key == _lastSenderKey) || _knownSenders.contains(key))) {
+        _lastSenderKey = key;
+        return;
+    }
+
+    const bool ipLocal = address.isLoopback() || _localAddresses.contains(address);
+    const QHostAddress targetAddress = ipLocal ? QHostAddress(QHostAddress::SpecialAddress::LocalHost) : address;
+    if (!containsTarget(_sessionTargets, targetAddress, port)) {
+        qCDebug(UDPLinkLog) << "UDP Adding target:" << targetAddress << port;
+        _sessionTargets.append(std::make_shared<UDPClient>(targetAddress, port));
+    }
+
+    if (ipv4 != 0) {
+        (void) _knownSenders.insert(key);
+        _lastSenderKey = key;
+    }
+}
 
-        QMutexLocker locker(&_sessionTargetsMutex);
-        if (!containsTarget(_sessionTargets, senderAddress, datagramIn.senderPort())) {
-            qCDebug(UDPLinkLog) << "UDP Adding target:" << senderAddress << datagramIn.senderPort();
-            _sessionTargets.append(std::make_shared<UDPClient>(senderAddress, datagramIn.senderPort()));
+QByteArray UDPWorker::_takeReceiveBuffer()
+{
+    for (qsizetype i = 0; i < _receiveBufferPool.size(); i++) {
+        if (_receiveBufferPool.at(i).isDetached()) {
+            QByteArray buffer = _receiveBufferPool.takeAt(i);
+            buffer.resize(0); // Keeps the allocation
+            return buffer;
         }
-        locker.unlock();
     }
 
-    if (!received && buffer.isEmpty()) {
-        qCWarning(UDPLinkLog) << "No Data Available to Read!";
+    // Every pooled buffer is still queued to the link, allocate another one
+    QByteArray buffer;
+    buffer.reserve(RECEIVE_BUFFER_CAPACITY);
+    return buffer;
+}
+
+void UDPWorker::_recycleReceiveBuffer(QByteArray &&buffer)
+{
+    // Don't keep a buffer which grew for an unusually large datagram
+    if (buffer.capacity() > (2 * RECEIVE_BUFFER_CAPACITY)) {
+        return;
+    }
+
+    if (_receiveBufferPool.size() < RECEIVE_BUFFER_POOL_SIZE) {
+        _receiveBufferPool.append(std::move(buffer));
+    }
+}
+
+void UDPWorker::_emitReceived(const QByteArray &data)
+{
+    if (!_frameParser) {
+        emit dataReceived(data);
         return;
     }
 
-    emit dataReceived(buffer);
+    MAVLinkFrameBatch batch;
+    _frameParser->parse(data, batch);
+    if (!batch.isEmpty()) {
+        emit messagesReceived(batch);
+    }
 }
 
 void UDPWorker::_onSocketBytesWritten(qint64 bytes)
@@ -525,6 +595,7 @@ UDPLink::UDPLink(SharedLinkConfigurationPtr &config, QObject *parent)
     (void) connect(_worker, &UDPWorker::disconnected, this, &UDPLink::_onDisconnected, Qt::QueuedConnection);
     (void) connect(_worker, &UDPWorker::errorOccurred, this, &UDPLink::_onErrorOccurred, Qt::QueuedConnection);
     (void) connect(_worker, &UDPWorker::dataReceived, this, &UDPLink::_onDataReceived, Qt::QueuedConnection);
+    (void) connect(_worker, &UDPWorker::messagesReceived, this, &UDPLink::_onMessagesReceived, Qt::QueuedConnection);
     (void) connect(_worker, &UDPWorker::dataSent, this, &UDPLink::_onDataSent, Qt::QueuedConnection);
 
     _workerThread->start();
@@ -552,6 +623,10 @@ bool UDPLink::isConnected() const
 
 bool UDPLink::_connect()
 {
+    if (linkThreadParsingEnabled()) {
+        _worker->setFrameParser(frameParser());
+    }
+
     return QMetaObject::invokeMethod(_worker, "connectLink", Qt::QueuedConnection);
 }
 
@@ -586,6 +661,11 @@ void UDPLink::_onDataReceived(const QByteArray &data)
     emit bytesReceived(this, data);
 }
 
+void UDPLink::_onMessagesReceived(const MAVLinkFrameBatch &batch)
+{
+    emit messagesReceived(this, batch);
+}
+
 void UDPLink::_onDataSent(const QByteArray &data)
 {
     emit bytesSent(this, data);
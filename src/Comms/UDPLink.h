@@ -5,7 +5,7 @@
 
 #include <QtCore/QByteArray>
 #include <QtCore/QList>
-#include <QtCore/QMutex>
+#include <QtCore/QSet>
 #include <QtCore/QString>
 #include <QtNetwork/QHostAddress>
 
@@ -113,6 +113,10 @@ class UDPWorker : public QObject
 
     bool isConnected() const;
 
+    /// Parse received datagrams on this thread and emit messagesReceived instead of dataReceived.
+    /// Must be set before connectLink is invoked.
+    void setFrameParser(std::shared_ptr<MAVLinkFrameParser> parser) { _frameParser = std::move(parser); }
+
 public slots:
     void setupSocket();
     void connectLink();
@@ -124,6 +128,7 @@ public slots:
     void disconnected();
     void errorOccurred(const QString &errorString);
     void dataReceived(const QByteArray &data);
+    void messagesReceived(const MAVLinkFrameBatch &batch);
     void dataSent(const QByteArray &data);
 
 private slots:
@@ -134,13 +139,26 @@ private slots:
     void _onSocketErrorOccurred(QAbstractSocket::SocketError socketError);
 
 private:
+    void _emitReceived(const QByteArray &data);
+    void _noteSender(const QHostAddress &address, quint16 port);
+    QByteArray _takeReceiveBuffer();
+    void _recycleReceiveBuffer(QByteArray &&buffer);
+
     const UDPConfiguration *_udpConfig = nullptr;
     QUdpSocket *_socket = nullptr;
-    QMutex _sessionTargetsMutex;
+    /// Only touched on the worker thread, so neither the targets nor the sender cache need a lock
     QList<std::shared_ptr<UDPClient>> _sessionTargets;
+    /// Senders already added to _sessionTargets, keyed by (IPv4 address << 16 | port) as received
+    QSet<quint64> _knownSenders;
+    quint64 _lastSenderKey = 0;
+    /// Receive buffers handed out through dataReceived. A buffer is reused once every receiver released it.
+    QList<QByteArray> _receiveBufferPool;
+    /// Scratch buffer every datagram is read into before its length is copied to a receive buffer
+    QByteArray _datagramBuffer;
     bool _isConnected = false;
     bool _errorEmitted = false;
     QSet<QHostAddress> _localAddresses;
+    std::shared_ptr<MAVLinkFrameParser> _frameParser;
 
     static const QHostAddress _multicastGroup;
 };
@@ -168,6 +186,7 @@ private slots:
     void _onDisconnected();
     void _onErrorOccurred(const QString &errorString);
     void _onDataReceived(const QByteArray &data);
+    void _onMessagesReceived(const MAVLinkFrameBatch &batch);
     void _onDataSent(const QByteArray &data);
 
 private:
@@ -3,8 +3,10 @@
 #include <cstdlib>
 #include <cstring>
 #include <limits>
+#include <type_traits>
 
 #include "Fact.h"
+#include "FactUpdateScheduler.h"
 #include "FactValueSliderListModel.h"
 #include "AppMessages.h"
 #include "QGCApplication.h"
@@ -14,6 +16,68 @@
 
 QGC_LOGGING_CATEGORY(FactLog, "FactSystem.Fact")
 
+namespace {
+
+/// Builds the variant setRawValue would store for @p value without going through QVariant conversion.
+///     @return false if the fact type needs the full conversion
+template<typename T>
+bool telemetryVariant(FactMetaData::ValueType_t type, T value, QVariant &typedValue)
+{
+    switch (type) {
+    case FactMetaData::valueTypeInt8:
+    case FactMetaData::valueTypeInt16:
+    case FactMetaData::valueTypeInt32:
+        if constexpr (std::is_same_v<T, qint32>) {
+            typedValue = QVariant(value);
+            return true;
+        }
+        return false;
+    case FactMetaData::valueTypeUint8:
+    case FactMetaData::valueTypeUint16:
+    case FactMetaData::valueTypeUint32:
+        if constexpr (std::is_same_v<T, quint32>) {
+            typedValue = QVariant(value);
+            return true;
+        }
+        return false;
+    case FactMetaData::valueTypeFloat:
+        typedValue = QVariant(static_cast<float>(value));
+        return true;
+    case FactMetaData::valueTypeElapsedTimeInSeconds:
+    case FactMetaData::valueTypeDouble:
+        typedValue = QVariant(static_cast<double>(value));
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool sameTelemetryValue(const QVariant &a, const QVariant &b)
+{
+    if (a.typeId() != b.typeId()) {
+        return false;
+    }
+
+    switch (a.typeId()) {
+    case QMetaType::Double:
+    {
+        const double da = a.toDouble();
+        const double db = b.toDouble();
+        return (da == db) || (std::isnan(da) && std::isnan(db));
+    }
+    case QMetaType::Float:
+    {
+        const float fa = a.toFloat();
+        const float fb = b.toFloat();
+        return (fa == fb) || (std::isnan(fa) && std::isnan(fb));
+    }
+    default:
+        return a == b;
+    }
+}
+
+} // namespace
+
 Fact::Fact(QObject *parent)
     : QObject(parent)
 {
@@ -97,7 +161,11 @@ const Fact &Fact::operator=(const Fact& other)
     _rawValue = other._rawValue;
     _type = other._type;
     _sendValueChangedSignals = other._sendValueChangedSignals;
-    _deferredValueChangeSignal = other._deferredValueChangeSignal;
+    _deferredUpdateRateMsecs = other._deferredUpdateRateMsecs;
+    _deferredValueChangeSignal = false;
+    if (other._deferredValueChangeSignal) {
+        _deferValueChangedSignal();
+    }
     _valueSliderModel = nullptr;
     if (_metaData && other._metaData) {
         *_metaData = *other._metaData;
@@ -223,10 +291,91 @@ void Fact::containerSetRawValue(const QVariant &value)
     emit vehicleUpdated(currentRaw);
 }
 
+void Fact::setTelemetryValue(double value)
+{
+    QVariant typedValue;
+    if (telemetryVariant(_type, value, typedValue)) {
+        _storeTelemetryValue(typedValue);
+    } else {
+        _setTelemetryValue(QVariant(value));
+    }
+}
+
+void Fact::setTelemetryValue(float value)
+{
+    QVariant typedValue;
+    if (telemetryVariant(_type, value, typedValue)) {
+        _storeTelemetryValue(typedValue);
+    } else {
+        _setTelemetryValue(QVariant(value));
+    }
+}
+
+void Fact::setTelemetryValue(qint32 value)
+{
+    QVariant typedValue;
+    if (telemetryVariant(_type, value, typedValue)) {
+        _storeTelemetryValue(typedValue);
+    } else {
+        _setTelemetryValue(QVariant(value));
+    }
+}
+
+void Fact::setTelemetryValue(quint32 value)
+{
+    QVariant typedValue;
+    if (telemetryVariant(_type, value, typedValue)) {
+        _storeTelemetryValue(typedValue);
+    } else {
+        _setTelemetryValue(QVariant(value));
+    }
+}
+
+void Fact::_setTelemetryValue(const QVariant &value)
+{
+    if (!_metaData) {
+        qCWarning(FactLog) << kMissingMetadata << name();
+        return;
+    }
+
+    QVariant typedValue;
+    QString errorString;
+    if (_metaData->convertAndValidateRaw(value, true /* convertOnly */, typedValue, errorString)) {
+        _storeTelemetryValue(typedValue);
+    }
+}
+
+void Fact::_storeTelemetryValue(const QVariant &typedValue)
+{
+    if (!_metaData) {
+        qCWarning(FactLog) << kMissingMetadata << name();
+        return;
+    }
+
+    {
+        QMutexLocker<QRecursiveMutex> locker(&_rawValueMutex);
+        if (sameTelemetryValue(typedValue, _rawValue)) {
+            return;
+        }
+        _rawValue = typedValue;
+    }
+
+    if (_sendValueChangedSignals) {
+        _sendValueChangedSignal(_metaData->rawTranslatorIsIdentity() ? typedValue : _metaData->rawTranslator()(typedValue));
+    } else {
+        // Cooked value is computed when the deferred signal goes out
+        _deferValueChangedSignal();
+    }
+    emit rawValueChanged(typedValue);
+}
+
 QVariant Fact::cookedValue() const
 {
     QMutexLocker<QRecursiveMutex> locker(&_rawValueMutex);
     if (_metaData) {
+        if (_metaData->rawTranslatorIsIdentity()) {
+            return _rawValue;
+        }
         return _metaData->rawTranslator()(_rawValue);
     }
 
@@ -836,7 +985,19 @@ void Fact::_sendValueChangedSignal(const QVariant &value)
         emit valueChanged(value);
         _deferredValueChangeSignal = false;
     } else {
-        _deferredValueChangeSignal = true;
+        _deferValueChangedSignal();
+    }
+}
+
+void Fact::_deferValueChangedSignal()
+{
+    if (_deferredValueChangeSignal) {
+        return;
+    }
+
+    _deferredValueChangeSignal = true;
+    if (_deferredUpdateRateMsecs > 0) {
+        FactUpdateScheduler::instance()->markDirty(this, _deferredUpdateRateMsecs);
     }
 }
 
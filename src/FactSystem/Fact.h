@@ -162,6 +162,10 @@ class Fact : public QObject
     // rate limited signalling for ui performance. Used by FactGroup for example.
     void setSendValueChangedSignals (bool sendValueChangedSignals);
     bool sendValueChangedSignals () const { return _sendValueChangedSignals; }
+    /// Deferred valueChanged signals are sent by FactUpdateScheduler at this rate. 0: the owner must call
+    /// sendDeferredValueChangedSignal itself.
+    void setDeferredUpdateRateMsecs(int updateRateMsecs) { _deferredUpdateRateMsecs = updateRateMsecs; }
+    int deferredUpdateRateMsecs() const { return _deferredUpdateRateMsecs; }
     bool deferredValueChangeSignal() const { return _deferredValueChangeSignal; }
     void clearDeferredValueChangeSignal() { _deferredValueChangeSignal = false; }
     void sendDeferredValueChangedSignal();
@@ -179,6 +183,15 @@ class Fact : public QObject
     /// Value coming from Vehicle. This does NOT send a _containerRawValueChanged signal.
     void containerSetRawValue(const QVariant &value);
 
+    /// Telemetry fast path for values decoded from vehicle messages. When the argument type matches the
+    /// fact type the value is stored as is, skipping the string capable conversion and validation done by
+    /// setRawValue. Other fact types fall back to a plain conversion. Like containerSetRawValue this does
+    /// NOT send a containerRawValueChanged signal. A NaN replacing a NaN is not a change.
+    void setTelemetryValue(double value);
+    void setTelemetryValue(float value);
+    void setTelemetryValue(qint32 value);
+    void setTelemetryValue(quint32 value);
+
     /// Generally you should not change the name of a fact. But if you know what you are doing, you can.
     void setName(const QString &name) { _name = name; }
 
@@ -213,6 +226,7 @@ class Fact : public QObject
     FactMetaData *_metaData = nullptr;
     bool _sendValueChangedSignals = true;
     bool _deferredValueChangeSignal = false;
+    int _deferredUpdateRateMsecs = 0;
     FactValueSliderListModel *_valueSliderModel = nullptr;
 
     static constexpr const char *kMissingMetadata = "Meta data pointer missing";
@@ -222,4 +236,7 @@ private slots:
 
 private:
     void _init();
+    void _deferValueChangedSignal();
+    void _setTelemetryValue(const QVariant &value);
+    void _storeTelemetryValue(const QVariant &typedValue);
 };
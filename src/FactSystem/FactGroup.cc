@@ -2,6 +2,7 @@
 
 #include <QtCore/QJsonArray>
 
+#include "FactUpdateScheduler.h"
 #include "QGCLoggingCategory.h"
 
 QGC_LOGGING_CATEGORY(FactGroupLog, "FactSystem.FactGroup")
@@ -12,7 +13,6 @@ FactGroup::FactGroup(int updateRateMsecs, const QString &metaDataFile, QObject *
     , _ignoreCamelCase(ignoreCamelCase)
 {
     // qCDebug(FactGroupLog) << Q_FUNC_INFO << this;
-    _setupTimer();
     _nameToFactMetaDataMap = FactMetaData::createMapFromJsonFile(metaDataFile, this);
 }
 
@@ -22,7 +22,6 @@ FactGroup::FactGroup(int updateRateMsecs, QObject *parent, bool ignoreCamelCase)
     , _ignoreCamelCase(ignoreCamelCase)
 {
     // qCDebug(FactGroupLog) << Q_FUNC_INFO << this;
-    _setupTimer();
 }
 
 FactGroup::~FactGroup()
@@ -36,14 +35,9 @@ void FactGroup::_loadFromJsonArray(const QJsonArray &jsonArray)
     _nameToFactMetaDataMap = FactMetaData::createMapFromJsonArray(jsonArray, defineMap, this);
 }
 
-void FactGroup::_setupTimer()
+void FactGroup::_setPeriodicUpdates()
 {
-    if (_updateRateMSecs > 0) {
-        (void) connect(&_updateTimer, &QTimer::timeout, this, &FactGroup::_updateAllValues);
-        _updateTimer.setSingleShot(false);
-        _updateTimer.setInterval(_updateRateMSecs);
-        _updateTimer.start();
-    }
+    FactUpdateScheduler::instance()->addPeriodicGroup(this);
 }
 
 bool FactGroup::factExists(const QString &name) const
@@ -121,6 +115,7 @@ void FactGroup::_addFact(Fact *fact, const QString &name)
     }
 
     fact->setSendValueChangedSignals(_updateRateMSecs == 0);
+    fact->setDeferredUpdateRateMsecs(_updateRateMSecs);
     if (_nameToFactMetaDataMap.contains(name)) {
         fact->setMetaData(_nameToFactMetaDataMap[name], true /* setDefaultFromMetaData */);
     }
@@ -151,16 +146,10 @@ void FactGroup::_updateAllValues()
 
 void FactGroup::setLiveUpdates(bool liveUpdates)
 {
-    if (_updateTimer.interval() == 0) {
+    if (_updateRateMSecs == 0) {
         return;
     }
 
-    if (liveUpdates) {
-        _updateTimer.stop();
-    } else {
-        _updateTimer.start();
-    }
-
     for (Fact *fact: _nameToFactMap) {
         fact->setSendValueChangedSignals(liveUpdates);
     }
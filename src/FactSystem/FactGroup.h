@@ -48,12 +48,18 @@ class FactGroup : public QObject
     /// Allows a FactGroup to parse incoming messages and fill in values
     virtual void handleMessage(Vehicle * /*vehicle*/, const mavlink_message_t & /*message*/) {}
 
+    /// @return Message ids handleMessage wants to see. Empty: the group is not sent any messages.
+    virtual QList<uint32_t> handledMessageIds() const { return {}; }
+
 signals:
     void factNamesChanged();
     void factGroupNamesChanged();
     void telemetryAvailableChanged(bool telemetryAvailable);
 
 protected slots:
+    /// Sends the deferred valueChanged signals of all facts. Rate limited groups are flushed by
+    /// FactUpdateScheduler, which only visits facts that changed. Groups registered through
+    /// _setPeriodicUpdates are called here on every tick for their update rate.
     virtual void _updateAllValues();
 
 protected:
@@ -63,6 +69,8 @@ protected slots:
     void _addFactGroup(FactGroup *factGroup) { _addFactGroup(factGroup, factGroup->objectName()); }
     void _loadFromJsonArray(const QJsonArray &jsonArray);
     void _setTelemetryAvailable(bool telemetryAvailable);
+    /// Calls _updateAllValues on every tick for the update rate, for groups which produce their own values
+    void _setPeriodicUpdates();
 
     const int _updateRateMSecs = 0;   ///< Update rate for Fact::valueChanged signals, 0: immediate update
 
@@ -72,10 +80,10 @@ protected slots:
     QStringList _factNames;
 
 private:
-    void _setupTimer();
+    friend class FactUpdateScheduler;
+
     static QString _camelCase(const QString &text);
 
-    QTimer _updateTimer;
     const bool _ignoreCamelCase = false;
     bool _telemetryAvailable = false;
 };
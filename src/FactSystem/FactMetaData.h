@@ -162,6 +162,9 @@ class FactMetaData : public QObject
     Translator rawTranslator() const { return _rawTranslator; }
     Translator cookedTranslator() const { return _cookedTranslator; }
 
+    /// true: raw and cooked values are the same, no translation needed
+    bool rawTranslatorIsIdentity() const { return _rawTranslator == _defaultTranslator; }
+
     /// Used to add new values to the bitmask lists after the meta data has been loaded
     void addBitmaskInfo(const QString &name, const QVariant &value);
 
@@ -0,0 +1,138 @@
+#include "FactUpdateScheduler.h"
+#include "Fact.h"
+#include "FactGroup.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QApplicationStatic>
+
+#include <utility>
+
+QGC_LOGGING_CATEGORY(FactUpdateSchedulerLog, "FactSystem.FactUpdateScheduler")
+
+Q_APPLICATION_STATIC(FactUpdateScheduler, _factUpdateSchedulerInstance);
+
+FactUpdateScheduler::FactUpdateScheduler(QObject *parent)
+    : QObject(parent)
+{
+    qCDebug(FactUpdateSchedulerLog) << this;
+
+    _timer.setSingleShot(true);
+    (void) connect(&_timer, &QTimer::timeout, this, &FactUpdateScheduler::_tick);
+    _clock.start();
+}
+
+FactUpdateScheduler::~FactUpdateScheduler()
+{
+    qCDebug(FactUpdateSchedulerLog) << this;
+}
+
+FactUpdateScheduler *FactUpdateScheduler::instance()
+{
+    return _factUpdateSchedulerInstance();
+}
+
+void FactUpdateScheduler::markDirty(Fact *fact, int updateRateMsecs)
+{
+    if (updateRateMsecs <= 0) {
+        qCWarning(FactUpdateSchedulerLog) << "Invalid update rate" << updateRateMsecs << fact->name();
+        return;
+    }
+
+    RateBucket &bucket = _buckets[updateRateMsecs];
+    bucket.dirtyFacts.append(fact);
+    _scheduleBucket(updateRateMsecs, bucket);
+}
+
+void FactUpdateScheduler::addPeriodicGroup(FactGroup *factGroup)
+{
+    const int updateRateMsecs = factGroup->_updateRateMSecs;
+    if (updateRateMsecs <= 0) {
+        qCWarning(FactUpdateSchedulerLog) << "Periodic group without update rate" << factGroup;
+        return;
+    }
+
+    RateBucket &bucket = _buckets[updateRateMsecs];
+    bucket.periodicGroups.append(factGroup);
+    _scheduleBucket(updateRateMsecs, bucket);
+}
+
+qsizetype FactUpdateScheduler::pendingCount() const
+{
+    qsizetype count = 0;
+    for (const RateBucket &bucket : _buckets) {
+        count += bucket.dirtyFacts.count();
+    }
+    return count;
+}
+
+void FactUpdateScheduler::_scheduleBucket(int updateRateMsecs, RateBucket &bucket)
+{
+    if (bucket.nextTickMs >= 0) {
+        return;
+    }
+
+    // Align to the rate so independent groups land on the same tick
+    bucket.nextTickMs = ((_clock.elapsed() / updateRateMsecs) + 1) * updateRateMsecs;
+    if ((_timerDueMs < 0) || (bucket.nextTickMs < _timerDueMs)) {
+        _armTimer();
+    }
+}
+
+void FactUpdateScheduler::_armTimer()
+{
+    qint64 dueMs = -1;
+    for (const RateBucket &bucket : std::as_const(_buckets)) {
+        if ((bucket.nextTickMs >= 0) && ((dueMs < 0) || (bucket.nextTickMs < dueMs))) {
+            dueMs = bucket.nextTickMs;
+        }
+    }
+
+    _timerDueMs = dueMs;
+    if (dueMs < 0) {
+        _timer.stop();
+    } else {
+        _timer.start(static_cast<int>(qMax(qint64(0), dueMs - _clock.elapsed())));
+    }
+}
+
+void FactUpdateScheduler::_tick()
+{
+    const qint64 now = _clock.elapsed();
+
+    for (auto it = _buckets.begin(); it != _buckets.end(); ++it) {
+        RateBucket &bucket = it.value();
+        if ((bucket.nextTickMs < 0) || (bucket.nextTickMs > now)) {
+            continue;
+        }
+
+        _flushBucket(bucket);
+
+        // Periodic groups keep the bucket ticking, facts only come back when they change again
+        bucket.nextTickMs = -1;
+        if (!bucket.periodicGroups.isEmpty() || !bucket.dirtyFacts.isEmpty()) {
+            bucket.nextTickMs = ((now / it.key()) + 1) * it.key();
+        }
+    }
+
+    _tickCount++;
+    _armTimer();
+}
+
+void FactUpdateScheduler::_flushBucket(RateBucket &bucket)
+{
+    (void) bucket.periodicGroups.removeAll(nullptr);
+    const QList<QPointer<FactGroup>> periodicGroups = bucket.periodicGroups;
+    for (const QPointer<FactGroup> &factGroup : periodicGroups) {
+        if (factGroup) {
+            factGroup->_updateAllValues();
+        }
+    }
+
+    // Facts changed by a valueChanged handler queue up again for the next tick
+    const QList<QPointer<Fact>> dirtyFacts = std::exchange(bucket.dirtyFacts, {});
+    for (const QPointer<Fact> &fact : dirtyFacts) {
+        if (fact) {
+            fact->sendDeferredValueChangedSignal();
+        }
+    }
+}
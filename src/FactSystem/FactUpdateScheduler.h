@@ -0,0 +1,61 @@
+#pragma once
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QList>
+#include <QtCore/QMap>
+#include <QtCore/QObject>
+#include <QtCore/QPointer>
+#include <QtCore/QTimer>
+
+class Fact;
+class FactGroup;
+
+/// Sends the deferred valueChanged signals of rate limited Facts from a single application wide timer.
+///
+/// A rate limited Fact queues itself the first time a value change is deferred and is flushed on the next
+/// tick for its update rate. Facts which did not change are never visited. Ticks are aligned to multiples
+/// of the update rate so every group with the same rate flushes together, and the timer is only armed
+/// while there is something to flush. Must be used from the main thread.
+class FactUpdateScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit FactUpdateScheduler(QObject *parent = nullptr);
+    ~FactUpdateScheduler();
+
+    static FactUpdateScheduler *instance();
+
+    /// Queues @p fact to send its deferred valueChanged signal on the next tick for @p updateRateMsecs
+    void markDirty(Fact *fact, int updateRateMsecs);
+
+    /// Calls FactGroup::_updateAllValues on every tick for the group's update rate, for groups which
+    /// produce their own values instead of waiting for vehicle messages
+    void addPeriodicGroup(FactGroup *factGroup);
+
+    /// Number of facts waiting for a tick
+    qsizetype pendingCount() const;
+
+    /// Number of timer ticks so far
+    quint64 tickCount() const { return _tickCount; }
+
+private slots:
+    void _tick();
+
+private:
+    struct RateBucket {
+        QList<QPointer<Fact>> dirtyFacts;
+        QList<QPointer<FactGroup>> periodicGroups;
+        qint64 nextTickMs = -1;     ///< -1: nothing to flush
+    };
+
+    void _scheduleBucket(int updateRateMsecs, RateBucket &bucket);
+    void _armTimer();
+    static void _flushBucket(RateBucket &bucket);
+
+    QMap<int, RateBucket> _buckets;     ///< Keyed by update rate in msecs
+    QTimer _timer;
+    QElapsedTimer _clock;
+    qint64 _timerDueMs = -1;
+    quint64 _tickCount = 0;
+};
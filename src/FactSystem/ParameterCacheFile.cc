@@ -0,0 +1,343 @@
+#include "ParameterCacheFile.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "QGCFileHelper.h"
+#include "QGCLoggingCategory.h"
+
+QGC_LOGGING_CATEGORY(ParameterCacheFileLog, "FactSystem.ParameterCacheFile")
+
+namespace {
+
+struct FileHeader {
+    quint32 magic;
+    quint16 version;
+    quint16 entrySize;
+    quint32 entryCount;
+    quint32 namePoolSize;
+};
+static_assert(sizeof(FileHeader) == 16);
+
+struct FileEntry {
+    quint32 nameOffset;     ///< Into the name pool
+    quint8 nameLength;
+    quint8 type;            ///< FactMetaData::ValueType_t
+    quint16 reserved;
+    quint64 value;          ///< ParameterCacheFile::Value::bits
+};
+static_assert(sizeof(FileEntry) == 16);
+
+// Journal record: marker, name length, latin1 name, type, typeToSize(type) value bytes
+constexpr quint8 kJournalRecordMarker = 0xA5;
+constexpr qsizetype kJournalRecordOverhead = 3;
+constexpr qsizetype kMaxNameLength = std::numeric_limits<quint8>::max();
+
+bool entryNameLessThan(const ParameterCacheFile::Entry &a, const ParameterCacheFile::Entry &b)
+{
+    return a.name < b.name;
+}
+
+} // namespace
+
+ParameterCacheFile::Value ParameterCacheFile::Value::fromVariant(FactMetaData::ValueType_t type, const QVariant &variant)
+{
+    Value value;
+    value.type = type;
+
+    switch (type) {
+    case FactMetaData::valueTypeUint8:
+        value.u8 = static_cast<quint8>(variant.toUInt());
+        break;
+    case FactMetaData::valueTypeInt8:
+        value.i8 = static_cast<qint8>(variant.toInt());
+        break;
+    case FactMetaData::valueTypeUint16:
+        value.u16 = static_cast<quint16>(variant.toUInt());
+        break;
+    case FactMetaData::valueTypeInt16:
+        value.i16 = static_cast<qint16>(variant.toInt());
+        break;
+    case FactMetaData::valueTypeUint32:
+        value.u32 = variant.toUInt();
+        break;
+    case FactMetaData::valueTypeInt32:
+        value.i32 = variant.toInt();
+        break;
+    case FactMetaData::valueTypeUint64:
+        value.u64 = variant.toULongLong();
+        break;
+    case FactMetaData::valueTypeInt64:
+        value.i64 = variant.toLongLong();
+        break;
+    case FactMetaData::valueTypeFloat:
+        value.f32 = variant.toFloat();
+        break;
+    case FactMetaData::valueTypeDouble:
+        value.f64 = variant.toDouble();
+        break;
+    default:
+        value.type = FactMetaData::valueTypeString;
+        break;
+    }
+
+    return value;
+}
+
+QVariant ParameterCacheFile::Value::toVariant() const
+{
+    switch (type) {
+    case FactMetaData::valueTypeUint8:
+        return QVariant(static_cast<quint32>(u8));
+    case FactMetaData::valueTypeInt8:
+        return QVariant(static_cast<qint32>(i8));
+    case FactMetaData::valueTypeUint16:
+        return QVariant(static_cast<quint32>(u16));
+    case FactMetaData::valueTypeInt16:
+        return QVariant(static_cast<qint32>(i16));
+    case FactMetaData::valueTypeUint32:
+        return QVariant(u32);
+    case FactMetaData::valueTypeInt32:
+        return QVariant(i32);
+    case FactMetaData::valueTypeUint64:
+        return QVariant(static_cast<qulonglong>(u64));
+    case FactMetaData::valueTypeInt64:
+        return QVariant(static_cast<qlonglong>(i64));
+    case FactMetaData::valueTypeFloat:
+        return QVariant(f32);
+    case FactMetaData::valueTypeDouble:
+        return QVariant(f64);
+    default:
+        return QVariant();
+    }
+}
+
+bool ParameterCacheFile::Value::operator==(const Value &other) const
+{
+    return (type == other.type) && (memcmp(data(), other.data(), size()) == 0);
+}
+
+bool ParameterCacheFile::isSupportedType(FactMetaData::ValueType_t type)
+{
+    switch (type) {
+    case FactMetaData::valueTypeUint8:
+    case FactMetaData::valueTypeInt8:
+    case FactMetaData::valueTypeUint16:
+    case FactMetaData::valueTypeInt16:
+    case FactMetaData::valueTypeUint32:
+    case FactMetaData::valueTypeInt32:
+    case FactMetaData::valueTypeUint64:
+    case FactMetaData::valueTypeInt64:
+    case FactMetaData::valueTypeFloat:
+    case FactMetaData::valueTypeDouble:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool ParameterCacheFile::read(const QString &fileName, Entries &entries, qsizetype *journalRecords)
+{
+    entries.clear();
+    if (journalRecords) {
+        *journalRecords = 0;
+    }
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const QByteArray bytes = file.readAll();
+
+    FileHeader header{};
+    if (bytes.size() < static_cast<qsizetype>(sizeof(header))) {
+        qCWarning(ParameterCacheFileLog) << "Cache file too small" << fileName;
+        return false;
+    }
+    (void) memcpy(&header, bytes.constData(), sizeof(header));
+
+    if ((header.magic != kMagic) || (header.version != kVersion) || (header.entrySize != sizeof(FileEntry))) {
+        qCDebug(ParameterCacheFileLog) << "Unsupported cache file format" << fileName << header.version;
+        return false;
+    }
+
+    const qint64 entryTableSize = static_cast<qint64>(header.entryCount) * sizeof(FileEntry);
+    const qint64 baseSize = static_cast<qint64>(sizeof(header)) + entryTableSize + header.namePoolSize;
+    if (bytes.size() < baseSize) {
+        qCWarning(ParameterCacheFileLog) << "Cache file truncated" << fileName;
+        return false;
+    }
+
+    const char *const entryTable = bytes.constData() + sizeof(header);
+    const char *const namePool = entryTable + entryTableSize;
+
+    entries.reserve(header.entryCount);
+    for (quint32 i = 0; i < header.entryCount; i++) {
+        FileEntry fileEntry{};
+        (void) memcpy(&fileEntry, entryTable + (i * sizeof(FileEntry)), sizeof(fileEntry));
+
+        const FactMetaData::ValueType_t type = static_cast<FactMetaData::ValueType_t>(fileEntry.type);
+        if (((static_cast<qint64>(fileEntry.nameOffset) + fileEntry.nameLength) > header.namePoolSize) || !isSupportedType(type)) {
+            qCWarning(ParameterCacheFileLog) << "Corrupt cache entry" << i << fileName;
+            entries.clear();
+            return false;
+        }
+
+        Entry entry;
+        entry.name = QString::fromLatin1(namePool + fileEntry.nameOffset, fileEntry.nameLength);
+        entry.value.type = type;
+        entry.value.bits = fileEntry.value;
+        entries.append(entry);
+    }
+
+    // Replay the journal. A record cut short by a crash mid append ends the replay.
+    QHash<QString, qsizetype> nameToEntryIndex;
+    bool newNames = false;
+    qsizetype records = 0;
+    qint64 pos = baseSize;
+    while (pos < bytes.size()) {
+        const qint64 remaining = bytes.size() - pos;
+        const char *const record = bytes.constData() + pos;
+        if ((remaining < kJournalRecordOverhead) || (static_cast<quint8>(record[0]) != kJournalRecordMarker)) {
+            break;
+        }
+
+        const qsizetype nameLength = static_cast<quint8>(record[1]);
+        if (remaining < (kJournalRecordOverhead + nameLength)) {
+            break;
+        }
+
+        Value value;
+        value.type = static_cast<FactMetaData::ValueType_t>(static_cast<quint8>(record[2 + nameLength]));
+        if (!value.isValid() || (remaining < static_cast<qint64>(kJournalRecordOverhead + nameLength + value.size()))) {
+            break;
+        }
+        (void) memcpy(&value.bits, record + kJournalRecordOverhead + nameLength, value.size());
+
+        if (nameToEntryIndex.isEmpty()) {
+            nameToEntryIndex.reserve(entries.count());
+            for (qsizetype i = 0; i < entries.count(); i++) {
+                nameToEntryIndex.insert(entries[i].name, i);
+            }
+        }
+
+        const QString name = QString::fromLatin1(record + 2, nameLength);
+        const auto it = nameToEntryIndex.constFind(name);
+        if (it != nameToEntryIndex.cend()) {
+            entries[it.value()].value = value;
+        } else {
+            nameToEntryIndex.insert(name, entries.count());
+            entries.append({ name, value });
+            newNames = true;
+        }
+
+        records++;
+        pos += kJournalRecordOverhead + nameLength + static_cast<qint64>(value.size());
+    }
+
+    if (pos < bytes.size()) {
+        qCWarning(ParameterCacheFileLog) << "Ignoring" << (bytes.size() - pos) << "bytes of incomplete journal in" << fileName;
+    }
+
+    if (newNames) {
+        std::sort(entries.begin(), entries.end(), entryNameLessThan);
+    }
+
+    if (journalRecords) {
+        *journalRecords = records;
+    }
+
+    qCDebug(ParameterCacheFileLog) << "Read" << entries.count() << "parameters," << records << "journal records from" << fileName;
+
+    return true;
+}
+
+bool ParameterCacheFile::write(const QString &fileName, const Entries &entries)
+{
+    Entries sortedEntries;
+    const Entries *source = &entries;
+    if (!std::is_sorted(entries.cbegin(), entries.cend(), entryNameLessThan)) {
+        sortedEntries = entries;
+        std::sort(sortedEntries.begin(), sortedEntries.end(), entryNameLessThan);
+        source = &sortedEntries;
+    }
+
+    QByteArray entryTable;
+    QByteArray namePool;
+    entryTable.reserve(source->count() * sizeof(FileEntry));
+
+    quint32 entryCount = 0;
+    for (const Entry &entry : *source) {
+        const QByteArray name = entry.name.toLatin1();
+        if (!entry.value.isValid() || (name.size() > kMaxNameLength)) {
+            qCWarning(ParameterCacheFileLog) << "Skipping parameter which can not be cached" << entry.name << entry.value.type;
+            continue;
+        }
+
+        FileEntry fileEntry{};
+        fileEntry.nameOffset = static_cast<quint32>(namePool.size());
+        fileEntry.nameLength = static_cast<quint8>(name.size());
+        fileEntry.type = static_cast<quint8>(entry.value.type);
+        fileEntry.value = entry.value.bits;
+
+        (void) entryTable.append(reinterpret_cast<const char*>(&fileEntry), sizeof(fileEntry));
+        (void) namePool.append(name);
+        entryCount++;
+    }
+
+    FileHeader header{};
+    header.magic = kMagic;
+    header.version = kVersion;
+    header.entrySize = sizeof(FileEntry);
+    header.entryCount = entryCount;
+    header.namePoolSize = static_cast<quint32>(namePool.size());
+
+    QByteArray data;
+    data.reserve(sizeof(header) + entryTable.size() + namePool.size());
+    (void) data.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    (void) data.append(entryTable);
+    (void) data.append(namePool);
+
+    if (!QGCFileHelper::atomicWrite(fileName, data)) {
+        qCWarning(ParameterCacheFileLog) << "Failed to write cache file" << fileName;
+        return false;
+    }
+
+    return true;
+}
+
+bool ParameterCacheFile::append(const QString &fileName, const QString &name, const Value &value)
+{
+    const QByteArray latin1Name = name.toLatin1();
+    if (!value.isValid() || (latin1Name.size() > kMaxNameLength)) {
+        return false;
+    }
+
+    QFile file(fileName);
+    if (!file.exists()) {
+        return false;
+    }
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qCWarning(ParameterCacheFileLog) << "Failed to open cache file for append" << fileName << file.errorString();
+        return false;
+    }
+
+    QByteArray record;
+    record.reserve(kJournalRecordOverhead + latin1Name.size() + value.size());
+    (void) record.append(static_cast<char>(kJournalRecordMarker));
+    (void) record.append(static_cast<char>(latin1Name.size()));
+    (void) record.append(latin1Name);
+    (void) record.append(static_cast<char>(value.type));
+    (void) record.append(static_cast<const char*>(value.data()), value.size());
+
+    if (file.write(record) != record.size()) {
+        qCWarning(ParameterCacheFileLog) << "Failed to append to cache file" << fileName << file.errorString();
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QVariant>
+
+#include "FactMetaData.h"
+
+/// On disk cache of the parameter values of one vehicle component, used by the PX4 _HASH_CHECK load.
+///
+/// A file starts with a base image: a header, a table of fixed size typed entries sorted by name and
+/// a pool which holds each name once. Later value changes are appended to the end of the file as
+/// journal records, so updating a single parameter costs one small write no matter how many
+/// parameters the component has. read() replays the journal over the base image, write() replaces
+/// the file with a fresh base image and an empty journal.
+///
+/// Values are stored in host byte order. A cache copied to a machine with the other byte order fails
+/// the magic check and is treated as missing.
+class ParameterCacheFile
+{
+public:
+    /// Parameter value held in its native type
+    struct Value {
+        FactMetaData::ValueType_t type = FactMetaData::valueTypeUint32;
+        union {
+            quint8  u8;
+            qint8   i8;
+            quint16 u16;
+            qint16  i16;
+            quint32 u32;
+            qint32  i32;
+            quint64 u64;
+            qint64  i64;
+            float   f32;
+            double  f64;
+            quint64 bits = 0;
+        };
+
+        /// @return Invalid Value (type valueTypeString) if @p type is not a numeric type
+        static Value fromVariant(FactMetaData::ValueType_t type, const QVariant &variant);
+
+        /// @return Value as a Fact raw value, using the same variant types as PARAM_VALUE decoding
+        QVariant toVariant() const;
+
+        /// Bytes of the value in host order, as fed to the _HASH_CHECK crc
+        const void *data() const { return &bits; }
+        size_t size() const { return FactMetaData::typeToSize(type); }
+
+        bool isValid() const { return isSupportedType(type); }
+
+        bool operator==(const Value &other) const;
+    };
+
+    struct Entry {
+        QString name;
+        Value value;
+    };
+    typedef QList<Entry> Entries;
+
+    /// Loads the base image and replays the journal on top of it
+    ///     @param entries Filled in sorted by name
+    ///     @param journalRecords Optional, set to the number of journal records replayed
+    ///     @return false if the file is missing or its base image is unusable
+    static bool read(const QString &fileName, Entries &entries, qsizetype *journalRecords = nullptr);
+
+    /// Atomically replaces the file with a base image of @p entries and an empty journal
+    static bool write(const QString &fileName, const Entries &entries);
+
+    /// Appends a journal record to an existing cache file. Cost does not depend on the file size.
+    ///     @return false if the file does not exist or could not be written
+    static bool append(const QString &fileName, const QString &name, const Value &value);
+
+    static bool isSupportedType(FactMetaData::ValueType_t type);
+
+    static constexpr quint32 kMagic = 0x33435051;   ///< "QPC3"
+    static constexpr quint16 kVersion = 1;
+};
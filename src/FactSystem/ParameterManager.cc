@@ -39,7 +39,8 @@ ParameterManager::ParameterManager(Vehicle *vehicle)
     , _logReplay(!vehicle->vehicleLinkManager()->primaryLink().expired() && vehicle->vehicleLinkManager()->primaryLink().lock()->isLogReplay())
     , _disableAllRetries(_logReplay)
     , _waitForParamValueAckMs(QGC::runningUnitTests() ? 50 : kWaitForParamValueAckMs)
-    , _tryftp(vehicle->apmFirmware())
+    , _paramRequestWindow(_paramRequestWindowConfig(_waitForParamValueAckMs))
+    , _tryftp(vehicle->firmwarePlugin()->supportsParamFileDownload())
 {
     qCDebug(ParameterManagerLog) << this;
 
@@ -66,6 +67,10 @@ ParameterManager::ParameterManager(Vehicle *vehicle)
         (void) connect(&_waitingParamTimeoutTimer, &QTimer::timeout, this, &ParameterManager::_waitingParamTimeout);
     }
 
+    _paramRequestWindowTimer.setSingleShot(true);
+    (void) connect(&_paramRequestWindowTimer, &QTimer::timeout, this, &ParameterManager::_paramRequestWindowTimeout);
+    _paramRequestClock.start();
+
     // Ensure the cache directory exists
     (void) QDir().mkpath(parameterCacheDir().absolutePath());
 }
@@ -156,13 +161,11 @@ void ParameterManager::_handleParamValue(int componentId, const QString &paramet
     // Used to debug cache crc misses (turn on ParameterManagerDebugCacheFailureLog)
     if (!_initialLoadComplete && !_logReplay && _debugCacheCRC.contains(componentId) && _debugCacheCRC[componentId]) {
         if (_debugCacheMap[componentId].contains(parameterName)) {
-            const ParamTypeVal &cacheParamTypeVal = _debugCacheMap[componentId][parameterName];
-            const size_t dataSize = FactMetaData::typeToSize(static_cast<FactMetaData::ValueType_t>(cacheParamTypeVal.first));
-            const void *const cacheData = cacheParamTypeVal.second.constData();
+            const ParameterCacheFile::Value &cacheValue = _debugCacheMap[componentId][parameterName];
             const void *const vehicleData = parameterValue.constData();
 
-            if (memcmp(cacheData, vehicleData, dataSize) != 0) {
-                qCDebug(ParameterManagerVerbose1Log) << "Cache/Vehicle values differ for name:cache:actual" << parameterName << parameterValue << cacheParamTypeVal.second;
+            if (memcmp(cacheValue.data(), vehicleData, cacheValue.size()) != 0) {
+                qCDebug(ParameterManagerVerbose1Log) << "Cache/Vehicle values differ for name:cache:actual" << parameterName << parameterValue << cacheValue.toVariant();
             }
             _debugCacheParamSeen[componentId][parameterName] = true;
         } else {
@@ -196,8 +199,8 @@ void ParameterManager::_handleParamValue(int componentId, const QString &paramet
     // Remove this parameter from the waiting lists
     if (_waitingReadParamIndexMap[componentId].contains(parameterIndex)) {
         _waitingReadParamIndexMap[componentId].remove(parameterIndex);
-        (void) _indexBatchQueue.removeOne(parameterIndex);
-        _fillIndexBatchQueue(false /* waitingParamTimeout */);
+        (void) _paramRequestWindow.responseReceived(componentId, parameterIndex, _paramRequestClock.elapsed());
+        (void) _fillParamRequestWindow();
     }
 
     // Track how many parameters we are still waiting for
@@ -253,6 +256,9 @@ void ParameterManager::_handleParamValue(int componentId, const QString &paramet
         if (_prevWaitingReadParamIndexCount != 0 && readWaitingParamCount == 0) {
             // All reads just finished, update the cache
             _writeLocalParamCache(_vehicle->id(), componentId);
+        } else if (_initialLoadComplete && readWaitingParamCount == 0) {
+            // Single value update such as a PARAM_SET ack or a refresh
+            _appendLocalParamCache(_vehicle->id(), componentId, fact);
         }
     }
 
@@ -644,6 +650,12 @@ void ParameterManager::_startParameterDownload(uint8_t componentId)
         return;
     }
 
+    // Prefer the bulk FTP download, but only from a vehicle which says it speaks MAVLink FTP
+    if (_tryftp && !(_vehicle->capabilityBits() & MAV_PROTOCOL_CAPABILITY_FTP)) {
+        qCDebug(ParameterManagerLog) << _logVehiclePrefix(-1) << "Vehicle does not advertise MAVLink FTP, using PARAM_REQUEST_LIST";
+        _tryftp = false;
+    }
+
     if (_tryftp && ((componentId == MAV_COMP_ID_ALL) || (componentId == MAV_COMP_ID_AUTOPILOT1))) {
         if (!_initialLoadComplete) {
             _paramRequestListTimer.start();
@@ -675,6 +687,11 @@ void ParameterManager::_startParameterDownload(uint8_t componentId)
             _paramRequestListTimer.start();
         }
 
+        // Missing params are only re-requested once the new stream stalls
+        _paramRequestWindowActive = false;
+        _paramRequestWindow.reset();
+        _paramRequestWindowTimer.stop();
+
         // Reset index wait lists
         for (int cid: _paramCountMap.keys()) {
             // Add/Update all indices to the wait list, parameter index is 0-based
@@ -821,54 +838,98 @@ QStringList ParameterManager::parameterNames(int componentId) const
     return names;
 }
 
-bool ParameterManager::_fillIndexBatchQueue(bool waitingParamTimeout)
+ParameterRequestWindow::Config ParameterManager::_paramRequestWindowConfig(int initialTimeoutMs)
 {
-    if (!_indexBatchQueueActive) {
-        return false;
-    }
-
-    constexpr int maxBatchSize = 10;
+    ParameterRequestWindow::Config config;
+    config.initialTimeoutMs = initialTimeoutMs;
+    config.minTimeoutMs = QGC::runningUnitTests() ? kTestParamRequestReadMinTimeoutMs : kParamRequestReadMinTimeoutMs;
+    config.maxTimeoutMs = QGC::runningUnitTests() ? kTestParamRequestReadMaxTimeoutMs : kParamRequestReadMaxTimeoutMs;
+    return config;
+}
 
-    if (waitingParamTimeout) {
-        // We timed out, clear the queue and try again
-        qCDebug(ParameterManagerLog) << "Refilling index based batch queue due to timeout";
-        _indexBatchQueue.clear();
-    } else {
-        qCDebug(ParameterManagerLog) << "Refilling index based batch queue due to received parameter";
+bool ParameterManager::_fillParamRequestWindow()
+{
+    if (!_paramRequestWindowActive) {
+        return false;
     }
 
     for (const int componentId: _waitingReadParamIndexMap.keys()) {
-        if (_waitingReadParamIndexMap[componentId].count()) {
-            qCDebug(ParameterManagerLog) << _logVehiclePrefix(componentId) << "_waitingReadParamIndexMap count" << _waitingReadParamIndexMap[componentId].count();
-            qCDebug(ParameterManagerVerbose1Log) << _logVehiclePrefix(componentId) << "_waitingReadParamIndexMap" << _waitingReadParamIndexMap[componentId];
-        }
+        QMap<int, int> &waitingIndices = _waitingReadParamIndexMap[componentId];
 
-        for (const int paramIndex: _waitingReadParamIndexMap[componentId].keys()) {
-            if (_indexBatchQueue.contains(paramIndex)) {
-                // Don't add more than once
+        for (auto it = waitingIndices.begin(); (it != waitingIndices.end()) && _paramRequestWindow.canSend();) {
+            const int paramIndex = it.key();
+            if (_paramRequestWindow.isOutstanding(componentId, paramIndex)) {
+                ++it;
                 continue;
             }
 
-            if (_indexBatchQueue.count() > maxBatchSize) {
-                break;
-            }
-
-            _waitingReadParamIndexMap[componentId][paramIndex]++;   // Bump retry count
-            if (_disableAllRetries || (_waitingReadParamIndexMap[componentId][paramIndex] > _maxInitialLoadRetrySingleParam)) {
+            const int requestCount = ++it.value();
+            if (_disableAllRetries || (requestCount > _maxInitialLoadRequestsSingleParam)) {
                 // Give up on this index
                 _failedReadParamIndexMap[componentId] << paramIndex;
-                qCDebug(ParameterManagerLog) << _logVehiclePrefix(componentId) << "Giving up on (paramIndex:" << paramIndex << "retryCount:" << _waitingReadParamIndexMap[componentId][paramIndex] << ")";
-                (void) _waitingReadParamIndexMap[componentId].remove(paramIndex);
-            } else {
-                // Retry again
-                _indexBatchQueue.append(paramIndex);
-                _mavlinkParamRequestRead(componentId, QString(), paramIndex, false /* notifyFailure */);
-                qCDebug(ParameterManagerLog) << _logVehiclePrefix(componentId) << "Read re-request for (paramIndex:" << paramIndex << "retryCount:" << _waitingReadParamIndexMap[componentId][paramIndex] << ")";
+                qCDebug(ParameterManagerLog) << _logVehiclePrefix(componentId) << "Giving up on (paramIndex:" << paramIndex << "requestCount:" << requestCount << ")";
+                it = waitingIndices.erase(it);
+                continue;
             }
+
+            _sendParamRequestReadByIndex(componentId, paramIndex);
+            _paramRequestWindow.requestSent(componentId, paramIndex, _paramRequestClock.elapsed(), requestCount > 1 /* retransmit */);
+            qCDebug(ParameterManagerVerbose1Log) << _logVehiclePrefix(componentId) << "Read re-request for (paramIndex:" << paramIndex << "requestCount:" << requestCount << ")";
+            ++it;
         }
     }
 
-    return (!_indexBatchQueue.isEmpty());
+    _startParamRequestWindowTimer();
+
+    return (_paramRequestWindow.outstandingCount() > 0);
+}
+
+void ParameterManager::_startParamRequestWindowTimer()
+{
+    const qint64 msecs = _paramRequestWindow.msecsToNextExpiry(_paramRequestClock.elapsed());
+    if (msecs < 0) {
+        _paramRequestWindowTimer.stop();
+    } else {
+        _paramRequestWindowTimer.start(static_cast<int>(msecs));
+    }
+}
+
+void ParameterManager::_paramRequestWindowTimeout()
+{
+    const QList<ParameterRequestWindow::Request> expired = _paramRequestWindow.takeExpired(_paramRequestClock.elapsed());
+    if (!expired.isEmpty()) {
+        qCDebug(ParameterManagerLog) << _logVehiclePrefix(-1) << "Index re-requests timed out:" << expired.count()
+                                     << "window:" << _paramRequestWindow.window()
+                                     << "timeout:" << _paramRequestWindow.timeoutMs();
+    }
+
+    // Requests which timed out are sent again, indices out of retries are given up on
+    (void) _fillParamRequestWindow();
+    _updateProgressBar();
+    _checkInitialLoadComplete();
+}
+
+void ParameterManager::_sendParamRequestReadByIndex(int componentId, int paramIndex)
+{
+    const SharedLinkInterfacePtr sharedLink = _vehicle->vehicleLinkManager()->primaryLink().lock();
+    if (!sharedLink) {
+        return;
+    }
+
+    // Empty name, the index selects the param
+    const char paramId[MAVLINK_MSG_PARAM_REQUEST_READ_FIELD_PARAM_ID_LEN + 1] = {};
+
+    mavlink_message_t msg{};
+    (void) mavlink_msg_param_request_read_pack_chan(MAVLinkProtocol::instance()->getSystemId(),
+                                                    MAVLinkProtocol::getComponentId(),
+                                                    sharedLink->mavlinkChannel(),
+                                                    &msg,
+                                                    static_cast<uint8_t>(_vehicle->id()),
+                                                    static_cast<uint8_t>(componentId),
+                                                    paramId,
+                                                    static_cast<int16_t>(paramIndex));
+
+    (void) _vehicle->sendMessageOnLinkThreadSafe(sharedLink.get(), msg);
 }
 
 void ParameterManager::_waitingParamTimeout()
@@ -879,11 +940,14 @@ void ParameterManager::_waitingParamTimeout()
 
     qCDebug(ParameterManagerLog) << _logVehiclePrefix(-1) << "_waitingParamTimeout";
 
-    // Now that we have timed out for possibly the first time we can activate the index batch queue
-    _indexBatchQueueActive = true;
+    // The stream has stalled, from now on missing params are requested through the request window
+    if (!_paramRequestWindowActive) {
+        qCDebug(ParameterManagerLog) << _logVehiclePrefix(-1) << "Starting index based re-requests";
+        _paramRequestWindowActive = true;
+    }
 
     // First check for any missing parameters from the initial index based load
-    bool paramsRequested = _fillIndexBatchQueue(true /* waitingParamTimeout */);
+    const bool paramsRequested = _fillParamRequestWindow();
     if (!paramsRequested && !_waitingForDefaultComponent && !_mapCompId2FactMap.contains(_vehicle->defaultComponentId())) {
         // Initial load is complete but we still don't have any default component params. Wait one more cycle to see if the
         // any show up.
@@ -1051,19 +1115,39 @@ void ParameterManager::_mavlinkParamRequestRead(int componentId, const QString &
 
 void ParameterManager::_writeLocalParamCache(int vehicleId, int componentId)
 {
-    CacheMapName2ParamTypeVal cacheMap;
+    const QMap<QString, Fact*> &factMap = _mapCompId2FactMap[componentId];
 
-    for (const QString &paramName: _mapCompId2FactMap[componentId].keys()) {
-        const Fact *const fact = _mapCompId2FactMap[componentId][paramName];
-        cacheMap[paramName] = ParamTypeVal(fact->type(), fact->rawValue());
+    ParameterCacheFile::Entries entries;
+    entries.reserve(factMap.count());
+    for (auto it = factMap.cbegin(); it != factMap.cend(); ++it) {
+        const Fact *const fact = it.value();
+        entries.append({ it.key(), ParameterCacheFile::Value::fromVariant(fact->type(), fact->rawValue()) });
     }
 
-    QFile cacheFile(parameterCacheFile(vehicleId, componentId));
-    if (cacheFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
-        QDataStream ds(&cacheFile);
-        ds << cacheMap;
+    if (ParameterCacheFile::write(parameterCacheFile(vehicleId, componentId), entries)) {
+        _paramCacheJournalRecords[componentId] = 0;
+        // The QDataStream .v2 cache this replaces is never read again
+        (void) QFile::remove(parameterCacheDir().filePath(QStringLiteral("%1_%2.v2").arg(vehicleId).arg(componentId)));
     } else {
-        qCWarning(ParameterManagerLog) << "Failed to open cache file for writing" << cacheFile.fileName();
+        (void) _paramCacheJournalRecords.remove(componentId);
+    }
+}
+
+void ParameterManager::_appendLocalParamCache(int vehicleId, int componentId, const Fact *fact)
+{
+    // Compact when the journal gets long, or when this session has not written the cache yet and so
+    // does not know how long the journal already is
+    const auto it = _paramCacheJournalRecords.find(componentId);
+    if ((it == _paramCacheJournalRecords.end()) || (it.value() >= _maxParamCacheJournalRecords)) {
+        _writeLocalParamCache(vehicleId, componentId);
+        return;
+    }
+
+    const ParameterCacheFile::Value value = ParameterCacheFile::Value::fromVariant(fact->type(), fact->rawValue());
+    if (ParameterCacheFile::append(parameterCacheFile(vehicleId, componentId), fact->name(), value)) {
+        it.value()++;
+    } else {
+        _writeLocalParamCache(vehicleId, componentId);
     }
 }
 
@@ -1078,17 +1162,16 @@ QDir ParameterManager::parameterCacheDir()
 
 QString ParameterManager::parameterCacheFile(int vehicleId, int componentId)
 {
-    return parameterCacheDir().filePath(QStringLiteral("%1_%2.v2").arg(vehicleId).arg(componentId));
+    return parameterCacheDir().filePath(QStringLiteral("%1_%2.v3").arg(vehicleId).arg(componentId));
 }
 
 void ParameterManager::_tryCacheHashLoad(int vehicleId, int componentId, const QVariant &hashValue)
 {
     qCDebug(ParameterManagerLog) << "Attemping load from cache";
 
-    /* The datastructure of the cache table */
-    CacheMapName2ParamTypeVal cacheMap;
-    QFile cacheFile(parameterCacheFile(vehicleId, componentId));
-    if (!cacheFile.exists()) {
+    const QString cacheFileName = parameterCacheFile(vehicleId, componentId);
+    ParameterCacheFile::Entries cacheEntries;
+    if (!ParameterCacheFile::read(cacheFileName, cacheEntries)) {
         qCDebug(ParameterManagerLog) << "No parameter cache file";
         if (!_hashCheckDone) {
             _hashCheckDone = true;
@@ -1103,26 +1186,18 @@ void ParameterManager::_tryCacheHashLoad(int vehicleId, int componentId, const Q
         // If already in PARAM_REQUEST_LIST flow, just let the stream continue
         return;
     }
-    (void) cacheFile.open(QIODevice::ReadOnly);
-
-    /* Deserialize the parameter cache table */
-    QDataStream ds(&cacheFile);
-    ds >> cacheMap;
 
     /* compute the crc of the local cache to check against the remote */
     uint32_t crc32_value = 0;
-    for (const QString &name: cacheMap.keys()) {
-        const ParamTypeVal &paramTypeVal = cacheMap[name];
-        const FactMetaData::ValueType_t factType = static_cast<FactMetaData::ValueType_t>(paramTypeVal.first);
+    for (const ParameterCacheFile::Entry &entry: cacheEntries) {
+        const QString &name = entry.name;
 
-        if (_vehicle->compInfoManager()->compInfoParam(MAV_COMP_ID_AUTOPILOT1)->factMetaDataForName(name, factType)->volatileValue()) {
+        if (_vehicle->compInfoManager()->compInfoParam(MAV_COMP_ID_AUTOPILOT1)->factMetaDataForName(name, entry.value.type)->volatileValue()) {
             // Does not take part in CRC
             qCDebug(ParameterManagerLog) << "Volatile parameter" << name;
         } else {
-            const void *const vdat = paramTypeVal.second.constData();
-            const FactMetaData::ValueType_t cacheFactType = static_cast<FactMetaData::ValueType_t>(paramTypeVal.first);
             crc32_value = QGC::crc32(reinterpret_cast<const uint8_t *>(qPrintable(name)), name.length(),  crc32_value);
-            crc32_value = QGC::crc32(static_cast<const uint8_t *>(vdat), FactMetaData::typeToSize(cacheFactType), crc32_value);
+            crc32_value = QGC::crc32(static_cast<const uint8_t *>(entry.value.data()), entry.value.size(), crc32_value);
         }
     }
 
@@ -1130,15 +1205,12 @@ void ParameterManager::_tryCacheHashLoad(int vehicleId, int componentId, const Q
     if (crc32_value == hashValue.toUInt()) {
         _hashCheckDone = true;
         _paramRequestListTimer.stop();
-        qCDebug(ParameterManagerLog) << "Parameters loaded from cache" << qPrintable(QFileInfo(cacheFile).absoluteFilePath());
+        qCDebug(ParameterManagerLog) << "Parameters loaded from cache" << qPrintable(QFileInfo(cacheFileName).absoluteFilePath());
 
-        const int count = cacheMap.count();
+        const int count = cacheEntries.count();
         int index = 0;
-        for (const QString &name: cacheMap.keys()) {
-            const ParamTypeVal &paramTypeVal = cacheMap[name];
-            const FactMetaData::ValueType_t factType = static_cast<FactMetaData::ValueType_t>(paramTypeVal.first);
-            const MAV_PARAM_TYPE mavParamType = factTypeToMavType(factType);
-            _handleParamValue(componentId, name, count, index++, mavParamType, paramTypeVal.second);
+        for (const ParameterCacheFile::Entry &entry: cacheEntries) {
+            _handleParamValue(componentId, entry.name, count, index++, factTypeToMavType(entry.value.type), entry.value.toVariant());
         }
 
         const SharedLinkInterfacePtr sharedLink = _vehicle->vehicleLinkManager()->primaryLink().lock();
@@ -1183,12 +1255,13 @@ void ParameterManager::_tryCacheHashLoad(int vehicleId, int componentId, const Q
 
         ani->start(QAbstractAnimation::DeleteWhenStopped);
     } else {
-        qCDebug(ParameterManagerLog) << "Parameters cache match failed" << qPrintable(QFileInfo(cacheFile).absoluteFilePath());
+        qCDebug(ParameterManagerLog) << "Parameters cache match failed" << qPrintable(QFileInfo(cacheFileName).absoluteFilePath());
         if (ParameterManagerDebugCacheFailureLog().isDebugEnabled()) {
             _debugCacheCRC[componentId] = true;
-            _debugCacheMap[componentId] = cacheMap;
-            for (const QString &name: cacheMap.keys()) {
-                _debugCacheParamSeen[componentId][name] = false;
+            _debugCacheMap[componentId].clear();
+            for (const ParameterCacheFile::Entry &entry: cacheEntries) {
+                _debugCacheMap[componentId][entry.name] = entry.value;
+                _debugCacheParamSeen[componentId][entry.name] = false;
             }
             QGC::showAppMessage(tr("Parameter cache CRC match failed"));
         }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
 #include <QtCore/QMap>
 #include <QtCore/QObject>
 #include <QtCore/QString>
@@ -8,6 +10,8 @@
 
 #include "Fact.h"
 #include "MAVLinkEnums.h"
+#include "ParameterCacheFile.h"
+#include "ParameterRequestWindow.h"
 #include "QGCMAVLinkTypes.h"
 
 class QTextStream;
@@ -109,6 +113,10 @@ class ParameterManager : public QObject
     static constexpr int kParamSetRetryCount = 2;                   ///< Number of retries for PARAM_SET
     static constexpr int kParamRequestReadRetryCount = 2;           ///< Number of retries for PARAM_REQUEST_READ
     static constexpr int kWaitForParamValueAckMs = 1000;            ///< Time to wait for param value ack after set param
+    static constexpr int kParamRequestReadMinTimeoutMs = 250;       ///< Lower bound of the round trip based timeout for missing param re-requests
+    static constexpr int kParamRequestReadMaxTimeoutMs = 3000;      ///< Upper bound of the round trip based timeout, including backoff
+    static constexpr int kTestParamRequestReadMinTimeoutMs = 25;    ///< Lower bound in unit tests (MockLink responds instantly)
+    static constexpr int kTestParamRequestReadMaxTimeoutMs = 400;   ///< Upper bound in unit tests
     static constexpr int kMaxInitialRequestListRetry = 4;           ///< Maximum retries for initial parameter request list
     static constexpr int kHashCheckTimeoutMs = 1000;                ///< Timeout for standalone _HASH_CHECK request
     static constexpr int kTestHashCheckTimeoutMs = 200;             ///< Shortened _HASH_CHECK timeout in unit tests (MockLink responds instantly)
@@ -152,6 +160,8 @@ private slots:
     void _mavlinkParamRequestRead(int componentId, const QString &paramName, int paramIndex, bool notifyFailure);
     void _requestHashCheck(uint8_t componentId);
     void _writeLocalParamCache(int vehicleId, int componentId);
+    /// Records a single value change in the cache journal, compacting the cache when the journal is long
+    void _appendLocalParamCache(int vehicleId, int componentId, const Fact *fact);
     void _tryCacheHashLoad(int vehicleId, int componentId, const QVariant &hashValue);
     void _loadMetaData();
     void _clearMetaData();
@@ -170,10 +180,15 @@ private slots:
     void _loadOfflineEditingParams();
     QString _logVehiclePrefix(int componentId) const;
     void _setLoadProgress(double loadProgress);
-    /// Requests missing index based parameters from the vehicle.
-    ///     @param waitingParamTimeout: true: being called due to timeout, false: being called to re-fill the batch queue
-    /// return true: Parameters were requested, false: No more requests needed
-    bool _fillIndexBatchQueue(bool waitingParamTimeout);
+    /// Requests missing index based parameters from the vehicle, as many as the request window allows.
+    /// return true: Requests are outstanding, false: No more requests needed
+    bool _fillParamRequestWindow();
+    /// Called when outstanding index based requests time out
+    void _paramRequestWindowTimeout();
+    void _startParamRequestWindowTimer();
+    /// Sends a single PARAM_REQUEST_READ by index. Retries are handled by the request window, not a state machine.
+    void _sendParamRequestReadByIndex(int componentId, int paramIndex);
+    static ParameterRequestWindow::Config _paramRequestWindowConfig(int initialTimeoutMs);
     void _updateProgressBar();
     void _checkInitialLoadComplete();
     void _ftpDownloadComplete(const QString &fileName, const QString &errorMsg);
@@ -202,13 +217,13 @@ private slots:
     bool _hashCheckDone = false;                ///< true: _HASH_CHECK has been attempted, go straight to PARAM_REQUEST_LIST
     bool _cacheOnlyHashCheck = false;           ///< true: current hash check is cache-only, don't fall back to full download
 
-    typedef QPair<int /* FactMetaData::ValueType_t */, QVariant /* Fact::rawValue */> ParamTypeVal;
-    typedef QMap<QString /* parameter name */, ParamTypeVal> CacheMapName2ParamTypeVal;
-
     QMap<int /* component id */, bool> _debugCacheCRC; ///< true: debug cache crc failure
-    QMap<int /* component id */, CacheMapName2ParamTypeVal> _debugCacheMap;
+    QMap<int /* component id */, QHash<QString /* param name */, ParameterCacheFile::Value>> _debugCacheMap;
     QMap<int /* component id */, QMap<QString /* param name */, bool /* seen */>> _debugCacheParamSeen;
 
+    QMap<int /* component id */, qsizetype> _paramCacheJournalRecords;     ///< Journal records appended since the cache was last compacted
+    static constexpr qsizetype _maxParamCacheJournalRecords = 256;
+
     // Wait counts from previous parameter update cycle
     int _prevWaitingReadParamIndexCount = 0;
 
@@ -216,15 +231,17 @@ private slots:
 
     static constexpr int _maxInitialRequestListRetry = kMaxInitialRequestListRetry;
     int _initialRequestRetryCount = 0;                          ///< Current retry count for request list
-    static constexpr int _maxInitialLoadRetrySingleParam = 5;   ///< Maximum retries for initial index based load of a single param
+    static constexpr int _maxInitialLoadRequestsSingleParam = 10;   ///< Maximum PARAM_REQUEST_READs for a single param during the initial index based load
     bool _disableAllRetries = false;                            ///< true: Don't retry any requests (used for testing and logReplay)
     const int _waitForParamValueAckMs;                          ///< 50 ms in unit tests, kWaitForParamValueAckMs otherwise
 
-    bool _indexBatchQueueActive = false;    ///< true: we are actively batching re-requests for missing index base params, false: index based re-request has not yet started
-    QList<int> _indexBatchQueue;            ///< The current queue of index re-requests
+    bool _paramRequestWindowActive = false; ///< true: we are actively re-requesting missing index based params, false: index based re-request has not yet started
+    ParameterRequestWindow _paramRequestWindow;
+    QElapsedTimer _paramRequestClock;       ///< Time base for the request window
+    QTimer _paramRequestWindowTimer;        ///< Fires when the next outstanding index based request times out
 
     QMap<int, int> _paramCountMap;                              ///< Key: Component id, Value: count of parameters in this component
-    QMap<int, QMap<int, int>> _waitingReadParamIndexMap;        ///< Key: Component id, Value: Map { Key: parameter index still waiting for, Value: retry count }
+    QMap<int, QMap<int, int>> _waitingReadParamIndexMap;        ///< Key: Component id, Value: Map { Key: parameter index still waiting for, Value: request count }
     QMap<int, QList<int>> _failedReadParamIndexMap;             ///< Key: Component id, Value: failed parameter index
 
     int _totalParamCount = 0;                   ///< Number of parameters across all components
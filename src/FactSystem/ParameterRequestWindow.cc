@@ -0,0 +1,144 @@
+#include "ParameterRequestWindow.h"
+
+#include <QtCore/QtMath>
+
+#include <limits>
+
+#include "QGCLoggingCategory.h"
+
+QGC_LOGGING_CATEGORY(ParameterRequestWindowLog, "FactSystem.ParameterRequestWindow")
+
+ParameterRequestWindow::ParameterRequestWindow(const Config &config)
+    : _config(config)
+{
+    reset();
+}
+
+void ParameterRequestWindow::reset()
+{
+    _outstanding.clear();
+    _window = qBound(1, _config.initialWindow, _config.maxWindow);
+    _slowStartThreshold = _config.maxWindow;
+    _smoothedRttMs = -1;
+    _rttVarianceMs = 0;
+    _backoffShift = 0;
+    _responseSinceTimeout = true;
+    _recoveryStartMs = -1;
+    _stats = Stats();
+}
+
+int ParameterRequestWindow::timeoutMs() const
+{
+    double timeoutMs = _config.initialTimeoutMs;
+    if (_smoothedRttMs >= 0) {
+        timeoutMs = _smoothedRttMs + (kRttVarianceMultiplier * _rttVarianceMs);
+    }
+    timeoutMs = qBound(static_cast<double>(_config.minTimeoutMs), timeoutMs, static_cast<double>(_config.maxTimeoutMs));
+
+    return qMin(qCeil(timeoutMs) << _backoffShift, _config.maxTimeoutMs);
+}
+
+void ParameterRequestWindow::requestSent(int componentId, int paramIndex, qint64 nowMs, bool retransmit)
+{
+    Outstanding outstanding;
+    outstanding.sentMs = nowMs;
+    outstanding.deadlineMs = nowMs + timeoutMs();
+    outstanding.retransmit = retransmit;
+    _outstanding.insert(_key(componentId, paramIndex), outstanding);
+
+    _stats.sent++;
+    if (retransmit) {
+        _stats.retransmits++;
+    }
+}
+
+bool ParameterRequestWindow::responseReceived(int componentId, int paramIndex, qint64 nowMs)
+{
+    const auto it = _outstanding.constFind(_key(componentId, paramIndex));
+    if (it == _outstanding.cend()) {
+        return false;
+    }
+
+    if (!it->retransmit) {
+        _addRttSample(nowMs - it->sentMs);
+    }
+    _outstanding.erase(it);
+
+    _stats.responses++;
+    _backoffShift = 0;
+    _responseSinceTimeout = true;
+
+    if (_window < _slowStartThreshold) {
+        _window += 1;
+    } else {
+        _window += 1 / _window;
+    }
+    _window = qMin(_window, static_cast<double>(_config.maxWindow));
+
+    return true;
+}
+
+QList<ParameterRequestWindow::Request> ParameterRequestWindow::takeExpired(qint64 nowMs)
+{
+    QList<Request> expired;
+    bool chargeLoss = false;
+
+    for (auto it = _outstanding.begin(); it != _outstanding.end();) {
+        if (it->deadlineMs > nowMs) {
+            ++it;
+            continue;
+        }
+
+        if (it->sentMs > _recoveryStartMs) {
+            chargeLoss = true;
+        }
+        expired.append(_request(it.key()));
+        it = _outstanding.erase(it);
+    }
+
+    if (expired.isEmpty()) {
+        return expired;
+    }
+    _stats.timeouts += expired.count();
+
+    if (chargeLoss) {
+        _slowStartThreshold = qMax(1., _window / 2);
+        _window = _slowStartThreshold;
+        _recoveryStartMs = nowMs;
+    }
+
+    // Nothing came back since the last timeout, the link may be gone or much slower than estimated
+    if (!_responseSinceTimeout) {
+        _backoffShift = qMin(_backoffShift + 1, kMaxBackoffShift);
+    }
+    _responseSinceTimeout = false;
+
+    qCDebug(ParameterRequestWindowLog) << "timeouts:" << expired.count() << "window:" << window() << "ssthresh:" << slowStartThreshold() << "timeout:" << timeoutMs();
+
+    return expired;
+}
+
+qint64 ParameterRequestWindow::msecsToNextExpiry(qint64 nowMs) const
+{
+    if (_outstanding.isEmpty()) {
+        return -1;
+    }
+
+    qint64 nextDeadlineMs = std::numeric_limits<qint64>::max();
+    for (const Outstanding &outstanding : _outstanding) {
+        nextDeadlineMs = qMin(nextDeadlineMs, outstanding.deadlineMs);
+    }
+
+    return qMax(qint64(0), nextDeadlineMs - nowMs);
+}
+
+void ParameterRequestWindow::_addRttSample(qint64 rttMs)
+{
+    if (_smoothedRttMs < 0) {
+        _smoothedRttMs = rttMs;
+        _rttVarianceMs = rttMs / 2.;
+    } else {
+        _rttVarianceMs += kRttVarianceGain * (qAbs(_smoothedRttMs - rttMs) - _rttVarianceMs);
+        _smoothedRttMs += kRttGain * (rttMs - _smoothedRttMs);
+    }
+}
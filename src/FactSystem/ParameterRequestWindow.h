@@ -0,0 +1,97 @@
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+
+#include <utility>
+
+/// Flow control for the index based PARAM_REQUEST_READs which fill the gaps left by a PARAM_REQUEST_LIST stream.
+///
+/// Works like TCP congestion control: up to window() requests are outstanding at once. The window grows
+/// by one per response while below the slow start threshold and by about one per window of responses
+/// above it. Requests which time out count as lost and halve the window, at most once per window of
+/// requests so a burst of losses is only charged once. The timeout is derived from the smoothed round
+/// trip time and its variance (RFC 6298) and doubles on consecutive timeouts until a response arrives.
+/// Round trip times are only sampled from requests which were sent once (Karn's algorithm).
+///
+/// Time is passed in by the caller so the class has no timers of its own.
+class ParameterRequestWindow
+{
+public:
+    struct Config {
+        int initialTimeoutMs = 1000;    ///< Timeout used until the first round trip sample
+        int minTimeoutMs = 250;
+        int maxTimeoutMs = 3000;
+        int initialWindow = 4;
+        int maxWindow = 32;
+    };
+
+    struct Stats {
+        quint64 sent = 0;
+        quint64 retransmits = 0;        ///< Requests for an index which was requested before
+        quint64 responses = 0;          ///< Responses which matched an outstanding request
+        quint64 timeouts = 0;
+    };
+
+    typedef std::pair<int /* component id */, int /* param index */> Request;
+
+    explicit ParameterRequestWindow(const Config &config);
+
+    /// Drops all outstanding requests and starts over with the initial window and timeout
+    void reset();
+
+    /// @return true: another request can be sent without exceeding the window
+    bool canSend() const { return _outstanding.count() < window(); }
+    bool isOutstanding(int componentId, int paramIndex) const { return _outstanding.contains(_key(componentId, paramIndex)); }
+    qsizetype outstandingCount() const { return _outstanding.count(); }
+
+    /// Records a request sent at @p nowMs
+    ///     @param retransmit true: the index was requested before, its response does not yield a round trip sample
+    void requestSent(int componentId, int paramIndex, qint64 nowMs, bool retransmit);
+
+    /// Records the response to a request and opens the window
+    ///     @return false if the request was not outstanding
+    bool responseReceived(int componentId, int paramIndex, qint64 nowMs);
+
+    /// Removes the requests which timed out by @p nowMs and shrinks the window for the loss
+    QList<Request> takeExpired(qint64 nowMs);
+
+    /// @return Time until the next outstanding request times out, 0 if one is already due, -1 if nothing is outstanding
+    qint64 msecsToNextExpiry(qint64 nowMs) const;
+
+    int window() const { return static_cast<int>(_window); }
+    int slowStartThreshold() const { return static_cast<int>(_slowStartThreshold); }
+    /// @return Timeout applied to the next request, including any backoff
+    int timeoutMs() const;
+    /// @return Smoothed round trip time, -1 before the first sample
+    double smoothedRttMs() const { return _smoothedRttMs; }
+    Stats stats() const { return _stats; }
+
+private:
+    struct Outstanding {
+        qint64 sentMs = 0;
+        qint64 deadlineMs = 0;
+        bool retransmit = false;
+    };
+
+    static quint32 _key(int componentId, int paramIndex) { return (static_cast<quint32>(componentId & 0xFF) << 16) | static_cast<quint16>(paramIndex); }
+    static Request _request(quint32 key) { return { static_cast<int>(key >> 16), static_cast<int>(key & 0xFFFF) }; }
+
+    void _addRttSample(qint64 rttMs);
+
+    Config _config;
+    QHash<quint32, Outstanding> _outstanding;
+    double _window = 0;
+    double _slowStartThreshold = 0;
+    double _smoothedRttMs = -1;
+    double _rttVarianceMs = 0;
+    int _backoffShift = 0;              ///< Timeout doubles per consecutive timeout
+    bool _responseSinceTimeout = true;
+    qint64 _recoveryStartMs = -1;       ///< Time the window was last shrunk, losses of older requests are not charged again
+    Stats _stats;
+
+    static constexpr double kRttGain = 0.125;           ///< RFC 6298 alpha
+    static constexpr double kRttVarianceGain = 0.25;    ///< RFC 6298 beta
+    static constexpr int kRttVarianceMultiplier = 4;    ///< RFC 6298 K
+    static constexpr int kMaxBackoffShift = 6;
+};
@@ -37,6 +37,7 @@ class APMFirmwarePlugin : public FirmwarePlugin
     QString flightMode(uint8_t base_mode, uint32_t custom_mode) const override;
     bool setFlightMode(const QString &flightMode, uint8_t *base_mode, uint32_t *custom_mode) const override;
     bool MAV_CMD_DO_SET_MODE_is_supported() const override { return true; }
+    bool supportsParamFileDownload() const override { return true; }
     bool isGuidedMode(const Vehicle *vehicle) const override;
     QString gotoFlightMode() const override { return guidedFlightMode(); }
     QString rtlFlightMode() const override;
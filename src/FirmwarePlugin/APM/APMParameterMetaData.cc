@@ -28,8 +28,10 @@ QString APMParameterMetaData::_groupFromParameterName(const QString &name)
     return group.remove(regex);
 }
 
-void APMParameterMetaData::parseParameterJson(const QJsonObject &json)
+QMap<QString, QCborMap> APMParameterMetaData::compileParameterJson(const QJsonObject &json)
 {
+    QHash<QString, RawParamData> rawParams;
+
     for (auto groupIt = json.constBegin(); groupIt != json.constEnd(); ++groupIt) {
         if (!groupIt->isObject()) {
             continue;
@@ -45,44 +47,49 @@ void APMParameterMetaData::parseParameterJson(const QJsonObject &json)
             const QString name = paramIt.key();
             const QString group = _groupFromParameterName(name);
 
-            if (_rawParams.contains(name)) {
+            if (rawParams.contains(name)) {
                 qCWarning(APMParameterMetaDataLog) << "Duplicate parameter found:" << name;
             }
 
-            _rawParams[name] = RawParamData{group, paramIt->toObject()};
+            rawParams[name] = RawParamData{group, paramIt->toObject()};
         }
     }
 
-    _correctGroupMemberships();
+    _correctGroupMemberships(rawParams);
+
+    QMap<QString, QCborMap> records;
+    for (auto it = rawParams.cbegin(); it != rawParams.cend(); ++it) {
+        QCborMap record;
+        record[QLatin1String(kGroupRecordKey)] = it->group;
+        record[QLatin1String(kFieldsRecordKey)] = QCborMap::fromJsonObject(it->fields);
+        records[it.key()] = record;
+    }
+
+    return records;
 }
 
-void APMParameterMetaData::_correctGroupMemberships()
+void APMParameterMetaData::_correctGroupMemberships(QHash<QString, RawParamData> &rawParams)
 {
     // Demote groups with only one member to the default group.
     QHash<QString, int> groupCount;
-    for (const auto &raw : std::as_const(_rawParams)) {
+    for (const auto &raw : std::as_const(rawParams)) {
         groupCount[raw.group]++;
     }
-    for (auto &raw : _rawParams) {
+    for (auto &raw : rawParams) {
         if (groupCount.value(raw.group) == 1) {
             raw.group = FactMetaData::defaultGroup();
         }
     }
 }
 
-FactMetaData *APMParameterMetaData::_lookupMetaData(const QString &name, FactMetaData::ValueType_t type)
+FactMetaData *APMParameterMetaData::_createMetaDataFromRecord(const QString &name, FactMetaData::ValueType_t type, const QCborMap &record)
 {
-    auto it = _rawParams.constFind(name);
-    if (it == _rawParams.constEnd()) {
-        return nullptr;
-    }
-
-    const RawParamData &raw = *it;
-    const QJsonObject &f = raw.fields;
+    const QString group = record.value(QLatin1String(kGroupRecordKey)).toString();
+    const QJsonObject f = record.value(QLatin1String(kFieldsRecordKey)).toMap().toJsonObject();
 
     auto *metaData = new FactMetaData(type, this);
     metaData->setName(name);
-    metaData->setGroup(raw.group);
+    metaData->setGroup(group);
 
     const QString displayName = f.value(u"DisplayName").toString();
     if (!displayName.isEmpty()) {
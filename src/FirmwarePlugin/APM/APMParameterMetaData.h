@@ -11,8 +11,9 @@ class APMParameterMetaData : public ParameterMetaData
     ~APMParameterMetaData() override;
 
 protected:
-    void parseParameterJson(const QJsonObject &json) override;
-    FactMetaData *_lookupMetaData(const QString &name, FactMetaData::ValueType_t type) override;
+    QMap<QString, QCborMap> compileParameterJson(const QJsonObject &json) override;
+    FactMetaData *_createMetaDataFromRecord(const QString &name, FactMetaData::ValueType_t type, const QCborMap &record) override;
+    QString _compiledCacheTag() const override { return QStringLiteral("APM"); }
     FactMetaData *_createDefaultMetaData(const QString &name, FactMetaData::ValueType_t type) override;
     void _postProcessMetaData(const QString &name, FactMetaData *metaData) override;
 
@@ -22,11 +23,12 @@ class APMParameterMetaData : public ParameterMetaData
         QJsonObject fields;
     };
 
-    void _correctGroupMemberships();
+    static void _correctGroupMemberships(QHash<QString, RawParamData> &rawParams);
     static QString _groupFromParameterName(const QString &name);
     static QList<ValueDescPair> _sortedNumericPairs(const QJsonObject &obj, const QString &paramName);
     static void _applyEnumValues(FactMetaData *metaData, const QJsonObject &valuesObj);
     static void _applyBitmask(FactMetaData *metaData, const QJsonObject &bitmaskObj);
 
-    QHash<QString, RawParamData> _rawParams;
+    static constexpr const char *kGroupRecordKey = "group";
+    static constexpr const char *kFieldsRecordKey = "fields";
 };
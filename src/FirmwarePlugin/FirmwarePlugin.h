@@ -275,6 +275,12 @@ class FirmwarePlugin : public QObject
     /// (CompassMot). Default is true.
     virtual bool supportsMotorInterference() const { return true; }
 
+    /// Returns true if the firmware serves its parameters as a single file over MAVLink FTP
+    /// (@PARAM/param.pck), which loads them in one bulk transfer instead of a PARAM_VALUE per
+    /// parameter. Only used when the vehicle also advertises MAV_PROTOCOL_CAPABILITY_FTP.
+    /// Default is false.
+    virtual bool supportsParamFileDownload() const { return false; }
+
     /// Called before any mavlink message is processed by Vehicle such that the firmwre plugin
     /// can adjust any message characteristics. This is handy to adjust or differences in mavlink
     /// spec implementations such that the base code can remain mavlink generic.
@@ -19,12 +19,14 @@ PX4ParameterMetaData::~PX4ParameterMetaData()
     qCDebug(PX4ParameterMetaDataLog) << this;
 }
 
-void PX4ParameterMetaData::parseParameterJson(const QJsonObject &json)
+QMap<QString, QCborMap> PX4ParameterMetaData::compileParameterJson(const QJsonObject &json)
 {
+    QMap<QString, QCborMap> records;
+
     const int version = json.value(u"version").toInt();
     if (version < 1) {
         qCWarning(PX4ParameterMetaDataLog) << "Parameter JSON version too old:" << version;
-        return;
+        return records;
     }
 
     const QJsonArray parameters = json.value(u"parameters").toArray();
@@ -40,20 +42,37 @@ void PX4ParameterMetaData::parseParameterJson(const QJsonObject &json)
             continue;
         }
 
-        if (_cachedMetaData.contains(name)) {
+        if (records.remove(name) > 0) {
             qCWarning(PX4ParameterMetaDataLog) << "Duplicate parameter:" << name;
-            _cachedMetaData.take(name)->deleteLater();
         }
 
-        FactMetaData *metaData = FactMetaData::createFromJsonObject(param, kEmptyDefines, this);
-        if (metaData->name().isEmpty()) {
+        // Parsed once here only to validate, the record is materialised again on demand
+        const FactMetaData *const metaData = FactMetaData::createFromJsonObject(param, kEmptyDefines, nullptr);
+        const bool valid = !metaData->name().isEmpty();
+        delete metaData;
+        if (!valid) {
             qCWarning(PX4ParameterMetaDataLog) << "Skipping invalid parameter metadata:" << name;
-            metaData->deleteLater();
             continue;
         }
-        _postProcessMetaData(name, metaData); // applied here; getMetaDataForFact() hits cache so won't re-apply
-        _cachedMetaData[name] = metaData;
+
+        records[name] = QCborMap::fromJsonObject(param);
     }
+
+    return records;
+}
+
+FactMetaData *PX4ParameterMetaData::_createMetaDataFromRecord(const QString &name, FactMetaData::ValueType_t type, const QCborMap &record)
+{
+    Q_UNUSED(type)
+
+    FactMetaData *const metaData = FactMetaData::createFromJsonObject(record.toJsonObject(), kEmptyDefines, this);
+    if (metaData->name() != name) {
+        qCWarning(PX4ParameterMetaDataLog) << "Invalid compiled parameter metadata:" << name;
+        metaData->deleteLater();
+        return nullptr;
+    }
+
+    return metaData;
 }
 
 void PX4ParameterMetaData::_postProcessMetaData(const QString &name, FactMetaData *metaData)
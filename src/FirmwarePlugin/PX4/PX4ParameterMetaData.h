@@ -11,6 +11,8 @@ class PX4ParameterMetaData : public ParameterMetaData
     ~PX4ParameterMetaData() override;
 
 protected:
-    void parseParameterJson(const QJsonObject &json) override;
+    QMap<QString, QCborMap> compileParameterJson(const QJsonObject &json) override;
+    FactMetaData *_createMetaDataFromRecord(const QString &name, FactMetaData::ValueType_t type, const QCborMap &record) override;
+    QString _compiledCacheTag() const override { return QStringLiteral("PX4"); }
     void _postProcessMetaData(const QString &name, FactMetaData *metaData) override;
 };
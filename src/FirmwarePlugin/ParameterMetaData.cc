@@ -1,17 +1,32 @@
 #include "ParameterMetaData.h"
+#include "AppMessages.h"
 #include "JsonParsing.h"
 #include "QGCCompression.h"
+#include "QGCFileHelper.h"
 #include "QGCLoggingCategory.h"
 
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 #include <QtCore/QRegularExpression>
+#include <QtCore/QStandardPaths>
 #include <QtCore/QThread>
 
 QGC_LOGGING_CATEGORY(ParameterMetaDataLog, "FirmwarePlugin.ParameterMetaData")
 
 const FactMetaData::DefineMap_t ParameterMetaData::kEmptyDefines;
 
+namespace {
+
+QString s_compiledCacheDir;
+bool s_compiledCacheDirSet = false;
+
+} // namespace
+
 ParameterMetaData::ParameterMetaData(QObject *parent)
     : QObject(parent)
 {
@@ -37,9 +52,36 @@ void ParameterMetaData::loadParameterFactMetaDataFile(const QString &metaDataFil
 
     qCDebug(ParameterMetaDataLog) << "Loading parameter meta data:" << metaDataFile;
 
-    QJsonDocument doc;
+    QElapsedTimer timer;
+    timer.start();
+
     QString errorString;
-    if (!JsonParsing::isJsonFile(metaDataFile, doc, errorString)) {
+    const QByteArray jsonBytes = QGCCompression::readFile(metaDataFile, &errorString);
+    if (jsonBytes.isEmpty() && !errorString.isEmpty()) {
+        qCWarning(ParameterMetaDataLog) << "Unable to open parameter meta data file:" << metaDataFile << errorString;
+        return;
+    }
+
+    // Compiled files are keyed by content so a changed metadata file is never served from a stale compile
+    const QString cacheDir = compiledCacheDir();
+    const QString compiledFilePrefix = QStringLiteral("%1_%2_").arg(_compiledCacheTag(), QFileInfo(metaDataFile).completeBaseName());
+    QString compiledFile;
+    if (!cacheDir.isEmpty()) {
+        QCryptographicHash hash(QCryptographicHash::Sha256);
+        hash.addData(QByteArray::number(ParameterMetaDataCache::kFormatVersion));
+        hash.addData(jsonBytes);
+        compiledFile = QDir(cacheDir).filePath(QStringLiteral("%1%2.%3").arg(compiledFilePrefix, QString::fromLatin1(hash.result().toHex()), QLatin1String(kCompiledFileExtension)));
+
+        if (QFile::exists(compiledFile) && _compiledMetaData.open(compiledFile)) {
+            _parameterMetaDataLoaded = true;
+            _loadedFromCompiledCache = true;
+            qCDebug(ParameterMetaDataLog) << "Mapped compiled parameter meta data:" << compiledFile << "params:" << _compiledMetaData.count() << "ms:" << timer.elapsed();
+            return;
+        }
+    }
+
+    QJsonDocument doc;
+    if (!JsonParsing::isJsonFile(jsonBytes, doc, errorString)) {
         qCWarning(ParameterMetaDataLog) << "Unable to open parameter meta data file:" << metaDataFile << errorString;
         return;
     }
@@ -49,7 +91,60 @@ void ParameterMetaData::loadParameterFactMetaDataFile(const QString &metaDataFil
     }
 
     _parameterMetaDataLoaded = true;
-    parseParameterJson(doc.object());
+
+    const QByteArray compiled = ParameterMetaDataCache::build(compileParameterJson(doc.object()));
+    if (!compiledFile.isEmpty()) {
+        if (QGCFileHelper::ensureDirectoryExists(cacheDir) && QGCFileHelper::atomicWrite(compiledFile, compiled) && _compiledMetaData.open(compiledFile)) {
+            qCDebug(ParameterMetaDataLog) << "Compiled parameter meta data:" << compiledFile << "params:" << _compiledMetaData.count() << "ms:" << timer.elapsed();
+            _removeStaleCompiledFiles(cacheDir, compiledFilePrefix, compiledFile);
+            return;
+        }
+        qCWarning(ParameterMetaDataLog) << "Unable to cache compiled parameter meta data:" << compiledFile;
+    }
+
+    (void) _compiledMetaData.setData(compiled);
+    qCDebug(ParameterMetaDataLog) << "Compiled parameter meta data in memory, params:" << _compiledMetaData.count() << "ms:" << timer.elapsed();
+}
+
+void ParameterMetaData::_removeStaleCompiledFiles(const QString &cacheDir, const QString &compiledFilePrefix, const QString &currentFile)
+{
+    // Compiles of older versions of the same metadata file are never read again
+    const QString suffix = QStringLiteral(".%1").arg(QLatin1String(kCompiledFileExtension));
+    constexpr qsizetype kHashLength = 64;   // Sha256 hex digest
+    const QDir dir(cacheDir);
+    const QStringList files = dir.entryList({ compiledFilePrefix + QStringLiteral("*") + suffix }, QDir::Files);
+    for (const QString &file : files) {
+        const QString path = dir.filePath(file);
+        // The prefix of one source file can be the start of another's base name, only remove exact matches
+        if ((file.length() != (compiledFilePrefix.length() + kHashLength + suffix.length())) || (path == currentFile)) {
+            continue;
+        }
+        if (QFile::remove(path)) {
+            qCDebug(ParameterMetaDataLog) << "Removed stale compiled parameter meta data:" << path;
+        } else {
+            qCDebug(ParameterMetaDataLog) << "Unable to remove stale compiled parameter meta data:" << path;
+        }
+    }
+}
+
+QString ParameterMetaData::compiledCacheDir()
+{
+    if (s_compiledCacheDirSet) {
+        return s_compiledCacheDir;
+    }
+
+    // Unit tests load the same json over and over, they opt in to a cache directory explicitly
+    if (QGC::runningUnitTests()) {
+        return QString();
+    }
+
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/ParameterMetaData/Compiled");
+}
+
+void ParameterMetaData::setCompiledCacheDir(const QString &dir)
+{
+    s_compiledCacheDir = dir;
+    s_compiledCacheDirSet = true;
 }
 
 FactMetaData *ParameterMetaData::getMetaDataForFact(const QString &name, FactMetaData::ValueType_t type)
@@ -133,9 +228,16 @@ QVersionNumber ParameterMetaData::versionFromFileName(const QString &fileName)
 
 FactMetaData *ParameterMetaData::_lookupMetaData(const QString &name, FactMetaData::ValueType_t type)
 {
-    Q_UNUSED(name)
-    Q_UNUSED(type)
-    return nullptr;
+    if (!_compiledMetaData.isValid()) {
+        return nullptr;
+    }
+
+    const QCborMap record = _compiledMetaData.record(name);
+    if (record.isEmpty()) {
+        return nullptr;
+    }
+
+    return _createMetaDataFromRecord(name, type, record);
 }
 
 FactMetaData *ParameterMetaData::_createDefaultMetaData(const QString &name, FactMetaData::ValueType_t type)
@@ -1,11 +1,14 @@
 #pragma once
 
+#include <QtCore/QCborMap>
 #include <QtCore/QJsonValue>
+#include <QtCore/QMap>
 #include <QtCore/QObject>
 #include <QtCore/QStringView>
 #include <QtCore/QVersionNumber>
 
 #include "FactMetaData.h"
+#include "ParameterMetaDataCache.h"
 
 class QJsonObject;
 
@@ -15,9 +18,22 @@ class ParameterMetaData : public QObject
     explicit ParameterMetaData(QObject *parent = nullptr);
     ~ParameterMetaData() override;
 
+    /// Loads the compiled form of @p metaDataFile from the compiled cache directory, compiling and caching
+    /// it first if this content has not been seen before. FactMetaData is only created by getMetaDataForFact.
     void loadParameterFactMetaDataFile(const QString &metaDataFile);
     FactMetaData *getMetaDataForFact(const QString &name, FactMetaData::ValueType_t type);
 
+    /// true: the last load mapped an already compiled file, no JSON was parsed
+    bool loadedFromCompiledCache() const { return _loadedFromCompiledCache; }
+
+    /// Number of FactMetaData objects created so far
+    qsizetype metaDataCount() const { return _cachedMetaData.count(); }
+
+    /// Directory compiled metadata is cached in. Empty: compile in memory on every load, the default when
+    /// running unit tests.
+    static QString compiledCacheDir();
+    static void setCompiledCacheDir(const QString &dir);
+
     static QVersionNumber versionFromMetaDataFile(const QString &metaDataFile);
     static QVersionNumber versionFromJsonData(const QByteArray &jsonData);
     static QVersionNumber versionFromJsonData(const QByteArray &jsonData, bool *validJson);
@@ -26,7 +42,16 @@ class ParameterMetaData : public QObject
     static const FactMetaData::DefineMap_t kEmptyDefines;
 
 protected:
-    virtual void parseParameterJson(const QJsonObject &json) = 0;
+    /// Compiles the metadata json into one record per parameter, keyed by parameter name. Only called when
+    /// there is no compiled file for this content yet, so problems in the json are reported here.
+    virtual QMap<QString, QCborMap> compileParameterJson(const QJsonObject &json) = 0;
+
+    /// Creates meta data for a parameter from the record compileParameterJson produced for it
+    virtual FactMetaData *_createMetaDataFromRecord(const QString &name, FactMetaData::ValueType_t type, const QCborMap &record) = 0;
+
+    /// Keeps compiled files of different parsers apart, part of the compiled file name
+    virtual QString _compiledCacheTag() const = 0;
+
     virtual FactMetaData *_lookupMetaData(const QString &name, FactMetaData::ValueType_t type);
     virtual FactMetaData *_createDefaultMetaData(const QString &name, FactMetaData::ValueType_t type);
     virtual void _postProcessMetaData(const QString &name, FactMetaData *metaData);
@@ -44,5 +69,13 @@ class ParameterMetaData : public QObject
     static void setBitmaskFromPairs(FactMetaData *metaData, const QList<ValueDescPair> &pairs);
 
     FactMetaData::NameToMetaDataMap_t _cachedMetaData;
+    ParameterMetaDataCache _compiledMetaData;
     bool _parameterMetaDataLoaded = false;
+    bool _loadedFromCompiledCache = false;
+
+    static constexpr const char *kCompiledFileExtension = "qgcpmd";
+
+private:
+    /// Removes the compiles of earlier contents of the same metadata file, keeping @p currentFile
+    static void _removeStaleCompiledFiles(const QString &cacheDir, const QString &compiledFilePrefix, const QString &currentFile);
 };
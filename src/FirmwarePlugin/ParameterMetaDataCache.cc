@@ -0,0 +1,202 @@
+#include "ParameterMetaDataCache.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QCborValue>
+#include <QtCore/QtEndian>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+QGC_LOGGING_CATEGORY(ParameterMetaDataCacheLog, "FirmwarePlugin.ParameterMetaDataCache")
+
+namespace {
+
+enum IndexField {
+    NameOffset,
+    NameLength,
+    RecordOffset,
+    RecordLength,
+};
+
+void appendUInt32(QByteArray &data, quint32 value)
+{
+    const quint32 le = qToLittleEndian(value);
+    (void) data.append(reinterpret_cast<const char*>(&le), sizeof(le));
+}
+
+void writeUInt32(QByteArray &data, qint64 offset, quint32 value)
+{
+    qToLittleEndian(value, data.data() + offset);
+}
+
+} // namespace
+
+ParameterMetaDataCache::~ParameterMetaDataCache()
+{
+    clear();
+}
+
+QByteArray ParameterMetaDataCache::build(const QMap<QString, QCborMap> &records)
+{
+    // Index is sorted by UTF-8 bytes so lookups don't depend on QString ordering
+    std::vector<std::pair<QByteArray, QByteArray>> entries;
+    entries.reserve(records.size());
+    for (auto it = records.cbegin(); it != records.cend(); ++it) {
+        entries.emplace_back(it.key().toUtf8(), it.value().toCborValue().toCbor());
+    }
+    std::sort(entries.begin(), entries.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+
+    const quint32 count = static_cast<quint32>(entries.size());
+
+    QByteArray data;
+    (void) data.append(kMagic, sizeof(kMagic));
+    appendUInt32(data, kFormatVersion);
+    appendUInt32(data, count);
+
+    const qint64 indexOffset = data.size();
+    data.resize(indexOffset + (count * kIndexEntrySize));
+
+    for (quint32 i = 0; i < count; i++) {
+        const auto &[name, record] = entries[i];
+        const qint64 entryOffset = indexOffset + (i * kIndexEntrySize);
+
+        writeUInt32(data, entryOffset + (NameOffset * sizeof(quint32)), static_cast<quint32>(data.size()));
+        writeUInt32(data, entryOffset + (NameLength * sizeof(quint32)), static_cast<quint32>(name.size()));
+        (void) data.append(name);
+
+        writeUInt32(data, entryOffset + (RecordOffset * sizeof(quint32)), static_cast<quint32>(data.size()));
+        writeUInt32(data, entryOffset + (RecordLength * sizeof(quint32)), static_cast<quint32>(record.size()));
+        (void) data.append(record);
+    }
+
+    return data;
+}
+
+bool ParameterMetaDataCache::open(const QString &fileName)
+{
+    clear();
+
+    _file.setFileName(fileName);
+    if (!_file.open(QIODevice::ReadOnly)) {
+        qCDebug(ParameterMetaDataCacheLog) << "Unable to open" << fileName << _file.errorString();
+        return false;
+    }
+
+    const qint64 size = _file.size();
+    _mappedData = (size > 0) ? _file.map(0, size) : nullptr;
+    if (!_mappedData || !_attach(_mappedData, size)) {
+        qCWarning(ParameterMetaDataCacheLog) << "Invalid compiled parameter meta data" << fileName;
+        clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool ParameterMetaDataCache::setData(const QByteArray &data)
+{
+    clear();
+
+    _buffer = data;
+    if (!_attach(reinterpret_cast<const uchar*>(_buffer.constData()), _buffer.size())) {
+        qCWarning(ParameterMetaDataCacheLog) << "Invalid compiled parameter meta data";
+        clear();
+        return false;
+    }
+
+    return true;
+}
+
+void ParameterMetaDataCache::clear()
+{
+    if (_file.isOpen()) {
+        if (_mappedData) {
+            (void) _file.unmap(_mappedData);
+        }
+        _file.close();
+    }
+
+    _mappedData = nullptr;
+    _data = nullptr;
+    _size = 0;
+    _count = 0;
+    _buffer.clear();
+}
+
+QCborMap ParameterMetaDataCache::record(const QString &name) const
+{
+    const qint64 index = _find(name.toUtf8());
+    if (index < 0) {
+        return QCborMap();
+    }
+
+    const QByteArrayView bytes = _bytes(index, RecordOffset);
+    return QCborValue::fromCbor(QByteArray::fromRawData(bytes.data(), bytes.size())).toMap();
+}
+
+bool ParameterMetaDataCache::_attach(const uchar *data, qint64 size)
+{
+    if ((size < kHeaderSize) || (std::memcmp(data, kMagic, sizeof(kMagic)) != 0)) {
+        return false;
+    }
+
+    const quint32 version = qFromLittleEndian<quint32>(data + sizeof(kMagic));
+    if (version != kFormatVersion) {
+        qCDebug(ParameterMetaDataCacheLog) << "Format version mismatch" << version;
+        return false;
+    }
+
+    const quint32 count = qFromLittleEndian<quint32>(data + sizeof(kMagic) + sizeof(quint32));
+    if ((kHeaderSize + (static_cast<qint64>(count) * kIndexEntrySize)) > size) {
+        return false;
+    }
+
+    // Validate every range once so lookups can trust the index
+    for (quint32 i = 0; i < count; i++) {
+        const uchar *const entry = data + kHeaderSize + (i * kIndexEntrySize);
+        for (const int field : { NameOffset, RecordOffset }) {
+            const qint64 offset = qFromLittleEndian<quint32>(entry + (field * sizeof(quint32)));
+            const qint64 length = qFromLittleEndian<quint32>(entry + ((field + 1) * sizeof(quint32)));
+            if ((offset + length) > size) {
+                return false;
+            }
+        }
+    }
+
+    _data = data;
+    _size = size;
+    _count = count;
+
+    return true;
+}
+
+qint64 ParameterMetaDataCache::_find(const QByteArray &utf8Name) const
+{
+    qint64 low = 0;
+    qint64 high = static_cast<qint64>(_count) - 1;
+
+    while (low <= high) {
+        const qint64 mid = low + ((high - low) / 2);
+        const int cmp = QByteArrayView(utf8Name).compare(_bytes(mid, NameOffset));
+        if (cmp == 0) {
+            return mid;
+        }
+        if (cmp < 0) {
+            high = mid - 1;
+        } else {
+            low = mid + 1;
+        }
+    }
+
+    return -1;
+}
+
+QByteArrayView ParameterMetaDataCache::_bytes(qint64 indexEntry, int field) const
+{
+    const uchar *const entry = _data + kHeaderSize + (indexEntry * kIndexEntrySize);
+    const quint32 offset = qFromLittleEndian<quint32>(entry + (field * sizeof(quint32)));
+    const quint32 length = qFromLittleEndian<quint32>(entry + ((field + 1) * sizeof(quint32)));
+    return QByteArrayView(reinterpret_cast<const char*>(_data + offset), length);
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QCborMap>
+#include <QtCore/QFile>
+#include <QtCore/QMap>
+#include <QtCore/QString>
+
+/// Compiled parameter metadata: one CBOR record per parameter behind a name index sorted for binary search.
+///
+/// Built once per metadata file content and memory-mapped from the cache directory on later loads. Opening it
+/// does no parsing, and a record is only decoded when a vehicle reports the parameter.
+///
+/// Layout, little endian, offsets from the start of the file:
+///     Header  magic[8] formatVersion:u32 count:u32
+///     Index   count x { nameOffset:u32 nameLength:u32 recordOffset:u32 recordLength:u32 } sorted by UTF-8 name
+///     Data    UTF-8 names and CBOR encoded records
+class ParameterMetaDataCache
+{
+    Q_DISABLE_COPY_MOVE(ParameterMetaDataCache)
+
+public:
+    ParameterMetaDataCache() = default;
+    ~ParameterMetaDataCache();
+
+    /// @return Compiled form of @p records, keyed by parameter name
+    static QByteArray build(const QMap<QString, QCborMap> &records);
+
+    /// Memory-maps a compiled file
+    ///     @return false if the file can't be mapped or is not a valid compiled file
+    bool open(const QString &fileName);
+
+    /// Uses compiled data held in memory, for when there is no cache directory to map from
+    bool setData(const QByteArray &data);
+
+    void clear();
+
+    bool isValid() const { return (_data != nullptr); }
+    bool isMapped() const { return (_mappedData != nullptr); }
+    quint32 count() const { return _count; }
+
+    /// @return Record for @p name, an empty map if the parameter is not in the metadata
+    QCborMap record(const QString &name) const;
+    bool contains(const QString &name) const { return (_find(name.toUtf8()) >= 0); }
+
+    static constexpr quint32 kFormatVersion = 1;
+
+private:
+    bool _attach(const uchar *data, qint64 size);
+    qint64 _find(const QByteArray &utf8Name) const;
+    QByteArrayView _bytes(qint64 indexEntry, int field) const;
+
+    QFile _file;
+    uchar *_mappedData = nullptr;
+    QByteArray _buffer;
+    const uchar *_data = nullptr;
+    qint64 _size = 0;
+    quint32 _count = 0;
+
+    static constexpr char kMagic[8] = { 'Q', 'G', 'C', 'P', 'M', 'E', 'T', 'A' };
+    static constexpr qint64 kHeaderSize = sizeof(kMagic) + (2 * sizeof(quint32));
+    static constexpr qint64 kIndexEntrySize = 4 * sizeof(quint32);
+};
@@ -9,7 +9,6 @@
 
 #include "ElevationTilePyramid.h"
 
-#include <limits>
 #include <utility>
 
 #include "QGCLoggingCategory.h"
@@ -36,51 +35,88 @@ void adjustAncestorCounts(QHash<TileMath::TileKey, int>& counts, const TileMath:
 
 }  // namespace
 
-bool ElevationTilePyramid::insertTile(const TileMath::TileKey& key, Grid grid, TileMath::TileKey* evictedKey)
+bool ElevationTilePyramid::insertTile(const TileMath::TileKey& key, Grid grid, QList<TileMath::TileKey>* evictedKeys)
 {
     if (!TileMath::isValidKey(key) || !grid.isValid()) {
         return false;
     }
-    const bool replacing = _tiles.contains(key);
-    if (!replacing && (_tiles.count() >= kMaxTiles)) {
-        const TileMath::TileKey evicted = _evictLeastRecentlyUsed();
-        if (TileMath::isValidKey(evicted) && evictedKey) {
-            *evictedKey = evicted;
+    auto it = _tiles.find(key);
+    if (it == _tiles.end()) {
+        Tile tile;
+        tile.pinned = _pinnedKeys.contains(key);
+        if (!tile.pinned) {
+            _lru.push_front(key);
+            tile.lru = _lru.begin();
         }
-    }
-    _tiles.insert(key, std::move(grid));
-    _lastUsed.insert(key, ++_useTick);
-    if (!replacing) {
+        it = _tiles.insert(key, std::move(tile));
         adjustAncestorCounts(_descendantCounts, key, +1);
+    } else {
+        _bytes -= it->bytes;
+        if (!it->pinned) {
+            _lru.splice(_lru.begin(), _lru, it->lru);
+        }
+    }
+    it->bytes = gridBytes(grid);
+    it->grid = std::move(grid);
+    _bytes += it->bytes;
+
+    if (_bytes > _budgetBytes) {
+        _evictLeastRecentlyUsed(key, evictedKeys);
     }
     return true;
 }
 
-TileMath::TileKey ElevationTilePyramid::_evictLeastRecentlyUsed()
+void ElevationTilePyramid::setPinnedKeys(QSet<TileMath::TileKey> keys)
 {
-    // Pinned tiles back rendered patches: never evict them. When everything
-    // is pinned there is no victim and the working set grows past the cap.
-    // O(tileCount) victim scan: fine at kMaxTiles, revisit if the cap grows
-    TileMath::TileKey lruKey{0, 0, -1};
-    qint64 lruTick = std::numeric_limits<qint64>::max();
-    for (auto it = _lastUsed.cbegin(); it != _lastUsed.cend(); ++it) {
-        if ((it.value() < lruTick) && !_pinnedKeys.contains(it.key())) {
-            lruTick = it.value();
-            lruKey = it.key();
+    // Only resident tiles whose pin state flips move between the LRU and the
+    // pinned set; a tile released from its pin was in use until now
+    for (const TileMath::TileKey& key : std::as_const(_pinnedKeys)) {
+        if (keys.contains(key)) {
+            continue;
+        }
+        const auto it = _tiles.find(key);
+        if (it != _tiles.end()) {
+            it->pinned = false;
+            _lru.push_front(key);
+            it->lru = _lru.begin();
         }
     }
-    if (!TileMath::isValidKey(lruKey)) {
+    for (const TileMath::TileKey& key : std::as_const(keys)) {
+        if (_pinnedKeys.contains(key)) {
+            continue;
+        }
+        const auto it = _tiles.find(key);
+        if (it != _tiles.end()) {
+            it->pinned = true;
+            _lru.erase(it->lru);
+        }
+    }
+    _pinnedKeys = std::move(keys);
+}
+
+void ElevationTilePyramid::_evictLeastRecentlyUsed(const TileMath::TileKey& keep, QList<TileMath::TileKey>* evictedKeys)
+{
+    // Pinned tiles back rendered patches and are not in the LRU, so the victim
+    // is always its tail. When everything else is pinned there is no victim
+    // and the working set grows past the budget.
+    while ((_bytes > _budgetBytes) && !_lru.empty() && (_lru.back() != keep)) {
+        const TileMath::TileKey lruKey = _lru.back();
+        _lru.pop_back();
+        const auto it = _tiles.find(lruKey);
+        _bytes -= it->bytes;
+        _tiles.erase(it);
+        adjustAncestorCounts(_descendantCounts, lruKey, -1);
+        // Verbose: fires per insert once the working set is full
         qCDebug(GeoMapElevationTilePyramidVerboseLog)
-            << "all resident tiles pinned, growing past cap, tileCount" << _tiles.count();
-        return lruKey;
+            << "evicting least-recently-used tile" << lruKey << "tileCount" << _tiles.count();
+        if (evictedKeys) {
+            evictedKeys->append(lruKey);
+        }
+    }
+    if (_bytes > _budgetBytes) {
+        qCDebug(GeoMapElevationTilePyramidVerboseLog)
+            << "all evictable tiles pinned, growing past budget, tileCount" << _tiles.count() << "bytes" << _bytes;
     }
-    // Verbose: fires per insert once the working set is full
-    qCDebug(GeoMapElevationTilePyramidVerboseLog)
-        << "evicting least-recently-used tile" << lruKey << "tileCount" << _tiles.count();
-    _tiles.remove(lruKey);
-    _lastUsed.remove(lruKey);
-    adjustAncestorCounts(_descendantCounts, lruKey, -1);
-    return lruKey;
 }
 
 ElevationTilePyramid::View ElevationTilePyramid::bestTileFor(const TileMath::TileKey& key) const
@@ -97,9 +133,11 @@ ElevationTilePyramid::View ElevationTilePyramid::bestTileFor(const TileMath::Til
         if (it == _tiles.cend()) {
             continue;
         }
-        _lastUsed.insert(candidate, ++_useTick);
+        if (!it->pinned) {
+            _lru.splice(_lru.begin(), _lru, it->lru);
+        }
         const double scale = 1.0 / (1LL << shift);
-        return View{&it.value(), candidate,
+        return View{&it->grid, candidate,
                     QRectF((key.x - (qint64(candidate.x) << shift)) * scale,
                            (key.y - (qint64(candidate.y) << shift)) * scale, scale, scale)};
     }
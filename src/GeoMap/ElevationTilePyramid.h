@@ -13,7 +13,9 @@
 #include <QtCore/QList>
 #include <QtCore/QRectF>
 #include <QtCore/QSet>
+#include <QtCore/QtGlobal>
 
+#include <list>
 #include <utility>
 
 #include "TileMath.h"
@@ -31,13 +33,17 @@
 /// Not thread-safe: confine to one thread or synchronize externally. This
 /// includes the const lookup methods — they mutate recency/instrumentation
 /// state, so even concurrent reads race.
-/// Bounded working set: least-recently-used tiles are evicted past kMaxTiles.
+/// Bounded working set: least-recently-used tiles are evicted once the stored
+/// samples exceed the byte budget.
 class ElevationTilePyramid
 {
+    // _lru iterators are stored in _tiles, a copy would point into the source's list
+    Q_DISABLE_COPY_MOVE(ElevationTilePyramid)
+
 public:
-    /// Working-set cap: least-recently-used tiles are evicted at insert time
-    /// (256x256 float tiles ~256KB each, so the cap bounds memory at ~32MB)
-    static constexpr int kMaxTiles = 128;
+    /// Default working-set budget: room for ~512 256x256 float tiles, enough
+    /// for steep pitch views where a large part of the horizon is resident
+    static constexpr qint64 kDefaultBudgetBytes = 128 * 1024 * 1024;
 
     /// Decoded elevation samples for one tile, row-major from the NW corner
     struct Grid
@@ -60,10 +66,12 @@ class ElevationTilePyramid
         bool isValid() const { return grid != nullptr; }
     };
 
+    explicit ElevationTilePyramid(qint64 budgetBytes = kDefaultBudgetBytes) : _budgetBytes(budgetBytes) {}
+
     /// Stores \a grid for \a key, replacing any previous tile. Invalid grids
-    /// are rejected (returns false). When the insert evicts a tile, its key is
-    /// written to \a evictedKey (left untouched otherwise).
-    bool insertTile(const TileMath::TileKey& key, Grid grid, TileMath::TileKey* evictedKey = nullptr);
+    /// are rejected (returns false). Keys of tiles the insert evicts are
+    /// appended to \a evictedKeys.
+    bool insertTile(const TileMath::TileKey& key, Grid grid, QList<TileMath::TileKey>* evictedKeys = nullptr);
 
     bool hasTile(const TileMath::TileKey& key) const { return _tiles.contains(key); }
 
@@ -73,10 +81,18 @@ class ElevationTilePyramid
 
     int tileCount() const { return static_cast<int>(_tiles.count()); }
 
+    /// Bytes held by stored samples, pinned tiles included
+    qint64 byteCount() const { return _bytes; }
+    qint64 budgetBytes() const { return _budgetBytes; }
+
+    /// Memory a grid is accounted for against the budget
+    static qint64 gridBytes(const Grid& grid) { return grid.heights.size() * qint64(sizeof(float)); }
+
     /// Tiles that must not be evicted (they back rendered patches or resolve
-    /// them as ancestors). kMaxTiles becomes a soft cap: when every resident
+    /// them as ancestors). The budget becomes a soft cap: when every resident
     /// tile is pinned, inserts grow past it rather than break a rendered mesh.
-    void setPinnedKeys(QSet<TileMath::TileKey> keys) { _pinnedKeys = std::move(keys); }
+    /// A tile released from its pin counts as just used.
+    void setPinnedKeys(QSet<TileMath::TileKey> keys);
 
     /// True when any stored tile lies strictly deeper within \a key's extent
     /// (i.e. a lookup inside \a key could resolve finer than \a key itself)
@@ -87,12 +103,23 @@ class ElevationTilePyramid
     qint64 lookupCountForTest() const { return _lookupCount; }
 
 private:
-    TileMath::TileKey _evictLeastRecentlyUsed();
+    using LruList = std::list<TileMath::TileKey>;
+
+    struct Tile
+    {
+        Grid grid;
+        qint64 bytes = 0;
+        LruList::iterator lru;  ///< position in _lru, only valid while unpinned
+        bool pinned = false;
+    };
+
+    void _evictLeastRecentlyUsed(const TileMath::TileKey& keep, QList<TileMath::TileKey>* evictedKeys);
 
-    QHash<TileMath::TileKey, Grid> _tiles;
+    QHash<TileMath::TileKey, Tile> _tiles;
     QHash<TileMath::TileKey, int> _descendantCounts;  ///< stored tiles strictly below each key
     QSet<TileMath::TileKey> _pinnedKeys;
-    mutable QHash<TileMath::TileKey, qint64> _lastUsed;
-    mutable qint64 _useTick = 0;
+    mutable LruList _lru;  ///< unpinned stored tiles, most recently used first
+    qint64 _bytes = 0;
+    qint64 _budgetBytes;
     mutable qint64 _lookupCount = 0;
 };
@@ -24,7 +24,7 @@ bool HeightField::insertTile(const TileMath::TileKey& key, ElevationTilePyramid:
     // Capture before the move: on rejection the grid has been consumed
     const int gridWidth = grid.width;
     const int gridHeight = grid.height;
-    TileMath::TileKey evicted{0, 0, -1};
+    QList<TileMath::TileKey> evicted;
     if (!_pyramid.insertTile(key, std::move(grid), &evicted)) {
         qCWarning(GeoMapHeightFieldLog) << "insertTile rejected: key" << key << "grid" << gridWidth << "x"
                                         << gridHeight;
@@ -38,9 +38,9 @@ bool HeightField::insertTile(const TileMath::TileKey& key, ElevationTilePyramid:
         const double span = TileMath::tileSpanAtZoom(k.zoom);
         return QRectF(corner.x(), corner.y(), span, span);
     };
-    if (TileMath::isValidKey(evicted)) {
-        qCDebug(GeoMapHeightFieldVerboseLog) << "evicted tile" << evicted;
-        emit regionChanged(tileExtent(evicted));
+    for (const TileMath::TileKey& evictedKey : std::as_const(evicted)) {
+        qCDebug(GeoMapHeightFieldVerboseLog) << "evicted tile" << evictedKey;
+        emit regionChanged(tileExtent(evictedKey));
     }
     emit regionChanged(tileExtent(key));
     return true;
@@ -32,7 +32,10 @@ QGC_LOGGING_CATEGORY(GeoMapSurfacePatchModelVerboseLog, "GeoMap.SurfacePatchMode
 
 SurfacePatchModel::SurfacePatchModel(QObject* parent) : QAbstractListModel(parent) {}
 
-SurfacePatchModel::~SurfacePatchModel() = default;
+SurfacePatchModel::~SurfacePatchModel()
+{
+    _unpinAllImages();  // the tile source is a child: still alive here
+}
 
 void SurfacePatchModel::setScene(GeoScene* scene)
 {
@@ -146,6 +149,7 @@ void SurfacePatchModel::_resetImagery()
     }
     _retiredOrder.clear();
     _fallbackCache.clear();
+    _unpinAllImages();
     if (!_tileImages.isEmpty()) {
         _tileImages.clear();
         if (!_keys.isEmpty()) {
@@ -154,6 +158,31 @@ void SurfacePatchModel::_resetImagery()
     }
 }
 
+void SurfacePatchModel::_pinImage(const TileMath::TileKey& key)
+{
+    // A displayed image stays in the shared cache for the 2D map and 3D viewer
+    if (_tileSource && !_pinnedImageKeys.contains(key) && _tileSource->pinTile(key)) {
+        _pinnedImageKeys.insert(key);
+    }
+}
+
+void SurfacePatchModel::_unpinImage(const TileMath::TileKey& key)
+{
+    if (_pinnedImageKeys.remove(key) && _tileSource) {
+        _tileSource->unpinTile(key);
+    }
+}
+
+void SurfacePatchModel::_unpinAllImages()
+{
+    if (_tileSource) {
+        for (const TileMath::TileKey& key : std::as_const(_pinnedImageKeys)) {
+            _tileSource->unpinTile(key);
+        }
+    }
+    _pinnedImageKeys.clear();
+}
+
 void SurfacePatchModel::_requestTileImage(const TileMath::TileKey& key)
 {
     if (!_tileSource) {
@@ -179,6 +208,7 @@ void SurfacePatchModel::_tileImageReady(int requestId, const QImage& image)
         return;
     }
     _tileImages.insert(key, image);
+    _pinImage(key);
     _fallbackCache.remove(key);  // own image supersedes any cached miss
     qCDebug(GeoMapSurfacePatchModelVerboseLog) << "tile image ready for" << key;
     _invalidateFallbacks(key);
@@ -715,6 +745,7 @@ void SurfacePatchModel::_patchAdded(const TileMath::TileKey& key)
     if (_tileSource) {
         if (_tileImages.contains(key)) {
             _retiredOrder.removeOne(key);  // back to live: exempt from eviction again
+            _pinImage(key);
         } else {
             _requestTileImage(key);
         }
@@ -758,6 +789,7 @@ void SurfacePatchModel::_patchRemoved(const TileMath::TileKey& key)
 
     // Retire the delivered image instead of dropping it: it seeds the
     // fallback for patches that replace this one across LOD changes
+    _unpinImage(key);  // off screen: the shared cache may evict it again
     if (_tileImages.contains(key)) {
         _retiredOrder.append(key);
         while (_retiredOrder.count() > kMaxRetiredImages) {
@@ -181,6 +181,9 @@ private slots:
 private:
     void _rebuildSurfaceModel();
     void _resetImagery();
+    void _pinImage(const TileMath::TileKey& key);
+    void _unpinImage(const TileMath::TileKey& key);
+    void _unpinAllImages();
     void _requestTileImage(const TileMath::TileKey& key);
     void _retryFailedImages();
     void _notifyTileImageChanged(const TileMath::TileKey& key);
@@ -216,6 +219,7 @@ private slots:
     QHash<int, TileMath::TileKey> _imageRequestKey;    ///< in-flight image request id -> patch
     QHash<TileMath::TileKey, int> _imageRequestByKey;  ///< reverse map for cancellation
     QSet<TileMath::TileKey> _failedImageKeys;          ///< resident patches awaiting an image retry
+    QSet<TileMath::TileKey> _pinnedImageKeys;          ///< live patches pinned in the shared decoded image cache
     QTimer* _imageRetryTimer = nullptr;
     QList<TileMath::TileKey> _keys;                    ///< row order; data fetched from SurfaceModel by key
 
@@ -69,6 +69,21 @@ int TileImageSource::requestTileImage(const TileMath::TileKey& key)
     }
     qCDebug(GeoMapTileImageSourceVerboseLog) << "requestTileImage: key" << key << "requestId" << requestId;
 
+    // Already decoded by this or another consumer (2D map, 3D viewer)
+    const QImage cached = QGCTileImageCache::instance()->image(_imageCacheKey(key));
+    if (!cached.isNull()) {
+        qCDebug(GeoMapTileImageSourceVerboseLog) << "tile" << key << "served from decoded image cache";
+        QMetaObject::invokeMethod(
+            this,
+            [this, requestId, cached] {
+                if (_pending.contains(requestId)) {
+                    _finishSucceeded(requestId, cached);
+                }
+            },
+            Qt::QueuedConnection);
+        return requestId;
+    }
+
     QGCFetchTileTask* const task = QGeoFileTileCacheQGC::createFetchTileTask(_mapType, key.x, key.y, key.zoom);
     connect(task, &QGCFetchTileTask::tileFetched, this, [this, requestId, key](QGCCacheTile* tile) {
         const std::unique_ptr<QGCCacheTile> guard(tile);  // caller-owned per task contract
@@ -148,8 +163,8 @@ void TileImageSource::_fetchFromNetwork(int requestId, const TileMath::TileKey&
             _finishFailed(requestId);
             return;
         }
-        QImage image;
-        if (!image.loadFromData(data)) {
+        const QImage image = QGCTileImageCache::instance()->decode(_imageCacheKey(key), data);
+        if (image.isNull()) {
             _warnFailure(key, QStringLiteral("network body failed to decode, %1 bytes").arg(data.size()));
             _finishFailed(requestId);  // never cache undecodable bodies (e.g. HTTP-200 error pages)
             return;
@@ -164,8 +179,9 @@ void TileImageSource::_fetchFromNetwork(int requestId, const TileMath::TileKey&
 
 void TileImageSource::_deliver(int requestId, const TileMath::TileKey& key, const QByteArray& data)
 {
-    QImage image;
-    if (isBingEmptyTile(_mapId, data) || !image.loadFromData(data)) {
+    const QImage image =
+        isBingEmptyTile(_mapId, data) ? QImage() : QGCTileImageCache::instance()->decode(_imageCacheKey(key), data);
+    if (image.isNull()) {
         // An unusable cached body (placeholder or corrupt) is a miss, not a
         // failure: failing here would re-read the same bytes on every paced
         // retry, blocking the network fallback until cache eviction
@@ -177,6 +193,23 @@ void TileImageSource::_deliver(int requestId, const TileMath::TileKey& key, cons
     _finishSucceeded(requestId, image);
 }
 
+bool TileImageSource::pinTile(const TileMath::TileKey& key)
+{
+    return (_mapId >= 0) && QGCTileImageCache::instance()->pin(_imageCacheKey(key));
+}
+
+void TileImageSource::unpinTile(const TileMath::TileKey& key)
+{
+    if (_mapId >= 0) {
+        QGCTileImageCache::instance()->unpin(_imageCacheKey(key));
+    }
+}
+
+QGCTileImageCache::Key TileImageSource::_imageCacheKey(const TileMath::TileKey& key) const
+{
+    return QGCTileImageCache::Key{_mapId, key.x, key.y, key.zoom};
+}
+
 void TileImageSource::_finishSucceeded(int requestId, const QImage& image)
 {
     _pending.remove(requestId);
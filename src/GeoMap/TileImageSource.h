@@ -16,6 +16,7 @@
 #include <QtCore/QString>
 #include <QtGui/QImage>
 
+#include "QGCTileImageCache.h"
 #include "TileMath.h"
 
 class QNetworkAccessManager;
@@ -24,7 +25,8 @@ class QNetworkReply;
 /// Async cache-first source of map tile images for draping onto surface patches.
 ///
 /// Thin adapter over QGC's existing map tile infrastructure: tile requests hit
-/// the shared tile cache database first, fall back to a provider network fetch
+/// the process-wide decoded image cache (QGCTileImageCache) first, then the
+/// shared tile cache database, fall back to a provider network fetch
 /// on miss (URL/headers from the provider registry), and store fetched tiles
 /// back into the cache. Patches are slippy-tile addressed, so one request maps
 /// to exactly one provider tile.
@@ -55,6 +57,12 @@ class TileImageSource : public QObject
 
     int pendingCount() const { return _pending.count(); }
 
+    /// Keep a delivered tile's image in the shared decoded image cache while
+    /// it is displayed. Pins are counted; unpin once per successful pin.
+    /// Returns false if the image is no longer cached.
+    bool pinTile(const TileMath::TileKey& key);
+    void unpinTile(const TileMath::TileKey& key);
+
 signals:
     void tileImageReady(int requestId, const QImage& image);
     void tileImageFailed(int requestId);
@@ -66,6 +74,7 @@ class TileImageSource : public QObject
     void _finishSucceeded(int requestId, const QImage& image);
     void _finishFailed(int requestId);
     void _warnFailure(const TileMath::TileKey& key, const QString& reason);
+    QGCTileImageCache::Key _imageCacheKey(const TileMath::TileKey& key) const;
 
     static constexpr int kFailureWarnIntervalMs = 10000;  ///< throttle for fetch-failure warnings
 
@@ -0,0 +1,102 @@
+#include "MAVLinkMessageDispatcher.h"
+
+#include <algorithm>
+
+MAVLinkMessageDispatcher::HandlerId MAVLinkMessageDispatcher::subscribe(const QList<uint32_t> &msgIds, const Handler &handler)
+{
+    auto subscription = std::make_unique<Subscription>();
+    subscription->id = _nextHandlerId++;
+    subscription->msgIds = msgIds;
+    subscription->handler = handler;
+
+    const HandlerId handlerId = subscription->id;
+    _subscriptions.push_back(std::move(subscription));
+    _invalidate();
+
+    return handlerId;
+}
+
+void MAVLinkMessageDispatcher::unsubscribe(HandlerId handlerId)
+{
+    for (const std::unique_ptr<Subscription> &subscription : _subscriptions) {
+        if (subscription->id == handlerId) {
+            // Deactivate now so an in-progress dispatch skips it, storage is released by _invalidate
+            subscription->active = false;
+            _invalidate();
+            return;
+        }
+    }
+}
+
+void MAVLinkMessageDispatcher::dispatch(const mavlink_message_t &message)
+{
+    _dispatchDepth++;
+
+    if (message.msgid <= kMaxIndexedMsgId) {
+        for (Subscription *subscription : _subscriptionsFor(message.msgid)) {
+            if (subscription->active) {
+                subscription->handler(message);
+            }
+        }
+    } else {
+        SubscriptionList subscriptions;
+        _collect(message.msgid, subscriptions);
+        for (Subscription *subscription : subscriptions) {
+            if (subscription->active) {
+                subscription->handler(message);
+            }
+        }
+    }
+
+    if ((--_dispatchDepth == 0) && _invalidatePending) {
+        _invalidate();
+    }
+}
+
+qsizetype MAVLinkMessageDispatcher::handlerCount(uint32_t msgId)
+{
+    SubscriptionList subscriptions;
+    _collect(msgId, subscriptions);
+    return static_cast<qsizetype>(subscriptions.size());
+}
+
+const MAVLinkMessageDispatcher::SubscriptionList &MAVLinkMessageDispatcher::_subscriptionsFor(uint32_t msgId)
+{
+    if (msgId >= _slotForMsgId.size()) {
+        _slotForMsgId.resize(msgId + 1, kNoSlot);
+    }
+
+    int &slot = _slotForMsgId[msgId];
+    if (slot == kNoSlot) {
+        SubscriptionList subscriptions;
+        _collect(msgId, subscriptions);
+        _slots.push_back(std::move(subscriptions));
+        slot = static_cast<int>(_slots.size() - 1);
+    }
+
+    return _slots[slot];
+}
+
+void MAVLinkMessageDispatcher::_collect(uint32_t msgId, SubscriptionList &list) const
+{
+    for (const std::unique_ptr<Subscription> &subscription : _subscriptions) {
+        if (subscription->active && (subscription->msgIds.isEmpty() || subscription->msgIds.contains(msgId))) {
+            list.push_back(subscription.get());
+        }
+    }
+}
+
+void MAVLinkMessageDispatcher::_invalidate()
+{
+    if (_dispatchDepth > 0) {
+        _invalidatePending = true;
+        return;
+    }
+
+    _invalidatePending = false;
+    (void) std::erase_if(_subscriptions, [](const std::unique_ptr<Subscription> &subscription) {
+        return !subscription->active;
+    });
+    std::fill(_slotForMsgId.begin(), _slotForMsgId.end(), kNoSlot);
+    _slots.clear();
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <QtCore/QList>
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "MAVLinkMessageType.h"
+
+/// \brief Routes incoming MAVLink messages to the handlers which subscribed to their message id.
+///
+/// Handlers for a message id are resolved once into a flat table indexed by msgid, so dispatch cost depends
+/// only on the number of interested handlers. Handlers run in subscription order. Subscribing or
+/// unsubscribing from within a handler is allowed and takes effect with the next dispatch.
+class MAVLinkMessageDispatcher
+{
+public:
+    using Handler = std::function<void(const mavlink_message_t &message)>;
+    using HandlerId = int;
+
+    MAVLinkMessageDispatcher() = default;
+    ~MAVLinkMessageDispatcher() = default;
+
+    /// Subscribe @a handler to @a msgIds. An empty list subscribes to every message.
+    /// @return Id to pass to unsubscribe
+    HandlerId subscribe(const QList<uint32_t> &msgIds, const Handler &handler);
+    void unsubscribe(HandlerId handlerId);
+
+    void dispatch(const mavlink_message_t &message);
+
+    /// @return Number of handlers a message with @a msgId is delivered to
+    qsizetype handlerCount(uint32_t msgId);
+
+private:
+    struct Subscription
+    {
+        HandlerId id = 0;
+        QList<uint32_t> msgIds;     ///< Empty: all messages
+        Handler handler;
+        bool active = true;
+    };
+    using SubscriptionList = std::vector<Subscription*>;
+
+    const SubscriptionList &_subscriptionsFor(uint32_t msgId);
+    void _collect(uint32_t msgId, SubscriptionList &list) const;
+    void _invalidate();
+
+    std::vector<std::unique_ptr<Subscription>> _subscriptions;  ///< Subscription order
+    std::vector<int> _slotForMsgId;                             ///< msgid -> index into _slots, kNoSlot until resolved
+    std::deque<SubscriptionList> _slots;                        ///< deque: nested dispatch may append while iterating
+    HandlerId _nextHandlerId = 1;
+    int _dispatchDepth = 0;
+    bool _invalidatePending = false;
+
+    static constexpr int kNoSlot = -1;
+    /// Common and ArduPilot dialect ids all fall below this; anything above is resolved per dispatch.
+    static constexpr uint32_t kMaxIndexedMsgId = 65535;
+};
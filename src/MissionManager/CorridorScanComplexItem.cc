@@ -255,22 +255,52 @@ void CorridorScanComplexItem::_rebuildTransectsPhase1(void)
     }
 
     // If the transects are getting rebuilt then any previsouly loaded mission items are now invalid
-    if (_loadedMissionItemsParent) {
-        _loadedMissionItems.clear();
-        _loadedMissionItemsParent->deleteLater();
-        _loadedMissionItemsParent = nullptr;
-    }
+    _clearLoadedMissionItems();
 
-    double transectSpacing = _calcTransectSpacing();
-    double fullWidth = _corridorWidthFact.rawValue().toDouble();
+    const std::atomic<bool> notCanceled(false);
+    _transects = _buildTransects(_transectSnapshot(), notCanceled);
+}
+
+TransectStyleComplexItem::TransectBuilder_t CorridorScanComplexItem::_transectBuilder(void)
+{
+    const TransectSnapshot_t snapshot = _transectSnapshot();
+    return [snapshot](const std::atomic<bool>& canceled) {
+        return _buildTransects(snapshot, canceled);
+    };
+}
+
+CorridorScanComplexItem::TransectSnapshot_t CorridorScanComplexItem::_transectSnapshot(void) const
+{
+    TransectSnapshot_t snapshot;
+
+    snapshot.polyline           = _corridorPolyline.coordinateList();
+    snapshot.corridorWidth      = _corridorWidthFact.rawValue().toDouble();
+    snapshot.transectSpacing    = _calcTransectSpacing();
+    snapshot.transectCount      = _calcTransectCount();
+    snapshot.entryPointLocation = _entryPointLocation;
+    snapshot.turnAroundDistance = _turnAroundDistanceFact.rawValue().toDouble();
+
+    return snapshot;
+}
+
+CorridorScanComplexItem::Transects_t CorridorScanComplexItem::_buildTransects(const TransectSnapshot_t& snapshot, const std::atomic<bool>& canceled)
+{
+    Transects_t rgTransects;
+
+    double transectSpacing = snapshot.transectSpacing;
+    double fullWidth = snapshot.corridorWidth;
     double halfWidth = fullWidth / 2.0;
-    int transectCount = _calcTransectCount();
+    int transectCount = snapshot.transectCount;
     double normalizedTransectPosition = transectSpacing / 2.0;
 
-    if (_corridorPolyline.count() >= 2) {
+    if (snapshot.polyline.count() >= 2) {
         // First build up the transects all going the same direction
         //qDebug() << "_rebuildTransectsPhase1";
         for (int i=0; i<transectCount; i++) {
+            if (canceled.load(std::memory_order_relaxed)) {
+                return rgTransects;
+            }
+
             //qDebug() << "start transect";
             double offsetDistance;
             if (transectCount == 1) {
@@ -283,7 +313,7 @@ void CorridorScanComplexItem::_rebuildTransectsPhase1(void)
 
             // Turn transect into CoordInfo transect
             QList<TransectStyleComplexItem::CoordInfo_t> transect;
-            QList<QGeoCoordinate> transectCoords = _corridorPolyline.offsetPolyline(offsetDistance);
+            QList<QGeoCoordinate> transectCoords = QGCMapPolyline::offsetPolyline(snapshot.polyline, offsetDistance);
             for (int j=1; j<transectCoords.count() - 1; j++) {
                 TransectStyleComplexItem::CoordInfo_t coordInfo = { transectCoords[j], CoordTypeInterior };
                 transect.append(coordInfo);
@@ -294,9 +324,9 @@ void CorridorScanComplexItem::_rebuildTransectsPhase1(void)
             transect.append(coordInfo);
 
             // Extend the transect ends for turnaround
-            if (_hasTurnaround()) {
+            if (snapshot.turnAroundDistance > 0) {
                 QGeoCoordinate turnaroundCoord;
-                double turnAroundDistance = _turnAroundDistanceFact.rawValue().toDouble();
+                double turnAroundDistance = snapshot.turnAroundDistance;
 
                 double azimuth = transectCoords[0].azimuthTo(transectCoords[1]);
                 turnaroundCoord = transectCoords[0].atDistanceAndAzimuth(-turnAroundDistance, azimuth);
@@ -318,7 +348,7 @@ void CorridorScanComplexItem::_rebuildTransectsPhase1(void)
             }
 #endif
 
-            _transects.append(transect);
+            rgTransects.append(transect);
             normalizedTransectPosition += transectSpacing;
         }
 
@@ -330,7 +360,7 @@ void CorridorScanComplexItem::_rebuildTransectsPhase1(void)
 
         bool reverseTransects = false;
         bool reverseVertices = false;
-        switch (_entryPointLocation) {
+        switch (snapshot.entryPointLocation) {
         case EntryPointDefaultOrder:
             reverseTransects = false;
             reverseVertices = false;
@@ -350,26 +380,26 @@ void CorridorScanComplexItem::_rebuildTransectsPhase1(void)
         }
         if (reverseTransects) {
             QList<QList<TransectStyleComplexItem::CoordInfo_t>> reversedTransects;
-            for (const QList<TransectStyleComplexItem::CoordInfo_t>& transect: _transects) {
+            for (const QList<TransectStyleComplexItem::CoordInfo_t>& transect: rgTransects) {
                 reversedTransects.prepend(transect);
             }
-            _transects = reversedTransects;
+            rgTransects = reversedTransects;
         }
         if (reverseVertices) {
-            for (int i=0; i<_transects.count(); i++) {
+            for (int i=0; i<rgTransects.count(); i++) {
                 QList<TransectStyleComplexItem::CoordInfo_t> reversedVertices;
-                for (const TransectStyleComplexItem::CoordInfo_t& vertex: _transects[i]) {
+                for (const TransectStyleComplexItem::CoordInfo_t& vertex: rgTransects[i]) {
                     reversedVertices.prepend(vertex);
                 }
-                _transects[i] = reversedVertices;
+                rgTransects[i] = reversedVertices;
             }
         }
 
         // Adjust to lawnmower pattern
         reverseVertices = false;
-        for (int i=0; i<_transects.count(); i++) {
+        for (int i=0; i<rgTransects.count(); i++) {
             // We must reverse the vertices for every other transect in order to make a lawnmower pattern
-            QList<TransectStyleComplexItem::CoordInfo_t> transectVertices = _transects[i];
+            QList<TransectStyleComplexItem::CoordInfo_t> transectVertices = rgTransects[i];
             if (reverseVertices) {
                 reverseVertices = false;
                 QList<TransectStyleComplexItem::CoordInfo_t> reversedVertices;
@@ -388,9 +418,11 @@ void CorridorScanComplexItem::_rebuildTransectsPhase1(void)
             } else {
                 reverseVertices = true;
             }
-            _transects[i] = transectVertices;
+            rgTransects[i] = transectVertices;
         }
     }
+
+    return rgTransects;
 }
 
 void CorridorScanComplexItem::_recalcCameraShots(void)
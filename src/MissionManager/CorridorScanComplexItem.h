@@ -70,6 +70,24 @@ private slots:
     void _recalcCameraShots         (void) final;
 
 private:
+    /// Everything transect generation reads from the item, captured on the gui thread
+    typedef struct {
+        QList<QGeoCoordinate>   polyline;
+        double                  corridorWidth;
+        double                  transectSpacing;
+        int                     transectCount;
+        EntryPointLocation      entryPointLocation;
+        double                  turnAroundDistance;
+    } TransectSnapshot_t;
+
+    // Overrides from TransectStyleComplexItem
+    TransectBuilder_t _transectBuilder(void) final;
+
+    TransectSnapshot_t  _transectSnapshot   (void) const;
+
+    /// Builds the transects for a snapshot. Runs on a worker thread so it must not touch the item.
+    static Transects_t  _buildTransects     (const TransectSnapshot_t& snapshot, const std::atomic<bool>& canceled);
+
     double  _calcTransectSpacing    (void) const;
     int     _calcTransectCount      (void) const;
     void    _saveCommon             (QJsonObject& complexObject);
@@ -29,12 +29,56 @@
 
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonDocument>
+#include <QtCore/QPointer>
+#include <QtCore/QSet>
 #include <QtMath>
 
 #define UPDATE_TIMEOUT 5000 ///< How often we check for bounding box changes
 
 QGC_LOGGING_CATEGORY(MissionControllerLog, "PlanManager.MissionController")
 
+namespace {
+
+FlightPathSegment::SegmentType _flightPathSegmentType(const VisualItemPair& pair, bool mavlinkTerrainFrame)
+{
+    if (pair.second->isTakeoffItem()) {
+        return FlightPathSegment::SegmentTypeTakeoff;
+    } else if (pair.second->isLandCommand()) {
+        return FlightPathSegment::SegmentTypeLand;
+    }
+    return mavlinkTerrainFrame ? FlightPathSegment::SegmentTypeTerrainFrame : FlightPathSegment::SegmentTypeGeneric;
+}
+
+/// Replaces the entries of @a model from @a start on with @a tail. Leading entries which already match are left alone
+/// so views only see the rows which actually changed.
+void _replaceModelTail(QmlObjectListModel& model, int start, const QList<FlightPathSegment*>& tail)
+{
+    int matching = 0;
+    while ((start + matching < model.count()) && (matching < tail.count()) && (model[start + matching] == tail[matching])) {
+        matching++;
+    }
+
+    const int removeCount = model.count() - (start + matching);
+    if (removeCount > 1) {
+        model.beginResetModel();
+    }
+    while (model.count() > start + matching) {
+        (void) model.removeAt(model.count() - 1);
+    }
+    QList<QObject*> added;
+    for (int i=matching; i<tail.count(); i++) {
+        added.append(tail[i]);
+    }
+    if (!added.isEmpty()) {
+        model.append(added);
+    }
+    if (removeCount > 1) {
+        model.endResetModel();
+    }
+}
+
+} // namespace
+
 MissionController::MissionController(PlanMasterController* masterController, QObject *parent)
     : PlanElementController (masterController, parent)
     , _controllerVehicle    (masterController->controllerVehicle())
@@ -71,6 +115,7 @@ MissionController::~MissionController()
 
 void MissionController::_resetMissionFlightStatus(void)
 {
+    _flightStatusCalc.invalidate();
     _flightStatusCalc.reset(_controllerVehicle, _managerVehicle, _missionContainsVTOLTakeoff);
     _missionFlightStatus = _flightStatusCalc.status();
 
@@ -923,12 +968,7 @@ FlightPathSegment* MissionController::_createFlightPathSegmentWorker(VisualItemP
     double              coord2AMSLAlt       = pair.second->amslEntryAlt();
     double              coord1AMSLAlt       = takeoffStraightUp ? coord2AMSLAlt : pair.first->amslExitAlt();
 
-    FlightPathSegment::SegmentType segmentType = mavlinkTerrainFrame ? FlightPathSegment::SegmentTypeTerrainFrame : FlightPathSegment::SegmentTypeGeneric;
-    if (pair.second->isTakeoffItem()) {
-        segmentType = FlightPathSegment::SegmentTypeTakeoff;
-    } else if (pair.second->isLandCommand()) {
-        segmentType = FlightPathSegment::SegmentTypeLand;
-    }
+    FlightPathSegment::SegmentType segmentType = _flightPathSegmentType(pair, mavlinkTerrainFrame);
 
     FlightPathSegment* segment = new FlightPathSegment(segmentType, coord1, coord1AMSLAlt, coord2, coord2AMSLAlt, !_flyView /* queryTerrainData */,  this);
 
@@ -941,78 +981,151 @@ FlightPathSegment* MissionController::_createFlightPathSegmentWorker(VisualItemP
     connect(pair.second, &VisualMissionItem::entryCoordinateChanged,    segment,    &FlightPathSegment::setCoordinate2);
     connect(pair.second, &VisualMissionItem::amslEntryAltChanged,       segment,    &FlightPathSegment::setCoord2AMSLAlt);
 
-    connect(pair.second, &VisualMissionItem::entryCoordinateChanged,    this,       &MissionController::_recalcMissionFlightStatusSignal, Qt::QueuedConnection);
-    connect(pair.second, &VisualMissionItem::exitCoordinateChanged,     this,       &MissionController::_recalcMissionFlightStatusSignal, Qt::QueuedConnection);
+    // Flight status is only stale from the item the segment leads to
+    VisualMissionItem* statusItem = pair.second;
+    connect(pair.second, &VisualMissionItem::entryCoordinateChanged,    this,       [this, statusItem]() { _setFlightStatusDirty(statusItem); });
+    connect(pair.second, &VisualMissionItem::exitCoordinateChanged,     this,       [this, statusItem]() { _setFlightStatusDirty(statusItem); });
 
+    QPointer<VisualMissionItem> segmentStatusItem = pair.second;
     connect(segment,    &FlightPathSegment::totalDistanceChanged,       this,       &MissionController::recalcTerrainProfile,             Qt::QueuedConnection);
-    connect(segment,    &FlightPathSegment::coord1AMSLAltChanged,       this,       &MissionController::_recalcMissionFlightStatusSignal, Qt::QueuedConnection);
-    connect(segment,    &FlightPathSegment::coord2AMSLAltChanged,       this,       &MissionController::_recalcMissionFlightStatusSignal, Qt::QueuedConnection);
+    connect(segment,    &FlightPathSegment::coord1AMSLAltChanged,       this,       [this, segmentStatusItem]() { _setFlightStatusDirty(segmentStatusItem.data()); });
+    connect(segment,    &FlightPathSegment::coord2AMSLAltChanged,       this,       [this, segmentStatusItem]() { _setFlightStatusDirty(segmentStatusItem.data()); });
     connect(segment,    &FlightPathSegment::amslTerrainHeightsChanged,  this,       &MissionController::recalcTerrainProfile,             Qt::QueuedConnection);
     connect(segment,    &FlightPathSegment::terrainCollisionChanged,    this,       &MissionController::recalcTerrainProfile,             Qt::QueuedConnection);
 
     return segment;
 }
 
-FlightPathSegment* MissionController::_addFlightPathSegment(FlightPathSegmentHashTable& prevItemPairHashTable, VisualItemPair& pair, bool mavlinkTerrainFrame)
+FlightPathSegment* MissionController::_addFlightPathSegment(VisualItemPair& pair, bool mavlinkTerrainFrame, QList<FlightPathSegment*>& replacedSegments)
 {
-    FlightPathSegment* segment = nullptr;
+    FlightPathSegment* segment = _flightPathSegmentHashTable.value(pair, nullptr);
 
-    if (prevItemPairHashTable.contains(pair) && (prevItemPairHashTable[pair]->segmentType() == FlightPathSegment::SegmentTypeTerrainFrame) != mavlinkTerrainFrame) {
+    if (segment && segment->segmentType() == _flightPathSegmentType(pair, mavlinkTerrainFrame)) {
         // Pair already exists and connected, just re-use
-        _flightPathSegmentHashTable[pair] = segment = prevItemPairHashTable.take(pair);
-    } else {
-        segment = _createFlightPathSegmentWorker(pair, mavlinkTerrainFrame);
-        _flightPathSegmentHashTable[pair] = segment;
+        return segment;
     }
 
-    _simpleFlightPathSegments.append(segment);
+    if (segment) {
+        // Still referenced by the segment models until they are updated
+        replacedSegments.append(segment);
+    }
+    segment = _createFlightPathSegmentWorker(pair, mavlinkTerrainFrame);
+    _flightPathSegmentHashTable[pair] = segment;
 
     return segment;
 }
 
+int MissionController::_flightPathResumeIndex(int firstDirtyIndex) const
+{
+    if (firstDirtyIndex <= 1 || _delayedSplitSegmentUpdate || _flightPathCheckpoints.count() < 2 || _flightPathCheckpoints.count() > _visualItems->count()) {
+        return 1;
+    }
+
+    // Items after the first RTL are never walked, so anything past it resumes at the RTL
+    const int index = qMin(firstDirtyIndex, static_cast<int>(_flightPathCheckpoints.count()) - 1);
+    if (_flightPathCheckpoints[index].item != _visualItems->get(index)) {
+        return 1;
+    }
+
+    return index;
+}
+
+void MissionController::_setFlightPathDirty(int visualItemIndex)
+{
+    _flightPathDirtyIndex = qMin(_flightPathDirtyIndex, qMax(visualItemIndex, 0));
+    emit _recalcFlightPathSegmentsSignal();
+}
+
+void MissionController::_setFlightPathDirty(VisualMissionItem* visualItem)
+{
+    // An item which is no longer in the list can't be located, so fall back to a full recalc
+    _setFlightPathDirty(visualItem ? _visualItems->indexOf(visualItem) : 0);
+}
+
+void MissionController::_setFlightStatusDirty(int visualItemIndex)
+{
+    _flightStatusDirtyIndex = qMin(_flightStatusDirtyIndex, qMax(visualItemIndex, 0));
+    emit _recalcMissionFlightStatusSignal();
+}
+
+void MissionController::_setFlightStatusDirty(VisualMissionItem* visualItem)
+{
+    _setFlightStatusDirty(visualItem ? _visualItems->indexOf(visualItem) : 0);
+}
+
 void MissionController::_recalcFlightPathSegments(void)
 {
-    VisualItemPair      lastSegmentVisualItemPair;
-    int                 segmentCount =              0;
-    bool                firstCoordinateNotFound =   true;
-    VisualMissionItem*  lastFlyThroughVI =          qobject_cast<VisualMissionItem*>(_visualItems->get(0));
+    if (!_visualItems->count()) {
+        return;
+    }
+
+    if (_flightPathDirtyIndex == _notDirty) {
+        // Already handled by an earlier delivery of the compressed signal
+        return;
+    }
+
+    const int           startIndex =                _flightPathResumeIndex(_flightPathDirtyIndex);
+    const bool          prevContainsVTOLTakeoff =   _missionContainsVTOLTakeoff;
+    _flightPathDirtyIndex = _notDirty;
+
+    FlightPathCheckpoint startState;
+    if (startIndex > 1) {
+        startState = _flightPathCheckpoints[startIndex];
+    } else {
+        startState.lastFlyThroughVI = qobject_cast<VisualMissionItem*>(_visualItems->get(0));
+        startState.linkStartToHome = _controllerVehicle->rover() ? true : false;
+    }
+
+    VisualItemPair      lastSegmentVisualItemPair = startState.lastSegmentVisualItemPair;
+    int                 segmentCount =              startState.segmentCount;
+    bool                firstCoordinateNotFound =   startState.firstCoordinateNotFound;
+    VisualMissionItem*  lastFlyThroughVI =          startState.lastFlyThroughVI;
     bool                linkEndToHome =             false;
-    bool                linkStartToHome =           _controllerVehicle->rover() ? true : false;
+    bool                linkStartToHome =           startState.linkStartToHome;
     bool                foundRTL =                  false;
     bool                homePositionValid =         _settingsItem->coordinate().isValid();
-    bool                roiActive =                 false;
-    bool                previousItemIsIncomplete =  false;
+    bool                roiActive =                 startState.roiActive;
+    bool                previousItemIsIncomplete =  startState.previousItemIsIncomplete;
     bool                signalSplitSegmentChanged = false;
 
-    qCDebug(MissionControllerLog) << "_recalcFlightPathSegments homePositionValid" << homePositionValid;
-
-    FlightPathSegmentHashTable oldSegmentTable = _flightPathSegmentHashTable;
-
-    _missionContainsVTOLTakeoff = false;
-    _flightPathSegmentHashTable.clear();
+    qCDebug(MissionControllerLog) << "_recalcFlightPathSegments homePositionValid" << homePositionValid << "startIndex" << startIndex;
 
-    _simpleFlightPathSegments.beginResetModel();
-    _directionArrows.beginResetModel();
+    _missionContainsVTOLTakeoff = startState.missionContainsVTOLTakeoff;
 
-    _simpleFlightPathSegments.clear();
-    _directionArrows.clear();
+    // Segments and arrows before startIndex are still valid, only the tails are rebuilt
+    QList<FlightPathSegment*> simpleFlightPathSegments;
+    QList<FlightPathSegment*> directionArrows;
+    QList<FlightPathSegment*> replacedSegments;
 
-    // Mission Settings item needs to start with no segment
+    // The simple flight path segments of the items being walked are going to be rebuilt. We can't just do this in the main loop
+    // below since that loop won't always process all items. The item we resume from may have a segment leading into the walked range.
     lastFlyThroughVI->clearSimpleFlighPathSegment();
-
-    // We need to clear the simple flight path segments on all items since they are going to be rebuilt. We can't just do this in the main loop
-    // below since that loop won't always process all items.
-    for (int i=1; i<_visualItems->count(); i++) {
+    for (int i=startIndex; i<_visualItems->count(); i++) {
         qobject_cast<VisualMissionItem*>(_visualItems->get(i))->clearSimpleFlighPathSegment();
     }
 
+    _flightPathCheckpoints.resize(_visualItems->count());
+    int checkpointCount = startIndex;
+
     // Grovel through the list of items keeping track of things needed to correctly draw waypoints lines
-    for (int i=1; i<_visualItems->count(); i++) {
+    for (int i=startIndex; i<_visualItems->count(); i++) {
         VisualMissionItem*  visualItem =    qobject_cast<VisualMissionItem*>(_visualItems->get(i));
         SimpleMissionItem*  simpleItem =    qobject_cast<SimpleMissionItem*>(visualItem);
         ComplexMissionItem* complexItem =   qobject_cast<ComplexMissionItem*>(visualItem);
 
-        visualItem->clearSimpleFlighPathSegment();
+        FlightPathCheckpoint& checkpoint =          _flightPathCheckpoints[i];
+        checkpoint.item =                           visualItem;
+        checkpoint.lastFlyThroughVI =               lastFlyThroughVI;
+        checkpoint.lastSegmentVisualItemPair =      lastSegmentVisualItemPair;
+        checkpoint.segmentCount =                   segmentCount;
+        checkpoint.simpleFlightPathSegmentCount =   startState.simpleFlightPathSegmentCount + simpleFlightPathSegments.count();
+        checkpoint.directionArrowCount =            startState.directionArrowCount + directionArrows.count();
+        checkpoint.firstCoordinateNotFound =        firstCoordinateNotFound;
+        checkpoint.linkStartToHome =                linkStartToHome;
+        checkpoint.roiActive =                      roiActive;
+        checkpoint.previousItemIsIncomplete =       previousItemIsIncomplete;
+        checkpoint.missionContainsVTOLTakeoff =     _missionContainsVTOLTakeoff;
+        checkpointCount = i + 1;
 
         if (simpleItem) {
             if (roiActive) {
@@ -1089,10 +1202,11 @@ void MissionController::_recalcFlightPathSegments(void)
                     lastSegmentVisualItemPair =  VisualItemPair(lastFlyThroughVI, visualItem);
                     SimpleMissionItem* lastSimpleItem = qobject_cast<SimpleMissionItem*>(lastFlyThroughVI);
                     bool mavlinkTerrainFrame = lastSimpleItem ? lastSimpleItem->missionItem().frame() == MAV_FRAME_GLOBAL_TERRAIN_ALT : false;
-                    FlightPathSegment* segment = _addFlightPathSegment(oldSegmentTable, lastSegmentVisualItemPair, mavlinkTerrainFrame);
+                    FlightPathSegment* segment = _addFlightPathSegment(lastSegmentVisualItemPair, mavlinkTerrainFrame, replacedSegments);
                     segment->setSpecialVisual(roiActive);
+                    simpleFlightPathSegments.append(segment);
                     if (addDirectionArrow) {
-                        _directionArrows.append(segment);
+                        directionArrows.append(segment);
                     }
                     if (visualItem->isCurrentItem() && _delayedSplitSegmentUpdate) {
                         _splitSegment = segment;
@@ -1107,27 +1221,23 @@ void MissionController::_recalcFlightPathSegments(void)
         }
     }
 
+    _flightPathCheckpoints.resize(checkpointCount);
+
     if (linkEndToHome && lastFlyThroughVI != _settingsItem && homePositionValid) {
         lastSegmentVisualItemPair = VisualItemPair(lastFlyThroughVI, _settingsItem);
-        FlightPathSegment* segment = _addFlightPathSegment(oldSegmentTable, lastSegmentVisualItemPair, false /* mavlinkTerrainFrame */);
+        FlightPathSegment* segment = _addFlightPathSegment(lastSegmentVisualItemPair, false /* mavlinkTerrainFrame */, replacedSegments);
         segment->setSpecialVisual(roiActive);
+        simpleFlightPathSegments.append(segment);
         lastFlyThroughVI->setSimpleFlighPathSegment(segment);
     }
 
     // Add direction arrow to last segment
     if (lastSegmentVisualItemPair.first) {
-        FlightPathSegment* coordVector = nullptr;
+        FlightPathSegment* coordVector = _flightPathSegmentHashTable.value(lastSegmentVisualItemPair, nullptr);
 
         // The pair may not be in the hash, this can happen in the fly view where only segments with arrows on them are added to hash.
         // check for that first and add if needed
-
-        if (_flightPathSegmentHashTable.contains(lastSegmentVisualItemPair)) {
-            // Pair exists in the new table already just reuse it
-            coordVector = _flightPathSegmentHashTable[lastSegmentVisualItemPair];
-        } else if (oldSegmentTable.contains(lastSegmentVisualItemPair)) {
-            // Pair already exists in old table, pull from old to new and reuse
-            _flightPathSegmentHashTable[lastSegmentVisualItemPair] = coordVector = oldSegmentTable.take(lastSegmentVisualItemPair);
-        } else {
+        if (!coordVector) {
             // Create a new segment. Since this is the fly view there is no need to wire change signals or worry about correct SegmentType
             coordVector = new FlightPathSegment(
                         FlightPathSegment::SegmentTypeGeneric,
@@ -1140,16 +1250,45 @@ void MissionController::_recalcFlightPathSegments(void)
             _flightPathSegmentHashTable[lastSegmentVisualItemPair] = coordVector;
         }
 
-        _directionArrows.append(coordVector);
+        directionArrows.append(coordVector);
     }
 
-    _simpleFlightPathSegments.endResetModel();
-    _directionArrows.endResetModel();
+    // Segments dropped from the models or the table may be obsolete line objects
+    QSet<FlightPathSegment*> obsoleteSegments(replacedSegments.cbegin(), replacedSegments.cend());
+    for (int i=startState.simpleFlightPathSegmentCount; i<_simpleFlightPathSegments.count(); i++) {
+        obsoleteSegments.insert(_simpleFlightPathSegments.value<FlightPathSegment*>(i));
+    }
+    for (int i=startState.directionArrowCount; i<_directionArrows.count(); i++) {
+        obsoleteSegments.insert(_directionArrows.value<FlightPathSegment*>(i));
+    }
 
-    // Anything left in the old table is an obsolete line object that can go
-    qDeleteAll(oldSegmentTable);
+    _replaceModelTail(_simpleFlightPathSegments, startState.simpleFlightPathSegmentCount, simpleFlightPathSegments);
+    _replaceModelTail(_directionArrows, startState.directionArrowCount, directionArrows);
 
-    emit _recalcMissionFlightStatusSignal();
+    QSet<FlightPathSegment*> liveSegments;
+    for (int i=0; i<_simpleFlightPathSegments.count(); i++) {
+        liveSegments.insert(_simpleFlightPathSegments.value<FlightPathSegment*>(i));
+    }
+    for (int i=0; i<_directionArrows.count(); i++) {
+        liveSegments.insert(_directionArrows.value<FlightPathSegment*>(i));
+    }
+    for (auto it = _flightPathSegmentHashTable.begin(); it != _flightPathSegmentHashTable.end(); ) {
+        if (liveSegments.contains(it.value())) {
+            ++it;
+        } else {
+            obsoleteSegments.insert(it.value());
+            it = _flightPathSegmentHashTable.erase(it);
+        }
+    }
+    obsoleteSegments.subtract(liveSegments);
+    if (obsoleteSegments.contains(_splitSegment)) {
+        _splitSegment = nullptr;
+        signalSplitSegmentChanged = true;
+    }
+    qDeleteAll(obsoleteSegments);
+
+    // The VTOL takeoff state feeds into the initial flight status, so a change invalidates all of it
+    _setFlightStatusDirty((_missionContainsVTOLTakeoff == prevContainsVTOLTakeoff) ? startIndex : 0);
 
     emit recalcTerrainProfile();
     if (signalSplitSegmentChanged) {
@@ -1159,13 +1298,17 @@ void MissionController::_recalcFlightPathSegments(void)
 
 void MissionController::_recalcMissionFlightStatus()
 {
-    if (!_visualItems->count()) {
+    if (!_visualItems->count() || _flightStatusDirtyIndex == _notDirty) {
         return;
     }
 
-    qCDebug(MissionControllerLog) << "_recalcMissionFlightStatus";
+    const int firstDirtyIndex = _flightStatusDirtyIndex;
+    _flightStatusDirtyIndex = _notDirty;
+
+    _flightStatusCalc.recalc(_visualItems, _settingsItem, _controllerVehicle, _managerVehicle, _appSettings, _planViewSettings, _missionContainsVTOLTakeoff, firstDirtyIndex);
+
+    qCDebug(MissionControllerLog) << "_recalcMissionFlightStatus startIndex" << _flightStatusCalc.lastRecalcStartIndex();
 
-    _flightStatusCalc.recalc(_visualItems, _settingsItem, _controllerVehicle, _managerVehicle, _appSettings, _planViewSettings, _missionContainsVTOLTakeoff);
     _missionFlightStatus = _flightStatusCalc.status();
     _minAMSLAltitude = _flightStatusCalc.minAMSLAltitude();
     _maxAMSLAltitude = _flightStatusCalc.maxAMSLAltitude();
@@ -1443,7 +1586,7 @@ void MissionController::_recalcAllWithCoordinate(const QGeoCoordinate& coordinat
     }
     _recalcSequence();
     _recalcChildItems();
-    emit _recalcFlightPathSegmentsSignal();
+    _setFlightPathDirty(0);
     _updateTimer.start(UPDATE_TIMEOUT);
 }
 
@@ -1466,7 +1609,7 @@ void MissionController::_initAllVisualItems(void)
         }
     }
 
-    connect(_settingsItem, &MissionSettingsItem::coordinateChanged,     this, &MissionController::_recalcMissionFlightStatus);
+    connect(_settingsItem, &MissionSettingsItem::coordinateChanged,     this, &MissionController::_homePositionCoordinateChanged);
     connect(_settingsItem, &MissionSettingsItem::coordinateChanged,     this, &MissionController::plannedHomePositionChanged);
     connect(_settingsItem, &MissionSettingsItem::coordinateChanged,     this, &MissionController::homePositionSetChanged);
 
@@ -1520,7 +1663,7 @@ void MissionController::_initAllVisualItems(void)
 
 void MissionController::_deinitAllVisualItems(void)
 {
-    disconnect(_settingsItem, &MissionSettingsItem::coordinateChanged, this, &MissionController::_recalcMissionFlightStatus);
+    disconnect(_settingsItem, &MissionSettingsItem::coordinateChanged, this, &MissionController::_homePositionCoordinateChanged);
     disconnect(_settingsItem, &MissionSettingsItem::coordinateChanged, this, &MissionController::plannedHomePositionChanged);
     disconnect(_settingsItem, &MissionSettingsItem::coordinateChanged, this, &MissionController::homePositionSetChanged);
 
@@ -1551,14 +1694,18 @@ void MissionController::_initVisualItem(VisualMissionItem* visualItem)
 {
     setDirty(false);
 
-    connect(visualItem, &VisualMissionItem::specifiesCoordinateChanged,                 this, &MissionController::_recalcFlightPathSegmentsSignal,  Qt::QueuedConnection);
-    connect(visualItem, &VisualMissionItem::specifiedFlightSpeedChanged,                this, &MissionController::_recalcMissionFlightStatusSignal, Qt::QueuedConnection);
-    connect(visualItem, &VisualMissionItem::specifiedGimbalYawChanged,                  this, &MissionController::_recalcMissionFlightStatusSignal, Qt::QueuedConnection);
-    connect(visualItem, &VisualMissionItem::specifiedGimbalPitchChanged,                this, &MissionController::_recalcMissionFlightStatusSignal, Qt::QueuedConnection);
-    connect(visualItem, &VisualMissionItem::specifiedVehicleYawChanged,                 this, &MissionController::_recalcMissionFlightStatusSignal, Qt::QueuedConnection);
-    connect(visualItem, &VisualMissionItem::terrainAltitudeChanged,                     this, &MissionController::_recalcMissionFlightStatusSignal, Qt::QueuedConnection);
-    connect(visualItem, &VisualMissionItem::additionalTimeDelayChanged,                 this, &MissionController::_recalcMissionFlightStatusSignal, Qt::QueuedConnection);
-    connect(visualItem, &VisualMissionItem::currentVTOLModeChanged,                     this, &MissionController::_recalcMissionFlightStatusSignal, Qt::QueuedConnection);
+    // Only the changed item and the ones after it need to be recalculated
+    const auto setFlightPathDirty =     [this, visualItem]() { _setFlightPathDirty(visualItem); };
+    const auto setFlightStatusDirty =   [this, visualItem]() { _setFlightStatusDirty(visualItem); };
+
+    connect(visualItem, &VisualMissionItem::specifiesCoordinateChanged,                 this, setFlightPathDirty);
+    connect(visualItem, &VisualMissionItem::specifiedFlightSpeedChanged,                this, setFlightStatusDirty);
+    connect(visualItem, &VisualMissionItem::specifiedGimbalYawChanged,                  this, setFlightStatusDirty);
+    connect(visualItem, &VisualMissionItem::specifiedGimbalPitchChanged,                this, setFlightStatusDirty);
+    connect(visualItem, &VisualMissionItem::specifiedVehicleYawChanged,                 this, setFlightStatusDirty);
+    connect(visualItem, &VisualMissionItem::terrainAltitudeChanged,                     this, setFlightStatusDirty);
+    connect(visualItem, &VisualMissionItem::additionalTimeDelayChanged,                 this, setFlightStatusDirty);
+    connect(visualItem, &VisualMissionItem::currentVTOLModeChanged,                     this, setFlightStatusDirty);
     connect(visualItem, &VisualMissionItem::lastSequenceNumberChanged,                  this, &MissionController::_recalcSequence);
 
     if (visualItem->isSimpleItem()) {
@@ -1572,11 +1719,11 @@ void MissionController::_initVisualItem(VisualMissionItem* visualItem)
     } else {
         ComplexMissionItem* complexItem = qobject_cast<ComplexMissionItem*>(visualItem);
         if (complexItem) {
-            connect(complexItem, &ComplexMissionItem::complexDistanceChanged,       this, &MissionController::_recalcMissionFlightStatusSignal, Qt::QueuedConnection);
-            connect(complexItem, &ComplexMissionItem::greatestDistanceToChanged,    this, &MissionController::_recalcMissionFlightStatusSignal, Qt::QueuedConnection);
-            connect(complexItem, &ComplexMissionItem::minAMSLAltitudeChanged,       this, &MissionController::_recalcMissionFlightStatusSignal, Qt::QueuedConnection);
-            connect(complexItem, &ComplexMissionItem::maxAMSLAltitudeChanged,       this, &MissionController::_recalcMissionFlightStatusSignal, Qt::QueuedConnection);
-            connect(complexItem, &ComplexMissionItem::isIncompleteChanged,          this, &MissionController::_recalcFlightPathSegmentsSignal,  Qt::QueuedConnection);
+            connect(complexItem, &ComplexMissionItem::complexDistanceChanged,       this, setFlightStatusDirty);
+            connect(complexItem, &ComplexMissionItem::greatestDistanceToChanged,    this, setFlightStatusDirty);
+            connect(complexItem, &ComplexMissionItem::minAMSLAltitudeChanged,       this, setFlightStatusDirty);
+            connect(complexItem, &ComplexMissionItem::maxAMSLAltitudeChanged,       this, setFlightStatusDirty);
+            connect(complexItem, &ComplexMissionItem::isIncompleteChanged,          this, setFlightPathDirty);
         } else {
             qWarning() << "ComplexMissionItem not found";
         }
@@ -1589,12 +1736,29 @@ void MissionController::_deinitVisualItem(VisualMissionItem* visualItem)
     // A full wildcard disconnect(obj, 0, 0, 0) tears out internal destroyed-signal
     // connections that Qt (and the tree/list models) rely on for cleanup.
     disconnect(visualItem, nullptr, this, nullptr);
+
+    // Segments are keyed by item pointer and a new item could later be allocated at the same address. The segments
+    // themselves stay alive until the next flight path recalc drops them from the models.
+    for (auto it = _flightPathSegmentHashTable.begin(); it != _flightPathSegmentHashTable.end(); ) {
+        if (it.key().first == visualItem || it.key().second == visualItem) {
+            it = _flightPathSegmentHashTable.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void MissionController::_homePositionCoordinateChanged(void)
+{
+    // Every distance is relative to home
+    _setFlightStatusDirty(0);
+    _recalcMissionFlightStatus();
 }
 
 void MissionController::_itemCommandChanged(void)
 {
     _recalcChildItems();
-    emit _recalcFlightPathSegmentsSignal();
+    _setFlightPathDirty(0);
 }
 
 void MissionController::_managerVehicleChanged(Vehicle* managerVehicle)
@@ -1622,8 +1786,8 @@ void MissionController::_managerVehicleChanged(Vehicle* managerVehicle)
     connect(_missionManager, &MissionManager::lastCurrentIndexChanged,  this, &MissionController::resumeMissionIndexChanged);
     connect(_missionManager, &MissionManager::resumeMissionReady,       this, &MissionController::resumeMissionReady);
     connect(_missionManager, &MissionManager::resumeMissionUploadFail,  this, &MissionController::resumeMissionUploadFail);
-    connect(_managerVehicle, &Vehicle::defaultCruiseSpeedChanged,       this, &MissionController::_recalcMissionFlightStatusSignal, Qt::QueuedConnection);
-    connect(_managerVehicle, &Vehicle::defaultHoverSpeedChanged,        this, &MissionController::_recalcMissionFlightStatusSignal, Qt::QueuedConnection);
+    connect(_managerVehicle, &Vehicle::defaultCruiseSpeedChanged,       this, [this]() { _setFlightStatusDirty(0); });
+    connect(_managerVehicle, &Vehicle::defaultHoverSpeedChanged,        this, [this]() { _setFlightStatusDirty(0); });
     connect(_managerVehicle, &Vehicle::vehicleTypeChanged,              this, &MissionController::complexMissionItemsChanged);
 
     emit complexMissionItemsChanged();
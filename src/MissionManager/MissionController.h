@@ -1,12 +1,15 @@
 #pragma once
 
 #include <QtCore/QHash>
+#include <QtCore/QList>
 #include <QtCore/QFile>
 #include <QtCore/QPersistentModelIndex>
 #include <QtCore/QVariant>
 #include <QtPositioning/QGeoCoordinate>
 #include <QtQmlIntegration/QtQmlIntegration>
 
+#include <limits>
+
 #include "PlanElementController.h"
 #include "QmlObjectListModel.h"
 #include "QmlObjectTreeModel.h"
@@ -344,6 +347,7 @@ private slots:
     void _currentMissionIndexChanged            (int sequenceNumber);
     void _recalcFlightPathSegments              (void);
     void _recalcMissionFlightStatus             (void);
+    void _homePositionCoordinateChanged         (void);
     void _progressPctChanged                    (double progressPct);
     void _visualItemsDirtyChanged               (bool dirty);
     void _managerSendComplete                   (bool error);
@@ -383,7 +387,12 @@ private slots:
     void                    _setPlannedHomePositionFromFirstCoordinate(const QGeoCoordinate& clickCoordinate);
     void                    _resetMissionFlightStatus           (void);
     void                    _initLoadedVisualItems              (QmlObjectListModel* loadedVisualItems);
-    FlightPathSegment*      _addFlightPathSegment               (FlightPathSegmentHashTable& prevItemPairHashTable, VisualItemPair& pair, bool mavlinkTerrainFrame);
+    FlightPathSegment*      _addFlightPathSegment               (VisualItemPair& pair, bool mavlinkTerrainFrame, QList<FlightPathSegment*>& replacedSegments);
+    int                     _flightPathResumeIndex              (int firstDirtyIndex) const;
+    void                    _setFlightPathDirty                 (int visualItemIndex);
+    void                    _setFlightPathDirty                 (VisualMissionItem* visualItem);
+    void                    _setFlightStatusDirty               (int visualItemIndex);
+    void                    _setFlightStatusDirty               (VisualMissionItem* visualItem);
     VisualMissionItem*      _insertSimpleMissionItemWorker      (QGeoCoordinate coordinate, MAV_CMD command, int visualItemIndex, bool makeCurrentItem);
     void                    _insertComplexMissionItemWorker     (const QGeoCoordinate& mapCenterCoordinate, ComplexMissionItem* complexItem, int visualItemIndex, bool makeCurrentItem);
     bool                    _isROIBeginItem                     (SimpleMissionItem* simpleItem);
@@ -397,6 +406,21 @@ private slots:
     static bool             _convertToMissionItems              (QmlObjectListModel* visualMissionItems, QList<MissionItem*>& rgMissionItems, QObject* missionItemParent);
 
 private:
+    /// State of the flight path segment walk prior to processing a visual item
+    struct FlightPathCheckpoint {
+        VisualMissionItem*  item =                          nullptr;    ///< Item about to be processed, validates the checkpoint
+        VisualMissionItem*  lastFlyThroughVI =              nullptr;
+        VisualItemPair      lastSegmentVisualItemPair;
+        int                 segmentCount =                  0;          ///< Segments since the last direction arrow
+        int                 simpleFlightPathSegmentCount =  0;
+        int                 directionArrowCount =           0;
+        bool                firstCoordinateNotFound =       true;
+        bool                linkStartToHome =               false;
+        bool                roiActive =                     false;
+        bool                previousItemIsIncomplete =      false;
+        bool                missionContainsVTOLTakeoff =    false;
+    };
+
     Vehicle*                    _controllerVehicle =            nullptr;
     Vehicle*                    _managerVehicle =               nullptr;
     MissionManager*             _missionManager =               nullptr;
@@ -424,6 +448,9 @@ private slots:
     QmlObjectListModel          _simpleFlightPathSegments;
     QmlObjectListModel          _directionArrows;
     FlightPathSegmentHashTable  _flightPathSegmentHashTable;
+    QList<FlightPathCheckpoint> _flightPathCheckpoints;         ///< Indexed by visual item index, stops at the first RTL
+    int                         _flightPathDirtyIndex =         0;  ///< First visual item with stale flight path segments, _notDirty if none
+    int                         _flightStatusDirtyIndex =       0;  ///< First visual item with stale flight status, _notDirty if none
     bool                        _firstItemsFromVehicle =        false;
     bool                        _itemsRequested =               false;
     bool                        _inRecalcSequence =             false;
@@ -465,4 +492,5 @@ private slots:
     static constexpr const char* _jsonGlobalPlanAltitudeModeKey = "globalPlanAltitudeMode";
 
     static constexpr int   _missionFileVersion =            2;
+    static constexpr int   _notDirty =                      std::numeric_limits<int>::max();
 };
@@ -45,13 +45,29 @@ void MissionFlightStatusCalculator::reset(Vehicle* controllerVehicle, Vehicle* m
     }
 }
 
+int MissionFlightStatusCalculator::_resumeIndex(QmlObjectListModel* visualItems, bool missionContainsVTOLTakeoff, int firstDirtyIndex) const
+{
+    if (firstDirtyIndex <= 0 || missionContainsVTOLTakeoff != _checkpointsVTOLTakeoff || _checkpoints.count() != visualItems->count()) {
+        return 0;
+    }
+
+    // Any change in list structure goes through a full recalc, this only guards against a stale dirty index
+    const int index = qMin(firstDirtyIndex, static_cast<int>(_checkpoints.count()) - 1);
+    if (_checkpoints[index].item != visualItems->get(index)) {
+        return 0;
+    }
+
+    return index;
+}
+
 void MissionFlightStatusCalculator::recalc(QmlObjectListModel* visualItems,
                                             MissionSettingsItem* settingsItem,
                                             Vehicle* controllerVehicle,
                                             Vehicle* managerVehicle,
                                             AppSettings* appSettings,
                                             PlanViewSettings* planViewSettings,
-                                            bool missionContainsVTOLTakeoff)
+                                            bool missionContainsVTOLTakeoff,
+                                            int firstDirtyIndex)
 {
     bool                firstCoordinateItem =           true;
     VisualMissionItem*  lastFlyThroughVI =   qobject_cast<VisualMissionItem*>(visualItems->get(0));
@@ -62,26 +78,60 @@ void MissionFlightStatusCalculator::recalc(QmlObjectListModel* visualItems,
     // If home position is not valid we can only calculate distances between waypoints which are
     // both relative altitude.
 
-    // No values for first item
-    lastFlyThroughVI->setAltDifference(0);
-    lastFlyThroughVI->setAzimuth(0);
-    lastFlyThroughVI->setDistance(0);
-    lastFlyThroughVI->setDistanceFromStart(0);
-
-    _minAMSLAltitude = _maxAMSLAltitude = qQNaN();
-
-    reset(controllerVehicle, managerVehicle, missionContainsVTOLTakeoff);
+    const double prevMinAMSLAltitude = _minAMSLAltitude;
+    const double prevMaxAMSLAltitude = _maxAMSLAltitude;
 
     bool   linkStartToHome =            false;
     bool   foundRTL =                   false;
     bool   pastLandCommand =            false;
     double totalHorizontalDistance =    0;
 
-    for (int i=0; i<visualItems->count(); i++) {
+    const int startIndex = _resumeIndex(visualItems, missionContainsVTOLTakeoff, firstDirtyIndex);
+    _lastRecalcStartIndex = startIndex;
+
+    if (startIndex == 0) {
+        // No values for first item
+        lastFlyThroughVI->setAltDifference(0);
+        lastFlyThroughVI->setAzimuth(0);
+        lastFlyThroughVI->setDistance(0);
+        lastFlyThroughVI->setDistanceFromStart(0);
+
+        _minAMSLAltitude = _maxAMSLAltitude = qQNaN();
+
+        reset(controllerVehicle, managerVehicle, missionContainsVTOLTakeoff);
+
+        _checkpoints.resize(visualItems->count());
+        _checkpointsVTOLTakeoff = missionContainsVTOLTakeoff;
+    } else {
+        const Checkpoint& checkpoint = _checkpoints[startIndex];
+        _status =                   checkpoint.status;
+        lastFlyThroughVI =          checkpoint.lastFlyThroughVI;
+        _minAMSLAltitude =          checkpoint.minAMSLAltitude;
+        _maxAMSLAltitude =          checkpoint.maxAMSLAltitude;
+        totalHorizontalDistance =   checkpoint.totalHorizontalDistance;
+        firstCoordinateItem =       checkpoint.firstCoordinateItem;
+        linkStartToHome =           checkpoint.linkStartToHome;
+        foundRTL =                  checkpoint.foundRTL;
+        pastLandCommand =           checkpoint.pastLandCommand;
+    }
+
+    for (int i=startIndex; i<visualItems->count(); i++) {
         VisualMissionItem*  item =          qobject_cast<VisualMissionItem*>(visualItems->get(i));
         SimpleMissionItem*  simpleItem =    qobject_cast<SimpleMissionItem*>(item);
         ComplexMissionItem* complexItem =   qobject_cast<ComplexMissionItem*>(item);
 
+        Checkpoint& checkpoint =            _checkpoints[i];
+        checkpoint.item =                   item;
+        checkpoint.status =                 _status;
+        checkpoint.lastFlyThroughVI =       lastFlyThroughVI;
+        checkpoint.minAMSLAltitude =        _minAMSLAltitude;
+        checkpoint.maxAMSLAltitude =        _maxAMSLAltitude;
+        checkpoint.totalHorizontalDistance = totalHorizontalDistance;
+        checkpoint.firstCoordinateItem =    firstCoordinateItem;
+        checkpoint.linkStartToHome =        linkStartToHome;
+        checkpoint.foundRTL =               foundRTL;
+        checkpoint.pastLandCommand =        pastLandCommand;
+
         if (simpleItem && simpleItem->mavCommand() == MAV_CMD_NAV_RETURN_TO_LAUNCH) {
             foundRTL = true;
         }
@@ -297,9 +347,11 @@ void MissionFlightStatusCalculator::recalc(QmlObjectListModel* visualItems,
         _maxAMSLAltitude = std::fmax(_maxAMSLAltitude, settingsItem->plannedHomePositionAltitude()->rawValue().toDouble());
     }
 
-    // Walk the list calculating altitude percentages
+    // Walk the list calculating altitude percentages. Items before the resume point only need an update if the range moved.
+    const auto sameAltitude = [](double a, double b) { return (qIsNaN(a) && qIsNaN(b)) || a == b; };
+    const bool altRangeChanged = !sameAltitude(_minAMSLAltitude, prevMinAMSLAltitude) || !sameAltitude(_maxAMSLAltitude, prevMaxAMSLAltitude);
     double altRange = _maxAMSLAltitude - _minAMSLAltitude;
-    for (int i=0; i<visualItems->count(); i++) {
+    for (int i=(altRangeChanged ? 0 : startIndex); i<visualItems->count(); i++) {
         VisualMissionItem* item = qobject_cast<VisualMissionItem*>(visualItems->get(i));
 
         if (item->specifiesCoordinate()) {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <QtCore/QList>
+
 #include "MissionFlightStatus.h"
 
 class AppSettings;
@@ -16,21 +18,33 @@ class VisualMissionItem;
 /// from a list of visual mission items and vehicle properties.
 /// Extracted from MissionController to reduce its complexity.
 ///
+/// The running state before each item is checkpointed, so a recalc after a single item
+/// changed only re-walks that item and the ones following it.
+///
 class MissionFlightStatusCalculator
 {
 public:
     /// Resets the flight status fields to defaults based on vehicle properties.
     void reset(Vehicle* controllerVehicle, Vehicle* managerVehicle, bool missionContainsVTOLTakeoff);
 
-    /// Runs the full recalculation over all visual items, updating per-item
+    /// Runs the recalculation over the visual items, updating per-item
     /// display properties and computing aggregate flight statistics.
+    ///     @param firstDirtyIndex Index of the first item which changed since the last recalc. Items before it
+    ///                            are not visited again. 0 forces a full recalc.
     void recalc(QmlObjectListModel* visualItems,
                 MissionSettingsItem* settingsItem,
                 Vehicle* controllerVehicle,
                 Vehicle* managerVehicle,
                 AppSettings* appSettings,
                 PlanViewSettings* planViewSettings,
-                bool missionContainsVTOLTakeoff);
+                bool missionContainsVTOLTakeoff,
+                int firstDirtyIndex = 0);
+
+    /// Drops the checkpoints so the next recalc is a full one
+    void invalidate() { _checkpoints.clear(); }
+
+    /// @return Index the last recalc started walking from, 0 for a full recalc
+    int lastRecalcStartIndex() const { return _lastRecalcStartIndex; }
 
     const MissionFlightStatus_t& status() const { return _status; }
     double minAMSLAltitude() const { return _minAMSLAltitude; }
@@ -41,6 +55,21 @@ class MissionFlightStatusCalculator
     static double calcDistanceToHome(VisualMissionItem* currentItem, VisualMissionItem* homeItem);
 
 private:
+    /// Running state of the walk prior to processing an item
+    struct Checkpoint {
+        VisualMissionItem*      item =                      nullptr;    ///< Item about to be processed, validates the checkpoint
+        MissionFlightStatus_t   status {};
+        VisualMissionItem*      lastFlyThroughVI =          nullptr;
+        double                  minAMSLAltitude =           0;
+        double                  maxAMSLAltitude =           0;
+        double                  totalHorizontalDistance =   0;
+        bool                    firstCoordinateItem =       true;
+        bool                    linkStartToHome =           false;
+        bool                    foundRTL =                  false;
+        bool                    pastLandCommand =           false;
+    };
+
+    int  _resumeIndex(QmlObjectListModel* visualItems, bool missionContainsVTOLTakeoff, int firstDirtyIndex) const;
     void _updateBatteryInfo(int waypointIndex);
     void _addHoverTime(double hoverTime, double hoverDistance, int waypointIndex);
     void _addCruiseTime(double cruiseTime, double cruiseDistance, int waypointIndex);
@@ -51,4 +80,8 @@ class MissionFlightStatusCalculator
     MissionFlightStatus_t _status {};
     double _minAMSLAltitude = 0;
     double _maxAMSLAltitude = 0;
+
+    QList<Checkpoint> _checkpoints;                         ///< Indexed by visual item index
+    bool _checkpointsVTOLTakeoff = false;                   ///< missionContainsVTOLTakeoff the checkpoints were built with
+    int _lastRecalcStartIndex = 0;
 };
@@ -1,7 +1,6 @@
 #include "SurveyComplexItem.h"
 #include "JsonParsing.h"
 #include "QGCGeo.h"
-#include "QGCQGeoCoordinate.h"
 #include "SettingsManager.h"
 #include "AppSettings.h"
 #include "PlanMasterController.h"
@@ -421,7 +420,7 @@ bool SurveyComplexItem::_gridAngleIsNorthSouthTransects()
     return gridAngle < 45.0 || (gridAngle > 360.0 - 45.0) || (gridAngle > 90.0 + 45.0 && gridAngle < 270.0 - 45.0);
 }
 
-void SurveyComplexItem::_adjustTransectsToEntryPointLocation(QList<QList<QGeoCoordinate>>& transects)
+void SurveyComplexItem::_adjustTransectsToEntryPointLocation(QList<QList<QGeoCoordinate>>& transects, int entryPoint)
 {
     if (transects.count() == 0) {
         return;
@@ -430,10 +429,10 @@ void SurveyComplexItem::_adjustTransectsToEntryPointLocation(QList<QList<QGeoCoo
     bool reversePoints = false;
     bool reverseTransects = false;
 
-    if (_entryPoint == EntryLocationBottomLeft || _entryPoint == EntryLocationBottomRight) {
+    if (entryPoint == EntryLocationBottomLeft || entryPoint == EntryLocationBottomRight) {
         reversePoints = true;
     }
-    if (_entryPoint == EntryLocationTopRight || _entryPoint == EntryLocationBottomRight) {
+    if (entryPoint == EntryLocationTopRight || entryPoint == EntryLocationBottomRight) {
         reverseTransects = true;
     }
 
@@ -446,7 +445,7 @@ void SurveyComplexItem::_adjustTransectsToEntryPointLocation(QList<QList<QGeoCoo
         _reverseTransectOrder(transects);
     }
 
-    qCDebug(SurveyComplexItemLog) << "_adjustTransectsToEntryPointLocation Modified entry point:entryLocation" << transects.first().first() << _entryPoint;
+    qCDebug(SurveyComplexItemLog) << "_adjustTransectsToEntryPointLocation Modified entry point:entryLocation" << transects.first().first() << entryPoint;
 }
 
 QPointF SurveyComplexItem::_rotatePoint(const QPointF& point, const QPointF& origin, double angle)
@@ -521,11 +520,15 @@ void SurveyComplexItem::_intersectLinesWithRect(const QList<QLineF>& lineList, c
     }
 }
 
-void SurveyComplexItem::_intersectLinesWithPolygon(const QList<QLineF>& lineList, const QPolygonF& polygon, QList<QLineF>& resultLines)
+void SurveyComplexItem::_intersectLinesWithPolygon(const QList<QLineF>& lineList, const QPolygonF& polygon, QList<QLineF>& resultLines, const std::atomic<bool>& canceled)
 {
     resultLines.clear();
 
     for (int i=0; i<lineList.count(); i++) {
+        if (canceled.load(std::memory_order_relaxed)) {
+            return;
+        }
+
         const QLineF& line = lineList[i];
         QList<QPointF> intersections;
 
@@ -622,38 +625,69 @@ double SurveyComplexItem::_turnaroundDistance(void) const
 }
 
 void SurveyComplexItem::_rebuildTransectsPhase1(void)
-{
-    _rebuildTransectsPhase1WorkerSinglePolygon(false /* refly */);
-    if (_refly90DegreesFact.rawValue().toBool()) {
-        _rebuildTransectsPhase1WorkerSinglePolygon(true /* refly */);
-    }
-}
-
-void SurveyComplexItem::_rebuildTransectsPhase1WorkerSinglePolygon(bool refly)
 {
     if (_ignoreRecalc) {
         return;
     }
 
     // If the transects are getting rebuilt then any previously loaded mission items are now invalid
-    if (_loadedMissionItemsParent) {
-        _loadedMissionItems.clear();
-        _loadedMissionItemsParent->deleteLater();
-        _loadedMissionItemsParent = nullptr;
+    _clearLoadedMissionItems();
+
+    const std::atomic<bool> notCanceled(false);
+    _transects = _buildTransects(_transectSnapshot(), notCanceled);
+}
+
+TransectStyleComplexItem::TransectBuilder_t SurveyComplexItem::_transectBuilder(void)
+{
+    const TransectSnapshot_t snapshot = _transectSnapshot();
+    return [snapshot](const std::atomic<bool>& canceled) {
+        return _buildTransects(snapshot, canceled);
+    };
+}
+
+SurveyComplexItem::TransectSnapshot_t SurveyComplexItem::_transectSnapshot(void) const
+{
+    TransectSnapshot_t snapshot;
+
+    snapshot.polygon                = _surveyAreaPolygon.coordinateList();
+    snapshot.gridAngle              = _gridAngleFact.rawValue().toDouble();
+    snapshot.gridSpacing            = _cameraCalc.adjustedFootprintSide()->rawValue().toDouble();
+    snapshot.entryPoint             = _entryPoint;
+    snapshot.flyAlternateTransects  = _flyAlternateTransectsFact.rawValue().toBool();
+    snapshot.refly90Degrees         = _refly90DegreesFact.rawValue().toBool();
+    snapshot.triggerDistance        = triggerDistance();
+    snapshot.hoverAndCapture        = hoverAndCaptureEnabled();
+    snapshot.turnAroundDistance     = _turnAroundDistanceFact.rawValue().toDouble();
+
+    return snapshot;
+}
+
+SurveyComplexItem::Transects_t SurveyComplexItem::_buildTransects(const TransectSnapshot_t& snapshot, const std::atomic<bool>& canceled)
+{
+    Transects_t rgTransects;
+
+    _buildTransectsSinglePolygon(snapshot, false /* refly */, rgTransects, canceled);
+    if (snapshot.refly90Degrees && !rgTransects.isEmpty()) {
+        _buildTransectsSinglePolygon(snapshot, true /* refly */, rgTransects, canceled);
     }
 
-    if (_surveyAreaPolygon.count() < 3) {
+    return rgTransects;
+}
+
+void SurveyComplexItem::_buildTransectsSinglePolygon(const TransectSnapshot_t& snapshot, bool refly, Transects_t& rgTransects, const std::atomic<bool>& canceled)
+{
+    if (snapshot.polygon.count() < 3) {
         return;
     }
 
     // Convert polygon to NED
 
     QList<QPointF> polygonPoints;
-    QGeoCoordinate tangentOrigin = _surveyAreaPolygon.pathModel().value<QGCQGeoCoordinate*>(0)->coordinate();
-    qCDebug(SurveyComplexItemLog) << "_rebuildTransectsPhase1 Convert polygon to NED - _surveyAreaPolygon.count():tangentOrigin" << _surveyAreaPolygon.count() << tangentOrigin;
-    for (int i=0; i<_surveyAreaPolygon.count(); i++) {
+    QGeoCoordinate tangentOrigin = snapshot.polygon[0];
+    qCDebug(SurveyComplexItemLog) << "_rebuildTransectsPhase1 Convert polygon to NED - polygon count:tangentOrigin" << snapshot.polygon.count() << tangentOrigin;
+    for (int i=0; i<snapshot.polygon.count(); i++) {
         double y, x, down;
-        QGeoCoordinate vertex = _surveyAreaPolygon.pathModel().value<QGCQGeoCoordinate*>(i)->coordinate();
+        QGeoCoordinate vertex = snapshot.polygon[i];
         if (i == 0) {
             // This avoids a nan calculation that comes out of convertGeoToNed
             x = y = 0;
@@ -666,8 +700,8 @@ void SurveyComplexItem::_rebuildTransectsPhase1WorkerSinglePolygon(bool refly)
 
     // Generate transects
 
-    double gridAngle = _gridAngleFact.rawValue().toDouble();
-    double gridSpacing = _cameraCalc.adjustedFootprintSide()->rawValue().toDouble();
+    double gridAngle = snapshot.gridAngle;
+    double gridSpacing = snapshot.gridSpacing;
 
     gridAngle = _clampGridAngle90(gridAngle);
     gridAngle += refly ? 90 : 0;
@@ -732,10 +766,14 @@ void SurveyComplexItem::_rebuildTransectsPhase1WorkerSinglePolygon(bool refly)
         }
     }
 
+    if (canceled.load(std::memory_order_relaxed)) {
+        return;
+    }
+
     // Now intersect the lines with the polygon
     QList<QLineF> intersectLines;
 #if 1
-    _intersectLinesWithPolygon(lineList, polygon, intersectLines);
+    _intersectLinesWithPolygon(lineList, polygon, intersectLines, canceled);
 #else
     // This is handy for debugging grid problems, not for release
     intersectLines = lineList;
@@ -744,8 +782,10 @@ void SurveyComplexItem::_rebuildTransectsPhase1WorkerSinglePolygon(bool refly)
     // Less than two transects intersected with the polygon:
     //      Create a single transect which goes through the center of the polygon
     //      Intersect it with the polygon
+    if (canceled.load(std::memory_order_relaxed)) {
+        return;
+    }
     if (intersectLines.count() < 2) {
-        _surveyAreaPolygon.center();
         QLineF firstLine = lineList.first();
         QPointF lineCenter = firstLine.pointAt(0.5);
         QPointF centerOffset = boundingCenter - lineCenter;
@@ -753,7 +793,7 @@ void SurveyComplexItem::_rebuildTransectsPhase1WorkerSinglePolygon(bool refly)
         lineList.clear();
         lineList.append(firstLine);
         intersectLines = lineList;
-        _intersectLinesWithPolygon(lineList, polygon, intersectLines);
+        _intersectLinesWithPolygon(lineList, polygon, intersectLines, canceled);
     }
 
     // Make sure all lines are going the same direction. Polygon intersection leads to lines which
@@ -775,13 +815,13 @@ void SurveyComplexItem::_rebuildTransectsPhase1WorkerSinglePolygon(bool refly)
         transects.append(transect);
     }
 
-    _adjustTransectsToEntryPointLocation(transects);
+    _adjustTransectsToEntryPointLocation(transects, snapshot.entryPoint);
 
     if (refly) {
-        _optimizeTransectsForShortestDistance(_transects.last().last().coord, transects);
+        _optimizeTransectsForShortestDistance(rgTransects.last().last().coord, transects);
     }
 
-    if (_flyAlternateTransectsFact.rawValue().toBool()) {
+    if (snapshot.flyAlternateTransects) {
         QList<QList<QGeoCoordinate>> alternatingTransects;
         for (int i=0; i<transects.count(); i++) {
             if (!(i & 1)) {
@@ -814,7 +854,8 @@ void SurveyComplexItem::_rebuildTransectsPhase1WorkerSinglePolygon(bool refly)
         transects[i] = transectVertices;
     }
 
-    // Convert to CoordInfo transects and append to _transects
+    // Convert to CoordInfo transects and append to rgTransects
+    const bool triggerCamera = snapshot.triggerDistance != 0;
     for (const QList<QGeoCoordinate>& transect : transects) {
         QGeoCoordinate                                  coord;
         QList<TransectStyleComplexItem::CoordInfo_t>    coordInfoTransect;
@@ -826,14 +867,14 @@ void SurveyComplexItem::_rebuildTransectsPhase1WorkerSinglePolygon(bool refly)
         coordInfoTransect.append(coordInfo);
 
         // For hover and capture we need points for each camera location within the transect
-        if (triggerCamera() && hoverAndCaptureEnabled()) {
+        if (triggerCamera && snapshot.hoverAndCapture) {
             double transectLength = transect[0].distanceTo(transect[1]);
             double transectAzimuth = transect[0].azimuthTo(transect[1]);
-            if (triggerDistance() < transectLength) {
-                int cInnerHoverPoints = static_cast<int>(floor(transectLength / triggerDistance()));
+            if (snapshot.triggerDistance < transectLength) {
+                int cInnerHoverPoints = static_cast<int>(floor(transectLength / snapshot.triggerDistance));
                 qCDebug(SurveyComplexItemLog) << "cInnerHoverPoints" << cInnerHoverPoints;
                 for (int i=0; i<cInnerHoverPoints; i++) {
-                    QGeoCoordinate hoverCoord = transect[0].atDistanceAndAzimuth(triggerDistance() * (i + 1), transectAzimuth);
+                    QGeoCoordinate hoverCoord = transect[0].atDistanceAndAzimuth(snapshot.triggerDistance * (i + 1), transectAzimuth);
                     TransectStyleComplexItem::CoordInfo_t hoverCoordInfo = { hoverCoord, CoordTypeInteriorHoverTrigger };
                     coordInfoTransect.insert(1 + i, hoverCoordInfo);
                 }
@@ -841,9 +882,9 @@ void SurveyComplexItem::_rebuildTransectsPhase1WorkerSinglePolygon(bool refly)
         }
 
         // Extend the transect ends for turnaround
-        if (_hasTurnaround()) {
+        if (snapshot.turnAroundDistance > 0) {
             QGeoCoordinate turnaroundCoord;
-            double turnAroundDistance = _turnAroundDistanceFact.rawValue().toDouble();
+            double turnAroundDistance = snapshot.turnAroundDistance;
 
             double azimuth = transect[0].azimuthTo(transect[1]);
             turnaroundCoord = transect[0].atDistanceAndAzimuth(-turnAroundDistance, azimuth);
@@ -858,7 +899,7 @@ void SurveyComplexItem::_rebuildTransectsPhase1WorkerSinglePolygon(bool refly)
             coordInfoTransect.append(coordInfo);
         }
 
-        _transects.append(coordInfoTransect);
+        rgTransects.append(coordInfoTransect);
     }
 }
 
@@ -14,6 +14,7 @@
 #include "Vehicle.h"
 #include "QGCLoggingCategory.h"
 
+#include <QtConcurrent/QtConcurrentRun>
 #include <QtCore/QJsonArray>
 
 QGC_LOGGING_CATEGORY(TransectStyleComplexItemLog, "Plan.TransectStyleComplexItem")
@@ -34,6 +35,10 @@ TransectStyleComplexItem::TransectStyleComplexItem(PlanMasterController* masterC
     _terrainPolyPathQueryTimer.setSingleShot(true);
     connect(&_terrainPolyPathQueryTimer, &QTimer::timeout, this, &TransectStyleComplexItem::_reallyQueryTransectsPathHeightInfo);
 
+    // Unit tests expect the transects to be up to date as soon as a setting changes. They opt into background builds explicitly.
+    _backgroundTransectBuild = !QGC::runningUnitTests();
+    connect(&_transectBuildWatcher, &QFutureWatcher<Transects_t>::finished, this, &TransectStyleComplexItem::_transectBuildFinished);
+
     // The follow is used to compress multiple recalc calls in a row to into a single call.
     connect(this, &TransectStyleComplexItem::_updateFlightPathSegmentsSignal, this, &TransectStyleComplexItem::_updateFlightPathSegmentsDontCallDirectly,   Qt::QueuedConnection);
     qgcApp()->addCompressedSignal(QMetaMethod::fromSignal(&TransectStyleComplexItem::_updateFlightPathSegmentsSignal));
@@ -102,6 +107,12 @@ TransectStyleComplexItem::TransectStyleComplexItem(PlanMasterController* masterC
     setDirty(false);
 }
 
+TransectStyleComplexItem::~TransectStyleComplexItem()
+{
+    // The worker only holds its own settings snapshot so it can safely outlive us, just tell it to stop early
+    _cancelTransectBuild();
+}
+
 void TransectStyleComplexItem::_setCameraShots(int cameraShots)
 {
     if (_cameraShots != cameraShots) {
@@ -143,6 +154,9 @@ void TransectStyleComplexItem::setCoordinate(const QGeoCoordinate& coordinate)
 
 void TransectStyleComplexItem::_save(QJsonObject& complexObject)
 {
+    // Visual transect points and mission items must match the current settings
+    _waitForTransectBuild();
+
     QJsonObject innerObject;
 
     innerObject[JsonParsing::jsonVersionKey] =       2;
@@ -203,6 +217,9 @@ bool TransectStyleComplexItem::_load(const QJsonObject& complexObject, bool forP
         return false;
     }
 
+    // Results of a rebuild started before the load no longer match the item
+    _cancelTransectBuild();
+
     // The TransectStyleComplexItem is a sub-object of the main complex item object
     QJsonObject innerObject = complexObject[_jsonTransectStyleComplexItemKey].toObject();
 
@@ -403,12 +420,75 @@ void TransectStyleComplexItem::_rebuildTransects(void)
         return;
     }
 
-    _transects.clear();
+    // Anything still in flight was built from stale settings
+    _cancelTransectBuild();
+
+    const TransectBuilder_t builder = _backgroundTransectBuild ? _transectBuilder() : TransectBuilder_t();
+    if (!builder) {
+        _transects.clear();
+        _rebuildTransectsPhase1();
+        _rebuildTransectsPhase2();
+        return;
+    }
+
+    // If the transects are getting rebuilt then any previously loaded mission items are now invalid
+    _clearLoadedMissionItems();
+
+    const std::shared_ptr<std::atomic<bool>> canceled = std::make_shared<std::atomic<bool>>(false);
+    _transectBuildCanceled = canceled;
+    _transectBuildPending = true;
+    _transectBuildWatcher.setFuture(QtConcurrent::run([builder, canceled]() {
+        return builder(*canceled);
+    }));
+}
+
+void TransectStyleComplexItem::_cancelTransectBuild(void)
+{
+    if (_transectBuildCanceled) {
+        _transectBuildCanceled->store(true, std::memory_order_relaxed);
+        _transectBuildCanceled.reset();
+    }
+    _transectBuildPending = false;
+}
+
+void TransectStyleComplexItem::_transectBuildFinished(void)
+{
+    // Not pending: canceled, or already applied by _waitForTransectBuild
+    if (!_transectBuildPending) {
+        return;
+    }
+
+    _transectBuildPending = false;
+    _transectBuildCanceled.reset();
+    _transects = _transectBuildWatcher.result();
+    qCDebug(TransectStyleComplexItemLog) << "Background transect build finished - transect count" << _transects.count();
+
+    _rebuildTransectsPhase2();
+}
+
+void TransectStyleComplexItem::_waitForTransectBuild(void)
+{
+    if (_transectBuildPending) {
+        _transectBuildWatcher.waitForFinished();
+        _transectBuildFinished();
+    }
+}
+
+void TransectStyleComplexItem::_clearLoadedMissionItems(void)
+{
+    if (_loadedMissionItemsParent) {
+        _loadedMissionItems.clear();
+        _loadedMissionItemsParent->deleteLater();
+        _loadedMissionItemsParent = nullptr;
+    }
+}
+
+/// Everything after _transects has been rebuilt: flight path, visuals and the values derived from them
+void TransectStyleComplexItem::_rebuildTransectsPhase2(void)
+{
     _rgPathHeightInfo.clear();
     _rgFlightPathCoordInfo.clear();
 
-    _rebuildTransectsPhase1();
-
     _minAMSLAltitude = _maxAMSLAltitude = qQNaN();
 
     switch (_cameraCalc.distanceMode()) {
@@ -1122,6 +1202,8 @@ void TransectStyleComplexItem::_handleHoverAndCaptureEnabled(QVariant enabled)
 
 void TransectStyleComplexItem::appendMissionItems(QList<MissionItem*>& items, QObject* missionItemParent)
 {
+    _waitForTransectBuild();
+
     if (_loadedMissionItems.count()) {
         // We have mission items from the loaded plan, use those
         _appendLoadedMissionItems(items, missionItemParent);
@@ -7,6 +7,12 @@
 #include "CameraCalc.h"
 #include "TerrainQuery.h"
 
+#include <QtCore/QFutureWatcher>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
 class PlanMasterController;
 
 class TransectStyleComplexItem : public ComplexMissionItem
@@ -15,6 +21,7 @@ class TransectStyleComplexItem : public ComplexMissionItem
 
 public:
     TransectStyleComplexItem(PlanMasterController* masterController, bool flyView, QString settignsGroup);
+    ~TransectStyleComplexItem();
 
     Q_PROPERTY(QGCMapPolygon*   surveyAreaPolygon           READ surveyAreaPolygon                                  CONSTANT)
     Q_PROPERTY(CameraCalc*      cameraCalc                  READ cameraCalc                                         CONSTANT)
@@ -57,8 +64,12 @@ class TransectStyleComplexItem : public ComplexMissionItem
     bool    hoverAndCaptureEnabled  (void) const { return hoverAndCapture()->rawValue().toBool(); }
     bool    triggerCamera           (void) const { return triggerDistance() != 0; }
 
+    /// true: A background transect rebuild is running and its results have not been applied yet
+    bool transectBuildPending(void) const { return _transectBuildPending; }
+
     // Used internally only by unit tests
     int _transectCount(void) const { return _transects.count(); }
+    void _setBackgroundTransectBuild(bool background) { _backgroundTransectBuild = background; }
 
     // Overrides from ComplexMissionItem
     int     lastSequenceNumber  (void) const final;
@@ -164,6 +175,20 @@ protected slots:
         CoordType       coordType;
     } CoordInfo_t;
 
+    typedef QList<QList<CoordInfo_t>> Transects_t;
+
+    /// Builds the transects on a worker thread. It must only use the settings snapshot it captured and should return
+    /// early once canceled is set, the result of a canceled build is thrown away.
+    typedef std::function<Transects_t(const std::atomic<bool>& canceled)> TransectBuilder_t;
+
+    /// Returns a builder for the current settings. The default empty builder rebuilds _transects synchronously
+    /// through _rebuildTransectsPhase1.
+    virtual TransectBuilder_t _transectBuilder(void) { return TransectBuilder_t(); }
+
+    /// Applies a pending background rebuild right away, waiting for the worker if needed
+    void _waitForTransectBuild(void);
+    void _clearLoadedMissionItems(void);
+
     QVariantList                                _visualTransectPoints;                          ///< Used to draw the flight path visuals on the screen
     QList<QList<CoordInfo_t>>                   _transects;
     QList<TerrainPathQuery::PathHeightInfo_t>   _rgPathHeightInfo;                              ///< Path height for each segment includes turn segments
@@ -209,6 +234,7 @@ private slots:
     void _updateFlightPathSegmentsDontCallDirectly  (void);
     void _segmentTerrainCollisionChanged            (bool terrainCollision) final;
     void _distanceModeChanged                       (int distanceMode);
+    void _transectBuildFinished                     (void);
 
 private:
     typedef struct {
@@ -218,6 +244,8 @@ private slots:
         bool useConditionGate;
     } BuildMissionItemsState_t;
 
+    void    _rebuildTransectsPhase2                                         (void);
+    void    _cancelTransectBuild                                            (void);
     void    _queryTransectsPathHeightInfo                                   (void);
     void    _queryMissionItemCoordHeights                                   (void);
     void    _adjustForAvailableTerrainData                                  (void);
@@ -235,6 +263,11 @@ private slots:
     TerrainAtCoordinateQuery*   _currentTerrainAtCoordinateQuery    = nullptr;
     QTimer                      _terrainPolyPathQueryTimer;
 
+    QFutureWatcher<Transects_t>         _transectBuildWatcher;
+    std::shared_ptr<std::atomic<bool>>  _transectBuildCanceled;                 ///< Cancel flag of the in flight build
+    bool                                _transectBuildPending       = false;
+    bool                                _backgroundTransectBuild    = true;
+
     // Deprecated json keys
     static constexpr const char* _jsonTerrainFollowKeyDeprecated = "FollowTerrain";
 };
@@ -317,14 +317,31 @@ QList<QPointF> QGCMapPolyline::nedPolyline(void)
 }
 
 QList<QGeoCoordinate> QGCMapPolyline::offsetPolyline(double distance)
+{
+    return offsetPolyline(coordinateList(), distance);
+}
+
+QList<QGeoCoordinate> QGCMapPolyline::offsetPolyline(const QList<QGeoCoordinate>& vertices, double distance)
 {
     QList<QGeoCoordinate> rgNewPolyline;
 
     // I'm sure there is some beautiful famous algorithm to do this, but here is a brute force method
 
-    if (count() > 1) {
+    if (vertices.count() > 1) {
+        const QGeoCoordinate tangentOrigin = vertices[0];
+
         // Convert the polygon to NED
-        QList<QPointF> rgNedVertices = nedPolyline();
+        QList<QPointF> rgNedVertices;
+        for (int i=0; i<vertices.count(); i++) {
+            double y, x, down;
+            if (i == 0) {
+                // This avoids a nan calculation that comes out of convertGeoToNed
+                x = y = 0;
+            } else {
+                QGCGeo::convertGeoToNed(vertices[i], tangentOrigin, y, x, down);
+            }
+            rgNedVertices += QPointF(x, y);
+        }
 
         // Walk the edges, offsetting by the specified distance
         QList<QLineF> rgOffsetEdges;
@@ -345,8 +362,6 @@ QList<QGeoCoordinate> QGCMapPolyline::offsetPolyline(double distance)
             rgOffsetEdges.append(offsetEdge);
         }
 
-        QGeoCoordinate  tangentOrigin = vertexCoordinate(0);
-
         // Add first vertex
         QGeoCoordinate coord;
         QGCGeo::convertNedToGeo(rgOffsetEdges[0].p1().y(), rgOffsetEdges[0].p1().x(), 0, tangentOrigin, coord);
@@ -47,6 +47,10 @@ class QGCMapPolyline : public QObject
     /// @return Offset set of vertices
     QList<QGeoCoordinate> offsetPolyline(double distance);
 
+    /// Offsets the edges of the specified polyline by the specified distance in meters. Safe to call from any thread.
+    /// @return Offset set of vertices
+    static QList<QGeoCoordinate> offsetPolyline(const QList<QGeoCoordinate>& vertices, double distance);
+
     /// Loads a polyline from a KML/SHP file
     /// @return true: success
     Q_INVOKABLE bool loadKMLOrSHPFile(const QString &file);
@@ -8,20 +8,32 @@
 #include "QGCNetworkHelper.h"
 #include "QGCMapTasks.h"
 #include "QGCMapUrlEngine.h"
+#include "QGCTileDownloadEngine.h"
 #include "QGeoFileTileCacheQGC.h"
 #include "QGeoTileFetcherQGC.h"
 
+#include <QtCore/QTimer>
+#include <QtNetwork/QNetworkAccessManager>
+
 QGC_LOGGING_CATEGORY(QGCCachedTileSetLog, "QtLocationPlugin.QGCCachedTileSet")
 
 QGCCachedTileSet::QGCCachedTileSet(const QString &name, QObject *parent)
     : QObject(parent)
     , _name(name)
+    , _stateFlushTimer(new QTimer(this))
 {
     qCDebug(QGCCachedTileSetLog) << this;
+
+    _stateFlushTimer->setSingleShot(true);
+    _stateFlushTimer->setInterval(kStateFlushIntervalMs);
+    (void) connect(_stateFlushTimer, &QTimer::timeout, this, &QGCCachedTileSet::_flushTileStates);
 }
 
 QGCCachedTileSet::~QGCCachedTileSet()
 {
+    // Tiles already downloaded must not be fetched again when the set is resumed
+    _flushTileStates();
+
     qCDebug(QGCCachedTileSetLog) << this;
 }
 
@@ -70,7 +82,7 @@ void QGCCachedTileSet::resumeDownloadTask()
 {
     _cancelPending = false;
 
-    QGCUpdateTileDownloadStateTask *task = new QGCUpdateTileDownloadStateTask(_id, QGCTile::StatePending, "*");
+    QGCUpdateTileDownloadStateTask *task = new QGCUpdateTileDownloadStateTask(_id, QGCTile::StatePending, QStringLiteral("*"));
     if (!getQGCMapEngine()->addTask(task)) {
         task->deleteLater();
     }
@@ -81,6 +93,10 @@ void QGCCachedTileSet::resumeDownloadTask()
 void QGCCachedTileSet::cancelDownloadTask()
 {
     _cancelPending = true;
+
+    if (_downloading) {
+        _prepareDownload();
+    }
 }
 
 void QGCCachedTileSet::_tileListFetched(const QQueue<QGCTile*> &tiles)
@@ -90,17 +106,43 @@ void QGCCachedTileSet::_tileListFetched(const QQueue<QGCTile*> &tiles)
         _noMoreTiles = true;
     }
 
-    if (tiles.isEmpty()) {
-        _doneWithDownload();
+    if (_cancelPending) {
+        // Batch was requested before the cancel, hand it back to the database without starting any download
+        if (!tiles.isEmpty()) {
+            QStringList hashes;
+            hashes.reserve(tiles.size());
+            for (QGCTile *tile : tiles) {
+                hashes.append(tile->hash);
+                delete tile;
+            }
+            _addTileStateTask(QGCTile::StatePending, hashes);
+        }
+        _prepareDownload();
         return;
     }
 
-    if (!_networkManager) {
+    if (!tiles.isEmpty() && !_downloadEngine) {
         _networkManager = new QNetworkAccessManager(this);
         QGCNetworkHelper::configureProxy(_networkManager);
+        _downloadEngine = new QGCTileDownloadEngine(_networkManager, this);
+        _downloadEngine->setInitialConcurrency(static_cast<int>(QGeoTileFetcherQGC::concurrentDownloads(_type)));
+        (void) connect(_downloadEngine, &QGCTileDownloadEngine::tileDownloaded, this, &QGCCachedTileSet::_tileDownloaded);
+        (void) connect(_downloadEngine, &QGCTileDownloadEngine::tileFailed, this, &QGCCachedTileSet::_tileDownloadFailed);
+    }
+
+    for (QGCTile *tile : tiles) {
+        QNetworkRequest request = QGeoTileFetcherQGC::getNetworkRequest(tile->type, tile->x, tile->y, tile->z);
+        if (request.url().isValid()) {
+            request.setOriginatingObject(this);
+            _downloadEngine->enqueue(tile->hash, request);
+        } else {
+            qCWarning(QGCCachedTileSetLog) << "Invalid URL for tile" << tile->hash << "- skipping";
+            setErrorCount(_errorCount + 1);
+            _recordTileState(tile->hash, QGCTile::StateError);
+        }
+        delete tile;
     }
 
-    _tilesToDownload.append(tiles);
     _prepareDownload();
 }
 
@@ -123,168 +165,154 @@ void QGCCachedTileSet::_doneWithDownload()
     setDownloading(false);
 
     emit completeChanged();
+    emit downloadRateChanged();
+}
+
+qsizetype QGCCachedTileSet::_pendingDownloads() const
+{
+    return _downloadEngine ? _downloadEngine->pendingCount() : 0;
 }
 
 void QGCCachedTileSet::_prepareDownload()
 {
-    if (_tilesToDownload.isEmpty()) {
-        if (_noMoreTiles) {
-            _doneWithDownload();
-        } else if (!_batchRequested) {
-            createDownloadTask();
+    if (_cancelPending) {
+        // Tiles which have not started go back to pending so the next download picks them up from the database
+        if (_downloadEngine) {
+            const QStringList dropped = _downloadEngine->clearQueued();
+            if (!dropped.isEmpty()) {
+                _addTileStateTask(QGCTile::StatePending, dropped);
+            }
+        }
+        if ((_pendingDownloads() == 0) && !_batchRequested) {
+            _flushTileStates();
+            setDownloading(false);
+            emit downloadRateChanged();
         }
         return;
     }
 
-    for (qsizetype i = _replies.count(); i < QGeoTileFetcherQGC::concurrentDownloads(_type); i++) {
-        if (_tilesToDownload.isEmpty()) {
-            break;
-        }
-
-        QGCTile* const tile = _tilesToDownload.dequeue();
-        QNetworkRequest request = QGeoTileFetcherQGC::getNetworkRequest(tile->type, tile->x, tile->y, tile->z);
-        if (!request.url().isValid()) {
-            qCWarning(QGCCachedTileSetLog) << "Invalid URL for tile" << tile->hash << "- skipping";
-            setErrorCount(_errorCount + 1);
-            delete tile;
-            continue;
-        }
-        request.setOriginatingObject(this);
-        request.setAttribute(QNetworkRequest::User, tile->hash);
-
-        QNetworkReply* const reply = _networkManager->get(request);
-        reply->setParent(this);
-        QGCNetworkHelper::ignoreSslErrorsIfNeeded(reply);
-        (void) connect(reply, &QNetworkReply::finished, this, &QGCCachedTileSet::_networkReplyFinished);
-        (void) connect(reply, &QNetworkReply::errorOccurred, this, &QGCCachedTileSet::_networkReplyError);
-        {
-            QMutexLocker lock(&_repliesMutex);
-            (void) _replies.insert(tile->hash, reply);
-        }
-
-        delete tile;
-        if (!_batchRequested && !_noMoreTiles && (_tilesToDownload.count() < (QGeoTileFetcherQGC::concurrentDownloads(_type) * 10))) {
+    const qsizetype pending = _pendingDownloads();
+    if (!_noMoreTiles) {
+        // Keep a full batch ahead of the downloads so the engine never runs dry while the database is queried
+        if (!_batchRequested && (pending < kTileBatchSize)) {
             createDownloadTask();
         }
-    }
-}
-
-void QGCCachedTileSet::_networkReplyFinished()
-{
-    QNetworkReply* const reply = qobject_cast<QNetworkReply*>(QObject::sender());
-    if (!reply) {
-        qCWarning(QGCCachedTileSetLog) << "NULL Reply";
-        return;
-    }
-    reply->deleteLater();
-
-    if (reply->error() != QNetworkReply::NoError) {
         return;
     }
 
-    if (!reply->isOpen()) {
-        qCWarning(QGCCachedTileSetLog) << "Empty Reply";
-        return;
-    }
-
-    const QString hash = reply->request().attribute(QNetworkRequest::User).toString();
-    if (hash.isEmpty()) {
-        qCWarning(QGCCachedTileSetLog) << "Empty Hash";
-        return;
-    }
-
-    {
-        QMutexLocker lock(&_repliesMutex);
-        if (_replies.contains(hash)) {
-            (void) _replies.remove(hash);
-        } else {
-            qCWarning(QGCCachedTileSetLog) << "Reply not in list: " << hash;
-        }
+    if ((pending == 0) && !_batchRequested) {
+        _flushTileStates();
+        _doneWithDownload();
     }
-    qCDebug(QGCCachedTileSetLog) << "Tile fetched:" << hash;
+}
 
-    QByteArray image = reply->readAll();
-    if (image.isEmpty()) {
+qsizetype QGCCachedTileSet::_cacheDownloadedTile(const QString &hash, const QByteArray &data)
+{
+    if (data.isEmpty()) {
         qCWarning(QGCCachedTileSetLog) << "Empty Image";
-        return;
+        return 0;
     }
 
     const QString type = UrlFactory::tileHashToType(hash);
     const SharedMapProvider mapProvider = UrlFactory::getMapProviderFromProviderType(type);
     if (!mapProvider) {
         qCWarning(QGCCachedTileSetLog) << "Invalid map provider for type:" << type;
-        return;
+        return 0;
     }
 
+    QByteArray image = data;
     if (mapProvider->isElevationProvider()) {
         const SharedElevationProvider elevationProvider = std::dynamic_pointer_cast<const ElevationProvider>(mapProvider);
         image = elevationProvider->serialize(image);
         if (image.isEmpty()) {
             qCWarning(QGCCachedTileSetLog) << "Failed to Serialize Terrain Tile";
-            return;
+            return 0;
         }
     }
 
     const QString format = mapProvider->getImageFormat(image);
     if (format.isEmpty()) {
         qCWarning(QGCCachedTileSetLog) << "Empty Format";
-        return;
+        return 0;
     }
 
     QGeoFileTileCacheQGC::cacheTile(type, hash, image, format, _id);
 
-    QGCUpdateTileDownloadStateTask *task = new QGCUpdateTileDownloadStateTask(_id, QGCTile::StateComplete, hash);
-    if (!getQGCMapEngine()->addTask(task)) {
-        task->deleteLater();
+    return image.size();
+}
+
+void QGCCachedTileSet::_tileDownloaded(const QString &hash, const QByteArray &data)
+{
+    qCDebug(QGCCachedTileSetLog) << "Tile fetched:" << hash;
+
+    const qsizetype size = _cacheDownloadedTile(hash, data);
+    if (size == 0) {
+        setErrorCount(_errorCount + 1);
+        _recordTileState(hash, QGCTile::StateError);
+        _prepareDownload();
+        return;
     }
 
-    setSavedTileSize(_savedTileSize + image.size());
+    _recordTileState(hash, QGCTile::StateComplete);
+
+    setSavedTileSize(_savedTileSize + size);
     setSavedTileCount(_savedTileCount + 1);
 
     if (_savedTileCount % 10 == 0) {
         const quint32 avg = _savedTileSize / _savedTileCount;
         setTotalTileSize(avg * _totalTileCount);
         setUniqueTileSize(avg * _uniqueTileCount);
+        emit downloadRateChanged();
     }
 
     _prepareDownload();
 }
 
-void QGCCachedTileSet::_networkReplyError(QNetworkReply::NetworkError error)
+void QGCCachedTileSet::_tileDownloadFailed(const QString &hash, const QString &errorString)
 {
-    QNetworkReply* const reply = qobject_cast<QNetworkReply*>(QObject::sender());
-    if (!reply) {
-        return;
-    }
-    qCDebug(QGCCachedTileSetLog) << "Error fetching tile" << reply->errorString();
+    qCWarning(QGCCachedTileSetLog) << "Error fetching tile" << hash << errorString;
 
     setErrorCount(_errorCount + 1);
+    _recordTileState(hash, QGCTile::StateError);
 
-    const QString hash = reply->request().attribute(QNetworkRequest::User).toString();
-    if (hash.isEmpty()) {
-        qCWarning(QGCCachedTileSetLog) << "Empty Hash";
-        return;
+    _prepareDownload();
+}
+
+void QGCCachedTileSet::_recordTileState(const QString &hash, QGCTile::TileState state)
+{
+    if (state == QGCTile::StateComplete) {
+        _completedHashes.append(hash);
+    } else {
+        _failedHashes.append(hash);
     }
 
-    {
-        QMutexLocker lock(&_repliesMutex);
-        if (_replies.contains(hash)) {
-            (void) _replies.remove(hash);
-        } else {
-            qCWarning(QGCCachedTileSetLog) << "Reply not in list:" << hash;
-        }
+    if ((_completedHashes.size() + _failedHashes.size()) >= kStateFlushCount) {
+        _flushTileStates();
+    } else if (!_stateFlushTimer->isActive()) {
+        _stateFlushTimer->start();
     }
+}
+
+void QGCCachedTileSet::_flushTileStates()
+{
+    _stateFlushTimer->stop();
 
-    if (error != QNetworkReply::OperationCanceledError) {
-        qCWarning(QGCCachedTileSetLog) << "Error:" << reply->errorString();
+    if (!_completedHashes.isEmpty()) {
+        _addTileStateTask(QGCTile::StateComplete, _completedHashes);
+        _completedHashes.clear();
     }
+    if (!_failedHashes.isEmpty()) {
+        _addTileStateTask(QGCTile::StateError, _failedHashes);
+        _failedHashes.clear();
+    }
+}
 
-    QGCUpdateTileDownloadStateTask *task = new QGCUpdateTileDownloadStateTask(_id, QGCTile::StateError, hash);
+void QGCCachedTileSet::_addTileStateTask(QGCTile::TileState state, const QStringList &hashes)
+{
+    QGCUpdateTileDownloadStateTask *task = new QGCUpdateTileDownloadStateTask(_id, state, hashes);
     if (!getQGCMapEngine()->addTask(task)) {
         task->deleteLater();
     }
-
-    _prepareDownload();
 }
 
 void QGCCachedTileSet::setSelected(bool sel)
@@ -298,6 +326,26 @@ void QGCCachedTileSet::setSelected(bool sel)
     }
 }
 
+double QGCCachedTileSet::tilesPerSecond() const
+{
+    return (_downloading && _downloadEngine) ? _downloadEngine->stats().tilesPerSecond : 0.;
+}
+
+double QGCCachedTileSet::bytesPerSecond() const
+{
+    return (_downloading && _downloadEngine) ? _downloadEngine->stats().bytesPerSecond : 0.;
+}
+
+QString QGCCachedTileSet::downloadRateStr() const
+{
+    if (!_downloading || !_downloadEngine) {
+        return QString();
+    }
+
+    const QGCTileDownloadEngine::Stats stats = _downloadEngine->stats();
+    return tr("%1 tiles/s (%2/s)").arg(QString::number(stats.tilesPerSecond, 'f', 1), QGC::bigSizeToString(static_cast<quint64>(stats.bytesPerSecond)));
+}
+
 QString QGCCachedTileSet::errorCountStr() const
 {
     return QGC::numberToString(_errorCount);
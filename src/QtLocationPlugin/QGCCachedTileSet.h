@@ -1,21 +1,21 @@
 #pragma once
 
 #include <QtCore/QDateTime>
-#include <QtCore/QHash>
-#include <QtCore/QMutex>
 #include <QtCore/QObject>
 #include <QtCore/QQueue>
 #include <QtCore/QString>
-#include <QtNetwork/QNetworkReply>
+#include <QtCore/QStringList>
+
+#include "QGCTile.h"
 
-struct QGCTile;
 class QGCMapEngineManager;
+class QGCTileDownloadEngine;
 class QNetworkAccessManager;
+class QTimer;
 
 class QGCCachedTileSet : public QObject
 {
     Q_OBJECT
-    Q_MOC_INCLUDE("QGCTile.h")
 
     Q_PROPERTY(QString      name                READ    name                NOTIFY nameChanged)
     Q_PROPERTY(QString      mapTypeStr          READ    mapTypeStr          CONSTANT)
@@ -45,6 +45,7 @@ class QGCCachedTileSet : public QObject
     Q_PROPERTY(bool         deleting            READ    deleting            NOTIFY deletingChanged)
     Q_PROPERTY(bool         downloading         READ    downloading         NOTIFY downloadingChanged)
     Q_PROPERTY(quint32      errorCount          READ    errorCount          NOTIFY errorCountChanged)
+    Q_PROPERTY(QString      downloadRateStr     READ    downloadRateStr     NOTIFY downloadRateChanged)
     Q_PROPERTY(QString      errorCountStr       READ    errorCountStr       NOTIFY errorCountChanged)
     Q_PROPERTY(bool         selected            READ    selected            WRITE  setSelected  NOTIFY selectedChanged)
 
@@ -91,6 +92,11 @@ class QGCCachedTileSet : public QObject
     QString errorCountStr() const;
     bool selected() const { return _selected; }
 
+    /// Download rate over the last few seconds, 0 when not downloading
+    double tilesPerSecond() const;
+    double bytesPerSecond() const;
+    QString downloadRateStr() const;
+
     void setManager(QGCMapEngineManager *mgr) { _manager = mgr; }
     void setSelected(bool sel);
     void setName(const QString &name) { if (name != _name) { _name = name; emit nameChanged(); } }
@@ -131,15 +137,21 @@ class QGCCachedTileSet : public QObject
     void errorCountChanged();
     void selectedChanged();
     void nameChanged();
+    void downloadRateChanged();
 
 private slots:
     void _tileListFetched(const QQueue<QGCTile*> &tiles);
-    void _networkReplyFinished();
-    void _networkReplyError(QNetworkReply::NetworkError error);
+    void _tileDownloaded(const QString &hash, const QByteArray &data);
+    void _tileDownloadFailed(const QString &hash, const QString &errorString);
+    void _flushTileStates();
 
 private:
     void _prepareDownload();
     void _doneWithDownload();
+    qsizetype _cacheDownloadedTile(const QString &hash, const QByteArray &data);
+    qsizetype _pendingDownloads() const;
+    void _recordTileState(const QString &hash, QGCTile::TileState state);
+    void _addTileStateTask(QGCTile::TileState state, const QStringList &hashes);
 
     QString _name;
     QString _mapTypeStr;
@@ -167,11 +179,16 @@ private slots:
     bool _cancelPending = false;
     QDateTime _creationDate;
 
-    QHash<QString, QNetworkReply*> _replies;
-    QMutex _repliesMutex;
-    QQueue<QGCTile*> _tilesToDownload;
     QGCMapEngineManager *_manager = nullptr;
     QNetworkAccessManager *_networkManager = nullptr;
+    QGCTileDownloadEngine *_downloadEngine = nullptr;
+
+    // Download states are written to the database in batches
+    QStringList _completedHashes;
+    QStringList _failedHashes;
+    QTimer *_stateFlushTimer = nullptr;
 
     static constexpr uint32_t kTileBatchSize = 256;
+    static constexpr qsizetype kStateFlushCount = 64;
+    static constexpr int kStateFlushIntervalMs = 1000;
 };
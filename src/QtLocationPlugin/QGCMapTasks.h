@@ -3,6 +3,7 @@
 #include <QtCore/QObject>
 #include <QtCore/QQueue>
 #include <QtCore/QString>
+#include <QtCore/QStringList>
 
 #include "QGCMapTaskBase.h"
 #include "QGCTileCacheTypes.h"
@@ -147,21 +148,26 @@ class QGCUpdateTileDownloadStateTask : public QGCMapTask
 
 public:
     QGCUpdateTileDownloadStateTask(quint64 setID, QGCTile::TileState state, const QString &hash, QObject *parent = nullptr)
+        : QGCUpdateTileDownloadStateTask(setID, state, QStringList{ hash }, parent)
+    {}
+    /// Updates all @p hashes in one database transaction
+    QGCUpdateTileDownloadStateTask(quint64 setID, QGCTile::TileState state, const QStringList &hashes, QObject *parent = nullptr)
         : QGCMapTask(TaskType::taskUpdateTileDownloadState, parent)
         , m_setID(setID)
         , m_state(state)
-        , m_hash(hash)
+        , m_hashes(hashes)
     {}
     ~QGCUpdateTileDownloadStateTask() = default;
 
-    QString hash() const { return m_hash; }
+    QString hash() const { return m_hashes.isEmpty() ? QString() : m_hashes.constFirst(); }
+    const QStringList &hashes() const { return m_hashes; }
     quint64 setID() const { return m_setID; }
     QGCTile::TileState state() const { return m_state; }
 
 private:
     const quint64 m_setID = 0;
     const QGCTile::TileState m_state = QGCTile::StatePending;
-    const QString m_hash;
+    const QStringList m_hashes;
 };
 
 //-----------------------------------------------------------------------------
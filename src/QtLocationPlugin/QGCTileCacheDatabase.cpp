@@ -26,6 +26,7 @@ static std::atomic<quint64> s_connectionCounter{0};
 QGCTileCacheDatabase::QGCTileCacheDatabase(const QString &databasePath)
     : _databasePath(databasePath)
     , _connectionName(QStringLiteral("QGCTileCache_%1").arg(s_connectionCounter.fetch_add(1)))
+    , _readConnectionName(_connectionName + QStringLiteral("_read"))
 {
 }
 
@@ -39,6 +40,11 @@ QSqlDatabase QGCTileCacheDatabase::_database() const
     return QSqlDatabase::database(_connectionName);
 }
 
+QSqlDatabase QGCTileCacheDatabase::_readDatabase() const
+{
+    return _readConnected ? QSqlDatabase::database(_readConnectionName) : _database();
+}
+
 QSqlDatabase QGCTileCacheDatabase::database() const
 {
     return _database();
@@ -134,6 +140,7 @@ bool QGCTileCacheDatabase::connectDB()
     if (_valid) {
         QGCSqlHelper::applySqlitePragmas(db);
         _connected = true;
+        (void) _connectReadDB();
     } else {
         qCCritical(QGCTileCacheDatabaseLog) << "Map Cache SQL error (open db):" << db.lastError();
         QSqlDatabase::removeDatabase(_connectionName);
@@ -141,17 +148,35 @@ bool QGCTileCacheDatabase::connectDB()
     return _valid;
 }
 
+bool QGCTileCacheDatabase::connectReadOnlyDB()
+{
+    if (_connected || _readConnected) {
+        disconnectDB();
+    }
+
+    _valid = _connectReadDB();
+    return _valid;
+}
+
 void QGCTileCacheDatabase::disconnectDB()
 {
-    if (!_connected) {
+    if (!_connected && !_readConnected) {
         return;
     }
+    const bool wasConnected = _connected;
     _connected = false;
 
     if (!QCoreApplication::instance()) {
         return;
     }
 
+    _clearPreparedQueries();
+    _disconnectReadDB();
+
+    if (!wasConnected) {
+        return;
+    }
+
     {
         QSqlDatabase db = QSqlDatabase::database(_connectionName, false);
         if (db.isOpen()) {
@@ -161,88 +186,173 @@ void QGCTileCacheDatabase::disconnectDB()
     QSqlDatabase::removeDatabase(_connectionName);
 }
 
+bool QGCTileCacheDatabase::_connectReadDB()
+{
+    // Tile lookups get their own read-only connection. With WAL journaling it reads the last
+    // committed state without waiting on a write transaction of the main connection.
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", _readConnectionName);
+        db.setDatabaseName(_databasePath);
+        db.setConnectOptions(QStringLiteral("QSQLITE_OPEN_READONLY"));
+        _readConnected = db.open();
+        if (!_readConnected) {
+            qCWarning(QGCTileCacheDatabaseLog) << "Failed to open read-only connection, reading through main connection:" << db.lastError();
+        }
+    }
+
+    if (!_readConnected) {
+        QSqlDatabase::removeDatabase(_readConnectionName);
+    }
+
+    return _readConnected;
+}
+
+void QGCTileCacheDatabase::_disconnectReadDB()
+{
+    if (!_readConnected) {
+        return;
+    }
+    _readConnected = false;
+
+    {
+        QSqlDatabase db = QSqlDatabase::database(_readConnectionName, false);
+        if (db.isOpen()) {
+            db.close();
+        }
+    }
+    QSqlDatabase::removeDatabase(_readConnectionName);
+}
+
+QSqlQuery *QGCTileCacheDatabase::_preparedQuery(std::unique_ptr<QSqlQuery> &query, const QSqlDatabase &db, const char *sql)
+{
+    if (!query) {
+        auto prepared = std::make_unique<QSqlQuery>(db);
+        if (!prepared->prepare(QString::fromLatin1(sql))) {
+            qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (prepare):" << sql << prepared->lastError().text();
+            return nullptr;
+        }
+        query = std::move(prepared);
+    }
+
+    return query.get();
+}
+
+void QGCTileCacheDatabase::_clearPreparedQueries()
+{
+    // Must be released before their connection is closed or the schema is dropped
+    _insertTileQuery.reset();
+    _tileIDQuery.reset();
+    _insertSetTileQuery.reset();
+    _getTileQuery.reset();
+}
+
 bool QGCTileCacheDatabase::saveTile(const QString &hash, const QString &format, const QByteArray &img, const QString &type, quint64 tileSet)
 {
-    if (!_ensureConnected()) {
-        return false;
+    const QGCCacheTile tile(hash, img, format, type, tileSet);
+    return saveTiles({ &tile }).constFirst();
+}
+
+QList<bool> QGCTileCacheDatabase::saveTiles(const QList<const QGCCacheTile*> &tiles)
+{
+    QList<bool> results(tiles.size(), false);
+    if (tiles.isEmpty() || !_ensureConnected()) {
+        return results;
     }
 
     QGCSqlHelper::Transaction txn(_database());
     if (!txn.ok()) {
-        qCWarning(QGCTileCacheDatabaseLog) << "Failed to start transaction for saveTile";
-        return false;
+        qCWarning(QGCTileCacheDatabaseLog) << "Failed to start transaction for saveTiles";
+        return results;
     }
 
-    QSqlQuery query(_database());
-    if (!query.prepare("INSERT OR IGNORE INTO Tiles(hash, format, tile, size, type, date) VALUES(?, ?, ?, ?, ?, ?)")) {
-        qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (prepare saveTile):" << query.lastError().text();
+    for (qsizetype i = 0; i < tiles.size(); i++) {
+        results[i] = _insertTile(*tiles[i]);
+    }
+
+    if (!txn.commit()) {
+        qCWarning(QGCTileCacheDatabaseLog) << "Failed to commit saveTiles transaction";
+        results.fill(false);
+        return results;
+    }
+
+    qCDebug(QGCTileCacheDatabaseLog) << "Saved" << results.count(true) << "of" << tiles.size() << "tiles";
+    return results;
+}
+
+bool QGCTileCacheDatabase::_insertTile(const QGCCacheTile &tile)
+{
+    const QSqlDatabase db = _database();
+
+    QSqlQuery *query = _preparedQuery(_insertTileQuery, db, "INSERT OR IGNORE INTO Tiles(hash, format, tile, size, type, date) VALUES(?, ?, ?, ?, ?, ?)");
+    if (!query) {
         return false;
     }
-    query.addBindValue(hash);
-    query.addBindValue(format);
-    query.addBindValue(img);
-    query.addBindValue(img.size());
-    query.addBindValue(UrlFactory::getQtMapIdFromProviderType(type));
-    query.addBindValue(QDateTime::currentSecsSinceEpoch());
-    if (!query.exec()) {
-        qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (saveTile INSERT):" << query.lastError().text();
+    query->bindValue(0, tile.hash);
+    query->bindValue(1, tile.format);
+    query->bindValue(2, tile.img);
+    query->bindValue(3, tile.img.size());
+    query->bindValue(4, UrlFactory::getQtMapIdFromProviderType(tile.type));
+    query->bindValue(5, QDateTime::currentSecsSinceEpoch());
+    if (!query->exec()) {
+        qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (saveTile INSERT):" << query->lastError().text();
         return false;
     }
 
-    if (!query.prepare("SELECT tileID FROM Tiles WHERE hash = ?")) {
-        qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (prepare tile lookup):" << query.lastError().text();
+    query = _preparedQuery(_tileIDQuery, db, "SELECT tileID FROM Tiles WHERE hash = ?");
+    if (!query) {
         return false;
     }
-    query.addBindValue(hash);
-    if (!query.exec() || !query.next()) {
-        qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (tile lookup):" << query.lastError().text();
+    query->bindValue(0, tile.hash);
+    if (!query->exec() || !query->next()) {
+        qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (tile lookup):" << query->lastError().text();
+        query->finish();
         return false;
     }
-    const quint64 tileID = query.value(0).toULongLong();
+    const quint64 tileID = query->value(0).toULongLong();
+    query->finish();
 
-    const quint64 setID = (tileSet == kInvalidTileSet) ? _getDefaultTileSet() : tileSet;
+    const quint64 setID = (tile.tileSet == kInvalidTileSet) ? _getDefaultTileSet() : tile.tileSet;
     if (setID == kInvalidTileSet) {
         qCWarning(QGCTileCacheDatabaseLog) << "Cannot save tile: no valid tile set";
         return false;
     }
-    if (!query.prepare("INSERT OR IGNORE INTO SetTiles(tileID, setID) VALUES(?, ?)")) {
-        qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (prepare SetTiles):" << query.lastError().text();
-        return false;
-    }
-    query.addBindValue(tileID);
-    query.addBindValue(setID);
-    if (!query.exec()) {
-        qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (add tile into SetTiles):" << query.lastError().text();
+
+    query = _preparedQuery(_insertSetTileQuery, db, "INSERT OR IGNORE INTO SetTiles(tileID, setID) VALUES(?, ?)");
+    if (!query) {
         return false;
     }
-
-    if (!txn.commit()) {
-        qCWarning(QGCTileCacheDatabaseLog) << "Failed to commit saveTile transaction";
+    query->bindValue(0, tileID);
+    query->bindValue(1, setID);
+    if (!query->exec()) {
+        qCWarning(QGCTileCacheDatabaseLog) << "Map Cache SQL error (add tile into SetTiles):" << query->lastError().text();
         return false;
     }
 
-    qCDebug(QGCTileCacheDatabaseLog) << "HASH:" << hash;
+    qCDebug(QGCTileCacheDatabaseLog) << "HASH:" << tile.hash;
     return true;
 }
 
 std::unique_ptr<QGCCacheTile> QGCTileCacheDatabase::getTile(const QString &hash)
 {
-    if (!_ensureConnected()) {
+    if (!_readConnected && !_ensureConnected()) {
         return nullptr;
     }
 
-    QSqlQuery query(_database());
-    if (!query.prepare("SELECT tile, format, type FROM Tiles WHERE hash = ?")) {
+    QSqlQuery *query = _preparedQuery(_getTileQuery, _readDatabase(), "SELECT tile, format, type FROM Tiles WHERE hash = ?");
+    if (!query) {
         return nullptr;
     }
-    query.addBindValue(hash);
-    if (query.exec() && query.next()) {
-        const QByteArray tileData = query.value(0).toByteArray();
-        const QString format = query.value(1).toString();
-        const QString type = UrlFactory::getProviderTypeFromQtMapId(query.value(2).toInt());
+    query->bindValue(0, hash);
+    if (query->exec() && query->next()) {
+        const QByteArray tileData = query->value(0).toByteArray();
+        const QString format = query->value(1).toString();
+        const QString type = UrlFactory::getProviderTypeFromQtMapId(query->value(2).toInt());
+        // Release the read snapshot so WAL checkpoints are not held back
+        query->finish();
         qCDebug(QGCTileCacheDatabaseLog) << "(Found in DB) HASH:" << hash;
         return std::make_unique<QGCCacheTile>(hash, tileData, format, type);
     }
+    query->finish();
 
     qCDebug(QGCTileCacheDatabaseLog) << "(NOT in DB) HASH:" << hash;
     return nullptr;
@@ -541,6 +651,7 @@ bool QGCTileCacheDatabase::resetDatabase()
     }
 
     _defaultSet = kInvalidTileSet;
+    _clearPreparedQueries();
 
     QGCSqlHelper::Transaction txn(_database());
     if (!txn.ok()) {
@@ -651,6 +762,53 @@ bool QGCTileCacheDatabase::updateTileDownloadState(quint64 setID, int state, con
     return true;
 }
 
+bool QGCTileCacheDatabase::updateTileDownloadStates(quint64 setID, int state, const QStringList &hashes)
+{
+    if (!_ensureConnected()) {
+        return false;
+    }
+    if (hashes.isEmpty()) {
+        return true;
+    }
+
+    QGCSqlHelper::Transaction txn(_database());
+    if (!txn.ok()) {
+        qCWarning(QGCTileCacheDatabaseLog) << "Failed to start transaction for updateTileDownloadStates";
+        return false;
+    }
+
+    QSqlQuery query(_database());
+    for (qsizetype offset = 0; offset < hashes.size(); offset += kStateUpdateBatchSize) {
+        const qsizetype batchCount = qMin(static_cast<qsizetype>(kStateUpdateBatchSize), hashes.size() - offset);
+        const QString inClause = QGCSqlHelper::placeholders(static_cast<int>(batchCount));
+        const QString sql = (state == QGCTile::StateComplete)
+            ? QStringLiteral("DELETE FROM TilesDownload WHERE setID = ? AND hash IN (%1)").arg(inClause)
+            : QStringLiteral("UPDATE TilesDownload SET state = ? WHERE setID = ? AND hash IN (%1)").arg(inClause);
+        if (!query.prepare(sql)) {
+            qCWarning(QGCTileCacheDatabaseLog) << "Failed to prepare tile download state update:" << query.lastError().text();
+            return false;
+        }
+        if (state != QGCTile::StateComplete) {
+            query.addBindValue(state);
+        }
+        query.addBindValue(setID);
+        for (qsizetype i = offset; i < (offset + batchCount); i++) {
+            query.addBindValue(hashes[i]);
+        }
+        if (!query.exec()) {
+            qCWarning(QGCTileCacheDatabaseLog) << "Error:" << query.lastError().text();
+            return false;
+        }
+    }
+
+    if (!txn.commit()) {
+        qCWarning(QGCTileCacheDatabaseLog) << "Failed to commit updateTileDownloadStates transaction";
+        return false;
+    }
+
+    return true;
+}
+
 bool QGCTileCacheDatabase::updateAllTileDownloadStates(quint64 setID, int state)
 {
     if (!_ensureConnected()) {
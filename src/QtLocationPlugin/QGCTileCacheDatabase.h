@@ -3,6 +3,7 @@
 #include <QtCore/QByteArray>
 #include <QtCore/QList>
 #include <QtCore/QString>
+#include <QtCore/QStringList>
 
 #include <memory>
 #include <optional>
@@ -12,6 +13,7 @@
 
 struct QGCCacheTile;
 class QSqlDatabase;
+class QSqlQuery;
 
 class QGCTileCacheDatabase
 {
@@ -24,6 +26,9 @@ class QGCTileCacheDatabase
 
     bool init();
     bool connectDB();
+    /// Opens only the read-only connection, getTile() is the only usable call. Lets another
+    /// thread look up tiles next to the connection of the thread which writes them.
+    bool connectReadOnlyDB();
     void disconnectDB();
 
     bool isValid() const { return _valid; }
@@ -31,6 +36,9 @@ class QGCTileCacheDatabase
 
     // Tiles
     bool saveTile(const QString &hash, const QString &format, const QByteArray &img, const QString &type, quint64 tileSet);
+    /// Saves all tiles in a single transaction
+    /// @return Per tile success, all false if the transaction could not be committed
+    QList<bool> saveTiles(const QList<const QGCCacheTile*> &tiles);
     std::unique_ptr<QGCCacheTile> getTile(const QString &hash);
     std::optional<quint64> findTile(const QString &hash);
 
@@ -48,6 +56,8 @@ class QGCTileCacheDatabase
     // Downloads
     QList<QGCTile> getTileDownloadList(quint64 setID, int count);
     bool updateTileDownloadState(quint64 setID, int state, const QString &hash);
+    /// Updates the download state of all @p hashes in a single transaction
+    bool updateTileDownloadStates(quint64 setID, int state, const QStringList &hashes);
     bool updateAllTileDownloadStates(quint64 setID, int state);
 
     // Cache
@@ -71,6 +81,12 @@ class QGCTileCacheDatabase
 private:
     bool _ensureConnected() const;
     QSqlDatabase _database() const;
+    QSqlDatabase _readDatabase() const;
+    bool _connectReadDB();
+    void _disconnectReadDB();
+    QSqlQuery *_preparedQuery(std::unique_ptr<QSqlQuery> &query, const QSqlDatabase &db, const char *sql);
+    void _clearPreparedQueries();
+    bool _insertTile(const QGCCacheTile &tile);
     bool _checkSchemaVersion();
     bool _createDB(QSqlDatabase db, bool createDefault = true);
     quint64 _getDefaultTileSet();
@@ -83,11 +99,20 @@ class QGCTileCacheDatabase
 
     QString _databasePath;
     QString _connectionName;
+    QString _readConnectionName;
     quint64 _defaultSet = kInvalidTileSet;
     bool _connected = false;
+    bool _readConnected = false;
+
+    // Kept prepared for the lifetime of the connection, tile saves and lookups are the hot path
+    std::unique_ptr<QSqlQuery> _insertTileQuery;
+    std::unique_ptr<QSqlQuery> _tileIDQuery;
+    std::unique_ptr<QSqlQuery> _insertSetTileQuery;
+    std::unique_ptr<QSqlQuery> _getTileQuery;
     bool _valid = false;
     bool _failed = false;
     static constexpr int kPruneBatchSize = 128;
+    static constexpr int kStateUpdateBatchSize = 256;
     static constexpr const char *kUniqueTilesSubquery =
         "SELECT A.tileID FROM SetTiles A JOIN SetTiles B ON A.tileID = B.tileID "
         "WHERE B.setID = ? GROUP BY A.tileID HAVING COUNT(A.tileID) = 1";
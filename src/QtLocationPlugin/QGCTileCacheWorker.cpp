@@ -42,10 +42,20 @@ void QGCCacheWorker::stop()
 {
     _stopRequested = true;
     QMutexLocker lock(&_taskQueueMutex);
+    for (QGCMapTask *task : std::as_const(_taskQueue)) {
+        if (task->type() == QGCMapTask::TaskType::taskCacheTile) {
+            (void) _pendingSaves.remove(static_cast<QGCSaveTileTask*>(task)->tile()->hash);
+        }
+    }
     qDeleteAll(_taskQueue);
     _taskQueue.clear();
     lock.unlock();
 
+    QMutexLocker fetchLock(&_fetchQueueMutex);
+    qDeleteAll(_fetchQueue);
+    _fetchQueue.clear();
+    fetchLock.unlock();
+
     if (isRunning()) {
         _waitc.wakeAll();
     }
@@ -59,7 +69,22 @@ bool QGCCacheWorker::enqueueTask(QGCMapTask *task)
         return false;
     }
 
+    if (task->type() == QGCMapTask::TaskType::taskFetchTile) {
+        QMutexLocker fetchLock(&_fetchQueueMutex);
+        _fetchQueue.enqueue(task);
+        fetchLock.unlock();
+        _fetchWaitc.wakeAll();
+        if (!isRunning()) {
+            start(QThread::NormalPriority);
+        }
+        return true;
+    }
+
     QMutexLocker lock(&_taskQueueMutex);
+    if (task->type() == QGCMapTask::TaskType::taskCacheTile) {
+        const QGCCacheTile *tile = static_cast<QGCSaveTileTask*>(task)->tile();
+        _pendingSaves.insert(tile->hash, tile);
+    }
     _taskQueue.enqueue(task);
     lock.unlock();
 
@@ -87,6 +112,10 @@ void QGCCacheWorker::run()
             orphan->deleteLater();
         }
         _taskQueue.clear();
+        _pendingSaves.clear();
+        lock.unlock();
+
+        _failQueuedFetches(tr("Database Init Failed"));
         return;
     }
 
@@ -98,16 +127,46 @@ void QGCCacheWorker::run()
 
     _dbValid = _database->isValid();
 
+    _startReader();
+
     _updateTimer.start();
 
     QMutexLocker lock(&_taskQueueMutex);
     while (!_stopRequested) {
         if (!_taskQueue.isEmpty()) {
             QGCMapTask* const task = _taskQueue.dequeue();
-            lock.unlock();
-            _runTask(task);
-            lock.relock();
-            task->deleteLater();
+            if (task->type() == QGCMapTask::TaskType::taskCacheTile) {
+                // Drain the run of pending saves so they share one transaction instead of one commit each
+                QList<QGCMapTask*> saveTasks{ task };
+                while (!_taskQueue.isEmpty() && (saveTasks.count() < kMaxSaveBatch) && (_taskQueue.head()->type() == QGCMapTask::TaskType::taskCacheTile)) {
+                    saveTasks.append(_taskQueue.dequeue());
+                }
+                lock.unlock();
+                _saveTiles(saveTasks);
+                lock.relock();
+                for (QGCMapTask *saveTask : saveTasks) {
+                    // The tile is committed (or failed), the reader must no longer take it from the task
+                    const QGCCacheTile *tile = static_cast<QGCSaveTileTask*>(saveTask)->tile();
+                    const auto pending = _pendingSaves.constFind(tile->hash);
+                    if ((pending != _pendingSaves.cend()) && (pending.value() == tile)) {
+                        (void) _pendingSaves.erase(pending);
+                    }
+                    saveTask->deleteLater();
+                }
+            } else {
+                lock.unlock();
+                // Reset and import rewrite or replace the database file, the reader's connection must not span them
+                const bool replacesDatabase = (task->type() == QGCMapTask::TaskType::taskReset) || (task->type() == QGCMapTask::TaskType::taskImport);
+                if (replacesDatabase) {
+                    _stopReader();
+                }
+                _runTask(task);
+                if (replacesDatabase) {
+                    _startReader();
+                }
+                lock.relock();
+                task->deleteLater();
+            }
 
             const qsizetype count = _taskQueue.count();
             if (count > 100) {
@@ -133,8 +192,12 @@ void QGCCacheWorker::run()
         orphan->deleteLater();
     }
     _taskQueue.clear();
+    _pendingSaves.clear();
     lock.unlock();
 
+    _stopReader();
+    _failQueuedFetches(tr("Worker shutting down"));
+
     _dbValid = false;
     if (_database) {
         _database->disconnectDB();
@@ -148,10 +211,7 @@ void QGCCacheWorker::_runTask(QGCMapTask *task)
     case QGCMapTask::TaskType::taskInit:
         break;
     case QGCMapTask::TaskType::taskCacheTile:
-        _saveTile(task);
-        break;
-    case QGCMapTask::TaskType::taskFetchTile:
-        _getTile(task);
+        _saveTiles({ task });
         break;
     case QGCMapTask::TaskType::taskFetchTileSets:
         _getTileSets(task);
@@ -206,32 +266,122 @@ void QGCCacheWorker::_emitTotals()
     _updateTimer.restart();
 }
 
-void QGCCacheWorker::_saveTile(QGCMapTask *mtask)
+void QGCCacheWorker::_saveTiles(const QList<QGCMapTask*> &mtasks)
 {
-    if (!_testTask(mtask)) {
+    if (!_database || !_database->isValid()) {
+        for (QGCMapTask *mtask : mtasks) {
+            (void) _testTask(mtask);
+        }
         return;
     }
 
-    QGCSaveTileTask *task = static_cast<QGCSaveTileTask*>(mtask);
-    if (!_database->saveTile(task->tile()->hash, task->tile()->format,
-                             task->tile()->img, task->tile()->type, task->tile()->tileSet)) {
-        mtask->setError("Error saving tile to cache");
+    QList<const QGCCacheTile*> tiles;
+    tiles.reserve(mtasks.size());
+    for (QGCMapTask *mtask : mtasks) {
+        tiles.append(static_cast<QGCSaveTileTask*>(mtask)->tile());
+    }
+
+    const QList<bool> saved = _database->saveTiles(tiles);
+    for (qsizetype i = 0; i < mtasks.size(); i++) {
+        if (!saved[i]) {
+            mtasks[i]->setError("Error saving tile to cache");
+        }
     }
 }
 
-void QGCCacheWorker::_getTile(QGCMapTask *mtask)
+void QGCCacheWorker::_startReader()
 {
-    if (!_testTask(mtask)) {
+    QMutexLocker lock(&_fetchQueueMutex);
+    if (_reader) {
+        return;
+    }
+    _readerStopRequested = false;
+    lock.unlock();
+
+    _reader.reset(QThread::create([this]() { _runReader(); }));
+    _reader->setObjectName(QStringLiteral("QGCCacheReader"));
+    _reader->start(QThread::NormalPriority);
+}
+
+void QGCCacheWorker::_stopReader()
+{
+    if (!_reader) {
+        return;
+    }
+
+    QMutexLocker lock(&_fetchQueueMutex);
+    _readerStopRequested = true;
+    lock.unlock();
+    _fetchWaitc.wakeAll();
+
+    (void) _reader->wait();
+    _reader.reset();
+}
+
+void QGCCacheWorker::_runReader()
+{
+    // QSqlDatabase connections are bound to the thread which opened them
+    QGCTileCacheDatabase database(_databasePath);
+    if (!database.connectReadOnlyDB()) {
+        qCWarning(QGCTileCacheWorkerLog) << "Failed to open read-only connection for tile fetches";
+    }
+
+    QMutexLocker lock(&_fetchQueueMutex);
+    while (!_readerStopRequested) {
+        if (_fetchQueue.isEmpty()) {
+            (void) _fetchWaitc.wait(lock.mutex(), 5000);
+            continue;
+        }
+
+        QGCMapTask* const task = _fetchQueue.dequeue();
+        lock.unlock();
+        _getTile(&database, task);
+        lock.relock();
+        task->deleteLater();
+    }
+    lock.unlock();
+
+    database.disconnectDB();
+}
+
+void QGCCacheWorker::_failQueuedFetches(const QString &error)
+{
+    QMutexLocker lock(&_fetchQueueMutex);
+    for (QGCMapTask *orphan : std::as_const(_fetchQueue)) {
+        orphan->setError(error);
+        orphan->deleteLater();
+    }
+    _fetchQueue.clear();
+}
+
+QGCCacheTile *QGCCacheWorker::_pendingSaveTile(const QString &hash)
+{
+    QMutexLocker lock(&_taskQueueMutex);
+    const QGCCacheTile *tile = _pendingSaves.value(hash, nullptr);
+    return tile ? new QGCCacheTile(*tile) : nullptr;
+}
+
+void QGCCacheWorker::_getTile(QGCTileCacheDatabase *database, QGCMapTask *mtask)
+{
+    if (!database->isValid()) {
+        mtask->setError("No Cache Database");
         return;
     }
 
     QGCFetchTileTask *task = static_cast<QGCFetchTileTask*>(mtask);
-    auto tile = _database->getTile(task->hash());
+    auto tile = database->getTile(task->hash());
     if (tile) {
         task->setTileFetched(tile.release());
         return;
     }
 
+    // Not committed yet, serve it from the save still waiting in the queue
+    QGCCacheTile *const pending = _pendingSaveTile(task->hash());
+    if (pending) {
+        task->setTileFetched(pending);
+        return;
+    }
+
     // Under unit tests a cache miss consults the synthetic tile generator instead of
     // erroring, so tile consumers never fall back to real network fetches (late
     // replies race UI teardown and crash). See UnitTestTileGenerator.
@@ -347,8 +497,10 @@ void QGCCacheWorker::_updateTileDownloadState(QGCMapTask *mtask)
     bool ok;
     if (task->hash() == QStringLiteral("*")) {
         ok = _database->updateAllTileDownloadStates(task->setID(), static_cast<int>(task->state()));
-    } else {
+    } else if (task->hashes().size() == 1) {
         ok = _database->updateTileDownloadState(task->setID(), static_cast<int>(task->state()), task->hash());
+    } else {
+        ok = _database->updateTileDownloadStates(task->setID(), static_cast<int>(task->state()), task->hashes());
     }
     if (!ok) {
         mtask->setError("Error updating tile download state");
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QList>
 #include <QtCore/QMutex>
 #include <QtCore/QQueue>
 #include <QtCore/QString>
@@ -15,10 +17,7 @@
 
 class QGCMapTask;
 class QGCTileCacheDatabase;
-
-#ifdef QGC_UNITTEST_BUILD
 struct QGCCacheTile;
-#endif
 
 class QGCCacheWorker : public QThread
 {
@@ -55,8 +54,16 @@ public slots:
 private:
     void _runTask(QGCMapTask *task);
 
-    void _saveTile(QGCMapTask *task);
-    void _getTile(QGCMapTask *task);
+    /// Tile fetches are served by a reader thread with its own read-only connection, so they
+    /// never wait behind queued saves or a save transaction of this thread
+    void _startReader();
+    void _stopReader();
+    void _runReader();
+    void _failQueuedFetches(const QString &error);
+    QGCCacheTile *_pendingSaveTile(const QString &hash);
+
+    void _saveTiles(const QList<QGCMapTask*> &tasks);
+    void _getTile(QGCTileCacheDatabase *database, QGCMapTask *task);
     void _getTileSets(QGCMapTask *task);
     void _createTileSet(QGCMapTask *task);
     void _getTileDownloadList(QGCMapTask *task);
@@ -74,6 +81,12 @@ public slots:
     QMutex _taskQueueMutex;
     QQueue<QGCMapTask*> _taskQueue;
     QWaitCondition _waitc;
+    QHash<QString, const QGCCacheTile*> _pendingSaves;     ///< Tiles queued or being saved, guarded by _taskQueueMutex
+    QMutex _fetchQueueMutex;
+    QQueue<QGCMapTask*> _fetchQueue;
+    QWaitCondition _fetchWaitc;
+    std::unique_ptr<QThread> _reader;
+    bool _readerStopRequested = false;                      ///< Guarded by _fetchQueueMutex
     QString _databasePath;
     QElapsedTimer _updateTimer;
     int _updateTimeout = kShortTimeoutMs;
@@ -82,6 +95,7 @@ public slots:
 
     static constexpr int kShortTimeoutMs = 2000;
     static constexpr int kLongTimeoutMs = 5000;
+    static constexpr qsizetype kMaxSaveBatch = 256;   ///< Upper bound on tiles saved per transaction
 
 #ifdef QGC_UNITTEST_BUILD
     static std::function<QGCCacheTile*(const QString&)> _unitTestTileGenerator;
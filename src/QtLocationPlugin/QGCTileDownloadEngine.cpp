@@ -0,0 +1,215 @@
+#include "QGCTileDownloadEngine.h"
+
+#include <QtNetwork/QNetworkAccessManager>
+#include <QtNetwork/QNetworkReply>
+
+#include "QGCLoggingCategory.h"
+#include "QGCNetworkHelper.h"
+#include "QGeoTileFetcherQGC.h"
+
+QGC_LOGGING_CATEGORY(QGCTileDownloadEngineLog, "QtLocationPlugin.QGCTileDownloadEngine")
+
+QGCTileDownloadEngine::QGCTileDownloadEngine(QNetworkAccessManager *networkManager, QObject *parent)
+    : QObject(parent)
+    , _networkManager(networkManager)
+    , _initialConcurrency(static_cast<int>(QGeoTileFetcherQGC::concurrentDownloads(QString())))
+{
+    qCDebug(QGCTileDownloadEngineLog) << this;
+
+    _clock.start();
+}
+
+QGCTileDownloadEngine::~QGCTileDownloadEngine()
+{
+    abortAll();
+
+    qCDebug(QGCTileDownloadEngineLog) << this;
+}
+
+void QGCTileDownloadEngine::enqueue(const QString &hash, const QNetworkRequest &request)
+{
+    const QString host = request.url().host();
+
+    auto it = _hosts.find(host);
+    if (it == _hosts.end()) {
+        it = _hosts.insert(host, HostState());
+        it->limit = _initialConcurrency;
+    }
+
+    it->queue.enqueue({ hash, request });
+    _queuedCount++;
+
+    _startDownloads(host);
+}
+
+QStringList QGCTileDownloadEngine::clearQueued()
+{
+    QStringList hashes;
+    hashes.reserve(_queuedCount);
+
+    for (HostState &hostState : _hosts) {
+        for (const PendingTile &tile : std::as_const(hostState.queue)) {
+            hashes.append(tile.hash);
+        }
+        hostState.queue.clear();
+    }
+    _queuedCount = 0;
+
+    return hashes;
+}
+
+void QGCTileDownloadEngine::abortAll()
+{
+    (void) clearQueued();
+
+    const QList<QNetworkReply*> replies = _replies.keys();
+    _replies.clear();
+    for (QNetworkReply *reply : replies) {
+        (void) reply->disconnect(this);
+        reply->abort();
+        reply->deleteLater();
+    }
+
+    for (HostState &hostState : _hosts) {
+        hostState.inFlight = 0;
+    }
+}
+
+int QGCTileDownloadEngine::concurrencyLimit(const QString &host) const
+{
+    const auto it = _hosts.constFind(host);
+    return (it == _hosts.cend()) ? _initialConcurrency : it->limit;
+}
+
+QGCTileDownloadEngine::Stats QGCTileDownloadEngine::stats() const
+{
+    Stats stats = _stats;
+    stats.inFlight = _replies.count();
+    stats.queued = _queuedCount;
+
+    const qint64 now = _clock.elapsed();
+    const qint64 windowMs = qBound(qint64(1), now, kRateWindowMs);
+    qint64 windowTiles = 0;
+    qint64 windowBytes = 0;
+    for (const auto &[timeMs, bytes] : _rateSamples) {
+        if ((now - timeMs) <= kRateWindowMs) {
+            windowTiles++;
+            windowBytes += bytes;
+        }
+    }
+    stats.tilesPerSecond = (windowTiles * 1000.) / windowMs;
+    stats.bytesPerSecond = (windowBytes * 1000.) / windowMs;
+
+    return stats;
+}
+
+void QGCTileDownloadEngine::_startDownloads(const QString &host)
+{
+    HostState &hostState = _hosts[host];
+
+    while (!hostState.queue.isEmpty() && (hostState.inFlight < hostState.limit)) {
+        const PendingTile tile = hostState.queue.dequeue();
+        _queuedCount--;
+
+        QNetworkReply *const reply = _networkManager->get(tile.request);
+        reply->setParent(this);
+        QGCNetworkHelper::ignoreSslErrorsIfNeeded(reply);
+        (void) connect(reply, &QNetworkReply::finished, this, &QGCTileDownloadEngine::_replyFinished);
+
+        (void) _replies.insert(reply, { tile.hash, host, _clock.elapsed() });
+        hostState.inFlight++;
+    }
+}
+
+void QGCTileDownloadEngine::_replyFinished()
+{
+    QNetworkReply *const reply = qobject_cast<QNetworkReply*>(QObject::sender());
+    if (!reply) {
+        return;
+    }
+    reply->deleteLater();
+
+    const auto it = _replies.constFind(reply);
+    if (it == _replies.cend()) {
+        return;
+    }
+    const ReplyInfo info = it.value();
+    _replies.erase(it);
+
+    HostState &hostState = _hosts[info.host];
+    hostState.inFlight--;
+
+    if (reply->error() == QNetworkReply::NoError) {
+        const QByteArray data = reply->readAll();
+        _recordSuccess(hostState, _clock.elapsed() - info.startMs);
+        _recordRate(data.size());
+        _stats.tilesDownloaded++;
+        _stats.bytesDownloaded += data.size();
+
+        _startDownloads(info.host);
+        emit tileDownloaded(info.hash, data);
+    } else {
+        if (_isCongestionError(reply)) {
+            _recordCongestion(hostState);
+        }
+        _stats.tilesFailed++;
+        qCDebug(QGCTileDownloadEngineLog) << "Error fetching tile" << info.hash << reply->errorString();
+
+        _startDownloads(info.host);
+        emit tileFailed(info.hash, reply->errorString());
+    }
+}
+
+void QGCTileDownloadEngine::_recordSuccess(HostState &hostState, qint64 latencyMs)
+{
+    if (hostState.latencyMs < 0.) {
+        hostState.latencyMs = latencyMs;
+        hostState.minLatencyMs = latencyMs;
+    } else {
+        hostState.latencyMs += kLatencySmoothing * (latencyMs - hostState.latencyMs);
+        hostState.minLatencyMs = qMin(hostState.minLatencyMs, static_cast<double>(latencyMs));
+    }
+
+    if (++hostState.windowCompletions < hostState.limit) {
+        return;
+    }
+    hostState.windowCompletions = 0;
+
+    const double latencyThresholdMs = (hostState.minLatencyMs * kLatencyBackoffRatio) + kLatencySlackMs;
+    if (hostState.latencyMs > latencyThresholdMs) {
+        // Requests are queueing up at the server or on the link
+        hostState.limit = qMax(kMinConcurrency, hostState.limit - 1);
+    } else if (!hostState.queue.isEmpty()) {
+        hostState.limit = qMin(_maxConcurrency, hostState.limit + 1);
+    }
+
+    qCDebug(QGCTileDownloadEngineLog) << "limit:" << hostState.limit << "latency:" << hostState.latencyMs << "min:" << hostState.minLatencyMs;
+}
+
+void QGCTileDownloadEngine::_recordCongestion(HostState &hostState)
+{
+    hostState.limit = qMax(kMinConcurrency, hostState.limit / 2);
+    hostState.windowCompletions = 0;
+
+    qCDebug(QGCTileDownloadEngineLog) << "backing off, limit:" << hostState.limit;
+}
+
+void QGCTileDownloadEngine::_recordRate(qint64 bytes)
+{
+    const qint64 now = _clock.elapsed();
+    _rateSamples.enqueue({ now, bytes });
+    while (!_rateSamples.isEmpty() && ((now - _rateSamples.head().first) > kRateWindowMs)) {
+        (void) _rateSamples.dequeue();
+    }
+}
+
+bool QGCTileDownloadEngine::_isCongestionError(QNetworkReply *reply)
+{
+    if (reply->error() == QNetworkReply::OperationCanceledError) {
+        return false;
+    }
+
+    // Missing tiles and other client errors say nothing about the load on the host
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    return (status == 0) || (status == 429) || (status >= 500);
+}
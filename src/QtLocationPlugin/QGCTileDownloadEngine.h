@@ -0,0 +1,113 @@
+#pragma once
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QObject>
+#include <QtCore/QQueue>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtNetwork/QNetworkRequest>
+
+#include <utility>
+
+class QNetworkAccessManager;
+class QNetworkReply;
+
+/// Downloads tiles for offline tile sets with a concurrency limit per host that adapts to the host.
+///
+/// Each host starts at the initial concurrency. After every window of completions (as many as the
+/// current limit) the limit grows by one if the host had more work queued and its smoothed latency
+/// stayed close to the best latency seen, or shrinks by one if latency has built up. Server errors,
+/// rate limiting and transport failures halve the limit. Must be used from a single thread.
+class QGCTileDownloadEngine : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Stats {
+        quint64 tilesDownloaded = 0;
+        quint64 tilesFailed = 0;
+        quint64 bytesDownloaded = 0;
+        double tilesPerSecond = 0.;     ///< Over the last kRateWindowMs
+        double bytesPerSecond = 0.;     ///< Over the last kRateWindowMs
+        qsizetype inFlight = 0;
+        qsizetype queued = 0;
+    };
+
+    explicit QGCTileDownloadEngine(QNetworkAccessManager *networkManager, QObject *parent = nullptr);
+    ~QGCTileDownloadEngine();
+
+    /// Queues a tile download, started as soon as the request's host has a free slot
+    void enqueue(const QString &hash, const QNetworkRequest &request);
+
+    /// Drops downloads which have not started yet, in flight downloads are left to finish
+    ///     @return Hashes of the dropped tiles
+    QStringList clearQueued();
+
+    /// Aborts and drops all downloads without reporting them
+    void abortAll();
+
+    /// Number of tiles queued or in flight
+    qsizetype pendingCount() const { return _queuedCount + _replies.count(); }
+
+    /// Current concurrency limit for @p host, the initial concurrency for hosts not seen yet
+    int concurrencyLimit(const QString &host) const;
+
+    void setInitialConcurrency(int concurrency) { _initialConcurrency = qBound(kMinConcurrency, concurrency, _maxConcurrency); }
+    void setMaxConcurrency(int concurrency) { _maxConcurrency = qMax(kMinConcurrency, concurrency); }
+
+    Stats stats() const;
+
+    static constexpr int kMinConcurrency = 1;
+    static constexpr int kDefaultMaxConcurrency = 16;
+    static constexpr qint64 kRateWindowMs = 5000;
+
+signals:
+    void tileDownloaded(const QString &hash, const QByteArray &data);
+    void tileFailed(const QString &hash, const QString &errorString);
+
+private slots:
+    void _replyFinished();
+
+private:
+    struct PendingTile {
+        QString hash;
+        QNetworkRequest request;
+    };
+
+    struct HostState {
+        QQueue<PendingTile> queue;
+        int inFlight = 0;
+        int limit = kMinConcurrency;
+        int windowCompletions = 0;      ///< Completions since the limit was last adjusted
+        double latencyMs = -1.;         ///< Smoothed, negative until the first sample
+        double minLatencyMs = -1.;
+    };
+
+    struct ReplyInfo {
+        QString hash;
+        QString host;
+        qint64 startMs = 0;
+    };
+
+    void _startDownloads(const QString &host);
+    void _recordSuccess(HostState &hostState, qint64 latencyMs);
+    void _recordCongestion(HostState &hostState);
+    void _recordRate(qint64 bytes);
+    static bool _isCongestionError(QNetworkReply *reply);
+
+    QNetworkAccessManager *_networkManager = nullptr;
+    QHash<QString, HostState> _hosts;
+    QHash<QNetworkReply*, ReplyInfo> _replies;
+    qsizetype _queuedCount = 0;
+    int _initialConcurrency;
+    int _maxConcurrency = kDefaultMaxConcurrency;
+
+    QElapsedTimer _clock;
+    QQueue<std::pair<qint64, qint64>> _rateSamples;     ///< Completion time, bytes received
+    Stats _stats;
+
+    static constexpr double kLatencySmoothing = 0.2;
+    static constexpr double kLatencyBackoffRatio = 2.;
+    static constexpr double kLatencySlackMs = 50.;
+};
@@ -0,0 +1,167 @@
+#include "QGCTileImageCache.h"
+
+#include <QtCore/QGlobalStatic>
+#include <QtCore/QMutexLocker>
+
+#include "QGCLoggingCategory.h"
+
+QGC_LOGGING_CATEGORY(QGCTileImageCacheLog, "QtLocationPlugin.QGCTileImageCache")
+
+Q_GLOBAL_STATIC(QGCTileImageCache, _tileImageCacheInstance)
+
+QGCTileImageCache::QGCTileImageCache(qint64 budgetBytes)
+    : _budgetBytes(budgetBytes)
+{
+    qCDebug(QGCTileImageCacheLog) << this;
+}
+
+QGCTileImageCache::~QGCTileImageCache()
+{
+    qCDebug(QGCTileImageCacheLog) << "hits:" << _stats.hits << "misses:" << _stats.misses << "evictions:" << _stats.evictions;
+}
+
+QGCTileImageCache *QGCTileImageCache::instance()
+{
+    return _tileImageCacheInstance();
+}
+
+QImage QGCTileImageCache::image(const Key &key)
+{
+    QMutexLocker locker(&_mutex);
+
+    const auto it = _entries.find(key);
+    if (it == _entries.end()) {
+        _stats.misses++;
+        return QImage();
+    }
+
+    if (it->pinCount == 0) {
+        _lru.splice(_lru.begin(), _lru, it->lru);
+    }
+    _stats.hits++;
+
+    return it->image;
+}
+
+void QGCTileImageCache::insert(const Key &key, const QImage &image)
+{
+    if (image.isNull()) {
+        return;
+    }
+
+    QMutexLocker locker(&_mutex);
+
+    auto it = _entries.find(key);
+    if (it == _entries.end()) {
+        _lru.push_front(key);
+        Entry entry;
+        entry.lru = _lru.begin();
+        it = _entries.insert(key, entry);
+    } else {
+        _bytes -= it->bytes;
+        if (it->pinCount == 0) {
+            _lru.splice(_lru.begin(), _lru, it->lru);
+        }
+    }
+
+    it->image = image;
+    it->bytes = image.sizeInBytes();
+    _bytes += it->bytes;
+
+    _evict();
+}
+
+QImage QGCTileImageCache::decode(const Key &key, const QByteArray &data)
+{
+    QImage image;
+    if (!image.loadFromData(data)) {
+        return QImage();
+    }
+
+    insert(key, image);
+
+    return image;
+}
+
+bool QGCTileImageCache::pin(const Key &key)
+{
+    QMutexLocker locker(&_mutex);
+
+    const auto it = _entries.find(key);
+    if (it == _entries.end()) {
+        return false;
+    }
+
+    if (it->pinCount++ == 0) {
+        _lru.erase(it->lru);
+    }
+
+    return true;
+}
+
+void QGCTileImageCache::unpin(const Key &key)
+{
+    QMutexLocker locker(&_mutex);
+
+    const auto it = _entries.find(key);
+    if ((it == _entries.end()) || (it->pinCount == 0)) {
+        qCWarning(QGCTileImageCacheLog) << "unpin called for tile which is not pinned" << key.mapId << key.zoom << key.x << key.y;
+        return;
+    }
+
+    if (--it->pinCount == 0) {
+        _lru.push_front(key);
+        it->lru = _lru.begin();
+        _evict();
+    }
+}
+
+void QGCTileImageCache::clear()
+{
+    QMutexLocker locker(&_mutex);
+
+    for (const Key &key : _lru) {
+        const auto it = _entries.find(key);
+        _bytes -= it->bytes;
+        _entries.erase(it);
+    }
+    _lru.clear();
+}
+
+void QGCTileImageCache::setBudgetBytes(qint64 bytes)
+{
+    QMutexLocker locker(&_mutex);
+
+    _budgetBytes = bytes;
+    _evict();
+}
+
+qint64 QGCTileImageCache::budgetBytes() const
+{
+    QMutexLocker locker(&_mutex);
+
+    return _budgetBytes;
+}
+
+QGCTileImageCache::Stats QGCTileImageCache::stats() const
+{
+    QMutexLocker locker(&_mutex);
+
+    Stats stats = _stats;
+    stats.images = _entries.count();
+    stats.pinnedImages = _entries.count() - static_cast<qsizetype>(_lru.size());
+    stats.bytes = _bytes;
+    return stats;
+}
+
+void QGCTileImageCache::_evict()
+{
+    // Images handed out earlier stay valid, the pixels are only released with the last QImage copy
+    while ((_bytes > _budgetBytes) && !_lru.empty()) {
+        const auto it = _entries.find(_lru.back());
+        _bytes -= it->bytes;
+        _entries.erase(it);
+        _lru.pop_back();
+        _stats.evictions++;
+    }
+}
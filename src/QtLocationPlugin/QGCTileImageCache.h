@@ -0,0 +1,87 @@
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtGui/QImage>
+
+#include <list>
+
+/// Process-wide cache of decoded map tile images.
+///
+/// The Qt Location map, GeoMap surface imagery and the 3D viewer all draw the same provider tiles.
+/// Decoding a tile once and handing out the implicitly shared QImage keeps a single copy of the pixels
+/// no matter how many consumers show it. Unpinned tiles are evicted least recently used first to stay
+/// within the byte budget. Pinned tiles are never evicted, they still count against the budget so a
+/// large pinned set shrinks the room left for the rest. Thread-safe.
+class QGCTileImageCache
+{
+public:
+    struct Key {
+        int mapId = 0;      ///< Qt map id of the provider, see UrlFactory::getQtMapIdFromProviderType
+        int x = 0;
+        int y = 0;
+        int zoom = 0;
+
+        bool operator==(const Key &other) const { return (mapId == other.mapId) && (x == other.x) && (y == other.y) && (zoom == other.zoom); }
+    };
+
+    struct Stats {
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 evictions = 0;      ///< Images dropped to stay within the budget
+        qsizetype images = 0;
+        qsizetype pinnedImages = 0;
+        qint64 bytes = 0;
+    };
+
+    explicit QGCTileImageCache(qint64 budgetBytes = kDefaultBudgetBytes);
+    ~QGCTileImageCache();
+
+    static QGCTileImageCache *instance();
+
+    /// @return Decoded image, a null image if the tile is not cached
+    QImage image(const Key &key);
+
+    /// Stores a decoded image, replacing any previous image for the tile. Null images are ignored.
+    void insert(const Key &key, const QImage &image);
+
+    /// Decodes @p data and stores the result
+    ///     @return Decoded image, a null image if @p data does not decode
+    QImage decode(const Key &key, const QByteArray &data);
+
+    /// Keeps a cached tile from being evicted until a matching unpin(). Pins are counted.
+    ///     @return false if the tile is not cached
+    bool pin(const Key &key);
+    void unpin(const Key &key);
+
+    /// Drops all unpinned images
+    void clear();
+
+    void setBudgetBytes(qint64 bytes);
+    qint64 budgetBytes() const;
+    Stats stats() const;
+
+    static constexpr qint64 kDefaultBudgetBytes = 64 * 1024 * 1024;
+
+private:
+    struct Entry {
+        QImage image;
+        qint64 bytes = 0;
+        int pinCount = 0;
+        std::list<Key>::iterator lru;   ///< Only valid while unpinned
+    };
+
+    void _evict();
+
+    mutable QMutex _mutex;
+    QHash<Key, Entry> _entries;
+    std::list<Key> _lru;                ///< Unpinned tiles, front is most recently used
+    qint64 _bytes = 0;
+    qint64 _budgetBytes;
+    Stats _stats;
+};
+
+inline size_t qHash(const QGCTileImageCache::Key &key, size_t seed = 0)
+{
+    return ::qHashMulti(seed, key.mapId, key.x, key.y, key.zoom);
+}
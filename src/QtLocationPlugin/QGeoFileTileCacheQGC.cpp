@@ -13,6 +13,7 @@
 #include "QGCMapEngine.h"
 #include "QGCMapTasks.h"
 #include "QGCMapUrlEngine.h"
+#include "QGCTileImageCache.h"
 #include "SettingsManager.h"
 
 QGC_LOGGING_CATEGORY(QGeoFileTileCacheQGCLog, "QtLocationPlugin.QGeoFileTileCacheQGC")
@@ -51,6 +52,26 @@ QGeoFileTileCacheQGC::~QGeoFileTileCacheQGC()
     qCDebug(QGeoFileTileCacheQGCLog) << this;
 }
 
+QSharedPointer<QGeoTileTexture> QGeoFileTileCacheQGC::get(const QGeoTileSpec &spec)
+{
+    const QGCTileImageCache::Key key = { spec.mapId(), spec.x(), spec.y(), spec.zoom() };
+
+    QSharedPointer<QGeoTileTexture> texture = QGeoFileTileCache::get(spec);
+    if (texture) {
+        // The texture shares its pixels with the cached image, so this costs no extra memory
+        QGCTileImageCache::instance()->insert(key, texture->image);
+        return texture;
+    }
+
+    const QImage image = QGCTileImageCache::instance()->image(key);
+    if (image.isNull()) {
+        return texture;
+    }
+
+    qCDebug(QGeoFileTileCacheQGCLog) << "Decoded tile served from shared cache" << spec.mapId() << spec.zoom() << spec.x() << spec.y();
+    return addToTextureCache(spec, image);
+}
+
 uint32_t QGeoFileTileCacheQGC::_getMemLimit(const QVariantMap &parameters)
 {
     uint32_t memLimit = 0;
@@ -14,6 +14,9 @@ class QGeoFileTileCacheQGC : public QGeoFileTileCache
     explicit QGeoFileTileCacheQGC(const QVariantMap &parameters, QObject *parent = nullptr);
     ~QGeoFileTileCacheQGC();
 
+    /// Serves tiles decoded by other consumers from QGCTileImageCache and publishes tiles decoded here
+    QSharedPointer<QGeoTileTexture> get(const QGeoTileSpec &spec) final;
+
     static quint32 getMaxDiskCacheSetting();
     static void cacheTile(const QString &type, int x, int y, int z, const QByteArray &image, const QString &format, qulonglong set = UINT64_MAX);
     static void cacheTile(const QString &type, const QString &hash, const QByteArray &image, const QString &format, qulonglong set = UINT64_MAX);
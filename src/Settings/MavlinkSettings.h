@@ -26,6 +26,7 @@ class MavlinkSettings : public SettingsGroup
     DEFINE_SETTINGFACT(gcsMavlinkSystemID)
 
     DEFINE_SETTINGFACT(noInitialDownloadWhenFlying)
+    DEFINE_SETTINGFACT(linkThreadParsing)
 
     // Although this is a global setting it only affects ArduPilot vehicle since PX4 automatically starts the stream from the vehicle side
     DEFINE_SETTINGFACT(apmStartMavlinkStreams)
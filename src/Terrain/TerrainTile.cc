@@ -4,6 +4,10 @@
 #include <QtCore/QtNumeric>
 #include <QtPositioning/QGeoCoordinate>
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
 QGC_LOGGING_CATEGORY(TerrainTileLog, "Terrain.terraintile");
 
 TerrainTile::TerrainTile(const QByteArray &byteArray)
@@ -51,18 +55,9 @@ TerrainTile::TerrainTile(const QByteArray &byteArray)
     qCDebug(TerrainTileLog) << this << "TileInfo: min, max, avg:" << _tileInfo.minElevation << _tileInfo.maxElevation << _tileInfo.avgElevation;
     qCDebug(TerrainTileLog) << this << "TileInfo: cell size:" << _cellSizeLat << _cellSizeLon;
 
-    _elevationData.resize(_tileInfo.gridSizeLat);
-    for (int k = 0; k < _tileInfo.gridSizeLat; k++) {
-        _elevationData[k].resize(_tileInfo.gridSizeLon);
-    }
-
-    int valueIndex = 0;
-    const int16_t* const pTileData = reinterpret_cast<const int16_t*>(&reinterpret_cast<const uint8_t*>(byteArray.constData())[cTileHeaderBytes]);
-    for (int i = 0; i < _tileInfo.gridSizeLat; i++) {
-        for (int j = 0; j < _tileInfo.gridSizeLon; j++) {
-            _elevationData[i][j] = pTileData[valueIndex++];
-        }
-    }
+    // The serialized grid is already row-major
+    _elevationData.resize(static_cast<qsizetype>(_tileInfo.gridSizeLat) * _tileInfo.gridSizeLon);
+    (void) memcpy(_elevationData.data(), byteArray.constData() + cTileHeaderBytes, cTileDataBytes);
 
     _isValid = true;
 }
@@ -93,14 +88,7 @@ double TerrainTile::elevation(const QGeoCoordinate &coordinate) const
         return qQNaN();
     }
 
-    if ((latIndex >= _elevationData.size()) || (lonIndex >= _elevationData[latIndex].size())) {
-        qCWarning(TerrainTileLog).noquote() << this << "Internal error: _elevationData size inconsistent _tileInfo << coordinate" << coordinate
-            << "\n\t_tileInfo.gridSizeLat:" << _tileInfo.gridSizeLat << "_tileInfo.gridSizeLon:" << _tileInfo.gridSizeLon
-            << "\n\t_data.size():" << _elevationData.size() << "_elevationData[latIndex].size():" << _elevationData[latIndex].size();
-        return qQNaN();
-    }
-
-    const int16_t elevation = _elevationData[latIndex][lonIndex];
+    const int16_t elevation = _elevationData[(static_cast<qsizetype>(latIndex) * _tileInfo.gridSizeLon) + lonIndex];
     if (elevation < _tileInfo.minElevation) {
         qCWarning(TerrainTileLog) << this << "Warning: elevation read is below min elevation in tile:" << elevation << "<" << _tileInfo.minElevation;
     } else if (elevation > _tileInfo.maxElevation) {
@@ -111,3 +99,54 @@ double TerrainTile::elevation(const QGeoCoordinate &coordinate) const
 
     return static_cast<double>(elevation);
 }
+
+qsizetype TerrainTile::elevations(const QGCGeo::GeoSpan &coordinates, std::span<double> elevations) const
+{
+    const qsizetype count = coordinates.size();
+    if (!_isValid || (static_cast<qsizetype>(coordinates.longitude.size()) != count) || (static_cast<qsizetype>(elevations.size()) < count)) {
+        qCWarning(TerrainTileLog) << this << "Request for elevations, but tile or request is invalid. valid:" << _isValid
+                                  << "coordinates:" << count << "elevations:" << elevations.size();
+        std::fill_n(elevations.begin(), std::min(count, static_cast<qsizetype>(elevations.size())), qQNaN());
+        return count;
+    }
+
+    const int16_t *const grid = _elevationData.constData();
+    const qsizetype rowStride = _tileInfo.gridSizeLon;
+    const int lastRow = _tileInfo.gridSizeLat - 1;
+    const int lastCol = _tileInfo.gridSizeLon - 1;
+    const double *const latitudes = coordinates.latitude.data();
+    const double *const longitudes = coordinates.longitude.data();
+    double *const results = elevations.data();
+
+    // Samples sit on the south west corner of their cell, so exact grid positions return the same value
+    // as elevation(). Branch free apart from the grid lookups to keep the loop vectorizable.
+    qsizetype outside = 0;
+    for (qsizetype i = 0; i < count; i++) {
+        const double row = (latitudes[i] - _tileInfo.swLat) / _cellSizeLat;
+        const double col = (longitudes[i] - _tileInfo.swLon) / _cellSizeLon;
+        const double row0 = std::floor(row);
+        const double col0 = std::floor(col);
+
+        const bool inside = (row0 >= 0.0) && (row0 <= lastRow) && (col0 >= 0.0) && (col0 <= lastCol);
+        const int r0 = inside ? static_cast<int>(row0) : 0;
+        const int c0 = inside ? static_cast<int>(col0) : 0;
+        const int r1 = std::min(r0 + 1, lastRow);
+        const int c1 = std::min(c0 + 1, lastCol);
+        const double rowFraction = inside ? (row - row0) : 0.0;
+        const double colFraction = inside ? (col - col0) : 0.0;
+
+        const int16_t *const south = grid + (r0 * rowStride);
+        const int16_t *const north = grid + (r1 * rowStride);
+        const double southElevation = south[c0] + ((south[c1] - south[c0]) * colFraction);
+        const double northElevation = north[c0] + ((north[c1] - north[c0]) * colFraction);
+
+        results[i] = inside ? (southElevation + ((northElevation - southElevation) * rowFraction)) : qQNaN();
+        outside += inside ? 0 : 1;
+    }
+
+    if (outside > 0) {
+        qCWarning(TerrainTileLog) << this << "Internal error:" << outside << "of" << count << "coordinates outside tile bounds";
+    }
+
+    return outside;
+}
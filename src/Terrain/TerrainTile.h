@@ -1,12 +1,19 @@
 #pragma once
 
 #include <QtCore/QList>
+
+#include <span>
+
+#include "QGCGeo.h"
+
 class QGeoCoordinate;
 class TerrainTileTest;
+class TerrainTileCacheTest;
 
 class TerrainTile
 {
     friend class TerrainTileTest;
+    friend class TerrainTileCacheTest;
 
 public:
     /// Constructor from serialized elevation data (either from file or web)
@@ -23,6 +30,12 @@ class TerrainTile
     ///    @return elevation
     double elevation(const QGeoCoordinate &coordinate) const;
 
+    /// Bilinearly interpolates the elevations at a batch of coordinates in a single pass over the grid
+    ///    @param coordinates coordinates to sample, altitudes are ignored
+    ///    @param[out] elevations coordinates.size() values, NaN for coordinates outside the tile
+    ///    @return number of coordinates which could not be sampled
+    qsizetype elevations(const QGCGeo::GeoSpan &coordinates, std::span<double> elevations) const;
+
     /// Accessor for the minimum elevation of the tile
     ///    @return minimum elevation
     double minElevation() const { return (_isValid ? static_cast<double>(_tileInfo.minElevation) : qQNaN()); }
@@ -35,6 +48,10 @@ class TerrainTile
     ///    @return average elevation
     double avgElevation() const { return (_isValid ? _tileInfo.avgElevation : qQNaN()); }
 
+    /// Approximate memory held by the decoded tile
+    ///    @return size in bytes
+    qint64 memoryBytes() const { return static_cast<qint64>(sizeof(*this)) + (_elevationData.size() * static_cast<qint64>(sizeof(int16_t))); }
+
 protected:
     struct TileInfo_t {
         double  swLat, swLon, neLat, neLon;
@@ -45,7 +62,7 @@ class TerrainTile
 
 private:
     TileInfo_t _tileInfo{};
-    QList<QList<int16_t>> _elevationData;   ///< 2D elevation data array
+    QList<int16_t> _elevationData;          ///< Row-major elevation grid, gridSizeLat rows of gridSizeLon values
     double _cellSizeLat = 0.0;              ///< data grid size in latitude direction
     double _cellSizeLon = 0.0;              ///< data grid size in longitude direction
     bool _isValid = false;                  ///< data loaded is valid
@@ -0,0 +1,233 @@
+#include "TerrainTileCache.h"
+#include "TerrainTile.h"
+#include "QGCFileHelper.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+
+#include <algorithm>
+
+QGC_LOGGING_CATEGORY(TerrainTileCacheLog, "Terrain.TerrainTileCache")
+
+TerrainTileCache::TerrainTileCache(const QString &directory, qint64 memoryBudgetBytes, qint64 diskBudgetBytes)
+    : _memoryBudgetBytes(memoryBudgetBytes)
+    , _directory(directory)
+    , _diskEnabled(!directory.isEmpty())
+    , _diskBudgetBytes(diskBudgetBytes)
+{
+    if (_diskEnabled) {
+        if (QGCFileHelper::ensureDirectoryExists(directory)) {
+            _scanDirectory();
+        } else {
+            qCWarning(TerrainTileCacheLog) << "Failed to create terrain tile cache directory" << directory;
+        }
+    }
+
+    qCDebug(TerrainTileCacheLog) << "directory:" << directory << "stored tiles:" << _disk.count() << "bytes:" << _diskBytes;
+}
+
+TerrainTileCache::~TerrainTileCache()
+{
+    qCDebug(TerrainTileCacheLog) << "memory hits:" << _stats.memoryHits << "disk hits:" << _stats.diskHits
+                                 << "misses:" << _stats.misses << "evictions:" << _stats.evictions;
+}
+
+std::shared_ptr<const TerrainTile> TerrainTileCache::tile(const QString &hash)
+{
+    QMutexLocker locker(&_mutex);
+
+    const auto memoryIt = _memory.find(hash);
+    if (memoryIt != _memory.end()) {
+        _memoryLru.splice(_memoryLru.begin(), _memoryLru, memoryIt->lru);
+        _stats.memoryHits++;
+        return memoryIt->tile;
+    }
+
+    const auto diskIt = _disk.find(hash);
+    if (diskIt == _disk.end()) {
+        _stats.misses++;
+        return nullptr;
+    }
+
+    // Read only, the store may be on read-only media. A tile which cannot be read is dropped from the index
+    // but its file is left alone.
+    QFile file(_filePath(hash));
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCWarning(TerrainTileCacheLog) << "Failed to open stored tile" << file.fileName() << file.errorString();
+        _forgetDisk(hash);
+        _stats.misses++;
+        return nullptr;
+    }
+
+    auto tile = std::make_shared<const TerrainTile>(file.readAll());
+    if (!tile->isValid()) {
+        qCWarning(TerrainTileCacheLog) << "Removing invalid stored tile" << file.fileName();
+        file.close();
+        _removeDisk(hash);
+        _stats.misses++;
+        return nullptr;
+    }
+
+    // Keep the least recently used order across restarts, best effort on a read-only store
+    (void) file.setFileTime(QDateTime::currentDateTimeUtc(), QFileDevice::FileModificationTime);
+    _diskLru.splice(_diskLru.begin(), _diskLru, diskIt->lru);
+    _stats.diskHits++;
+
+    return _insertMemory(hash, std::move(tile));
+}
+
+std::shared_ptr<const TerrainTile> TerrainTileCache::insert(const QString &hash, const QByteArray &payload)
+{
+    auto tile = std::make_shared<const TerrainTile>(payload);
+    if (!tile->isValid()) {
+        return nullptr;
+    }
+
+    QMutexLocker locker(&_mutex);
+
+    if (_diskEnabled && !_disk.contains(hash)) {
+        _storeDisk(hash, payload);
+    }
+
+    const auto memoryIt = _memory.constFind(hash);
+    if (memoryIt != _memory.cend()) {
+        return memoryIt->tile;
+    }
+
+    return _insertMemory(hash, std::move(tile));
+}
+
+void TerrainTileCache::clearMemory()
+{
+    QMutexLocker locker(&_mutex);
+
+    _memory.clear();
+    _memoryLru.clear();
+    _memoryBytes = 0;
+}
+
+void TerrainTileCache::setMemoryBudgetBytes(qint64 bytes)
+{
+    QMutexLocker locker(&_mutex);
+
+    _memoryBudgetBytes = bytes;
+    _evictMemory();
+}
+
+TerrainTileCache::Stats TerrainTileCache::stats() const
+{
+    QMutexLocker locker(&_mutex);
+
+    Stats stats = _stats;
+    stats.memoryTiles = _memory.count();
+    stats.memoryBytes = _memoryBytes;
+    stats.diskTiles = _disk.count();
+    stats.diskBytes = _diskBytes;
+    return stats;
+}
+
+std::shared_ptr<const TerrainTile> TerrainTileCache::_insertMemory(const QString &hash, std::shared_ptr<const TerrainTile> tile)
+{
+    MemoryEntry entry;
+    entry.tile = std::move(tile);
+    entry.bytes = entry.tile->memoryBytes();
+    _memoryLru.push_front(hash);
+    entry.lru = _memoryLru.begin();
+
+    _memoryBytes += entry.bytes;
+    const std::shared_ptr<const TerrainTile> result = entry.tile;
+    (void) _memory.insert(hash, entry);
+
+    _evictMemory();
+
+    return result;
+}
+
+void TerrainTileCache::_evictMemory()
+{
+    // Tiles still referenced by a caller stay alive until released
+    while ((_memoryBytes > _memoryBudgetBytes) && (_memoryLru.size() > 1)) {
+        const auto it = _memory.find(_memoryLru.back());
+        _memoryBytes -= it->bytes;
+        qCDebug(TerrainTileCacheLog) << "Evicting decoded tile" << it.key();
+        _memory.erase(it);
+        _memoryLru.pop_back();
+        _stats.evictions++;
+    }
+}
+
+void TerrainTileCache::_scanDirectory()
+{
+    const QString nameFilter = QStringLiteral("*") + QLatin1String(_fileExtension);
+    QFileInfoList files = _directory.entryInfoList({ nameFilter }, QDir::Files | QDir::NoDotAndDotDot);
+    std::sort(files.begin(), files.end(), [](const QFileInfo &a, const QFileInfo &b) {
+        return a.lastModified() > b.lastModified();
+    });
+
+    for (const QFileInfo &info : files) {
+        const QString hash = info.completeBaseName();
+        DiskEntry entry;
+        entry.bytes = info.size();
+        _diskLru.push_back(hash);
+        entry.lru = std::prev(_diskLru.end());
+        (void) _disk.insert(hash, entry);
+        _diskBytes += entry.bytes;
+    }
+
+    _evictDisk();
+}
+
+void TerrainTileCache::_storeDisk(const QString &hash, const QByteArray &payload)
+{
+    if (!QGCFileHelper::atomicWrite(_filePath(hash), payload)) {
+        qCWarning(TerrainTileCacheLog) << "Failed to store tile" << _filePath(hash);
+        return;
+    }
+
+    DiskEntry entry;
+    entry.bytes = payload.size();
+    _diskLru.push_front(hash);
+    entry.lru = _diskLru.begin();
+    (void) _disk.insert(hash, entry);
+    _diskBytes += entry.bytes;
+
+    _evictDisk();
+}
+
+void TerrainTileCache::_removeDisk(const QString &hash)
+{
+    if (!_disk.contains(hash)) {
+        return;
+    }
+
+    (void) QFile::remove(_filePath(hash));
+    _forgetDisk(hash);
+}
+
+void TerrainTileCache::_forgetDisk(const QString &hash)
+{
+    const auto it = _disk.find(hash);
+    if (it == _disk.end()) {
+        return;
+    }
+
+    _diskBytes -= it->bytes;
+    _diskLru.erase(it->lru);
+    _disk.erase(it);
+}
+
+void TerrainTileCache::_evictDisk()
+{
+    while ((_diskBytes > _diskBudgetBytes) && (_diskLru.size() > 1)) {
+        const QString hash = _diskLru.back();
+        qCDebug(TerrainTileCacheLog) << "Removing stored tile" << hash;
+        _removeDisk(hash);
+    }
+}
+
+QString TerrainTileCache::_filePath(const QString &hash) const
+{
+    return _directory.filePath(hash + QLatin1String(_fileExtension));
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <QtCore/QDir>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+
+#include <list>
+#include <memory>
+
+class TerrainTile;
+
+/// Two-level cache of terrain tiles keyed by tile hash.
+///
+/// Decoded tiles are kept in a byte-budgeted in-memory LRU. Behind it, the serialized tile payloads are
+/// stored one file per tile in a directory with its own byte budget, so tiles survive restarts and can be
+/// served offline. A memory miss falls back to disk before the caller has to download the tile.
+/// Thread-safe.
+class TerrainTileCache
+{
+public:
+    struct Stats {
+        quint64 memoryHits = 0;     ///< Lookups served from the decoded tile LRU
+        quint64 diskHits = 0;       ///< Lookups served by loading a stored payload
+        quint64 misses = 0;         ///< Lookups found in neither level
+        quint64 evictions = 0;      ///< Decoded tiles dropped to stay within the memory budget
+        qsizetype memoryTiles = 0;
+        qint64 memoryBytes = 0;
+        qsizetype diskTiles = 0;
+        qint64 diskBytes = 0;
+    };
+
+    /// @param directory Location of the on-disk store, empty for a memory-only cache
+    /// @param memoryBudgetBytes Upper bound for the decoded tiles held in memory
+    /// @param diskBudgetBytes Upper bound for the stored payloads, least recently used are removed first
+    TerrainTileCache(const QString &directory, qint64 memoryBudgetBytes, qint64 diskBudgetBytes);
+    ~TerrainTileCache();
+
+    /// @return Decoded tile from memory or disk, nullptr if neither level has it
+    std::shared_ptr<const TerrainTile> tile(const QString &hash);
+
+    /// Decodes a serialized tile payload and stores it in both levels
+    /// @return Decoded tile, nullptr if the payload is not a valid tile
+    std::shared_ptr<const TerrainTile> insert(const QString &hash, const QByteArray &payload);
+
+    /// Drops all decoded tiles; stored payloads are kept
+    void clearMemory();
+
+    void setMemoryBudgetBytes(qint64 bytes);
+    Stats stats() const;
+
+    static constexpr qint64 kDefaultMemoryBudgetBytes = 32 * 1024 * 1024;
+    static constexpr qint64 kDefaultDiskBudgetBytes = 256 * 1024 * 1024;
+
+private:
+    struct MemoryEntry {
+        std::shared_ptr<const TerrainTile> tile;
+        qint64 bytes = 0;
+        std::list<QString>::iterator lru;
+    };
+
+    struct DiskEntry {
+        qint64 bytes = 0;
+        std::list<QString>::iterator lru;
+    };
+
+    std::shared_ptr<const TerrainTile> _insertMemory(const QString &hash, std::shared_ptr<const TerrainTile> tile);
+    void _evictMemory();
+    void _scanDirectory();
+    void _storeDisk(const QString &hash, const QByteArray &payload);
+    void _removeDisk(const QString &hash);
+    void _forgetDisk(const QString &hash);     ///< Drops the index entry, keeps the file
+    void _evictDisk();
+    QString _filePath(const QString &hash) const;
+
+    mutable QMutex _mutex;
+
+    QHash<QString, MemoryEntry> _memory;
+    std::list<QString> _memoryLru;          ///< Front is most recently used
+    qint64 _memoryBytes = 0;
+    qint64 _memoryBudgetBytes;
+
+    const QDir _directory;
+    const bool _diskEnabled;
+    QHash<QString, DiskEntry> _disk;
+    std::list<QString> _diskLru;            ///< Front is most recently used
+    qint64 _diskBytes = 0;
+    const qint64 _diskBudgetBytes;
+
+    Stats _stats;
+
+    static constexpr const char *_fileExtension = ".tile";
+};
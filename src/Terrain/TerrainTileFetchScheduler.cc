@@ -0,0 +1,69 @@
+#include "TerrainTileFetchScheduler.h"
+#include "QGCLoggingCategory.h"
+
+QGC_LOGGING_CATEGORY(TerrainTileFetchSchedulerLog, "Terrain.TerrainTileFetchScheduler")
+
+TerrainTileFetchScheduler::TerrainTileFetchScheduler(int maxConcurrentFetches, FetchFunction fetchFunction)
+    : _maxConcurrentFetches(qMax(1, maxConcurrentFetches))
+    , _fetchFunction(std::move(fetchFunction))
+{
+    _clock.start();
+}
+
+bool TerrainTileFetchScheduler::request(const TileKey &key)
+{
+    if (isPending(key.hash)) {
+        _metrics.coalescedRequests++;
+        return false;
+    }
+
+    qCDebug(TerrainTileFetchSchedulerLog) << "queue tile" << key.hash << "in flight:" << _inFlight.count() << "waiting:" << _waiting.count();
+
+    _waiting.enqueue(key);
+    (void) _waitingHashes.insert(key.hash);
+    _startWaiting();
+
+    return true;
+}
+
+void TerrainTileFetchScheduler::finished(const QString &hash, bool success)
+{
+    const auto it = _inFlight.constFind(hash);
+    if (it == _inFlight.cend()) {
+        qCWarning(TerrainTileFetchSchedulerLog) << "finished called for tile which is not in flight" << hash;
+        return;
+    }
+
+    const qint64 fetchMs = _clock.elapsed() - it.value();
+    _inFlight.erase(it);
+
+    if (success) {
+        _metrics.tilesFetched++;
+    } else {
+        _metrics.tilesFailed++;
+    }
+    _metrics.totalFetchMs += fetchMs;
+    _metrics.maxFetchMs = qMax(_metrics.maxFetchMs, fetchMs);
+
+    qCDebug(TerrainTileFetchSchedulerLog) << "tile done" << hash << "success:" << success << "ms:" << fetchMs;
+
+    _startWaiting();
+}
+
+TerrainTileFetchScheduler::Metrics TerrainTileFetchScheduler::metrics() const
+{
+    Metrics metrics = _metrics;
+    metrics.tilesInFlight = _inFlight.count();
+    metrics.tilesWaiting = _waiting.count();
+    return metrics;
+}
+
+void TerrainTileFetchScheduler::_startWaiting()
+{
+    while (!_waiting.isEmpty() && (_inFlight.count() < _maxConcurrentFetches)) {
+        const TileKey key = _waiting.dequeue();
+        (void) _waitingHashes.remove(key.hash);
+        (void) _inFlight.insert(key.hash, _clock.elapsed());
+        _fetchFunction(key);
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QQueue>
+#include <QtCore/QSet>
+#include <QtCore/QString>
+
+#include <functional>
+
+/// Schedules terrain tile fetches for TerrainTileManager.
+///
+/// Requests for the same tile are coalesced while it is waiting or in flight, and at most
+/// maxConcurrentFetches tiles are fetched at once. The actual fetch is done by the owner through
+/// the fetch function, which must report back through finished(). Not thread-safe.
+class TerrainTileFetchScheduler
+{
+public:
+    struct TileKey {
+        QString hash;
+        int x = 0;
+        int y = 0;
+        int mapId = 0;
+    };
+
+    struct Metrics {
+        qsizetype tilesInFlight = 0;
+        qsizetype tilesWaiting = 0;
+        quint64 tilesFetched = 0;
+        quint64 tilesFailed = 0;
+        quint64 coalescedRequests = 0;  ///< Requests for a tile which was already waiting or in flight
+        qint64 totalFetchMs = 0;        ///< Sum of start to finish time of all completed fetches
+        qint64 maxFetchMs = 0;
+    };
+
+    using FetchFunction = std::function<void(const TileKey &key)>;
+
+    TerrainTileFetchScheduler(int maxConcurrentFetches, FetchFunction fetchFunction);
+
+    /// Queues a tile fetch unless the tile is already waiting or in flight
+    ///     @return true if a new fetch was scheduled
+    bool request(const TileKey &key);
+
+    /// Reports the end of a fetch started through the fetch function and starts waiting fetches
+    void finished(const QString &hash, bool success);
+
+    bool isPending(const QString &hash) const { return _inFlight.contains(hash) || _waitingHashes.contains(hash); }
+    int maxConcurrentFetches() const { return _maxConcurrentFetches; }
+    Metrics metrics() const;
+
+    static constexpr int kDefaultMaxConcurrentFetches = 4;
+
+private:
+    void _startWaiting();
+
+    const int _maxConcurrentFetches;
+    const FetchFunction _fetchFunction;
+
+    QQueue<TileKey> _waiting;
+    QSet<QString> _waitingHashes;
+    QHash<QString, qint64> _inFlight;   ///< Tile hash -> _clock time the fetch was started
+    QElapsedTimer _clock;
+    Metrics _metrics;
+};
@@ -9,13 +9,18 @@
 #include "FlightMapSettings.h"
 #include "QGCLoggingCategory.h"
 #include "QGCGeo.h"
+#include "AppMessages.h"
 
 #include <QtCore/QDateTime>
+#include <QtCore/QStandardPaths>
 #include <QtLocation/private/qgeotilespec_p.h>
 #include <QtNetwork/QNetworkAccessManager>
 #include <QtNetwork/QNetworkRequest>
 
+#include <algorithm>
 #include <limits>
+#include <span>
+#include <vector>
 
 #include "QGCNetworkHelper.h"
 
@@ -23,6 +28,15 @@ QGC_LOGGING_CATEGORY(TerrainTileManagerLog, "Terrain.TerrainTileManager")
 
 namespace {
     constexpr int kMaxCarpetGridSize = 10000;
+
+    /// Unit tests serve synthetic tiles, keep them out of the persistent store
+    QString tileCacheDirectory()
+    {
+        if (QGC::runningUnitTests()) {
+            return QString();
+        }
+        return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QStringLiteral("/TerrainTiles");
+    }
 }
 
 Q_GLOBAL_STATIC(TerrainTileManager, _terrainTileManager)
@@ -34,17 +48,19 @@ TerrainTileManager *TerrainTileManager::instance()
 
 TerrainTileManager::TerrainTileManager(QObject *parent)
     : QObject(parent)
+    , _fetchScheduler(TerrainTileFetchScheduler::kDefaultMaxConcurrentFetches, [this](const TerrainTileFetchScheduler::TileKey &key) { _fetchTile(key); })
+    , _tileCache(tileCacheDirectory(), TerrainTileCache::kDefaultMemoryBudgetBytes, TerrainTileCache::kDefaultDiskBudgetBytes)
     , _networkManager(new QNetworkAccessManager(this))
 {
     qCDebug(TerrainTileManagerLog) << this;
 
     QGCNetworkHelper::configureProxy(_networkManager);
+
+    _requestClock.start();
 }
 
 TerrainTileManager::~TerrainTileManager()
 {
-    qDeleteAll(_tiles);
-
     qCDebug(TerrainTileManagerLog) << this;
 }
 
@@ -54,48 +70,64 @@ bool TerrainTileManager::getAltitudesForCoordinates(const QList<QGeoCoordinate>
 
     const QString elevationProviderName = SettingsManager::instance()->flightMapSettings()->elevationMapProvider()->rawValue().toString();
     const SharedMapProvider provider = UrlFactory::getMapProviderFromProviderType(elevationProviderName);
-    for (const QGeoCoordinate &coordinate: coordinates) {
-        const QString tileHash = UrlFactory::getTileHash(
-            provider->getMapName(),
-            provider->long2tileX(coordinate.longitude(), 1),
-            provider->lat2tileY(coordinate.latitude(), 1),
-            1
-        );
-        qCDebug(TerrainTileManagerLog) << "hash:coordinate" << tileHash << coordinate;
-
-        TerrainTile* const tile = _getCachedTile(tileHash);
+
+    // Split into structure of arrays once so each run of coordinates within a tile is sampled in a single pass
+    const qsizetype count = coordinates.count();
+    std::vector<double> latitudes(count);
+    std::vector<double> longitudes(count);
+    for (qsizetype i = 0; i < count; i++) {
+        latitudes[i] = coordinates[i].latitude();
+        longitudes[i] = coordinates[i].longitude();
+    }
+
+    const qsizetype firstAltitude = altitudes.count();
+    altitudes.resize(firstAltitude + count);
+
+    bool missingTiles = false;
+    qsizetype runStart = 0;
+    while (runStart < count) {
+        const int tileX = provider->long2tileX(longitudes[runStart], 1);
+        const int tileY = provider->lat2tileY(latitudes[runStart], 1);
+        qsizetype runEnd = runStart + 1;
+        while ((runEnd < count) && (provider->long2tileX(longitudes[runEnd], 1) == tileX) && (provider->lat2tileY(latitudes[runEnd], 1) == tileY)) {
+            runEnd++;
+        }
+        const size_t runLength = static_cast<size_t>(runEnd - runStart);
+
+        const QString tileHash = UrlFactory::getTileHash(provider->getMapName(), tileX, tileY, 1);
+        qCDebug(TerrainTileManagerLog) << "hash:coordinates" << tileHash << runLength;
+
+        const std::span<double> runAltitudes(altitudes.data() + firstAltitude + runStart, runLength);
+        const std::shared_ptr<const TerrainTile> tile = _getCachedTile(tileHash);
         if (tile) {
-            const double elevation = tile->elevation(coordinate);
-            if (qIsNaN(elevation)) {
+            const QGCGeo::GeoSpan run{
+                std::span<const double>(latitudes).subspan(static_cast<size_t>(runStart), runLength),
+                std::span<const double>(longitudes).subspan(static_cast<size_t>(runStart), runLength),
+                {}
+            };
+            if (tile->elevations(run, runAltitudes) > 0) {
                 error = true;
                 qCWarning(TerrainTileManagerLog) << "Internal Error: missing elevation in tile cache";
             } else {
-                qCDebug(TerrainTileManagerLog) << "returning elevation from tile cache" << elevation;
+                qCDebug(TerrainTileManagerLog) << "returning elevations from tile cache" << runLength;
             }
-            altitudes.push_back(elevation);
         } else if (_isFailedTile(tileHash)) {
             // Tile fetch failed recently; short-circuit to avoid hammering the server with repeated requests
             // (e.g. uninitialized 0,0 coordinates from MAVLink TERRAIN_REQUEST returning HTTP 500).
             error = true;
-            altitudes.push_back(qQNaN());
-        } else if (_state != TerrainQuery::State::Downloading) {
-            QGeoTileSpec spec;
-            spec.setX(provider->long2tileX(coordinate.longitude(), 1));
-            spec.setY(provider->lat2tileY(coordinate.latitude(), 1));
-            spec.setZoom(1);
-            spec.setMapId(provider->getMapId());
-            const QNetworkRequest request = QGeoTileFetcherQGC::getNetworkRequest(spec.mapId(), spec.x(), spec.y(), spec.zoom());
-            QGeoTiledMapReplyQGC *reply = new QGeoTiledMapReplyQGC(_networkManager, request, spec, this);
-            (void) connect(reply, &QGeoTiledMapReplyQGC::finished, this, &TerrainTileManager::_terrainDone);
-            if (reply->init()) {
-                _state = TerrainQuery::State::Downloading;
-            } else {
-                reply->deleteLater();
-            }
-            return false;
+            std::fill(runAltitudes.begin(), runAltitudes.end(), qQNaN());
         } else {
-            return false;
+            // Keep going so every missing tile of the request is fetched concurrently
+            missingTiles = true;
+            (void) _fetchScheduler.request({ tileHash, tileX, tileY, provider->getMapId() });
         }
+
+        runStart = runEnd;
+    }
+
+    if (missingTiles) {
+        altitudes.resize(firstAltitude);
+        return false;
     }
 
     return true;
@@ -121,7 +153,8 @@ void TerrainTileManager::addCoordinateQuery(TerrainQueryInterface *terrainQueryI
             coordinates,
             false,
             0,
-            0
+            0,
+            _requestClock.elapsed()
         };
         _requestQueue.enqueue(queuedRequestInfo);
         return;
@@ -156,7 +189,8 @@ void TerrainTileManager::addPathQuery(TerrainQueryInterface *terrainQueryInterfa
             coordinates,
             false,
             0,
-            0
+            0,
+            _requestClock.elapsed()
         };
         _requestQueue.enqueue(queuedRequestInfo);
         return;
@@ -220,7 +254,8 @@ void TerrainTileManager::addCarpetQuery(TerrainQueryInterface *terrainQueryInter
             coordinates,
             statsOnly,
             gridSizeLat + 1,
-            gridSizeLon + 1
+            gridSizeLon + 1,
+            _requestClock.elapsed()
         };
         _requestQueue.enqueue(queuedRequestInfo);
         return;
@@ -261,47 +296,45 @@ QList<QGeoCoordinate> TerrainTileManager::_pathQueryToCoords(const QGeoCoordinat
     return coordinates;
 }
 
-void TerrainTileManager::_tileFailed()
+TerrainTileManager::QueryMetrics TerrainTileManager::queryMetrics() const
 {
-    QList<double> noAltitudes;
+    QueryMetrics metrics;
+    metrics.queuedRequests = _requestQueue.count();
+    metrics.resolvedRequests = _resolvedRequests;
+    metrics.totalRequestLatencyMs = _totalRequestLatencyMs;
+    metrics.maxRequestLatencyMs = _maxRequestLatencyMs;
+    metrics.tileFetches = _fetchScheduler.metrics();
+    return metrics;
+}
 
-    for (const QueuedRequestInfo_t &requestInfo: _requestQueue) {
-        if (requestInfo.terrainQueryInterface.isNull()) {
-            continue;
-        }
-        switch (requestInfo.queryMode) {
-        case TerrainQuery::QueryMode::QueryModeCoordinates:
-            requestInfo.terrainQueryInterface->signalCoordinateHeights(false, noAltitudes);
-            break;
-        case TerrainQuery::QueryMode::QueryModePath:
-            requestInfo.terrainQueryInterface->signalPathHeights(false, requestInfo.distanceBetween, requestInfo.finalDistanceBetween, noAltitudes);
-            break;
-        case TerrainQuery::QueryMode::QueryModeCarpet:
-            requestInfo.terrainQueryInterface->signalCarpetHeights(false, qQNaN(), qQNaN(), QList<QList<double>>());
-            break;
-        default:
-            continue;
-        }
+void TerrainTileManager::_fetchTile(const TerrainTileFetchScheduler::TileKey &key)
+{
+    QGeoTileSpec spec;
+    spec.setX(key.x);
+    spec.setY(key.y);
+    spec.setZoom(1);
+    spec.setMapId(key.mapId);
+    const QNetworkRequest request = QGeoTileFetcherQGC::getNetworkRequest(spec.mapId(), spec.x(), spec.y(), spec.zoom());
+    QGeoTiledMapReplyQGC *reply = new QGeoTiledMapReplyQGC(_networkManager, request, spec, this);
+    const QString hash = key.hash;
+    (void) connect(reply, &QGeoTiledMapReplyQGC::finished, this, [this, reply, hash]() {
+        _terrainDone(reply, hash);
+    });
+    if (!reply->init()) {
+        reply->deleteLater();
+        // The scheduler may be starting fetches for a query which is still being scanned, so report later
+        (void) _recordFailedTile(hash);
+        (void) QMetaObject::invokeMethod(this, [this, hash]() {
+            _tileFetchFinished(hash, false);
+        }, Qt::QueuedConnection);
     }
-
-    _requestQueue.clear();
 }
 
-void TerrainTileManager::_terrainDone()
+void TerrainTileManager::_terrainDone(QGeoTiledMapReplyQGC *reply, const QString &hash)
 {
-    _state = TerrainQuery::State::Idle;
-
-    QGeoTiledMapReplyQGC* const reply = qobject_cast<QGeoTiledMapReplyQGC*>(QObject::sender());
-    if (!reply) {
-        qCWarning(TerrainTileManagerLog) << "Elevation tile fetched but invalid reply data type.";
-        return;
-    }
     reply->deleteLater();
 
     const QByteArray responseBytes = reply->mapImageData();
-    const QGeoTileSpec spec = reply->tileSpec();
-
-    const QString hash = UrlFactory::getTileHash(UrlFactory::getProviderTypeFromQtMapId(spec.mapId()), spec.x(), spec.y(), spec.zoom());
 
     if (reply->error() != QGeoTiledMapReplyQGC::NoError) {
         const bool firstFailure = _recordFailedTile(hash);
@@ -310,7 +343,7 @@ void TerrainTileManager::_terrainDone()
         } else {
             qCDebug(TerrainTileManagerLog) << "Elevation tile fetching returned error (suppressed):" << reply->errorString();
         }
-        _tileFailed();
+        _tileFetchFinished(hash, false);
         return;
     }
 
@@ -321,7 +354,7 @@ void TerrainTileManager::_terrainDone()
         } else {
             qCDebug(TerrainTileManagerLog) << "Error in fetching elevation tile. Empty response (suppressed).";
         }
-        _tileFailed();
+        _tileFetchFinished(hash, false);
         return;
     }
 
@@ -330,7 +363,19 @@ void TerrainTileManager::_terrainDone()
     qCDebug(TerrainTileManagerLog) << "Received some bytes of terrain data:" << responseBytes.size();
 
     _cacheTile(responseBytes, hash);
+    _tileFetchFinished(hash, true);
+}
 
+void TerrainTileManager::_tileFetchFinished(const QString &hash, bool success)
+{
+    _fetchScheduler.finished(hash, success);
+    _resolveQueuedRequests();
+}
+
+void TerrainTileManager::_resolveQueuedRequests()
+{
+    // Answers every queued request whose tiles are all resident or failed. Requests still missing
+    // tiles have them (re)scheduled by getAltitudesForCoordinates, duplicates are coalesced.
     for (qsizetype i = _requestQueue.count() - 1; i >= 0; i--) {
         bool error;
         QList<double> altitudes;
@@ -345,6 +390,11 @@ void TerrainTileManager::_terrainDone()
             continue;
         }
 
+        const qint64 latencyMs = _requestClock.elapsed() - requestInfo.queuedMs;
+        _resolvedRequests++;
+        _totalRequestLatencyMs += latencyMs;
+        _maxRequestLatencyMs = qMax(_maxRequestLatencyMs, latencyMs);
+
         switch (requestInfo.queryMode) {
         case TerrainQuery::QueryMode::QueryModeCoordinates:
             if (error) {
@@ -390,35 +440,14 @@ void TerrainTileManager::_terrainDone()
 
 void TerrainTileManager::_cacheTile(const QByteArray &data, const QString &hash)
 {
-    TerrainTile* const terrainTile = new TerrainTile(data);
-    if (!terrainTile->isValid()) {
-        delete terrainTile;
+    if (!_tileCache.insert(hash, data)) {
         qCWarning(TerrainTileManagerLog) << "Received invalid tile";
-        return;
-    }
-
-    QMutexLocker locker(&_tilesMutex);
-    if (!_tiles.contains(hash)) {
-        (void) _tiles.insert(hash, terrainTile);
-    } else {
-        delete terrainTile;
     }
 }
 
-TerrainTile *TerrainTileManager::_getCachedTile(const QString &hash)
+std::shared_ptr<const TerrainTile> TerrainTileManager::_getCachedTile(const QString &hash)
 {
-    QMutexLocker locker(&_tilesMutex);
-
-    if (!_tiles.contains(hash)) {
-        return nullptr;
-    }
-
-    TerrainTile* const tile = _tiles[hash];
-    if (!tile->isValid()) {
-        return nullptr;
-    }
-
-    return tile;
+    return _tileCache.tile(hash);
 }
 
 bool TerrainTileManager::_isFailedTile(const QString &hash)
@@ -475,19 +504,21 @@ void TerrainTileManager::_processCarpetResults(const QList<double> &altitudes, i
     minHeight = std::numeric_limits<double>::max();
     maxHeight = std::numeric_limits<double>::lowest();
 
-    int idx = 0;
+    if (!statsOnly) {
+        carpet.reserve(gridSizeLat);
+    }
+
+    const double *const data = altitudes.constData();
     for (int latIdx = 0; latIdx < gridSizeLat; latIdx++) {
-        QList<double> row;
-        for (int lonIdx = 0; lonIdx < gridSizeLon; lonIdx++) {
-            const double height = altitudes[idx++];
-            minHeight = qMin(minHeight, height);
-            maxHeight = qMax(maxHeight, height);
-            if (!statsOnly) {
-                (void) row.append(height);
-            }
+        const double *const rowBegin = data + (static_cast<qsizetype>(latIdx) * gridSizeLon);
+        const double *const rowEnd = rowBegin + gridSizeLon;
+        const auto [rowMin, rowMax] = std::minmax_element(rowBegin, rowEnd);
+        if (rowMin != rowEnd) {
+            minHeight = qMin(minHeight, *rowMin);
+            maxHeight = qMax(maxHeight, *rowMax);
         }
         if (!statsOnly) {
-            (void) carpet.append(row);
+            (void) carpet.append(QList<double>(rowBegin, rowEnd));
         }
     }
 }
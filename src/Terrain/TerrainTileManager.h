@@ -1,13 +1,17 @@
 #pragma once
 
 #include "TerrainQueryInterface.h"
+#include "TerrainTileCache.h"
+#include "TerrainTileFetchScheduler.h"
 
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QMutex>
 #include <QtCore/QObject>
 #include <QtCore/QQueue>
 #include <QtPositioning/QGeoCoordinate>
 
 class TerrainTile;
+class QGeoTiledMapReplyQGC;
 class QNetworkAccessManager;
 
 class TerrainTileManager : public QObject
@@ -28,15 +32,29 @@ class TerrainTileManager : public QObject
     void addPathQuery(TerrainQueryInterface *terrainQueryInterface, const QGeoCoordinate &startPoint, const QGeoCoordinate &endPoint);
     void addCarpetQuery(TerrainQueryInterface *terrainQueryInterface, const QGeoCoordinate &swCoord, const QGeoCoordinate &neCoord, bool statsOnly);
 
-private slots:
-    void _terrainDone();
+    struct QueryMetrics {
+        qsizetype queuedRequests = 0;       ///< Requests waiting for tiles
+        quint64 resolvedRequests = 0;       ///< Queued requests answered so far
+        qint64 totalRequestLatencyMs = 0;   ///< Sum of queued to answered time over resolved requests
+        qint64 maxRequestLatencyMs = 0;
+        TerrainTileFetchScheduler::Metrics tileFetches;
+    };
+
+    /// Hit/miss statistics of the in-memory and on-disk tile cache
+    TerrainTileCache::Stats tileCacheStats() const { return _tileCache.stats(); }
+
+    /// Queue depth, request latency and tile fetch statistics
+    QueryMetrics queryMetrics() const;
 
 private:
     /// Returns a list of individual coordinates along the requested path spaced according to the terrain tile value spacing
     static QList<QGeoCoordinate> _pathQueryToCoords(const QGeoCoordinate &fromCoord, const QGeoCoordinate &toCoord, double &distanceBetween, double &finalDistanceBetween);
-    void _tileFailed();
+    void _fetchTile(const TerrainTileFetchScheduler::TileKey &key);
+    void _terrainDone(QGeoTiledMapReplyQGC *reply, const QString &hash);
+    void _tileFetchFinished(const QString &hash, bool success);
+    void _resolveQueuedRequests();
     void _cacheTile(const QByteArray &data, const QString &hash);
-    TerrainTile *_getCachedTile(const QString &hash);
+    std::shared_ptr<const TerrainTile> _getCachedTile(const QString &hash);
     bool _isFailedTile(const QString &hash);
     bool _recordFailedTile(const QString &hash);    ///< Records a failed fetch; returns true if this is the first failure for the tile
     void _clearFailedTile(const QString &hash);
@@ -52,13 +70,18 @@ private slots:
         bool carpetStatsOnly;                           ///< For carpet queries: return only stats
         int carpetGridSizeLat;                          ///< For carpet queries: number of rows
         int carpetGridSizeLon;                          ///< For carpet queries: number of columns
+        qint64 queuedMs = 0;                            ///< _requestClock time the request was queued
     };
 
     QQueue<QueuedRequestInfo_t> _requestQueue;
-    TerrainQuery::State _state = TerrainQuery::State::Idle;
+    TerrainTileFetchScheduler _fetchScheduler;
+    QElapsedTimer _requestClock;
+    quint64 _resolvedRequests = 0;
+    qint64 _totalRequestLatencyMs = 0;
+    qint64 _maxRequestLatencyMs = 0;
 
-    QMutex _tilesMutex;                     ///< Guards both _tiles and _failedTiles
-    QHash<QString, TerrainTile*> _tiles;
+    TerrainTileCache _tileCache;
+    QMutex _tilesMutex;                     ///< Guards _failedTiles
     QHash<QString, qint64> _failedTiles;  ///< Tile hash -> ms since epoch of last failed fetch; suppresses immediate retries
     qint64 _lastFailedTileSweepMs = 0;      ///< ms since epoch of last expired-entry sweep of _failedTiles
 
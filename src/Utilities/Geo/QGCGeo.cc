@@ -11,8 +11,21 @@
 #include "QGCLoggingCategory.h"
 
 #include <QtCore/QString>
+#include <QtCore/QtMath>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <initializer_list>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define QGC_GEO_BATCH_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define QGC_GEO_BATCH_NEON
+#include <arm_neon.h>
+#endif
 
 #include <GeographicLib/Geocentric.hpp>
 #include <GeographicLib/Geodesic.hpp>
@@ -24,6 +37,193 @@
 
 QGC_LOGGING_CATEGORY(QGCGeoLog, "Utilities.QGCGeo")
 
+namespace {
+
+// ============================================================================
+// Batch Kernels
+// ============================================================================
+
+constexpr double kWgs84A = 6378137.0;
+constexpr double kWgs84F = 1.0 / 298.257223563;
+constexpr double kWgs84E2 = kWgs84F * (2.0 - kWgs84F);
+
+/// Points per block; keeps the trig scratch arrays on the stack and in L1
+constexpr qsizetype kBatchBlockSize = 256;
+
+/// Local tangent plane at a fixed origin, set up once per batch
+struct LocalFrame
+{
+    double x0 = 0.0;                ///< Origin in ECEF
+    double y0 = 0.0;
+    double z0 = 0.0;
+    std::array<double, 9> r{};      ///< Local ENU -> ECEF rotation, row major (same layout as GeographicLib)
+};
+
+LocalFrame makeLocalFrame(const QGeoCoordinate &origin)
+{
+    const double originAlt = std::isnan(origin.altitude()) ? 0.0 : origin.altitude();
+
+    LocalFrame frame;
+    std::vector<double> rotation(9);
+    GeographicLib::Geocentric::WGS84().Forward(origin.latitude(), origin.longitude(), originAlt,
+                                               frame.x0, frame.y0, frame.z0, rotation);
+    std::copy(rotation.cbegin(), rotation.cend(), frame.r.begin());
+    return frame;
+}
+
+struct ScalarLanes
+{
+    using V = double;
+    static constexpr qsizetype width = 1;
+
+    static V load(const double *p) { return *p; }
+    static void store(double *p, V v) { *p = v; }
+    static V set(double v) { return v; }
+    static V add(V a, V b) { return a + b; }
+    static V sub(V a, V b) { return a - b; }
+    static V mul(V a, V b) { return a * b; }
+    static V div(V a, V b) { return a / b; }
+    static V sqrt(V a) { return std::sqrt(a); }
+};
+
+#if defined(QGC_GEO_BATCH_SSE2)
+struct SimdLanes
+{
+    using V = __m128d;
+    static constexpr qsizetype width = 2;
+
+    static V load(const double *p) { return _mm_loadu_pd(p); }
+    static void store(double *p, V v) { _mm_storeu_pd(p, v); }
+    static V set(double v) { return _mm_set1_pd(v); }
+    static V add(V a, V b) { return _mm_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm_mul_pd(a, b); }
+    static V div(V a, V b) { return _mm_div_pd(a, b); }
+    static V sqrt(V a) { return _mm_sqrt_pd(a); }
+};
+#elif defined(QGC_GEO_BATCH_NEON)
+struct SimdLanes
+{
+    using V = float64x2_t;
+    static constexpr qsizetype width = 2;
+
+    static V load(const double *p) { return vld1q_f64(p); }
+    static void store(double *p, V v) { vst1q_f64(p, v); }
+    static V set(double v) { return vdupq_n_f64(v); }
+    static V add(V a, V b) { return vaddq_f64(a, b); }
+    static V sub(V a, V b) { return vsubq_f64(a, b); }
+    static V mul(V a, V b) { return vmulq_f64(a, b); }
+    static V div(V a, V b) { return vdivq_f64(a, b); }
+    static V sqrt(V a) { return vsqrtq_f64(a); }
+};
+#else
+using SimdLanes = ScalarLanes;
+#endif
+
+/// Per-point inputs to the ECEF/rotation kernel, filled by the (scalar) trig pass
+struct GeodeticBlock
+{
+    std::array<double, kBatchBlockSize> sinLat;
+    std::array<double, kBatchBlockSize> cosLat;
+    std::array<double, kBatchBlockSize> sinLon;
+    std::array<double, kBatchBlockSize> cosLon;
+    std::array<double, kBatchBlockSize> alt;
+};
+
+/// Geodetic -> ECEF -> local ENU for points [begin, count) of a block, L::width points at a time.
+/// Returns the index of the first point not processed.
+template<typename L>
+qsizetype geodeticToEnuLanes(const LocalFrame &frame, const GeodeticBlock &in, qsizetype begin, qsizetype count,
+                             double *east, double *north, double *up, double upSign)
+{
+    const typename L::V one = L::set(1.0);
+    const typename L::V a = L::set(kWgs84A);
+    const typename L::V e2 = L::set(kWgs84E2);
+    const typename L::V oneMinusE2 = L::set(1.0 - kWgs84E2);
+    const typename L::V x0 = L::set(frame.x0);
+    const typename L::V y0 = L::set(frame.y0);
+    const typename L::V z0 = L::set(frame.z0);
+    const auto &r = frame.r;
+
+    qsizetype i = begin;
+    for (; (i + L::width) <= count; i += L::width) {
+        const typename L::V sinLat = L::load(in.sinLat.data() + i);
+        const typename L::V cosLat = L::load(in.cosLat.data() + i);
+        const typename L::V h = L::load(in.alt.data() + i);
+
+        // Prime vertical radius of curvature
+        const typename L::V n = L::div(a, L::sqrt(L::sub(one, L::mul(e2, L::mul(sinLat, sinLat)))));
+        const typename L::V nhCosLat = L::mul(L::add(n, h), cosLat);
+
+        const typename L::V dx = L::sub(L::mul(nhCosLat, L::load(in.cosLon.data() + i)), x0);
+        const typename L::V dy = L::sub(L::mul(nhCosLat, L::load(in.sinLon.data() + i)), y0);
+        const typename L::V dz = L::sub(L::mul(L::add(L::mul(n, oneMinusE2), h), sinLat), z0);
+
+        // ECEF -> ENU is the transpose of the origin's ENU -> ECEF rotation
+        L::store(east + i, L::add(L::add(L::mul(L::set(r[0]), dx), L::mul(L::set(r[3]), dy)), L::mul(L::set(r[6]), dz)));
+        L::store(north + i, L::add(L::add(L::mul(L::set(r[1]), dx), L::mul(L::set(r[4]), dy)), L::mul(L::set(r[7]), dz)));
+        L::store(up + i, L::add(L::add(L::mul(L::set(r[2] * upSign), dx), L::mul(L::set(r[5] * upSign), dy)), L::mul(L::set(r[8] * upSign), dz)));
+    }
+
+    return i;
+}
+
+/// Shared body of the batch NED/ENU conversions. upSign of -1 yields down instead of up.
+void geodeticToLocal(const QGCGeo::GeoSpan &coords, const QGeoCoordinate &origin,
+                     double *east, double *north, double *up, double upSign)
+{
+    const LocalFrame frame = makeLocalFrame(origin);
+    const qsizetype size = coords.size();
+    const bool hasAltitude = !coords.altitude.empty();
+
+    GeodeticBlock block;
+    for (qsizetype offset = 0; offset < size; offset += kBatchBlockSize) {
+        const qsizetype count = std::min(kBatchBlockSize, size - offset);
+
+        for (qsizetype i = 0; i < count; i++) {
+            const double lat = qDegreesToRadians(coords.latitude[offset + i]);
+            const double lon = qDegreesToRadians(coords.longitude[offset + i]);
+            const double alt = hasAltitude ? coords.altitude[offset + i] : 0.0;
+            block.sinLat[i] = std::sin(lat);
+            block.cosLat[i] = std::cos(lat);
+            block.sinLon[i] = std::sin(lon);
+            block.cosLon[i] = std::cos(lon);
+            block.alt[i] = std::isnan(alt) ? 0.0 : alt;
+        }
+
+        double *const e = east + offset;
+        double *const n = north + offset;
+        double *const u = up + offset;
+        const qsizetype tail = geodeticToEnuLanes<SimdLanes>(frame, block, 0, count, e, n, u, upSign);
+        (void) geodeticToEnuLanes<ScalarLanes>(frame, block, tail, count, e, n, u, upSign);
+    }
+}
+
+bool checkBatchSizes(const char *function, qsizetype expected, std::initializer_list<size_t> sizes)
+{
+    for (const size_t size : sizes) {
+        if (static_cast<qsizetype>(size) < expected) {
+            qCWarning(QGCGeoLog) << function << "output span too small:" << size << "expected" << expected;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool checkGeoSpan(const char *function, const QGCGeo::GeoSpan &coords)
+{
+    const qsizetype size = coords.size();
+    if ((static_cast<qsizetype>(coords.longitude.size()) != size) ||
+        (!coords.altitude.empty() && (static_cast<qsizetype>(coords.altitude.size()) != size))) {
+        qCWarning(QGCGeoLog) << function << "mismatched GeoSpan sizes" << coords.latitude.size()
+                             << coords.longitude.size() << coords.altitude.size();
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
 namespace QGCGeo
 {
 
@@ -371,4 +571,75 @@ QGeoCoordinate interpolateAtDistance(const QGeoCoordinate &from, const QGeoCoord
     return QGeoCoordinate(lat, lon, alt);
 }
 
+// ============================================================================
+// Batch Conversions (Structure of Arrays)
+// ============================================================================
+
+void convertGeoToNed(const GeoSpan &coords, const QGeoCoordinate &origin, std::span<double> x, std::span<double> y, std::span<double> z)
+{
+    if (!checkGeoSpan(Q_FUNC_INFO, coords) || !checkBatchSizes(Q_FUNC_INFO, coords.size(), {x.size(), y.size(), z.size()})) {
+        return;
+    }
+
+    geodeticToLocal(coords, origin, y.data(), x.data(), z.data(), -1.0);
+}
+
+void convertNedToGeo(std::span<const double> x, std::span<const double> y, std::span<const double> z, const QGeoCoordinate &origin,
+                     std::span<double> latitude, std::span<double> longitude, std::span<double> altitude)
+{
+    const qsizetype size = static_cast<qsizetype>(x.size());
+    if (!checkBatchSizes(Q_FUNC_INFO, size, {y.size(), z.size(), latitude.size(), longitude.size(), altitude.size()})) {
+        return;
+    }
+
+    // ECEF -> geodetic is iterative, so this stays scalar and only amortizes the tangent plane setup
+    const double originAlt = std::isnan(origin.altitude()) ? 0.0 : origin.altitude();
+    const GeographicLib::LocalCartesian ltp(origin.latitude(), origin.longitude(), originAlt,
+                                            GeographicLib::Geocentric::WGS84());
+    for (qsizetype i = 0; i < size; i++) {
+        ltp.Reverse(y[i], x[i], -z[i], latitude[i], longitude[i], altitude[i]);
+    }
+}
+
+void convertGpsToEnu(const GeoSpan &coords, const QGeoCoordinate &ref, std::span<double> east, std::span<double> north, std::span<double> up)
+{
+    if (!checkGeoSpan(Q_FUNC_INFO, coords) || !checkBatchSizes(Q_FUNC_INFO, coords.size(), {east.size(), north.size(), up.size()})) {
+        return;
+    }
+
+    geodeticToLocal(coords, ref, east.data(), north.data(), up.data(), 1.0);
+}
+
+void geodesicDistance(const GeoSpan &coords, std::span<double> distances)
+{
+    const qsizetype size = coords.size();
+    if ((size < 2) || !checkGeoSpan(Q_FUNC_INFO, coords) || !checkBatchSizes(Q_FUNC_INFO, size - 1, {distances.size()})) {
+        return;
+    }
+
+    // The inverse problem is solved iteratively per pair, so there is nothing to vectorize here
+    const GeographicLib::Geodesic &geod = GeographicLib::Geodesic::WGS84();
+    for (qsizetype i = 0; i < (size - 1); i++) {
+        geod.Inverse(coords.latitude[i], coords.longitude[i], coords.latitude[i + 1], coords.longitude[i + 1], distances[i]);
+    }
+}
+
+void convertGeoToUTM(const GeoSpan &coords, std::span<double> easting, std::span<double> northing, std::span<int> zones)
+{
+    const qsizetype size = coords.size();
+    if (!checkGeoSpan(Q_FUNC_INFO, coords) || !checkBatchSizes(Q_FUNC_INFO, size, {easting.size(), northing.size(), zones.size()})) {
+        return;
+    }
+
+    for (qsizetype i = 0; i < size; i++) {
+        try {
+            bool northp;
+            GeographicLib::UTMUPS::Forward(coords.latitude[i], coords.longitude[i], zones[i], northp, easting[i], northing[i]);
+        } catch (const GeographicLib::GeographicErr &e) {
+            qCDebug(QGCGeoLog) << e.what();
+            zones[i] = 0;
+        }
+    }
+}
+
 } // namespace QGCGeo
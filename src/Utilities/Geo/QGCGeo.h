@@ -25,6 +25,8 @@
 #include <QtGui/QVector3D>
 #include <QtPositioning/QGeoCoordinate>
 
+#include <span>
+
 namespace QGCGeo
 {
 
@@ -189,4 +191,60 @@ QList<QGeoCoordinate> interpolatePath(const QGeoCoordinate &from, const QGeoCoor
 /// @note Useful for midpoint: interpolateAtDistance(from, to, geodesicDistance(from, to) / 2)
 QGeoCoordinate interpolateAtDistance(const QGeoCoordinate &from, const QGeoCoordinate &to, double distance);
 
+// ============================================================================
+// Batch Conversions (Structure of Arrays)
+// ============================================================================
+
+/// Read-only structure-of-arrays view of geodetic coordinates.
+struct GeoSpan
+{
+    std::span<const double> latitude;   ///< Degrees
+    std::span<const double> longitude;  ///< Degrees
+    std::span<const double> altitude;   ///< Meters. May be empty, in which case all points are at 0.0 (sea level).
+
+    qsizetype size() const { return static_cast<qsizetype>(latitude.size()); }
+};
+
+/// Batch version of convertGeoToNed().
+/// @param coords Geodetic coordinates to convert.
+/// @param origin Reference point for local tangent plane.
+/// @param[out] x North components in meters, coords.size() values.
+/// @param[out] y East components in meters, coords.size() values.
+/// @param[out] z Down components in meters, coords.size() values.
+/// @note The tangent plane is set up once and the ECEF/rotation arithmetic runs two points at a time on
+///       SSE2/NEON when available, with a scalar fallback. NaN altitudes are treated as 0.0 (sea level).
+void convertGeoToNed(const GeoSpan &coords, const QGeoCoordinate &origin, std::span<double> x, std::span<double> y, std::span<double> z);
+
+/// Batch version of convertNedToGeo().
+/// @param x North components in meters.
+/// @param y East components in meters.
+/// @param z Down components in meters.
+/// @param origin Reference point for local tangent plane.
+/// @param[out] latitude Resulting latitudes in degrees, x.size() values.
+/// @param[out] longitude Resulting longitudes in degrees, x.size() values.
+/// @param[out] altitude Resulting altitudes in meters, x.size() values.
+void convertNedToGeo(std::span<const double> x, std::span<const double> y, std::span<const double> z, const QGeoCoordinate &origin,
+                     std::span<double> latitude, std::span<double> longitude, std::span<double> altitude);
+
+/// Batch version of convertGpsToEnu() in double precision.
+/// @param coords Geodetic coordinates to convert.
+/// @param ref Reference point for local tangent plane.
+/// @param[out] east East components in meters, coords.size() values.
+/// @param[out] north North components in meters, coords.size() values.
+/// @param[out] up Up components in meters, coords.size() values.
+/// @note NaN altitudes are treated as 0.0 (sea level).
+void convertGpsToEnu(const GeoSpan &coords, const QGeoCoordinate &ref, std::span<double> east, std::span<double> north, std::span<double> up);
+
+/// Geodesic distance between each pair of consecutive coordinates using WGS84 ellipsoid.
+/// @param coords Coordinates defining a path.
+/// @param[out] distances distances[i] is the distance from coords[i] to coords[i + 1], coords.size() - 1 values.
+void geodesicDistance(const GeoSpan &coords, std::span<double> distances);
+
+/// Batch version of convertGeoToUTM().
+/// @param coords Geodetic coordinates to convert.
+/// @param[out] easting UTM eastings in meters, coords.size() values.
+/// @param[out] northing UTM northings in meters, coords.size() values.
+/// @param[out] zones UTM zones (1-60), 0 where the conversion failed, coords.size() values.
+void convertGeoToUTM(const GeoSpan &coords, std::span<double> easting, std::span<double> northing, std::span<int> zones);
+
 } // namespace QGCGeo
@@ -49,6 +49,7 @@ class BatteryFactGroup : public FactGroupWithId
 
     // Overrides from FactGroup
     void handleMessage(Vehicle *vehicle, const mavlink_message_t &message) final;
+    QList<uint32_t> handledMessageIds() const final;
 
 private slots:
     void _timeRemainingChanged(const QVariant &value);
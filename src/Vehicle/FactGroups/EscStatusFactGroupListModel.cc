@@ -76,6 +76,11 @@ EscStatusFactGroup::EscStatusFactGroup(uint32_t escIndex, QObject *parent)
     _temperatureFact.setRawValue(0);
 }
 
+QList<uint32_t> EscStatusFactGroup::handledMessageIds() const
+{
+    return { MAVLINK_MSG_ID_ESC_INFO, MAVLINK_MSG_ID_ESC_STATUS };
+}
+
 void EscStatusFactGroup::handleMessage(Vehicle *vehicle, const mavlink_message_t &message)
 {
     switch (message.msgid) {
@@ -46,6 +46,7 @@ class EscStatusFactGroup : public FactGroupWithId
 
     // Overrides from FactGroup
     void handleMessage(Vehicle *vehicle, const mavlink_message_t &message) final;
+    QList<uint32_t> handledMessageIds() const final;
 
 private:
     void _handleEscInfo(Vehicle *vehicle, const mavlink_message_t &message);
@@ -15,6 +15,11 @@ RadioStatusFactGroup::RadioStatusFactGroup(QObject *parent)
     _addFact(&_rNoiseFact);
 }
 
+QList<uint32_t> RadioStatusFactGroup::handledMessageIds() const
+{
+    return { MAVLINK_MSG_ID_RADIO_STATUS };
+}
+
 void RadioStatusFactGroup::handleMessage(Vehicle *vehicle, const mavlink_message_t &message)
 {
     Q_UNUSED(vehicle);
@@ -11,6 +11,8 @@ VehicleClockFactGroup::VehicleClockFactGroup(QObject *parent)
     _currentTimeFact.setRawValue(QTime().toString());
     _currentUTCTimeFact.setRawValue(std::numeric_limits<float>::quiet_NaN());
     _currentDateFact.setRawValue(std::numeric_limits<float>::quiet_NaN());
+
+    _setPeriodicUpdates();
 }
 
 void VehicleClockFactGroup::_updateAllValues()
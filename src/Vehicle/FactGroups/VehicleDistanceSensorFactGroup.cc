@@ -18,6 +18,11 @@ VehicleDistanceSensorFactGroup::VehicleDistanceSensorFactGroup(QObject *parent)
     _addFact(&_maxDistanceFact);
 }
 
+QList<uint32_t> VehicleDistanceSensorFactGroup::handledMessageIds() const
+{
+    return { MAVLINK_MSG_ID_DISTANCE_SENSOR };
+}
+
 void VehicleDistanceSensorFactGroup::handleMessage(Vehicle *vehicle, const mavlink_message_t &message)
 {
     Q_UNUSED(vehicle);
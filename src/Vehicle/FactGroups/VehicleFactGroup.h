@@ -73,6 +73,7 @@ class VehicleFactGroup : public FactGroup
     Fact *rcRSSI() { return &_rcRSSIFact; }
 
     void handleMessage(Vehicle *vehicle, const mavlink_message_t &message) override;
+    QList<uint32_t> handledMessageIds() const override;
 
     /// Write a raw RSSI sample (0-100, or 255 for invalid) through the low-pass filter
     /// into the rcRSSI Fact. Called by Vehicle when an RC_CHANNELS message arrives.
@@ -5,6 +5,11 @@
 
 #include <QtPositioning/QGeoCoordinate>
 
+QList<uint32_t> VehicleGPS2FactGroup::handledMessageIds() const
+{
+    return { MAVLINK_MSG_ID_GPS2_RAW, MAVLINK_MSG_ID_GNSS_INTEGRITY };
+}
+
 void VehicleGPS2FactGroup::handleMessage(Vehicle *vehicle, const mavlink_message_t &message)
 {
     Q_UNUSED(vehicle);
@@ -15,6 +15,7 @@ class VehicleGPS2FactGroup : public VehicleGPSFactGroup
 
     // Overrides from VehicleGPSFactGroup
     void handleMessage(Vehicle *vehicle, const mavlink_message_t &message) final;
+    QList<uint32_t> handledMessageIds() const final;
 
 private:
     void _handleGps2Raw(const mavlink_message_t &message);
@@ -43,6 +43,16 @@ VehicleGPSFactGroup::VehicleGPSFactGroup(QObject *parent)
     _postProcessingQualityFact.setRawValue(255);
 }
 
+QList<uint32_t> VehicleGPSFactGroup::handledMessageIds() const
+{
+    return {
+        MAVLINK_MSG_ID_GPS_RAW_INT,
+        MAVLINK_MSG_ID_HIGH_LATENCY,
+        MAVLINK_MSG_ID_HIGH_LATENCY2,
+        MAVLINK_MSG_ID_GNSS_INTEGRITY
+    };
+}
+
 void VehicleGPSFactGroup::handleMessage(Vehicle *vehicle, const mavlink_message_t &message)
 {
     Q_UNUSED(vehicle);
@@ -18,6 +18,7 @@ class VehicleHygrometerFactGroup : public FactGroup
 
     // Overrides from FactGroup
     void handleMessage(Vehicle *vehicle, const mavlink_message_t &message) final;
+    QList<uint32_t> handledMessageIds() const final;
 
 protected:
     void _handleHygrometerSensor(const mavlink_message_t &message);
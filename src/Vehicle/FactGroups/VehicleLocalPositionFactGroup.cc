@@ -19,6 +19,11 @@ VehicleLocalPositionFactGroup::VehicleLocalPositionFactGroup(QObject *parent)
     _vzFact.setRawValue(qQNaN());
 }
 
+QList<uint32_t> VehicleLocalPositionFactGroup::handledMessageIds() const
+{
+    return { MAVLINK_MSG_ID_LOCAL_POSITION_NED };
+}
+
 void VehicleLocalPositionFactGroup::handleMessage(Vehicle *vehicle, const mavlink_message_t &message)
 {
     Q_UNUSED(vehicle);
@@ -30,13 +35,13 @@ void VehicleLocalPositionFactGroup::handleMessage(Vehicle *vehicle, const mavlin
     mavlink_local_position_ned_t localPosition{};
     mavlink_msg_local_position_ned_decode(&message, &localPosition);
 
-    x()->setRawValue(localPosition.x);
-    y()->setRawValue(localPosition.y);
-    z()->setRawValue(localPosition.z);
+    x()->setTelemetryValue(localPosition.x);
+    y()->setTelemetryValue(localPosition.y);
+    z()->setTelemetryValue(localPosition.z);
 
-    vx()->setRawValue(localPosition.vx);
-    vy()->setRawValue(localPosition.vy);
-    vz()->setRawValue(localPosition.vz);
+    vx()->setTelemetryValue(localPosition.vx);
+    vy()->setTelemetryValue(localPosition.vy);
+    vz()->setTelemetryValue(localPosition.vz);
 
     _setTelemetryAvailable(true);
 }
@@ -19,6 +19,11 @@ VehicleLocalPositionSetpointFactGroup::VehicleLocalPositionSetpointFactGroup(QOb
     _vzFact.setRawValue(qQNaN());
 }
 
+QList<uint32_t> VehicleLocalPositionSetpointFactGroup::handledMessageIds() const
+{
+    return { MAVLINK_MSG_ID_POSITION_TARGET_LOCAL_NED };
+}
+
 void VehicleLocalPositionSetpointFactGroup::handleMessage(Vehicle *vehicle, const mavlink_message_t &message)
 {
     Q_UNUSED(vehicle);
@@ -30,13 +35,13 @@ void VehicleLocalPositionSetpointFactGroup::handleMessage(Vehicle *vehicle, cons
     mavlink_position_target_local_ned_t localPosition{};
     mavlink_msg_position_target_local_ned_decode(&message, &localPosition);
 
-    x()->setRawValue(localPosition.x);
-    y()->setRawValue(localPosition.y);
-    z()->setRawValue(localPosition.z);
+    x()->setTelemetryValue(localPosition.x);
+    y()->setTelemetryValue(localPosition.y);
+    z()->setTelemetryValue(localPosition.z);
 
-    vx()->setRawValue(localPosition.vx);
-    vy()->setRawValue(localPosition.vy);
-    vz()->setRawValue(localPosition.vz);
+    vx()->setTelemetryValue(localPosition.vx);
+    vy()->setTelemetryValue(localPosition.vy);
+    vz()->setTelemetryValue(localPosition.vz);
 
     _setTelemetryAvailable(true);
 }
@@ -19,6 +19,11 @@ VehicleRPMFactGroup::VehicleRPMFactGroup(QObject *parent)
     _rpmSensor2Fact.setRawValue(qQNaN());
 }
 
+QList<uint32_t> VehicleRPMFactGroup::handledMessageIds() const
+{
+    return { MAVLINK_MSG_ID_RAW_RPM, MAVLINK_MSG_ID_RPM };
+}
+
 void VehicleRPMFactGroup::handleMessage(Vehicle *vehicle, const mavlink_message_t &message)
 {
     Q_UNUSED(vehicle);
@@ -15,6 +15,16 @@ VehicleWindFactGroup::VehicleWindFactGroup(QObject *parent)
     _verticalSpeedFact.setRawValue(qQNaN());
 }
 
+QList<uint32_t> VehicleWindFactGroup::handledMessageIds() const
+{
+    return {
+        MAVLINK_MSG_ID_WIND_COV,
+        MAVLINK_MSG_ID_HIGH_LATENCY,
+        MAVLINK_MSG_ID_HIGH_LATENCY2,
+        MAVLINK_MSG_ID_WIND
+    };
+}
+
 void VehicleWindFactGroup::handleMessage(Vehicle *vehicle, const mavlink_message_t &message)
 {
     Q_UNUSED(vehicle);
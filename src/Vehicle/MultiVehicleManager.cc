@@ -54,6 +54,7 @@ void MultiVehicleManager::init()
     _offlineEditingVehicle = new Vehicle(Vehicle::MAV_AUTOPILOT_TRACK, Vehicle::MAV_TYPE_TRACK, this);
 
     (void) connect(MAVLinkProtocol::instance(), &MAVLinkProtocol::vehicleHeartbeatInfo, this, &MultiVehicleManager::_vehicleHeartbeatInfo);
+    (void) connect(MAVLinkProtocol::instance(), &MAVLinkProtocol::messageReceived, this, &MultiVehicleManager::_mavlinkMessageReceived);
 
     _gcsHeartbeatTimer->setInterval(kGCSHeartbeatRateMSecs);
     _gcsHeartbeatTimer->setSingleShot(false);
@@ -118,6 +119,7 @@ void MultiVehicleManager::_vehicleHeartbeatInfo(LinkInterface* link, int vehicle
     (void) connect(vehicle->parameterManager(), &ParameterManager::parametersReadyChanged, this, &MultiVehicleManager::_vehicleParametersReadyChanged);
 
     _vehicles->append(vehicle);
+    _vehiclesBySysId.insert(vehicleId, vehicle);
 
     // Send QGC heartbeat ASAP, this allows PX4 to start accepting commands
     _sendGCSHeartbeat();
@@ -144,6 +146,36 @@ void MultiVehicleManager::_vehicleHeartbeatInfo(LinkInterface* link, int vehicle
 #endif
 }
 
+void MultiVehicleManager::_mavlinkMessageReceived(LinkInterface *link, const mavlink_message_t &message)
+{
+    // Handlers may remove vehicles from the table, so fan-out iterates over a copy
+    if (message.sysid == 0) {
+        // Broadcast system id is for everyone
+        const QList<Vehicle*> vehicles = _vehiclesBySysId.values();
+        for (Vehicle *const vehicle : vehicles) {
+            vehicle->_mavlinkMessageReceived(link, message);
+        }
+        return;
+    }
+
+    Vehicle *const target = _vehiclesBySysId.value(message.sysid, nullptr);
+
+    if (message.msgid == MAVLINK_MSG_ID_RADIO_STATUS) {
+        // RADIO_STATUS comes from the radio itself with its own sysid. Pass it through to every vehicle using the link.
+        const QList<Vehicle*> vehicles = _vehiclesBySysId.values();
+        for (Vehicle *const vehicle : vehicles) {
+            if ((vehicle == target) || vehicle->vehicleLinkManager()->containsLink(link)) {
+                vehicle->_mavlinkMessageReceived(link, message);
+            }
+        }
+        return;
+    }
+
+    if (target) {
+        target->_mavlinkMessageReceived(link, message);
+    }
+}
+
 void MultiVehicleManager::_deleteVehiclePhase1(Vehicle *vehicle)
 {
     qCDebug(MultiVehicleManagerLog) << Q_FUNC_INFO << vehicle;
@@ -162,6 +194,11 @@ void MultiVehicleManager::_deleteVehiclePhase1(Vehicle *vehicle)
         return;
     }
 
+    // Stop routing right away, the Vehicle itself is deleted later
+    if (_vehiclesBySysId.value(vehicle->id()) == vehicle) {
+        (void) _vehiclesBySysId.remove(vehicle->id());
+    }
+
     deselectVehicle(vehicle->id());
 
     _setActiveVehicleAvailable(false);
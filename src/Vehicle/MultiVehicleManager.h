@@ -1,8 +1,11 @@
 #pragma once
 
+#include <QtCore/QHash>
 #include <QtCore/QObject>
 #include <QtQmlIntegration/QtQmlIntegration>
 
+#include "MAVLinkMessageType.h"
+
 class LinkInterface;
 class Vehicle;
 class QmlObjectListModel;
@@ -56,6 +59,7 @@ private slots:
     void _vehicleParametersReadyChanged(bool parametersReady);
     void _sendGCSHeartbeat();
     void _vehicleHeartbeatInfo(LinkInterface *link, int vehicleId, int componentId, int vehicleFirmwareType, int vehicleType);
+    void _mavlinkMessageReceived(LinkInterface *link, const mavlink_message_t &message);
 
 private:
     bool _vehicleExists(int vehicleId);
@@ -72,6 +76,7 @@ private slots:
     bool _parameterReadyVehicleAvailable = false;   ///< true: An active vehicle with ready parameters is available
     Vehicle *_activeVehicle = nullptr;              ///< Currently active vehicle from a ui perspective
     QList<int> _ignoreVehicleIds;                   ///< List of vehicle id for which we ignore further communication
+    QHash<int, Vehicle*> _vehiclesBySysId;          ///< Routing table for incoming messages
     bool _initialized = false;
 
     static constexpr int kGCSHeartbeatRateMSecs = 1000;  ///< Heartbeat rate
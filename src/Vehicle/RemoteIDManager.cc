@@ -50,7 +50,7 @@ RemoteIDManager::RemoteIDManager(Vehicle* vehicle)
     _targetComponent = _vehicle->compId();
 }
 
-void RemoteIDManager::mavlinkMessageReceived(mavlink_message_t& message )
+void RemoteIDManager::mavlinkMessageReceived(const mavlink_message_t& message)
 {
     switch (message.msgid) {
     // So far we are only listening to this one, as heartbeat won't be sent if connected by CAN
@@ -71,7 +71,7 @@ void RemoteIDManager::_odidTimeout()
 }
 
 // Parsing of the ARM_STATUS message comming from the RID device
-void RemoteIDManager::_handleArmStatus(mavlink_message_t& message)
+void RemoteIDManager::_handleArmStatus(const mavlink_message_t& message)
 {
     // Compid must be ODID_TXRX_X
     if ( (message.compid < MAV_COMP_ID_ODID_TXRX_1) || (message.compid > MAV_COMP_ID_ODID_TXRX_3) ) {
@@ -120,7 +120,6 @@ Vehicle::Vehicle(LinkInterface*             link,
 {
     connect(MultiVehicleManager::instance(), &MultiVehicleManager::activeVehicleChanged, this, &Vehicle::_activeVehicleChanged);
 
-    connect(MAVLinkProtocol::instance(), &MAVLinkProtocol::messageReceived,        this, &Vehicle::_mavlinkMessageReceived);
     connect(MAVLinkProtocol::instance(), &MAVLinkProtocol::mavlinkMessageStatus,   this, &Vehicle::_mavlinkMessageStatus);
 
     connect(this, &Vehicle::flightModeChanged,          this, &Vehicle::_handleFlightModeChanged);
@@ -383,6 +382,56 @@ void Vehicle::_commonInit(LinkInterface* link)
     _vehicleSupports = new VehicleSupports(this);
 
     _createCameraManager();
+
+    _subscribeMessageHandlers();
+}
+
+void Vehicle::_subscribeMessageHandlers()
+{
+    (void) _messageDispatcher.subscribe({ MAVLINK_MSG_ID_FILE_TRANSFER_PROTOCOL }, [this](const mavlink_message_t &message) {
+        _ftpManager->_mavlinkMessageReceived(message);
+    });
+    (void) _messageDispatcher.subscribe({ MAVLINK_MSG_ID_PARAM_VALUE }, [this](const mavlink_message_t &message) {
+        _parameterManager->mavlinkMessageReceived(message);
+    });
+    (void) _messageDispatcher.subscribe({ MAVLINK_MSG_ID_DATA_TRANSMISSION_HANDSHAKE, MAVLINK_MSG_ID_ENCAPSULATED_DATA }, [this](const mavlink_message_t &message) {
+        _imageProtocolManager->mavlinkMessageReceived(message);
+    });
+    (void) _messageDispatcher.subscribe({ MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS }, [this](const mavlink_message_t &message) {
+        _remoteIDManager->mavlinkMessageReceived(message);
+    });
+
+    // Requested messages can have any id
+    (void) _messageDispatcher.subscribe({}, [this](const mavlink_message_t &message) {
+        _reqMsgCoord->handleReceivedMessage(message);
+    });
+
+    // Fact groups are added dynamically (battery/esc lists, gimbals), so pick those up as they appear
+    _subscribeFactGroupMessageHandlers();
+    (void) connect(this, &FactGroup::factGroupNamesChanged, this, &Vehicle::_subscribeFactGroupMessageHandlers);
+
+    // Vehicle is itself the VehicleFactGroup
+    (void) _messageDispatcher.subscribe(VehicleFactGroup::handledMessageIds(), [this](const mavlink_message_t &message) {
+        VehicleFactGroup::handleMessage(this, message);
+    });
+}
+
+void Vehicle::_subscribeFactGroupMessageHandlers()
+{
+    for (FactGroup *factGroup : factGroups()) {
+        if (_messageDispatcherFactGroups.contains(factGroup)) {
+            continue;
+        }
+        (void) _messageDispatcherFactGroups.insert(factGroup);
+
+        const QList<uint32_t> msgIds = factGroup->handledMessageIds();
+        if (msgIds.isEmpty()) {
+            continue;
+        }
+        (void) _messageDispatcher.subscribe(msgIds, [this, factGroup](const mavlink_message_t &message) {
+            factGroup->handleMessage(this, message);
+        });
+    }
 }
 
 Vehicle::~Vehicle()
@@ -516,15 +565,9 @@ void Vehicle::resetCounters()
     _heardFrom          = false;
 }
 
+// MultiVehicleManager only routes messages for this vehicle here: our sysid, broadcast, or RADIO_STATUS from one of our links
 void Vehicle::_mavlinkMessageReceived(LinkInterface* link, mavlink_message_t message)
 {
-    if (message.sysid != _systemID && message.sysid != 0) {
-        // We allow RADIO_STATUS messages which come from a link the vehicle is using to pass through and be handled
-        if (!(message.msgid == MAVLINK_MSG_ID_RADIO_STATUS && _vehicleLinkManager->containsLink(link))) {
-            return;
-        }
-    }
-
     // We give the link manager first whack since it it reponsible for adding new links
     _vehicleLinkManager->mavlinkMessageReceived(link, message);
 
@@ -567,23 +610,13 @@ void Vehicle::_mavlinkMessageReceived(LinkInterface* link, mavlink_message_t mes
     if (!_terrainProtocolHandler->mavlinkMessageReceived(message)) {
         return;
     }
-    _ftpManager->_mavlinkMessageReceived(message);
-    _parameterManager->mavlinkMessageReceived(message);
-    (void) QMetaObject::invokeMethod(_imageProtocolManager, "mavlinkMessageReceived", Qt::AutoConnection, message);
-    _remoteIDManager->mavlinkMessageReceived(message);
 
-    _reqMsgCoord->handleReceivedMessage(message);
-
-    // Handle creation of dynamic fact group lists
+    // Handle creation of dynamic fact group lists before dispatch so new groups see this message
     _batteryFactGroupListModel->handleMessageForFactGroupCreation(this, message);
     _escStatusFactGroupListModel->handleMessageForFactGroupCreation(this, message);
 
-    // Let the fact groups take a whack at the mavlink traffic
-    for (FactGroup* factGroup : factGroups()) {
-        factGroup->handleMessage(this, message);
-    }
-
-    this->handleMessage(this, message);
+    // Managers and fact groups only see the message ids they subscribed to
+    _messageDispatcher.dispatch(message);
 
     switch (message.msgid) {
     case MAVLINK_MSG_ID_HOME_POSITION:
@@ -7,6 +7,7 @@
 #include <QtCore/QFile>
 #include <QtCore/QObject>
 #include <QtCore/QPointer>
+#include <QtCore/QSet>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QTime>
 #include <QtCore/QTimer>
@@ -17,6 +18,7 @@
 #include <array>
 #include <atomic>
 
+#include "MAVLinkMessageDispatcher.h"
 #include "QGCMAVLink.h"
 #include "VehicleFactGroup.h"
 #include "VehicleSigningController.h"  // Q_PROPERTY needs the full QObject type for moc/QML metatype registration
@@ -106,6 +108,7 @@ class Vehicle : public VehicleFactGroup, public VehicleTypes
     friend class InitialConnectStateMachine;
     friend class VehicleLinkManager;
     friend class FactGroupListModel;                // Allow call _addFactGroup
+    friend class MultiVehicleManager;               // Routes incoming messages to _mavlinkMessageReceived
 #ifdef QGC_UNITTEST_BUILD
     friend class SendMavCommandWithSignallingTest;  // Unit test
     friend class SendMavCommandWithHandlerTest;     // Unit test
@@ -1059,6 +1062,12 @@ private slots:
     MavCommandQueue*            _mavCmdQueue    = nullptr;
     RequestMessageCoordinator*  _reqMsgCoord    = nullptr;
 
+    void _subscribeMessageHandlers();
+    void _subscribeFactGroupMessageHandlers();
+
+    MAVLinkMessageDispatcher    _messageDispatcher;
+    QSet<FactGroup*>            _messageDispatcherFactGroups;   ///< Fact groups already subscribed to _messageDispatcher
+
 public:
     /// Ack timeout used in unit tests — kept on Vehicle for source-compat with
     /// existing tests (mirrors MavCommandQueue::kTestAckTimeoutMs).
@@ -3,10 +3,10 @@
 #include "QGCLoggingCategory.h"
 #include "MapProvider.h"
 #include "QGCMapUrlEngine.h"
+#include "QGCTileImageCache.h"
 #include "Viewer3DTileReply.h"
 
 #include <QtGui/QPainter>
-#include <QtGui/QPixmap>
 #include <QtNetwork/QNetworkAccessManager>
 
 #include <cmath>
@@ -29,15 +29,13 @@ void Viewer3DTileQuery::MapTileContainer_t::init()
     mapTextureImage.fill(Qt::gray);
 }
 
-void Viewer3DTileQuery::MapTileContainer_t::setMapTile()
+void Viewer3DTileQuery::MapTileContainer_t::setMapTile(QPoint tileIndex, const QImage &tileImage)
 {
-    QPixmap tmpPixmap;
-    tmpPixmap.loadFromData(currentTileData);
-    QImage tmpImage = tmpPixmap.toImage().convertToFormat(QImage::Format_RGBA32FPx4);
+    const QImage tmpImage = tileImage.convertToFormat(QImage::Format_RGBA32FPx4);
 
     QPainter painter(&mapTextureImage);
-    int idxX = (currentTileIndex.x() - tileMinIndex.x()) * tileSize;
-    int idxY = (currentTileIndex.y() - tileMinIndex.y()) * tileSize;
+    int idxX = (tileIndex.x() - tileMinIndex.x()) * tileSize;
+    int idxY = (tileIndex.y() - tileMinIndex.y()) * tileSize;
     painter.drawImage(idxX, idxY, tmpImage);
 }
 
@@ -64,8 +62,17 @@ void Viewer3DTileQuery::_loadMapTiles(int zoomLevel, QPoint tileMinIndex, QPoint
         _networkManager->setTransferTimeout(9000);
     }
 
+    int cachedTilesCount = 0;
     for (int x = tileMinIndex.x(); x <= tileMaxIndex.x(); x++) {
         for (int y = tileMinIndex.y(); y <= tileMaxIndex.y(); y++) {
+            // Tiles already decoded for the 2D map or GeoMap are painted right away
+            const QImage cachedImage = QGCTileImageCache::instance()->image({ _mapId, x, y, zoomLevel });
+            if (!cachedImage.isNull()) {
+                _mapToBeLoaded.setMapTile(QPoint(x, y), cachedImage);
+                cachedTilesCount++;
+                continue;
+            }
+
             _mapToBeLoaded.tileList.append(_tileKey(_mapId, x, y, zoomLevel));
 
             auto *reply = new Viewer3DTileReply(zoomLevel, x, y, _mapId, _mapType, _networkManager, this);
@@ -75,10 +82,19 @@ void Viewer3DTileQuery::_loadMapTiles(int zoomLevel, QPoint tileMinIndex, QPoint
         }
     }
 
-    _totalTilesCount = _mapToBeLoaded.tileList.size();
-    qCDebug(Viewer3DTileQueryLog) << "Requesting" << _totalTilesCount << "tiles at zoom" << zoomLevel
+    _totalTilesCount = _mapToBeLoaded.tileList.size() + cachedTilesCount;
+    qCDebug(Viewer3DTileQueryLog) << "Requesting" << _mapToBeLoaded.tileList.size() << "of" << _totalTilesCount << "tiles at zoom" << zoomLevel
                                   << "x:[" << tileMinIndex.x() << ".." << tileMaxIndex.x() << "]"
                                   << "y:[" << tileMinIndex.y() << ".." << tileMaxIndex.y() << "]";
+
+    if (_mapToBeLoaded.tileList.isEmpty()) {
+        // Completion is still reported after textureGeometryReady, as for downloaded tiles
+        QMetaObject::invokeMethod(this, [this]() {
+            if (_mapToBeLoaded.tileList.isEmpty()) {
+                emit loadingMapCompleted();
+            }
+        }, Qt::QueuedConnection);
+    }
 }
 
 Viewer3DTileQuery::TileStatistics_t Viewer3DTileQuery::_findAndLoadMapTiles(int zoomLevel, const QGeoCoordinate &coordinateMin, const QGeoCoordinate &coordinateMax)
@@ -172,9 +188,10 @@ void Viewer3DTileQuery::_tileDone(Viewer3DTileInfo tileData)
     const qsizetype itemRemoved = _mapToBeLoaded.tileList.removeAll(key);
 
     if (itemRemoved > 0) {
-        _mapToBeLoaded.currentTileIndex = QPoint(tileData.x, tileData.y);
-        _mapToBeLoaded.currentTileData = tileData.data;
-        _mapToBeLoaded.setMapTile();
+        const QImage tileImage = QGCTileImageCache::instance()->decode({ tileData.mapId, tileData.x, tileData.y, tileData.zoomLevel }, tileData.data);
+        if (!tileImage.isNull()) {
+            _mapToBeLoaded.setMapTile(QPoint(tileData.x, tileData.y), tileImage);
+        }
 
         if (_mapToBeLoaded.tileList.isEmpty()) {
             qCDebug(Viewer3DTileQueryLog) << "All tiles downloaded";
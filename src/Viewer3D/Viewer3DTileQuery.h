@@ -51,8 +51,6 @@ class Viewer3DTileQuery : public QObject
         QStringList tileList;
         QPoint tileMinIndex;
         QPoint tileMaxIndex;
-        QPoint currentTileIndex;
-        QByteArray currentTileData;
         QImage mapTextureImage;
 
         int zoomLevel = 0;
@@ -60,7 +58,7 @@ class Viewer3DTileQuery : public QObject
         int mapHeight = 0;
 
         void init();
-        void setMapTile();
+        void setMapTile(QPoint tileIndex, const QImage &tileImage);
         QByteArray mapData() const;
         void clear();
     };
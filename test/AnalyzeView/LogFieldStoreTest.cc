@@ -0,0 +1,197 @@
+#include "LogFieldStoreTest.h"
+
+#include "LogFieldStore.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QTemporaryFile>
+#include <QtCore/QtEndian>
+
+namespace {
+
+// Record layout: uint64 TimeUS, float a, double b, int16 c (centi-units)
+constexpr qint64 kHeaderSize = 4;
+constexpr qint64 kRecordSize = 22;
+constexpr qsizetype kRecordCount = 100;
+
+constexpr double kLatitudeBase = 47.3977420;
+
+QByteArray buildRecords()
+{
+    QByteArray bytes(kHeaderSize, 'X');
+    for (int i = 0; i < kRecordCount; i++) {
+        char record[kRecordSize];
+        qToLittleEndian<quint64>(static_cast<quint64>(i) * 10000ULL, record);
+        qToLittleEndian<float>(static_cast<float>(i) * 0.5f, record + 8);
+        qToLittleEndian<double>(kLatitudeBase + (i * 1e-7), record + 12);
+        qToLittleEndian<qint16>(static_cast<qint16>(-i * 10), record + 20);
+        bytes.append(record, kRecordSize);
+    }
+    return bytes;
+}
+
+LogFieldStore::FieldDecoder decoder(qint32 offset, LogFieldStore::ValueType type, double divisor = 1.0)
+{
+    LogFieldStore::FieldDecoder result;
+    result.offset = offset;
+    result.type = type;
+    result.divisor = divisor;
+    return result;
+}
+
+/// Indexes buildRecords() as topic "T" with fields T.a, T.b and T.c
+bool openIndexedStore(LogFieldStore &store, QTemporaryFile &tmp)
+{
+    tmp.setFileTemplate(QDir::tempPath() + QStringLiteral("/logfieldstore_XXXXXX.bin"));
+    if (!tmp.open()) {
+        return false;
+    }
+    const QByteArray bytes = buildRecords();
+    if (tmp.write(bytes) != bytes.size()) {
+        return false;
+    }
+    tmp.close();
+
+    QString errorMessage;
+    if (!store.open(tmp.fileName(), errorMessage)) {
+        return false;
+    }
+
+    const int topic = store.addTopic(decoder(0, LogFieldStore::ValueType::UInt64, 1e6));
+    store.addField(QStringLiteral("T.a"), topic, decoder(8, LogFieldStore::ValueType::Float));
+    store.addField(QStringLiteral("T.b"), topic, decoder(12, LogFieldStore::ValueType::Double));
+    store.addField(QStringLiteral("T.c"), topic, decoder(20, LogFieldStore::ValueType::Int16, 100.0));
+    for (int i = 0; i < kRecordCount; i++) {
+        store.addRecord(topic, kHeaderSize + (i * kRecordSize));
+    }
+    return true;
+}
+
+} // namespace
+
+void LogFieldStoreTest::_decodeOnDemandTest()
+{
+    QTemporaryFile tmp;
+    LogFieldStore store;
+    QVERIFY(openIndexedStore(store, tmp));
+
+    // Indexing decodes nothing
+    QCOMPARE(store.cachedColumnCount(), 0);
+    QCOMPARE(store.sampleCount(QStringLiteral("T.a")), kRecordCount);
+    QCOMPARE(store.cachedColumnCount(), 0);
+
+    const LogFieldStore::ColumnPtr a = store.column(QStringLiteral("T.a"));
+    QVERIFY(a);
+    QCOMPARE(a->size(), kRecordCount);
+    QCOMPARE(a->timestamps.size(), kRecordCount);
+    QVERIFY(store.isCached(QStringLiteral("T.a")));
+    QVERIFY(!store.isCached(QStringLiteral("T.c")));
+    QCOMPARE(a->timeAt(10), 0.1);
+    QCOMPARE(a->valueAt(10), 5.0);
+
+    const LogFieldStore::ColumnPtr c = store.column(QStringLiteral("T.c"));
+    QVERIFY(c);
+    QVERIFY(qAbs(c->valueAt(7) - (-0.7)) < 1e-6);
+    QCOMPARE(store.cachedColumnCount(), 2);
+
+    // A second request is served from the cache
+    QCOMPARE(store.column(QStringLiteral("T.a")).get(), a.get());
+}
+
+void LogFieldStoreTest::_sharedTimestampsTest()
+{
+    QTemporaryFile tmp;
+    LogFieldStore store;
+    QVERIFY(openIndexedStore(store, tmp));
+
+    const LogFieldStore::ColumnPtr a = store.column(QStringLiteral("T.a"));
+    const LogFieldStore::ColumnPtr b = store.column(QStringLiteral("T.b"));
+    QVERIFY(a && b);
+
+    // Columns of one topic share a single timestamp array
+    QCOMPARE(a->timestamps.constData(), b->timestamps.constData());
+}
+
+void LogFieldStoreTest::_wideValuePrecisionTest()
+{
+    QTemporaryFile tmp;
+    LogFieldStore store;
+    QVERIFY(openIndexedStore(store, tmp));
+
+    // Degrees stored as floats would lose everything below ~1e-5
+    const LogFieldStore::ColumnPtr b = store.column(QStringLiteral("T.b"));
+    QVERIFY(b);
+    for (int i = 0; i < kRecordCount; i++) {
+        QVERIFY(qAbs(b->valueAt(i) - (kLatitudeBase + (i * 1e-7))) < 1e-9);
+    }
+}
+
+void LogFieldStoreTest::_lruEvictionTest()
+{
+    QTemporaryFile tmp;
+    LogFieldStore store;
+    QVERIFY(openIndexedStore(store, tmp));
+
+    // Room for two columns: 100 timestamps + 100 values each
+    constexpr qint64 kColumnBytes = kRecordCount * (sizeof(double) + sizeof(float));
+    store.setCacheLimitBytes(2 * kColumnBytes);
+
+    (void) store.column(QStringLiteral("T.a"));
+    (void) store.column(QStringLiteral("T.b"));
+    QCOMPARE(store.cachedBytes(), 2 * kColumnBytes);
+
+    // Touch a so b becomes the least recently used
+    (void) store.column(QStringLiteral("T.a"));
+    const LogFieldStore::ColumnPtr c = store.column(QStringLiteral("T.c"));
+    QVERIFY(store.isCached(QStringLiteral("T.a")));
+    QVERIFY(!store.isCached(QStringLiteral("T.b")));
+    QVERIFY(store.isCached(QStringLiteral("T.c")));
+    QCOMPARE(store.cachedColumnCount(), 2);
+
+    // Evicted columns are decoded again on the next request
+    const LogFieldStore::ColumnPtr b = store.column(QStringLiteral("T.b"));
+    QVERIFY(b);
+    QCOMPARE(b->size(), kRecordCount);
+    QVERIFY(!store.isCached(QStringLiteral("T.a")));
+
+    // Columns held by a caller stay valid after eviction
+    store.setCacheLimitBytes(0);
+    QCOMPARE(store.cachedColumnCount(), 1);
+    QVERIFY(qAbs(c->valueAt(1) - (-0.1)) < 1e-6);
+}
+
+void LogFieldStoreTest::_spilledPayloadTest()
+{
+    QTemporaryFile tmp;
+    LogFieldStore store;
+    QVERIFY(openIndexedStore(store, tmp));
+
+    char record[kRecordSize];
+    qToLittleEndian<quint64>(5000000ULL, record);
+    qToLittleEndian<float>(42.f, record + 8);
+    qToLittleEndian<double>(kLatitudeBase, record + 12);
+    qToLittleEndian<qint16>(0, record + 20);
+
+    const qint64 offset = store.addSpilledPayload(record, kRecordSize);
+    QVERIFY(offset >= store.size());
+    store.addRecord(0, offset);
+
+    const LogFieldStore::ColumnPtr a = store.column(QStringLiteral("T.a"));
+    QVERIFY(a);
+    QCOMPARE(a->size(), kRecordCount + 1);
+    QCOMPARE(a->timeAt(kRecordCount), 5.0);
+    QCOMPARE(a->valueAt(kRecordCount), 42.0);
+}
+
+void LogFieldStoreTest::_unknownFieldTest()
+{
+    QTemporaryFile tmp;
+    LogFieldStore store;
+    QVERIFY(openIndexedStore(store, tmp));
+
+    QVERIFY(!store.hasField(QStringLiteral("T.missing")));
+    QVERIFY(!store.column(QStringLiteral("T.missing")));
+    QCOMPARE(store.sampleCount(QStringLiteral("T.missing")), 0);
+    QCOMPARE(store.cachedColumnCount(), 0);
+}
+
+UT_REGISTER_TEST(LogFieldStoreTest, TestLabel::Unit, TestLabel::AnalyzeView)
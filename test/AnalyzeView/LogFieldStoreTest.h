@@ -0,0 +1,16 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class LogFieldStoreTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _decodeOnDemandTest();
+    void _sharedTimestampsTest();
+    void _wideValuePrecisionTest();
+    void _lruEvictionTest();
+    void _spilledPayloadTest();
+    void _unknownFieldTest();
+};
@@ -1,5 +1,6 @@
 #include "LogFileParserTest.h"
 
+#include "LogFieldStore.h"
 #include "LogFileParser.h"
 #include "LogViewerDataFlashParser.h"
 #include "LogViewerULogParser.h"
@@ -496,6 +497,69 @@ void LogFileParserTest::_fieldSamplesFilteredComprehensiveTest()
     }
 }
 
+void LogFileParserTest::_fieldsDecodedOnDemandTest()
+{
+    const QByteArray bytes = buildULog(
+        [](ulog_cpp::Writer &w) {
+            w.messageFormat(ulog_cpp::MessageFormat{
+                "sensor_combined",
+                {ulog_cpp::Field{"uint64_t", "timestamp"},
+                 ulog_cpp::Field{"float", "gyro_rad_x"}}
+            });
+            w.messageFormat(ulog_cpp::MessageFormat{
+                "battery_status",
+                {ulog_cpp::Field{"uint64_t", "timestamp"},
+                 ulog_cpp::Field{"int32_t", "cell_count"}}
+            });
+        },
+        [](ulog_cpp::Writer &w) {
+            w.addLoggedMessage(ulog_cpp::AddLoggedMessage{0, 1, "sensor_combined"});
+            w.addLoggedMessage(ulog_cpp::AddLoggedMessage{0, 2, "battery_status"});
+            for (int i = 0; i < 100; ++i) {
+                w.data(ulog_cpp::Data{1, makePayload64Float(static_cast<uint64_t>(i) * 10000ULL, static_cast<float>(i))});
+                if ((i % 10) == 0) {
+                    w.data(ulog_cpp::Data{2, makePayload64Int32(static_cast<uint64_t>(i) * 10000ULL, 4)});
+                }
+            }
+        });
+
+    QTemporaryFile tmp;
+    tmp.setFileTemplate(QDir::tempPath() + QStringLiteral("/logtest_XXXXXX.ulg"));
+    QVERIFY(writeTempFile(tmp, bytes));
+
+    LogFileParser parser;
+    QVERIFY(parser.parseFile(tmp.fileName()));
+    QCOMPARE(parser.sampleCount(), 110);
+
+    // Parsing only indexes message offsets; no field is decoded yet
+    LogFieldStore *const store = parser.fieldStore();
+    QVERIFY(store);
+    QCOMPARE(store->cachedColumnCount(), 0);
+    QCOMPARE(store->sampleCount(QStringLiteral("sensor_combined.gyro_rad_x")), 100);
+    QCOMPARE(store->sampleCount(QStringLiteral("battery_status.cell_count")), 10);
+
+    QCOMPARE(parser.fieldSamplesFiltered(QStringLiteral("sensor_combined.gyro_rad_x"), 0.0, 1.0, 1000).size(), 100);
+    QVERIFY(store->isCached(QStringLiteral("sensor_combined.gyro_rad_x")));
+    QVERIFY(!store->isCached(QStringLiteral("battery_status.cell_count")));
+
+    QCOMPARE(parser.fieldValueAt(QStringLiteral("battery_status.cell_count"), 0.5), 4.0);
+    QVERIFY(store->isCached(QStringLiteral("battery_status.cell_count")));
+
+    // Evicted columns decode again with identical samples. The most recently used column is always kept.
+    const QVariantList before = parser.fieldSamples(QStringLiteral("sensor_combined.gyro_rad_x"));
+    (void) parser.fieldValueAt(QStringLiteral("battery_status.cell_count"), 0.5);
+    store->setCacheLimitBytes(0);
+    QVERIFY(!store->isCached(QStringLiteral("sensor_combined.gyro_rad_x")));
+    QCOMPARE(parser.fieldSamples(QStringLiteral("sensor_combined.gyro_rad_x")), before);
+
+    const QVariantMap minMax = parser.fieldMinMax(QStringLiteral("sensor_combined.gyro_rad_x"));
+    QCOMPARE(minMax.value(QStringLiteral("min")).toDouble(), 0.0);
+    QCOMPARE(minMax.value(QStringLiteral("max")).toDouble(), 99.0);
+
+    parser.clear();
+    QVERIFY(!parser.fieldStore());
+}
+
 // ============================================================================
 // gpsPath() tests
 // ============================================================================
@@ -16,6 +16,7 @@ private slots:
     void _parseDataFlashRegressionTest();
     void _parseUnsupportedExtensionTest();
     void _fieldSamplesFilteredComprehensiveTest();
+    void _fieldsDecodedOnDemandTest();
     void _gpsPathULogVehicleGlobalPositionTest();
     void _gpsPathULogVehicleGpsPositionLatDegTest();
     void _gpsPathAPMDataFlashPOSTest();
@@ -4,7 +4,7 @@
 #include "BaseClasses/VehicleTestManualConnect.h"
 
 /// Tests the message-based (LOG_REQUEST_LIST/LOG_REQUEST_DATA) transport of OnboardLogController.
-/// MockLink does not advertise MAV_PROTOCOL_CAPABILITY_FTP by default so the controller
+/// PX4 MockLink does not advertise MAV_PROTOCOL_CAPABILITY_FTP by default so the controller
 /// must select the message transport.
 class OnboardLogDownloadTest : public VehicleTest
 {
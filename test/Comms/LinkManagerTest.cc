@@ -1,10 +1,57 @@
 #include "LinkManagerTest.h"
 
 #include "LinkManager.h"
+#include "MAVLinkLib.h"
+#include "MAVLinkProtocol.h"
+#include "MavlinkSettings.h"
 #include "MockLink.h"
+#include "SettingsManager.h"
+#include "UDPLink.h"
 
+#include <QtCore/QCoreApplication>
+#include <QtCore/QThread>
+#include <QtNetwork/QNetworkDatagram>
+#include <QtNetwork/QUdpSocket>
 #include <QtTest/QTest>
 
+namespace {
+
+/// Wire bytes of an unsigned NAMED_VALUE_FLOAT, so the forwarded copy must match byte for byte
+QByteArray namedValueBytes(float value)
+{
+    mavlink_status_t packStatus{};
+    mavlink_message_t message{};
+    (void) mavlink_msg_named_value_float_pack_status(200, MAV_COMP_ID_ONBOARD_COMPUTER, &packStatus, &message, 0, "FWDTEST", value);
+
+    uint8_t buffer[MAVLINK_MAX_PACKET_LEN]{};
+    const int length = mavlink_msg_to_send_buffer(buffer, &message);
+    return QByteArray(reinterpret_cast<const char *>(buffer), length);
+}
+
+quint16 freeUdpPort()
+{
+    QUdpSocket probe;
+    if (!probe.bind(QHostAddress::LocalHost, 0)) {
+        return 0;
+    }
+    return probe.localPort();
+}
+
+/// Drains @a socket until a datagram equal to @a expected arrives, skipping unrelated forwarded traffic
+bool receivedDatagram(QUdpSocket &socket, const QByteArray &expected)
+{
+    return UnitTest::waitForCondition([&socket, &expected]() {
+        while (socket.hasPendingDatagrams()) {
+            if (socket.receiveDatagram().data() == expected) {
+                return true;
+            }
+        }
+        return false;
+    }, TestTimeout::mediumMs(), u"forwarded datagram");
+}
+
+} // namespace
+
 SharedLinkConfigurationPtr LinkManagerTest::_addMockConfig(const QString &name, bool dynamic, bool autoConnect)
 {
     MockConfiguration *const mockConfig = new MockConfiguration(name);
@@ -120,4 +167,108 @@ void LinkManagerTest::_testLinkActiveStableAcrossReconnect()
     linkManager()->removeConfiguration(config.get());
 }
 
+void LinkManagerTest::_testForwardingSharesSerializedMessage()
+{
+    QUdpSocket forwardReceiver;
+    QUdpSocket supportReceiver;
+    QVERIFY(forwardReceiver.bind(QHostAddress::LocalHost, 0));
+    QVERIFY(supportReceiver.bind(QHostAddress::LocalHost, 0));
+
+    MavlinkSettings *const mavlinkSettings = SettingsManager::instance()->mavlinkSettings();
+    mavlinkSettings->forwardMavlinkHostName()->setRawValue(QStringLiteral("127.0.0.1:%1").arg(forwardReceiver.localPort()));
+    mavlinkSettings->forwardMavlinkAPMSupportHostName()->setRawValue(QStringLiteral("127.0.0.1:%1").arg(supportReceiver.localPort()));
+    mavlinkSettings->forwardMavlink()->setRawValue(true);
+    linkManager()->_addMAVLinkForwardingLink();
+    linkManager()->createMavlinkForwardingSupportLink();
+
+    SharedLinkInterfacePtr forwardLink = linkManager()->mavlinkForwardingLink();
+    SharedLinkInterfacePtr supportLink = linkManager()->mavlinkForwardingSupportLink();
+    QVERIFY(forwardLink);
+    QVERIFY(supportLink);
+    QTRY_VERIFY_WITH_TIMEOUT(forwardLink->isConnected() && supportLink->isConnected(), TestTimeout::mediumMs());
+
+    SharedLinkConfigurationPtr sourceConfig = _addMockConfig(QStringLiteral("ForwardSourceMock"), true /*dynamic*/, false /*autoConnect*/);
+    QVERIFY(sourceConfig);
+    LinkInterface *const sourceLink = sourceConfig->link();
+    QVERIFY(sourceLink);
+
+    // The message is serialized once and both forwarding links write the same bytes
+    const QByteArray first = namedValueBytes(1.0f);
+    MAVLinkProtocol::instance()->receiveBytes(sourceLink, first);
+    QVERIFY(receivedDatagram(forwardReceiver, first));
+    QVERIFY(receivedDatagram(supportReceiver, first));
+
+    // A changed message is serialized again rather than reusing the previous buffer
+    const QByteArray second = namedValueBytes(2.0f);
+    QVERIFY(second != first);
+    MAVLinkProtocol::instance()->receiveBytes(sourceLink, second);
+    QVERIFY(receivedDatagram(forwardReceiver, second));
+    QVERIFY(receivedDatagram(supportReceiver, second));
+
+    // Removing a forwarding link invalidates the cached targets, the remaining link keeps receiving
+    linkManager()->disconnectLink(supportLink.get());
+    supportLink.reset();
+    QTRY_VERIFY_WITH_TIMEOUT(!linkManager()->mavlinkForwardingSupportLink(), TestTimeout::mediumMs());
+
+    const QByteArray third = namedValueBytes(3.0f);
+    MAVLinkProtocol::instance()->receiveBytes(sourceLink, third);
+    QVERIFY(receivedDatagram(forwardReceiver, third));
+
+    mavlinkSettings->forwardMavlink()->setRawValue(false);
+    linkManager()->disconnectLink(forwardLink.get());
+    forwardLink.reset();
+    linkManager()->removeConfiguration(sourceConfig.get());
+}
+
+void LinkManagerTest::_testLinkThreadParsingDeliversOnMainThread()
+{
+    Fact *const linkThreadParsing = SettingsManager::instance()->mavlinkSettings()->linkThreadParsing();
+    linkThreadParsing->setRawValue(true);
+
+    UDPConfiguration *const udpConfig = new UDPConfiguration(QStringLiteral("ParseThreadUdp"));
+    udpConfig->setDynamic(true);
+    udpConfig->setLocalPort(freeUdpPort());
+    QVERIFY(udpConfig->localPort() != 0);
+    SharedLinkConfigurationPtr config = linkManager()->addConfiguration(udpConfig);
+    QVERIFY(linkManager()->createConnectedLink(config));
+    LinkInterface *const link = config->link();
+    QVERIFY(link);
+    QTRY_VERIFY_WITH_TIMEOUT(link->isConnected(), TestTimeout::mediumMs());
+
+    // Raw bytes only reach the GUI thread when the worker did not parse them
+    QObject receiver;
+    int rawBatches = 0;
+    int parsedBatches = 0;
+    (void) connect(link, &LinkInterface::bytesReceived, &receiver, [&rawBatches]() { rawBatches++; });
+    (void) connect(link, &LinkInterface::messagesReceived, &receiver, [&parsedBatches]() { parsedBatches++; });
+
+    QList<float> values;
+    bool deliveredOnMainThread = true;
+    (void) connect(MAVLinkProtocol::instance(), &MAVLinkProtocol::messageReceived, &receiver,
+                   [&values, &deliveredOnMainThread, link](LinkInterface *receivedLink, const mavlink_message_t &message) {
+        if ((receivedLink != link) || (message.msgid != MAVLINK_MSG_ID_NAMED_VALUE_FLOAT)) {
+            return;
+        }
+        deliveredOnMainThread &= (QThread::currentThread() == QCoreApplication::instance()->thread());
+        values.append(mavlink_msg_named_value_float_get_value(&message));
+    });
+
+    QUdpSocket sender;
+    for (int i = 1; i <= 3; i++) {
+        const QByteArray bytes = namedValueBytes(static_cast<float>(i));
+        QCOMPARE(sender.writeDatagram(bytes, QHostAddress::LocalHost, udpConfig->localPort()), static_cast<qint64>(bytes.size()));
+    }
+
+    QTRY_COMPARE_WITH_TIMEOUT(values.size(), static_cast<qsizetype>(3), TestTimeout::mediumMs());
+    QCOMPARE(values, QList<float>({ 1.0f, 2.0f, 3.0f }));
+    QVERIFY(deliveredOnMainThread);
+    QVERIFY(parsedBatches > 0);
+    QCOMPARE(rawBatches, 0);
+
+    linkManager()->disconnectLink(link);
+    QTRY_VERIFY_WITH_TIMEOUT(config->link() == nullptr, TestTimeout::mediumMs());
+    linkManager()->removeConfiguration(config.get());
+    linkThreadParsing->setRawValue(false);
+}
+
 UT_REGISTER_TEST(LinkManagerTest, TestLabel::Integration, TestLabel::Comms)
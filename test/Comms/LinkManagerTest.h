@@ -16,6 +16,8 @@ private slots:
     void _testNonAutoConnectLinkNotReconnected();
     void _testNeverStartedLinkNotConnected();
     void _testLinkActiveStableAcrossReconnect();
+    void _testForwardingSharesSerializedMessage();
+    void _testLinkThreadParsingDeliversOnMainThread();
 
 private:
     SharedLinkConfigurationPtr _addMockConfig(const QString &name, bool dynamic, bool autoConnect);
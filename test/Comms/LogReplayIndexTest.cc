@@ -0,0 +1,168 @@
+#include "LogReplayIndexTest.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QtEndian>
+#include <QtTest/QTest>
+
+#include <limits>
+
+#include "LogReplayIndex.h"
+#include "MAVLinkLib.h"
+
+namespace {
+
+constexpr quint64 kBaseTimeUSecs = 1700000000000000ULL;
+constexpr quint64 kFrameIntervalUSecs = 100000;
+constexpr int kFrameCount = 50;
+
+/// Returns a tlog of cMessages HEARTBEATs kFrameIntervalUSecs apart. @a recordOffsets receives where each record starts.
+QByteArray buildTlogBytes(int cMessages, QList<qint64> *recordOffsets = nullptr)
+{
+    QByteArray tlog;
+
+    for (int i = 0; i < cMessages; i++) {
+        if (recordOffsets) {
+            recordOffsets->append(tlog.size());
+        }
+
+        const quint64 timestampUSecs = qToBigEndian<quint64>(kBaseTimeUSecs + (i * kFrameIntervalUSecs));
+        (void) tlog.append(reinterpret_cast<const char*>(&timestampUSecs), sizeof(timestampUSecs));
+
+        mavlink_status_t packStatus{};
+        mavlink_message_t msg{};
+        (void) mavlink_msg_heartbeat_pack_status(1, MAV_COMP_ID_AUTOPILOT1, &packStatus, &msg, MAV_TYPE_QUADROTOR,
+                                                 MAV_AUTOPILOT_PX4, 0, i, MAV_STATE_ACTIVE);
+
+        uint8_t buffer[MAVLINK_MAX_PACKET_LEN]{};
+        const int cBuffer = mavlink_msg_to_send_buffer(buffer, &msg);
+        (void) tlog.append(reinterpret_cast<const char*>(buffer), cBuffer);
+    }
+
+    return tlog;
+}
+
+} // namespace
+
+QString LogReplayIndexTest::_writeLogFile(const QByteArray &contents)
+{
+    if (!_tempDir.isValid()) {
+        return QString();
+    }
+
+    const QString filename = _tempDir.filePath(QStringLiteral("%1.tlog").arg(QTest::currentTestFunction()));
+
+    QFile file(filename);
+    if (!file.open(QFile::WriteOnly) || (file.write(contents) != contents.size())) {
+        return QString();
+    }
+
+    return filename;
+}
+
+void LogReplayIndexTest::_testBuild()
+{
+    QList<qint64> recordOffsets;
+    const QString filename = _writeLogFile(buildTlogBytes(kFrameCount, &recordOffsets));
+    QVERIFY(!filename.isEmpty());
+
+    const LogReplayIndex index = LogReplayIndex::build(filename);
+    QVERIFY(index.isValid());
+    QCOMPARE(index.frameCount(), static_cast<qint64>(kFrameCount));
+    QCOMPARE(index.startTimeUSecs(), kBaseTimeUSecs);
+    QCOMPARE(index.endTimeUSecs(), kBaseTimeUSecs + ((kFrameCount - 1) * kFrameIntervalUSecs));
+
+    // Sparse: one entry per interval, i.e. every third frame at 100 ms spacing
+    static_assert((3 * kFrameIntervalUSecs) >= LogReplayIndex::kEntryIntervalUSecs);
+    static_assert((2 * kFrameIntervalUSecs) < LogReplayIndex::kEntryIntervalUSecs);
+    QCOMPARE(index.entries().size(), static_cast<qsizetype>((kFrameCount + 2) / 3));
+    for (qsizetype i = 0; i < index.entries().size(); i++) {
+        const LogReplayIndex::Entry &entry = index.entries().at(i);
+        QCOMPARE(entry.offset, recordOffsets.at(i * 3));
+        QCOMPARE(entry.timestampUSecs, kBaseTimeUSecs + (i * 3 * kFrameIntervalUSecs));
+    }
+}
+
+void LogReplayIndexTest::_testLookup()
+{
+    QList<qint64> recordOffsets;
+    const QString filename = _writeLogFile(buildTlogBytes(kFrameCount, &recordOffsets));
+    QVERIFY(!filename.isEmpty());
+
+    const LogReplayIndex index = LogReplayIndex::build(filename);
+    QVERIFY(index.isValid());
+
+    QCOMPARE(index.entryIndexForTime(0), static_cast<qsizetype>(0));
+    QCOMPARE(index.entryIndexForTime(kBaseTimeUSecs), static_cast<qsizetype>(0));
+    // 1.0 s falls between the entries at 0.9 s and 1.2 s
+    QCOMPARE(index.entryIndexForTime(kBaseTimeUSecs + 1000000), static_cast<qsizetype>(3));
+    QCOMPARE(index.entryIndexForTime(kBaseTimeUSecs + 1200000), static_cast<qsizetype>(4));
+    QCOMPARE(index.entryIndexForTime(std::numeric_limits<quint64>::max()), index.entries().size() - 1);
+
+    QCOMPARE(index.entryIndexBeforeOffset(0), static_cast<qsizetype>(0));
+    QCOMPARE(index.entryIndexBeforeOffset(recordOffsets.at(3)), static_cast<qsizetype>(0));
+    QCOMPARE(index.entryIndexBeforeOffset(recordOffsets.at(4)), static_cast<qsizetype>(1));
+}
+
+void LogReplayIndexTest::_testTrailingBytesIgnored()
+{
+    QByteArray tlog = buildTlogBytes(kFrameCount);
+    (void) tlog.append(QByteArray(100, '\0'));
+    const QString filename = _writeLogFile(tlog);
+    QVERIFY(!filename.isEmpty());
+
+    const LogReplayIndex index = LogReplayIndex::build(filename);
+    QVERIFY(index.isValid());
+    QCOMPARE(index.frameCount(), static_cast<qint64>(kFrameCount));
+    QCOMPARE(index.endTimeUSecs(), kBaseTimeUSecs + ((kFrameCount - 1) * kFrameIntervalUSecs));
+}
+
+void LogReplayIndexTest::_testCacheRoundTrip()
+{
+    const QString filename = _writeLogFile(buildTlogBytes(kFrameCount));
+    QVERIFY(!filename.isEmpty());
+
+    QVERIFY(!LogReplayIndex::load(filename).isValid());
+
+    const LogReplayIndex built = LogReplayIndex::build(filename);
+    QVERIFY(built.save(filename));
+    QVERIFY(QFile::exists(LogReplayIndex::cacheFilename(filename)));
+
+    const LogReplayIndex loaded = LogReplayIndex::load(filename);
+    QVERIFY(loaded.isValid());
+    QCOMPARE(loaded.frameCount(), built.frameCount());
+    QCOMPARE(loaded.startTimeUSecs(), built.startTimeUSecs());
+    QCOMPARE(loaded.endTimeUSecs(), built.endTimeUSecs());
+    QCOMPARE(loaded.entries().size(), built.entries().size());
+    for (qsizetype i = 0; i < built.entries().size(); i++) {
+        QCOMPARE(loaded.entries().at(i).offset, built.entries().at(i).offset);
+        QCOMPARE(loaded.entries().at(i).timestampUSecs, built.entries().at(i).timestampUSecs);
+    }
+}
+
+void LogReplayIndexTest::_testStaleCacheIgnored()
+{
+    const QString filename = _writeLogFile(buildTlogBytes(kFrameCount));
+    QVERIFY(!filename.isEmpty());
+
+    QVERIFY(LogReplayIndex::build(filename).save(filename));
+    QVERIFY(LogReplayIndex::load(filename).isValid());
+
+    // The log grew after the index was written
+    QFile file(filename);
+    QVERIFY(file.open(QFile::Append));
+    QVERIFY(file.write(buildTlogBytes(1)) > 0);
+    file.close();
+
+    QVERIFY(!LogReplayIndex::load(filename).isValid());
+}
+
+void LogReplayIndexTest::_testCanceledBuild()
+{
+    const QString filename = _writeLogFile(buildTlogBytes(kFrameCount));
+    QVERIFY(!filename.isEmpty());
+
+    const LogReplayIndex index = LogReplayIndex::build(filename, []() { return true; });
+    QVERIFY(!index.isValid());
+}
+
+UT_REGISTER_TEST(LogReplayIndexTest, TestLabel::Unit, TestLabel::Comms)
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <QtCore/QTemporaryDir>
+
+#include "UnitTest.h"
+
+class LogReplayIndexTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testBuild();
+    void _testLookup();
+    void _testTrailingBytesIgnored();
+    void _testCacheRoundTrip();
+    void _testStaleCacheIgnored();
+    void _testCanceledBuild();
+
+private:
+    QString _writeLogFile(const QByteArray &contents);
+
+    QTemporaryDir _tempDir;
+};
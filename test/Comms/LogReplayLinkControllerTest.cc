@@ -30,7 +30,11 @@ void LogReplayLinkControllerTest::_testStateTracksLinkSignals()
     QCOMPARE(controller.percentComplete(), 0.5);
     QCOMPARE(controller.property("playheadTime").toString(), QStringLiteral("01m:30s"));
 
+    emit link.messagesPerSecondChanged(1234.);
+    QCOMPARE(controller.messagesPerSecond(), 1234.);
+
     controller.setLink(nullptr);
+    QCOMPARE(controller.messagesPerSecond(), 0.);
 }
 
 void LogReplayLinkControllerTest::_testResetWhenLinkDisconnects()
@@ -6,6 +6,7 @@
 #include <QtTest/QSignalSpy>
 #include <QtTest/QTest>
 
+#include "LogReplayIndex.h"
 #include "LogReplayLink.h"
 #include "MAVLinkLib.h"
 
@@ -33,6 +34,31 @@ QByteArray buildTlogBytes(int cMessages, quint64 baseTimeUSecs)
     return tlog;
 }
 
+/// Returns a tlog of distinguishable HEARTBEATs (custom_mode is the index) spaced intervalUSecs apart.
+/// frames receives the MAVLink bytes of each message.
+QByteArray buildSteppingTlogBytes(int cMessages, quint64 baseTimeUSecs, quint64 intervalUSecs, QList<QByteArray> &frames)
+{
+    QByteArray tlog;
+
+    for (int i = 0; i < cMessages; i++) {
+        const quint64 timestampUSecs = qToBigEndian<quint64>(baseTimeUSecs + (i * intervalUSecs));
+        (void) tlog.append(reinterpret_cast<const char*>(&timestampUSecs), sizeof(timestampUSecs));
+
+        mavlink_status_t packStatus{};
+        packStatus.current_tx_seq = static_cast<uint8_t>(i);
+        mavlink_message_t msg{};
+        (void) mavlink_msg_heartbeat_pack_status(1, MAV_COMP_ID_AUTOPILOT1, &packStatus, &msg, MAV_TYPE_QUADROTOR,
+                                                 MAV_AUTOPILOT_PX4, 0, i, MAV_STATE_ACTIVE);
+
+        uint8_t buffer[MAVLINK_MAX_PACKET_LEN]{};
+        const int cBuffer = mavlink_msg_to_send_buffer(buffer, &msg);
+        frames.append(QByteArray(reinterpret_cast<const char*>(buffer), cBuffer));
+        (void) tlog.append(frames.constLast());
+    }
+
+    return tlog;
+}
+
 }  // namespace
 
 QString LogReplayLinkTest::_writeLogFile(const QByteArray& contents)
@@ -201,4 +227,158 @@ void LogReplayLinkTest::_testTruncatedLogFails()
     QVERIFY(errorSpy.first().first().toString().contains(QStringLiteral("corrupt or empty")));
 }
 
+void LogReplayLinkTest::_testSeekUsesIndex()
+{
+    // 100 ms frames: the index only has an entry every few frames, so a seek must scan forward from it
+    constexpr int cMessages = 51;
+    constexpr quint64 intervalUSecs = 100000;
+    const quint64 baseTimeUSecs = 1700000000000000ULL;
+    QList<QByteArray> frames;
+    const QString filename = _writeLogFile(buildSteppingTlogBytes(cMessages, baseTimeUSecs, intervalUSecs, frames));
+    QVERIFY(!filename.isEmpty());
+
+    LogReplayConfiguration config(QStringLiteral("LogReplayLinkTest"));
+    config.setLogFilename(filename);
+
+    LogReplayWorker worker(&config);
+    worker.setup();
+
+    QSignalSpy indexSpy(&worker, &LogReplayWorker::indexReady);
+    QSignalSpy percentSpy(&worker, &LogReplayWorker::playbackPercentCompleteChanged);
+    QSignalSpy dataSpy(&worker, &LogReplayWorker::dataReceived);
+
+    worker.connectToLog();
+    worker.pause();
+    QVERIFY(indexSpy.wait());
+    QVERIFY(worker.hasIndex());
+
+    // 5 s log: 31% is 1.55 s, the first frame at or after it is the one at 1.6 s
+    worker.movePlayhead(31);
+    QCOMPARE(percentSpy.constLast().first().toReal(), 32.);
+
+    worker.stepForward();
+    QCOMPARE(dataSpy.constLast().first().toByteArray(), frames.at(16));
+
+    // Seeking to the end stays on the last frame
+    worker.movePlayhead(100);
+    QCOMPARE(percentSpy.constLast().first().toReal(), 100.);
+    worker.stepForward();
+    QCOMPARE(dataSpy.constLast().first().toByteArray(), frames.constLast());
+
+    // The index was cached next to the log for the next load
+    QVERIFY(LogReplayIndex::load(filename).isValid());
+
+    worker.disconnectFromLog();
+}
+
+void LogReplayLinkTest::_testFrameStepping()
+{
+    constexpr int cMessages = 10;
+    const quint64 baseTimeUSecs = 1700000000000000ULL;
+    QList<QByteArray> frames;
+    const QString filename = _writeLogFile(buildSteppingTlogBytes(cMessages, baseTimeUSecs, 1000000, frames));
+    QVERIFY(!filename.isEmpty());
+
+    LogReplayConfiguration config(QStringLiteral("LogReplayLinkTest"));
+    config.setLogFilename(filename);
+
+    LogReplayWorker worker(&config);
+    worker.setup();
+
+    QSignalSpy indexSpy(&worker, &LogReplayWorker::indexReady);
+    QSignalSpy dataSpy(&worker, &LogReplayWorker::dataReceived);
+
+    worker.connectToLog();
+    worker.pause();
+    QVERIFY(indexSpy.wait());
+
+    const auto step = [&](bool forward) {
+        if (forward) {
+            worker.stepForward();
+        } else {
+            worker.stepBackward();
+        }
+        return dataSpy.constLast().first().toByteArray();
+    };
+
+    QCOMPARE(step(true), frames.at(0));
+    QCOMPARE(step(true), frames.at(1));
+    QCOMPARE(step(true), frames.at(2));
+    QCOMPARE(step(false), frames.at(1));
+    QCOMPARE(step(false), frames.at(0));
+    QCOMPARE(step(false), frames.at(0));    // Clamped at the first frame
+    QCOMPARE(step(true), frames.at(1));
+
+    worker.disconnectFromLog();
+}
+
+void LogReplayLinkTest::_testAsFastAsPossible()
+{
+    // Over five hours of log time, which paced playback could never finish within the test timeout
+    constexpr int cMessages = 20000;
+    const quint64 baseTimeUSecs = 1700000000000000ULL;
+    QList<QByteArray> frames;
+    const QString filename = _writeLogFile(buildSteppingTlogBytes(cMessages, baseTimeUSecs, 1000000, frames));
+    QVERIFY(!filename.isEmpty());
+
+    LogReplayConfiguration config(QStringLiteral("LogReplayLinkTest"));
+    config.setLogFilename(filename);
+
+    LogReplayWorker worker(&config);
+    worker.setup();
+    worker.setAsFastAsPossible(true);
+
+    QByteArray received;
+    (void) connect(&worker, &LogReplayWorker::dataReceived, this, [&](const QByteArray &data) {
+        received.append(data);
+        worker.chunkConsumed();
+    });
+    QSignalSpy atEndSpy(&worker, &LogReplayWorker::playbackAtEnd);
+    QSignalSpy rateSpy(&worker, &LogReplayWorker::messagesPerSecondChanged);
+
+    worker.connectToLog();
+    QVERIFY(atEndSpy.wait());
+
+    QCOMPARE(received, frames.join());
+    QVERIFY(!rateSpy.isEmpty());
+    QVERIFY(rateSpy.constLast().first().toReal() > 0.);
+    QVERIFY(!worker.isPlaying());
+
+    worker.disconnectFromLog();
+}
+
+void LogReplayLinkTest::_testAsFastAsPossibleBackpressure()
+{
+    // Large enough for more chunks than may be in flight at once
+    constexpr int cMessages = 20000;
+    constexpr int maxChunksInFlight = 4;
+    const quint64 baseTimeUSecs = 1700000000000000ULL;
+    QList<QByteArray> frames;
+    const QString filename = _writeLogFile(buildSteppingTlogBytes(cMessages, baseTimeUSecs, 1000000, frames));
+    QVERIFY(!filename.isEmpty());
+
+    LogReplayConfiguration config(QStringLiteral("LogReplayLinkTest"));
+    config.setLogFilename(filename);
+
+    LogReplayWorker worker(&config);
+    worker.setup();
+    worker.setAsFastAsPossible(true);
+
+    QSignalSpy dataSpy(&worker, &LogReplayWorker::dataReceived);
+
+    worker.connectToLog();
+
+    // Nothing consumes the chunks, so the worker must stop reading once the limit is reached
+    QTRY_COMPARE(dataSpy.count(), maxChunksInFlight);
+    QTest::qWait(50);
+    QCOMPARE(dataSpy.count(), maxChunksInFlight);
+    QVERIFY(worker.isPlaying());
+
+    worker.chunkConsumed();
+    QTRY_COMPARE(dataSpy.count(), maxChunksInFlight + 1);
+
+    worker.pause();
+    worker.disconnectFromLog();
+}
+
 UT_REGISTER_TEST(LogReplayLinkTest, TestLabel::Unit, TestLabel::Comms)
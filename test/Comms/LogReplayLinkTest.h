@@ -19,6 +19,10 @@ private slots:
     void _testGarbageOnlyLogFails();
     void _testTruncatedLogFails_data();
     void _testTruncatedLogFails();
+    void _testSeekUsesIndex();
+    void _testFrameStepping();
+    void _testAsFastAsPossible();
+    void _testAsFastAsPossibleBackpressure();
 
 private:
     QString _writeLogFile(const QByteArray& contents);
@@ -0,0 +1,126 @@
+#include "MAVLinkFrameParserTest.h"
+
+#include <QtTest/QTest>
+
+#include "LinkManager.h"
+#include "MAVLinkFrameParser.h"
+#include "MAVLinkLib.h"
+
+namespace {
+
+/// Wire bytes of a HEARTBEAT with the given sequence number.
+QByteArray heartbeatBytes(uint8_t seq, bool v1 = false)
+{
+    mavlink_status_t packStatus{};
+    packStatus.current_tx_seq = seq;
+    if (v1) {
+        packStatus.flags |= MAVLINK_STATUS_FLAG_OUT_MAVLINK1;
+    }
+
+    mavlink_message_t msg{};
+    (void) mavlink_msg_heartbeat_pack_status(1, MAV_COMP_ID_AUTOPILOT1, &packStatus, &msg, MAV_TYPE_QUADROTOR,
+                                             MAV_AUTOPILOT_PX4, 0, 0, MAV_STATE_ACTIVE);
+
+    uint8_t buffer[MAVLINK_MAX_PACKET_LEN]{};
+    const int cBuffer = mavlink_msg_to_send_buffer(buffer, &msg);
+    return QByteArray(reinterpret_cast<char*>(buffer), cBuffer);
+}
+
+QByteArray v1VibrationBytes()
+{
+    mavlink_status_t packStatus{};
+    packStatus.flags |= MAVLINK_STATUS_FLAG_OUT_MAVLINK1;
+
+    mavlink_message_t msg{};
+    (void) mavlink_msg_vibration_pack_status(1, MAV_COMP_ID_AUTOPILOT1, &packStatus, &msg, 0, 0.1f, 0.1f, 0.1f, 0, 0, 0);
+
+    uint8_t buffer[MAVLINK_MAX_PACKET_LEN]{};
+    const int cBuffer = mavlink_msg_to_send_buffer(buffer, &msg);
+    return QByteArray(reinterpret_cast<char*>(buffer), cBuffer);
+}
+
+} // namespace
+
+void MAVLinkFrameParserTest::init()
+{
+    UnitTest::init();
+
+    _channel = LinkManager::instance()->allocateMavlinkChannel();
+    QVERIFY(_channel != LinkManager::invalidMavlinkChannel());
+    mavlink_reset_channel_status(_channel);
+}
+
+void MAVLinkFrameParserTest::cleanup()
+{
+    if (_channel != LinkManager::invalidMavlinkChannel()) {
+        mavlink_reset_channel_status(_channel);
+        LinkManager::instance()->freeMavlinkChannel(_channel);
+    }
+
+    UnitTest::cleanup();
+}
+
+void MAVLinkFrameParserTest::_testFramesSplitAcrossChunks()
+{
+    MAVLinkFrameParser parser(_channel, nullptr);
+
+    const QByteArray bytes = heartbeatBytes(0) + heartbeatBytes(1);
+    const qsizetype split = bytes.size() / 2 + 3;
+
+    MAVLinkFrameBatch first;
+    parser.parse(bytes.left(split), first);
+    QCOMPARE(first.messages.size(), 1);
+
+    MAVLinkFrameBatch second;
+    parser.parse(bytes.mid(split), second);
+    QCOMPARE(second.messages.size(), 1);
+    QCOMPARE(second.messages.constFirst().msgid, static_cast<uint32_t>(MAVLINK_MSG_ID_HEARTBEAT));
+    QCOMPARE(second.messages.constFirst().seq, static_cast<uint8_t>(1));
+    QVERIFY(second.v2TrafficSeen);
+    QCOMPARE(second.stats.totalReceived, static_cast<uint64_t>(2));
+}
+
+void MAVLinkFrameParserTest::_testSequenceLoss()
+{
+    MAVLinkFrameParser parser(_channel, nullptr);
+
+    // 250 -> 254 skips three, 254 -> 2 wraps and skips three more
+    MAVLinkFrameBatch batch;
+    parser.parse(heartbeatBytes(250) + heartbeatBytes(254) + heartbeatBytes(2), batch);
+    QCOMPARE(batch.messages.size(), 3);
+    QCOMPARE(batch.stats.totalLoss, static_cast<uint64_t>(6));
+
+    // After a reset the next frame starts a fresh sequence history
+    parser.resetSequenceTracking();
+    parser.resetStats();
+    MAVLinkFrameBatch afterReset;
+    parser.parse(heartbeatBytes(100), afterReset);
+    QCOMPARE(afterReset.stats.totalReceived, static_cast<uint64_t>(1));
+    QCOMPARE(afterReset.stats.totalLoss, static_cast<uint64_t>(0));
+}
+
+void MAVLinkFrameParserTest::_testV1Filtering()
+{
+    MAVLinkFrameParser parser(_channel, nullptr);
+
+    // v1 HEARTBEAT is delivered but not counted; other v1 messages are dropped and flagged
+    MAVLinkFrameBatch batch;
+    parser.parse(heartbeatBytes(0, true) + v1VibrationBytes(), batch);
+    QCOMPARE(batch.messages.size(), 1);
+    QCOMPARE(batch.messages.constFirst().msgid, static_cast<uint32_t>(MAVLINK_MSG_ID_HEARTBEAT));
+    QVERIFY(batch.v1TrafficDropped);
+    QVERIFY(!batch.v2TrafficSeen);
+    QCOMPARE(batch.stats.totalReceived, static_cast<uint64_t>(0));
+}
+
+void MAVLinkFrameParserTest::_testDetachStopsParsing()
+{
+    MAVLinkFrameParser parser(_channel, nullptr);
+    parser.detach();
+
+    MAVLinkFrameBatch batch;
+    parser.parse(heartbeatBytes(0), batch);
+    QVERIFY(batch.isEmpty());
+}
+
+UT_REGISTER_TEST(MAVLinkFrameParserTest, TestLabel::Unit, TestLabel::Comms)
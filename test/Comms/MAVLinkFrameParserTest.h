@@ -0,0 +1,21 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class MAVLinkFrameParserTest : public UnitTest
+{
+    Q_OBJECT
+
+protected slots:
+    void init() override;
+    void cleanup() override;
+
+private slots:
+    void _testFramesSplitAcrossChunks();
+    void _testSequenceLoss();
+    void _testV1Filtering();
+    void _testDetachStopsParsing();
+
+private:
+    uint8_t _channel = 0;
+};
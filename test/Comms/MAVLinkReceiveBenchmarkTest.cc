@@ -0,0 +1,132 @@
+#include "MAVLinkReceiveBenchmarkTest.h"
+
+#include <QtTest/QTest>
+
+#include "Benchmarking.h"
+#include "LinkInterface.h"
+#include "MAVLinkLib.h"
+#include "MAVLinkProtocol.h"
+#include "MockConfiguration.h"
+
+namespace {
+
+/// Minimal link which never connects, so MAVLinkProtocol can be driven without LinkManager or a channel.
+class BenchmarkLink : public LinkInterface
+{
+public:
+    explicit BenchmarkLink(SharedLinkConfigurationPtr &config)
+        : LinkInterface(config)
+    {
+    }
+
+    void disconnect() override {}
+    bool isConnected() const override { return true; }
+
+private:
+    void _writeBytes(const QByteArray &bytes) override { Q_UNUSED(bytes); }
+    bool _connect() override { return true; }
+};
+
+SharedLinkInterfacePtr createLink(int index)
+{
+    SharedLinkConfigurationPtr config = std::make_shared<MockConfiguration>(QStringLiteral("Bench %1").arg(index));
+    return std::make_shared<BenchmarkLink>(config);
+}
+
+/// Batch of ATTITUDE messages from a system with no Vehicle, so the benchmark measures the receive path only.
+MAVLinkFrameBatch attitudeBatch(int count)
+{
+    MAVLinkFrameBatch batch;
+    for (int i = 0; i < count; i++) {
+        mavlink_status_t packStatus{};
+        packStatus.current_tx_seq = static_cast<uint8_t>(i);
+
+        mavlink_message_t msg{};
+        (void) mavlink_msg_attitude_pack_status(200, MAV_COMP_ID_AUTOPILOT1, &packStatus, &msg, i, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f);
+        batch.messages.append(msg);
+    }
+    batch.v2TrafficSeen = true;
+    return batch;
+}
+
+} // namespace
+
+void MAVLinkReceiveBenchmarkTest::_testUnregisteredLinkDropped()
+{
+    MAVLinkProtocol *const protocol = MAVLinkProtocol::instance();
+    const SharedLinkInterfacePtr link = createLink(0);
+
+    int received = 0;
+    const QMetaObject::Connection connection = connect(protocol, &MAVLinkProtocol::messageReceived, this, [&received]() { received++; });
+
+    protocol->receiveMessages(link.get(), attitudeBatch(3));
+    QCOMPARE(received, 0);
+
+    protocol->registerLink(link);
+    protocol->receiveMessages(link.get(), attitudeBatch(3));
+    QCOMPARE(received, 3);
+
+    protocol->unregisterLink(link.get());
+    protocol->receiveMessages(link.get(), attitudeBatch(3));
+    QCOMPARE(received, 3);
+
+    (void) disconnect(connection);
+}
+
+void MAVLinkReceiveBenchmarkTest::_testExpiredLinkDropped()
+{
+    MAVLinkProtocol *const protocol = MAVLinkProtocol::instance();
+    SharedLinkInterfacePtr link = createLink(0);
+    LinkInterface *const rawLink = link.get();
+    protocol->registerLink(link);
+
+    int received = 0;
+    const QMetaObject::Connection connection = connect(protocol, &MAVLinkProtocol::messageReceived, this, [&received]() { received++; });
+
+    // A batch queued before the link was destroyed must not resurrect or dereference it
+    link.reset();
+    protocol->receiveMessages(rawLink, attitudeBatch(3));
+    QCOMPARE(received, 0);
+
+    protocol->unregisterLink(rawLink);
+    (void) disconnect(connection);
+}
+
+void MAVLinkReceiveBenchmarkTest::_benchmarkReceiveThroughput()
+{
+    MAVLinkProtocol *const protocol = MAVLinkProtocol::instance();
+
+    constexpr int kMessagesPerBatch = 16;
+    const MAVLinkFrameBatch batch = attitudeBatch(kMessagesPerBatch);
+
+    quint64 received = 0;
+    const QMetaObject::Connection connection = connect(protocol, &MAVLinkProtocol::messageReceived, this, [&received]() { received++; });
+
+    auto bench = qgc::bench::ciConfig();
+    bench.unit("msg").batch(kMessagesPerBatch).relative(true);
+
+    for (const int linkCount : {1, 8, 32}) {
+        QList<SharedLinkInterfacePtr> links;
+        for (int i = 0; i < linkCount; i++) {
+            links.append(createLink(i));
+            protocol->registerLink(links.constLast());
+        }
+
+        qsizetype next = 0;
+        received = 0;
+        bench.run(QStringLiteral("receiveMessages %1 links").arg(linkCount).toStdString(), [&] {
+            protocol->receiveMessages(links.at(next).get(), batch);
+            next = (next + 1) % links.size();
+        });
+        QVERIFY(received > 0);
+        QCOMPARE(received % kMessagesPerBatch, 0);
+
+        for (const SharedLinkInterfacePtr &link : links) {
+            protocol->unregisterLink(link.get());
+        }
+    }
+
+    (void) disconnect(connection);
+}
+
+UT_REGISTER_TEST(MAVLinkReceiveBenchmarkTest, TestLabel::Unit, TestLabel::Comms)
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class MAVLinkReceiveBenchmarkTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testUnregisteredLinkDropped();
+    void _testExpiredLinkDropped();
+    void _benchmarkReceiveThroughput();
+};
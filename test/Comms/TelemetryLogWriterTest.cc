@@ -0,0 +1,96 @@
+#include "TelemetryLogWriterTest.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QtEndian>
+
+#include "TelemetryLogWriter.h"
+
+QString TelemetryLogWriterTest::_logPath() const
+{
+    return _tempDir.filePath(QStringLiteral("%1.mavlink").arg(QTest::currentTestFunction()));
+}
+
+void TelemetryLogWriterTest::_testFramesWrittenInOrder()
+{
+    QVERIFY(_tempDir.isValid());
+
+    TelemetryLogWriter writer;
+    QVERIFY(writer.open(_logPath()));
+
+    constexpr int frameCount = 1000;
+    QByteArray expected;
+    for (int i = 0; i < frameCount; i++) {
+        const QByteArray frame(20 + (i % 200), static_cast<char>(i));
+        QVERIFY(writer.append(static_cast<quint64>(i), frame));
+
+        uint8_t timestamp[sizeof(quint64)];
+        qToBigEndian(static_cast<quint64>(i), timestamp);
+        expected.append(reinterpret_cast<const char*>(timestamp), sizeof(timestamp));
+        expected.append(frame);
+    }
+
+    writer.close();
+
+    const TelemetryLogWriter::Stats stats = writer.stats();
+    QCOMPARE(stats.framesQueued, static_cast<quint64>(frameCount));
+    QCOMPARE(stats.framesDropped, static_cast<quint64>(0));
+    QCOMPARE(stats.bytesWritten, static_cast<quint64>(expected.size()));
+    // Group commit: far fewer writes than frames
+    QVERIFY(stats.writeCalls < static_cast<quint64>(frameCount / 10));
+
+    QFile file(_logPath());
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(file.readAll(), expected);
+}
+
+void TelemetryLogWriterTest::_testFlushWritesBufferedFrames()
+{
+    QVERIFY(_tempDir.isValid());
+
+    TelemetryLogWriter writer;
+    QVERIFY(writer.open(_logPath()));
+
+    const QByteArray frame(32, 'x');
+    QVERIFY(writer.append(1, frame));
+    QVERIFY(writer.flush());
+
+    QCOMPARE(QFile(_logPath()).size(), static_cast<qint64>(sizeof(quint64) + frame.size()));
+    QVERIFY(writer.isOpen());
+
+    writer.close();
+    QVERIFY(!writer.isOpen());
+}
+
+void TelemetryLogWriterTest::_testOversizedFrameDropped()
+{
+    QVERIFY(_tempDir.isValid());
+
+    TelemetryLogWriter writer;
+    writer.setBufferCapacity(64);
+    QVERIFY(writer.open(_logPath()));
+
+    QVERIFY(!writer.append(1, QByteArray(128, 'x')));
+    QVERIFY(writer.append(2, QByteArray(16, 'y')));
+
+    writer.close();
+
+    const TelemetryLogWriter::Stats stats = writer.stats();
+    QCOMPARE(stats.framesDropped, static_cast<quint64>(1));
+    QCOMPARE(stats.framesQueued, static_cast<quint64>(1));
+    QCOMPARE(QFile(_logPath()).size(), static_cast<qint64>(sizeof(quint64) + 16));
+}
+
+void TelemetryLogWriterTest::_testAppendAfterCloseRejected()
+{
+    QVERIFY(_tempDir.isValid());
+
+    TelemetryLogWriter writer;
+    QVERIFY(!writer.append(1, QByteArray(8, 'x')));
+
+    QVERIFY(writer.open(_logPath()));
+    writer.close();
+    QVERIFY(!writer.append(1, QByteArray(8, 'x')));
+    QCOMPARE(writer.fileName(), _logPath());
+}
+
+UT_REGISTER_TEST(TelemetryLogWriterTest, TestLabel::Unit, TestLabel::Comms)
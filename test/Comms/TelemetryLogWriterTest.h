@@ -0,0 +1,21 @@
+#pragma once
+
+#include <QtCore/QTemporaryDir>
+
+#include "UnitTest.h"
+
+class TelemetryLogWriterTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testFramesWrittenInOrder();
+    void _testFlushWritesBufferedFrames();
+    void _testOversizedFrameDropped();
+    void _testAppendAfterCloseRejected();
+
+private:
+    QString _logPath() const;
+
+    QTemporaryDir _tempDir;
+};
@@ -0,0 +1,134 @@
+#include "UDPLinkTest.h"
+
+#include <QtNetwork/QUdpSocket>
+#include <QtTest/QTest>
+
+#include <memory>
+#include <vector>
+
+#include "UDPLink.h"
+
+namespace {
+
+constexpr int kSenderCount = 4;
+constexpr int kDatagramsPerSender = 50;
+
+quint16 freeUdpPort()
+{
+    QUdpSocket probe;
+    if (!probe.bind(QHostAddress::LocalHost, 0)) {
+        return 0;
+    }
+    return probe.localPort();
+}
+
+QByteArray datagram(int sender, int index)
+{
+    return QStringLiteral("<%1:%2>").arg(sender).arg(index, 3, 10, QLatin1Char('0')).toLatin1();
+}
+
+std::vector<std::unique_ptr<QUdpSocket>> createSenders()
+{
+    std::vector<std::unique_ptr<QUdpSocket>> senders;
+    for (int i = 0; i < kSenderCount; i++) {
+        auto sender = std::make_unique<QUdpSocket>();
+        if (!sender->bind(QHostAddress::LocalHost, 0)) {
+            return {};
+        }
+        senders.push_back(std::move(sender));
+    }
+    return senders;
+}
+
+} // namespace
+
+void UDPLinkTest::_testInterleavedSendersReceived()
+{
+    UDPConfiguration config(QStringLiteral("UDPLinkTest"));
+    config.setLocalPort(freeUdpPort());
+    QVERIFY(config.localPort() != 0);
+
+    UDPWorker worker(&config);
+    worker.setupSocket();
+    worker.connectLink();
+    QTRY_VERIFY(worker.isConnected());
+
+    QByteArray received;
+    (void) connect(&worker, &UDPWorker::dataReceived, this, [&received](const QByteArray &data) {
+        received.append(data);
+    });
+
+    const std::vector<std::unique_ptr<QUdpSocket>> senders = createSenders();
+    QCOMPARE(static_cast<int>(senders.size()), kSenderCount);
+
+    qsizetype expectedSize = 0;
+    for (int index = 0; index < kDatagramsPerSender; index++) {
+        for (int sender = 0; sender < kSenderCount; sender++) {
+            const QByteArray data = datagram(sender, index);
+            QCOMPARE(senders[sender]->writeDatagram(data, QHostAddress::LocalHost, config.localPort()), data.size());
+            expectedSize += data.size();
+        }
+    }
+
+    QTRY_COMPARE(received.size(), expectedSize);
+
+    // Datagrams are never split and each sender's datagrams stay in order
+    for (int sender = 0; sender < kSenderCount; sender++) {
+        qsizetype from = 0;
+        for (int index = 0; index < kDatagramsPerSender; index++) {
+            const qsizetype at = received.indexOf(datagram(sender, index), from);
+            QVERIFY(at >= from);
+            from = at + 1;
+        }
+    }
+
+    worker.disconnectLink();
+}
+
+void UDPLinkTest::_testRepliesReachEverySender()
+{
+    UDPConfiguration config(QStringLiteral("UDPLinkTest"));
+    config.setLocalPort(freeUdpPort());
+    QVERIFY(config.localPort() != 0);
+
+    UDPWorker worker(&config);
+    worker.setupSocket();
+    worker.connectLink();
+    QTRY_VERIFY(worker.isConnected());
+
+    qsizetype receivedSize = 0;
+    (void) connect(&worker, &UDPWorker::dataReceived, this, [&receivedSize](const QByteArray &data) {
+        receivedSize += data.size();
+    });
+
+    const std::vector<std::unique_ptr<QUdpSocket>> senders = createSenders();
+    QCOMPARE(static_cast<int>(senders.size()), kSenderCount);
+
+    // Several datagrams per sender: each sender must still be added as a target exactly once
+    qsizetype expectedSize = 0;
+    for (int index = 0; index < 3; index++) {
+        for (const std::unique_ptr<QUdpSocket> &sender : senders) {
+            const QByteArray data = datagram(0, index);
+            (void) sender->writeDatagram(data, QHostAddress::LocalHost, config.localPort());
+            expectedSize += data.size();
+        }
+    }
+    QTRY_COMPARE(receivedSize, expectedSize);
+
+    const QByteArray reply("reply");
+    worker.writeData(reply);
+
+    for (const std::unique_ptr<QUdpSocket> &sender : senders) {
+        QTRY_VERIFY(sender->hasPendingDatagrams());
+        QByteArray data(64, '\0');
+        data.resize(sender->readDatagram(data.data(), data.size()));
+        QCOMPARE(data, reply);
+
+        QTest::qWait(10);
+        QVERIFY(!sender->hasPendingDatagrams());
+    }
+
+    worker.disconnectLink();
+}
+
+UT_REGISTER_TEST(UDPLinkTest, TestLabel::Unit, TestLabel::Comms)
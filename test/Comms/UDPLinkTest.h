@@ -0,0 +1,12 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class UDPLinkTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testInterleavedSendersReceived();
+    void _testRepliesReachEverySender();
+};
@@ -3,9 +3,13 @@
 #include "ParameterMetaData.h"
 #include "ParameterMetaDataTestHelper.h"
 
+#include <QtCore/QDir>
+#include <QtCore/QFile>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 #include <QtCore/QRegularExpression>
+#include <QtCore/QScopeGuard>
+#include <QtCore/QTemporaryDir>
 #include <QtCore/QVersionNumber>
 
 using namespace Qt::StringLiterals;
@@ -281,6 +285,59 @@ void APMParameterMetaDataTest::_loadBundledAPMMetaData()
     QVERIFY(!battMon->shortDescription().isEmpty());
 }
 
+void APMParameterMetaDataTest::_compiledCacheRoundTrip()
+{
+    const QString file = QStringLiteral(":/FirmwarePlugin/APM/APMParameterFactMetaData.Copter.4.7.json");
+    if (!QFile::exists(file)) {
+        QSKIP("Bundled APM Copter 4.7 JSON metadata not available");
+    }
+
+    QTemporaryDir cacheDir;
+    QVERIFY(cacheDir.isValid());
+    {
+        ParameterMetaData::setCompiledCacheDir(cacheDir.path());
+        const auto resetCacheDir = qScopeGuard([] { ParameterMetaData::setCompiledCacheDir(QString()); });
+
+        // All ArduPilot vehicles share the APM tag: only the older Copter compile goes, the Plane one stays
+        const QString staleFile = QDir(cacheDir.path()).filePath(QStringLiteral("APM_APMParameterFactMetaData.Copter.4.7_%1.qgcpmd").arg(QString(64, QLatin1Char('0'))));
+        const QString otherFile = QDir(cacheDir.path()).filePath(QStringLiteral("APM_APMParameterFactMetaData.Plane.4.7_%1.qgcpmd").arg(QString(64, QLatin1Char('0'))));
+        for (const QString &fileName : { staleFile, otherFile }) {
+            QFile staleCompile(fileName);
+            QVERIFY(staleCompile.open(QIODevice::WriteOnly));
+            QVERIFY(staleCompile.write("stale") > 0);
+        }
+
+        APMParameterMetaData compiled;
+        compiled.loadParameterFactMetaDataFile(file);
+        QVERIFY(!compiled.loadedFromCompiledCache());
+        QVERIFY(!QFile::exists(staleFile));
+        QVERIFY(QFile::exists(otherFile));
+        QCOMPARE(QDir(cacheDir.path()).entryList({ QStringLiteral("*.qgcpmd") }, QDir::Files).count(), 2);
+
+        APMParameterMetaData mapped;
+        mapped.loadParameterFactMetaDataFile(file);
+        QVERIFY(mapped.loadedFromCompiledCache());
+        QCOMPARE(mapped.metaDataCount(), 0);
+
+        FactMetaData *compiledFact = compiled.getMetaDataForFact("PILOT_THR_BHV", FactMetaData::valueTypeInt32);
+        FactMetaData *mappedFact = mapped.getMetaDataForFact("PILOT_THR_BHV", FactMetaData::valueTypeInt32);
+        QVERIFY(compiledFact);
+        QVERIFY(mappedFact);
+        QCOMPARE(mapped.metaDataCount(), 1);
+        QCOMPARE(mappedFact->name(), compiledFact->name());
+        QCOMPARE(mappedFact->shortDescription(), compiledFact->shortDescription());
+        QCOMPARE(mappedFact->bitmaskStrings(), compiledFact->bitmaskStrings());
+        QCOMPARE(mappedFact->bitmaskValues(), compiledFact->bitmaskValues());
+    }
+
+    // The scope guard put unit tests back on in-memory compiles
+    QVERIFY(ParameterMetaData::compiledCacheDir().isEmpty());
+    APMParameterMetaData uncached;
+    uncached.loadParameterFactMetaDataFile(file);
+    QVERIFY(!uncached.loadedFromCompiledCache());
+    QCOMPARE(QDir(cacheDir.path()).entryList({ QStringLiteral("*.qgcpmd") }, QDir::Files).count(), 2);
+}
+
 void APMParameterMetaDataTest::_verifyFullAPMParse()
 {
     const QString file = QStringLiteral(":/FirmwarePlugin/APM/APMParameterFactMetaData.Copter.4.7.json");
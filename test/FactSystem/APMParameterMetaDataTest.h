@@ -23,6 +23,7 @@ private slots:
     void _loadMissingFile();
     void _loadEmptyJson();
     void _loadBundledAPMMetaData();
+    void _compiledCacheRoundTrip();
     void _verifyFullAPMParse();
     void _versionFromJsonDataAPMFormat();
     void _invalidEnumKeySkipped();
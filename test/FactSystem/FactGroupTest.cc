@@ -5,6 +5,7 @@
 
 #include "Fact.h"
 #include "FactGroup.h"
+#include "FactUpdateScheduler.h"
 
 /// Testable subclass exposing protected members
 class TestableFactGroup : public FactGroup
@@ -21,6 +22,29 @@ class TestableFactGroup : public FactGroup
     using FactGroup::_setTelemetryAvailable;
 };
 
+/// Rate limited group which counts _updateAllValues calls
+class RateLimitedFactGroup : public FactGroup
+{
+    Q_OBJECT
+public:
+    explicit RateLimitedFactGroup(int updateRateMsecs, QObject *parent = nullptr)
+        : FactGroup(updateRateMsecs, parent)
+    {
+    }
+
+    using FactGroup::_addFact;
+    using FactGroup::_setPeriodicUpdates;
+
+    int updateAllValuesCount = 0;
+
+protected:
+    void _updateAllValues() override
+    {
+        updateAllValuesCount++;
+        FactGroup::_updateAllValues();
+    }
+};
+
 void FactGroupTest::_addFactAndLookup_test()
 {
     TestableFactGroup group;
@@ -234,6 +258,88 @@ void FactGroupTest::_factGroupNames_test()
     QVERIFY(names.contains(QStringLiteral("sub2")));
 }
 
+void FactGroupTest::_rateLimitedFlushesDirtyFacts_test()
+{
+    RateLimitedFactGroup group(kTestUpdateRateMsecs);
+    Fact changedFact(0, "changedFact", FactMetaData::valueTypeDouble);
+    Fact idleFact(0, "idleFact", FactMetaData::valueTypeDouble);
+    group._addFact(&changedFact);
+    group._addFact(&idleFact);
+
+    QSignalSpy changedSpy(&changedFact, &Fact::valueChanged);
+    QSignalSpy idleSpy(&idleFact, &Fact::valueChanged);
+    QVERIFY(changedSpy.isValid());
+    QVERIFY(idleSpy.isValid());
+
+    const qsizetype pendingBefore = FactUpdateScheduler::instance()->pendingCount();
+    changedFact.setRawValue(1.0);
+    changedFact.setRawValue(2.0);
+    changedFact.setTelemetryValue(3.0);
+    QCOMPARE(changedSpy.count(), 0);
+
+    // Only queued once no matter how many times the value changes between ticks
+    QCOMPARE(FactUpdateScheduler::instance()->pendingCount(), pendingBefore + 1);
+
+    QVERIFY(changedSpy.wait(kTestWaitMsecs));
+    QCOMPARE(changedSpy.count(), 1);
+    QCOMPARE(changedSpy.at(0).at(0).toDouble(), 3.0);
+    QCOMPARE(idleSpy.count(), 0);
+
+    // Group no longer visits the fact until it changes again
+    QVERIFY(!changedSpy.wait(kTestUpdateRateMsecs * 3));
+    QCOMPARE(group.updateAllValuesCount, 0);
+}
+
+void FactGroupTest::_rateLimitedGroupsShareTick_test()
+{
+    RateLimitedFactGroup group1(kTestUpdateRateMsecs);
+    RateLimitedFactGroup group2(kTestUpdateRateMsecs);
+    Fact fact1(0, "fact1", FactMetaData::valueTypeInt32);
+    Fact fact2(0, "fact2", FactMetaData::valueTypeInt32);
+    group1._addFact(&fact1);
+    group2._addFact(&fact2);
+
+    QSignalSpy spy1(&fact1, &Fact::valueChanged);
+    QSignalSpy spy2(&fact2, &Fact::valueChanged);
+    QVERIFY(spy1.isValid());
+    QVERIFY(spy2.isValid());
+
+    fact1.setRawValue(1);
+    fact2.setRawValue(2);
+
+    // Both groups flush from the same tick
+    QVERIFY(spy1.wait(kTestWaitMsecs));
+    QCOMPARE(spy2.count(), 1);
+}
+
+void FactGroupTest::_periodicUpdates_test()
+{
+    RateLimitedFactGroup group(kTestUpdateRateMsecs);
+    group._setPeriodicUpdates();
+
+    QTRY_VERIFY_WITH_TIMEOUT(group.updateAllValuesCount >= 2, kTestWaitMsecs);
+}
+
+void FactGroupTest::_liveUpdates_test()
+{
+    RateLimitedFactGroup group(kTestUpdateRateMsecs);
+    Fact fact(0, "fact", FactMetaData::valueTypeInt32);
+    group._addFact(&fact);
+
+    QSignalSpy spy(&fact, &Fact::valueChanged);
+    QVERIFY(spy.isValid());
+
+    group.setLiveUpdates(true);
+    fact.setRawValue(5);
+    QCOMPARE(spy.count(), 1);
+
+    group.setLiveUpdates(false);
+    fact.setRawValue(6);
+    QCOMPARE(spy.count(), 1);
+    QVERIFY(spy.wait(kTestWaitMsecs));
+    QCOMPARE(spy.count(), 2);
+}
+
 #include "FactGroupTest.moc"
 
 UT_REGISTER_TEST(FactGroupTest, TestLabel::Unit)
@@ -24,4 +24,12 @@ private slots:
     void _telemetryAvailable_test();
     void _factNames_test();
     void _factGroupNames_test();
+    void _rateLimitedFlushesDirtyFacts_test();
+    void _rateLimitedGroupsShareTick_test();
+    void _periodicUpdates_test();
+    void _liveUpdates_test();
+
+private:
+    static constexpr int kTestUpdateRateMsecs = 50;
+    static constexpr int kTestWaitMsecs = 2000;
 };
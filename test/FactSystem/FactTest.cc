@@ -1,8 +1,11 @@
 #include "FactTest.h"
 #include <QtTest/QSignalSpy>
 
+#include <cmath>
 #include <cstdlib>
+#include <limits>
 
+#include "Benchmarking.h"
 #include "Fact.h"
 #include "FactMetaData.h"
 
@@ -338,4 +341,165 @@ void FactTest::_rawValueStringFullPrecisionDouble_test()
     QCOMPARE(fact.rawValueStringFullPrecision(), QStringLiteral("0"));
 }
 
+void FactTest::_setTelemetryValue_test()
+{
+    Fact fact(0, "TelemetryParam", FactMetaData::valueTypeDouble);
+
+    QSignalSpy valueSpy(&fact, &Fact::valueChanged);
+    QSignalSpy rawSpy(&fact, &Fact::rawValueChanged);
+    QSignalSpy containerSpy(&fact, &Fact::containerRawValueChanged);
+    QVERIFY(valueSpy.isValid());
+    QVERIFY(rawSpy.isValid());
+    QVERIFY(containerSpy.isValid());
+
+    fact.setTelemetryValue(12.5);
+    QCOMPARE(fact.rawValue().typeId(), QMetaType::Double);
+    QCOMPARE(fact.rawValue().toDouble(), 12.5);
+    QCOMPARE(valueSpy.count(), 1);
+    QCOMPARE(rawSpy.count(), 1);
+
+    // Same value does not signal
+    fact.setTelemetryValue(12.5);
+    QCOMPARE(valueSpy.count(), 1);
+    QCOMPARE(rawSpy.count(), 1);
+
+    // Vehicle values are never sent back
+    QCOMPARE(containerSpy.count(), 0);
+
+    // Cooked value goes through the translator
+    fact.metaData()->setRawUnits("radians");
+    fact.setTelemetryValue(M_PI);
+    QCOMPARE_FUZZY(valueSpy.last().at(0).toDouble(), 180.0, 1e-5);
+    QCOMPARE_FUZZY(fact.cookedValue().toDouble(), 180.0, 1e-5);
+}
+
+void FactTest::_setTelemetryValueNaN_test()
+{
+    Fact fact(0, "TelemetryParam", FactMetaData::valueTypeFloat);
+
+    fact.setTelemetryValue(std::numeric_limits<float>::quiet_NaN());
+
+    QSignalSpy spy(&fact, &Fact::rawValueChanged);
+    QVERIFY(spy.isValid());
+
+    fact.setTelemetryValue(std::numeric_limits<float>::quiet_NaN());
+    QCOMPARE(spy.count(), 0);
+
+    fact.setTelemetryValue(1.0f);
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(fact.rawValue().typeId(), QMetaType::Float);
+}
+
+void FactTest::_setTelemetryValueConvert_test()
+{
+    // Stored type always follows the fact type, matching setRawValue
+    Fact floatFact(0, "FloatParam", FactMetaData::valueTypeFloat);
+    floatFact.setTelemetryValue(2.5);
+    QCOMPARE(floatFact.rawValue().typeId(), QMetaType::Float);
+    QCOMPARE(floatFact.rawValue().toFloat(), 2.5f);
+
+    Fact doubleFact(0, "DoubleParam", FactMetaData::valueTypeDouble);
+    doubleFact.setTelemetryValue(qint32(-7));
+    QCOMPARE(doubleFact.rawValue().typeId(), QMetaType::Double);
+    QCOMPARE(doubleFact.rawValue().toDouble(), -7.0);
+
+    Fact int16Fact(0, "Int16Param", FactMetaData::valueTypeInt16);
+    int16Fact.setTelemetryValue(qint32(-300));
+    QCOMPARE(int16Fact.rawValue().typeId(), QMetaType::Int);
+    QCOMPARE(int16Fact.rawValue().toInt(), -300);
+
+    Fact uint8Fact(0, "Uint8Param", FactMetaData::valueTypeUint8);
+    uint8Fact.setTelemetryValue(quint32(200));
+    QCOMPARE(uint8Fact.rawValue().typeId(), QMetaType::UInt);
+    QCOMPARE(uint8Fact.rawValue().toUInt(), 200u);
+
+    Fact uint64Fact(0, "Uint64Param", FactMetaData::valueTypeUint64);
+    uint64Fact.setTelemetryValue(quint32(4000000000u));
+    QCOMPARE(uint64Fact.rawValue().typeId(), QMetaType::ULongLong);
+    QCOMPARE(uint64Fact.rawValue().toULongLong(), 4000000000ull);
+
+    // Same conversion as setRawValue for mismatched types
+    Fact intFact(0, "IntParam", FactMetaData::valueTypeInt32);
+    Fact rawFact(0, "RawParam", FactMetaData::valueTypeInt32);
+    intFact.setTelemetryValue(3.7);
+    rawFact.setRawValue(QVariant(3.7));
+    QCOMPARE(intFact.rawValue(), rawFact.rawValue());
+}
+
+void FactTest::_setTelemetryValueDeferred_test()
+{
+    Fact fact(0, "TelemetryParam", FactMetaData::valueTypeDouble);
+    fact.setSendValueChangedSignals(false);
+
+    QSignalSpy valueSpy(&fact, &Fact::valueChanged);
+    QVERIFY(valueSpy.isValid());
+
+    fact.setTelemetryValue(1.0);
+    fact.setTelemetryValue(2.0);
+    QCOMPARE(valueSpy.count(), 0);
+    QVERIFY(fact.deferredValueChangeSignal());
+
+    fact.sendDeferredValueChangedSignal();
+    QCOMPARE(valueSpy.count(), 1);
+    QCOMPARE(valueSpy.at(0).at(0).toDouble(), 2.0);
+}
+
+void FactTest::_benchmarkTelemetrySetter()
+{
+    // Per update cost of a FactGroup style telemetry fact, deferred signalling as FactGroup does
+    Fact doubleFact(0, "DoubleParam", FactMetaData::valueTypeDouble);
+    Fact floatFact(0, "FloatParam", FactMetaData::valueTypeFloat);
+    Fact radiansFact(0, "RadiansParam", FactMetaData::valueTypeDouble);
+    radiansFact.metaData()->setRawUnits("radians");
+    for (Fact *fact : { &doubleFact, &floatFact, &radiansFact }) {
+        fact->setSendValueChangedSignals(false);
+    }
+
+    double value = 0.;
+
+    auto bench = qgc::bench::ciConfig();
+    bench.title("Fact telemetry update").relative(true);
+
+    bench.run("setRawValue(double)", [&] {
+        value += 0.001;
+        doubleFact.setRawValue(QVariant(value));
+        ankerl::nanobench::doNotOptimizeAway(doubleFact);
+    });
+
+    bench.run("setTelemetryValue(double)", [&] {
+        value += 0.001;
+        doubleFact.setTelemetryValue(value);
+        ankerl::nanobench::doNotOptimizeAway(doubleFact);
+    });
+
+    bench.run("setRawValue(float)", [&] {
+        value += 0.001;
+        floatFact.setRawValue(QVariant(static_cast<float>(value)));
+        ankerl::nanobench::doNotOptimizeAway(floatFact);
+    });
+
+    bench.run("setTelemetryValue(float)", [&] {
+        value += 0.001;
+        floatFact.setTelemetryValue(static_cast<float>(value));
+        ankerl::nanobench::doNotOptimizeAway(floatFact);
+    });
+
+    bench.run("setRawValue(double) radians", [&] {
+        value += 0.001;
+        radiansFact.setRawValue(QVariant(value));
+        ankerl::nanobench::doNotOptimizeAway(radiansFact);
+    });
+
+    bench.run("setTelemetryValue(double) radians", [&] {
+        value += 0.001;
+        radiansFact.setTelemetryValue(value);
+        ankerl::nanobench::doNotOptimizeAway(radiansFact);
+    });
+
+    bench.run("cookedValue()", [&] {
+        const QVariant cooked = doubleFact.cookedValue();
+        ankerl::nanobench::doNotOptimizeAway(cooked);
+    });
+}
+
 UT_REGISTER_TEST(FactTest, TestLabel::Unit)
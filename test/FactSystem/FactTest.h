@@ -29,4 +29,11 @@ private slots:
     void _rawValueStringFullPrecisionFloat_test();
     void _rawValueStringFullPrecisionDouble_test();
     void _labelFallback_test();
+    void _setTelemetryValue_test();
+    void _setTelemetryValueNaN_test();
+    void _setTelemetryValueConvert_test();
+    void _setTelemetryValueDeferred_test();
+
+    // Benchmarks (nanobench)
+    void _benchmarkTelemetrySetter();
 };
@@ -3,10 +3,14 @@
 #include "ParameterMetaDataTestHelper.h"
 #include "PX4ParameterMetaData.h"
 
+#include <QtCore/QDir>
+#include <QtCore/QFile>
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 #include <QtCore/QRegularExpression>
+#include <QtCore/QScopeGuard>
+#include <QtCore/QTemporaryDir>
 
 using namespace Qt::StringLiterals;
 
@@ -556,4 +560,74 @@ void PX4ParameterMetaDataTest::_versionFromJsonDataNoVersion()
     QVERIFY(ParameterMetaData::versionFromJsonData("not json{{{").isNull());
 }
 
+void PX4ParameterMetaDataTest::_compiledCacheRoundTrip()
+{
+    QTemporaryDir cacheDir;
+    QVERIFY(cacheDir.isValid());
+    ParameterMetaData::setCompiledCacheDir(cacheDir.path());
+    const auto resetCacheDir = qScopeGuard([] { ParameterMetaData::setCompiledCacheDir(QString()); });
+
+    const QString file = QStringLiteral(":/FirmwarePlugin/PX4/PX4ParameterFactMetaData.json");
+
+    // A compile of an earlier version of the same file is removed, other metadata files keep theirs
+    const QString staleFile = QDir(cacheDir.path()).filePath(QStringLiteral("PX4_PX4ParameterFactMetaData_%1.qgcpmd").arg(QString(64, QLatin1Char('0'))));
+    const QString otherFile = QDir(cacheDir.path()).filePath(QStringLiteral("PX4_PX4ParameterFactMetaData_Other_%1.qgcpmd").arg(QString(64, QLatin1Char('0'))));
+    for (const QString &fileName : { staleFile, otherFile }) {
+        QFile staleCompile(fileName);
+        QVERIFY(staleCompile.open(QIODevice::WriteOnly));
+        QVERIFY(staleCompile.write("stale") > 0);
+    }
+
+    PX4ParameterMetaData compiled;
+    compiled.loadParameterFactMetaDataFile(file);
+    QVERIFY(!compiled.loadedFromCompiledCache());
+    QVERIFY(!QFile::exists(staleFile));
+    QVERIFY(QFile::exists(otherFile));
+    QCOMPARE(QDir(cacheDir.path()).entryList({ QStringLiteral("*.qgcpmd") }, QDir::Files).count(), 2);
+
+    PX4ParameterMetaData mapped;
+    mapped.loadParameterFactMetaDataFile(file);
+    QVERIFY(mapped.loadedFromCompiledCache());
+
+    // Nothing is materialised until a vehicle asks for it
+    QCOMPARE(mapped.metaDataCount(), 0);
+
+    FactMetaData *compiledFact = compiled.getMetaDataForFact("ADSB_EMERGC", FactMetaData::valueTypeInt32);
+    FactMetaData *mappedFact = mapped.getMetaDataForFact("ADSB_EMERGC", FactMetaData::valueTypeInt32);
+    QVERIFY(compiledFact);
+    QVERIFY(mappedFact);
+    QCOMPARE(mapped.metaDataCount(), 1);
+    QCOMPARE(mappedFact->name(), compiledFact->name());
+    QCOMPARE(mappedFact->category(), compiledFact->category());
+    QCOMPARE(mappedFact->shortDescription(), compiledFact->shortDescription());
+    QCOMPARE(mappedFact->rawMin(), compiledFact->rawMin());
+    QCOMPARE(mappedFact->rawMax(), compiledFact->rawMax());
+    QCOMPARE(mappedFact->enumStrings(), compiledFact->enumStrings());
+    QCOMPARE(mappedFact->enumValues(), compiledFact->enumValues());
+
+    FactMetaData *unknown = mapped.getMetaDataForFact("NOT_A_PARAM", FactMetaData::valueTypeFloat);
+    QVERIFY(unknown);
+    QVERIFY(unknown->name().isEmpty());
+}
+
+void PX4ParameterMetaDataTest::_compiledCacheRejectsCorruptFile()
+{
+    QTemporaryFile corrupt;
+    QVERIFY(corrupt.open());
+    corrupt.write(ParameterMetaDataCache::build({ { u"A_PARAM"_s, QCborMap() } }).left(20));
+    corrupt.close();
+
+    ParameterMetaDataCache cache;
+    expectLogMessage("FirmwarePlugin.ParameterMetaDataCache", QtWarningMsg, QRegularExpression("Invalid compiled parameter meta data"));
+    QVERIFY(!cache.open(corrupt.fileName()));
+    verifyExpectedLogMessage();
+    QVERIFY(!cache.isValid());
+
+    QVERIFY(cache.setData(ParameterMetaDataCache::build({ { u"B_PARAM"_s, QCborMap({ { u"x"_s, 1 } }) }, { u"A_PARAM"_s, QCborMap({ { u"x"_s, 2 } }) } })));
+    QCOMPARE(cache.count(), 2u);
+    QCOMPARE(cache.record(u"A_PARAM"_s).value(u"x"_s).toInteger(), 2);
+    QCOMPARE(cache.record(u"B_PARAM"_s).value(u"x"_s).toInteger(), 1);
+    QVERIFY(!cache.contains(u"C_PARAM"_s));
+}
+
 UT_REGISTER_TEST(PX4ParameterMetaDataTest, TestLabel::Unit)
@@ -35,4 +35,6 @@ private slots:
     void _versionFromFileNameNoMatch();
     void _versionFromJsonDataAPMFormat();
     void _versionFromJsonDataNoVersion();
+    void _compiledCacheRoundTrip();
+    void _compiledCacheRejectsCorruptFile();
 };
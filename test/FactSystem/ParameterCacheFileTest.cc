@@ -0,0 +1,229 @@
+#include "ParameterCacheFileTest.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QTemporaryDir>
+
+#include <algorithm>
+
+#include "ParameterCacheFile.h"
+
+namespace {
+
+ParameterCacheFile::Value floatValue(float value)
+{
+    ParameterCacheFile::Value cacheValue;
+    cacheValue.type = FactMetaData::valueTypeFloat;
+    cacheValue.f32 = value;
+    return cacheValue;
+}
+
+ParameterCacheFile::Value int32Value(qint32 value)
+{
+    ParameterCacheFile::Value cacheValue;
+    cacheValue.type = FactMetaData::valueTypeInt32;
+    cacheValue.i32 = value;
+    return cacheValue;
+}
+
+ParameterCacheFile::Entries testEntries()
+{
+    ParameterCacheFile::Entries entries;
+    entries.append({ QStringLiteral("BAT1_V_CHARGED"), floatValue(4.2f) });
+    entries.append({ QStringLiteral("MPC_XY_VEL_MAX"), floatValue(12.f) });
+    entries.append({ QStringLiteral("SYS_AUTOSTART"), int32Value(4001) });
+    return entries;
+}
+
+const ParameterCacheFile::Entry *findEntry(const ParameterCacheFile::Entries &entries, const QString &name)
+{
+    for (const ParameterCacheFile::Entry &entry : entries) {
+        if (entry.name == name) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+void ParameterCacheFileTest::_valueVariantRoundTrip_test()
+{
+    // Variant types must match what PARAM_VALUE decoding hands to the facts
+    const ParameterCacheFile::Value uint8Value = ParameterCacheFile::Value::fromVariant(FactMetaData::valueTypeUint8, QVariant(200u));
+    QCOMPARE(uint8Value.u8, static_cast<quint8>(200));
+    QCOMPARE(uint8Value.size(), static_cast<size_t>(1));
+    QCOMPARE(uint8Value.toVariant().typeId(), QMetaType::UInt);
+    QCOMPARE(uint8Value.toVariant().toUInt(), 200u);
+
+    const ParameterCacheFile::Value int16Value = ParameterCacheFile::Value::fromVariant(FactMetaData::valueTypeInt16, QVariant(-1234));
+    QCOMPARE(int16Value.toVariant().typeId(), QMetaType::Int);
+    QCOMPARE(int16Value.toVariant().toInt(), -1234);
+
+    const ParameterCacheFile::Value realValue = ParameterCacheFile::Value::fromVariant(FactMetaData::valueTypeFloat, QVariant(1.5f));
+    QCOMPARE(realValue.toVariant().typeId(), QMetaType::Float);
+    QCOMPARE(realValue.toVariant().toFloat(), 1.5f);
+    QCOMPARE(realValue, floatValue(1.5f));
+
+    const ParameterCacheFile::Value stringValue = ParameterCacheFile::Value::fromVariant(FactMetaData::valueTypeString, QVariant(QStringLiteral("x")));
+    QVERIFY(!stringValue.isValid());
+}
+
+void ParameterCacheFileTest::_writeReadRoundTrip_test()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString fileName = tempDir.filePath(QStringLiteral("1_1.v3"));
+
+    const ParameterCacheFile::Entries entries = testEntries();
+    QVERIFY(ParameterCacheFile::write(fileName, entries));
+
+    ParameterCacheFile::Entries readEntries;
+    qsizetype journalRecords = -1;
+    QVERIFY(ParameterCacheFile::read(fileName, readEntries, &journalRecords));
+    QCOMPARE(journalRecords, 0);
+    QCOMPARE(readEntries.count(), entries.count());
+    for (qsizetype i = 0; i < entries.count(); i++) {
+        QCOMPARE(readEntries[i].name, entries[i].name);
+        QCOMPARE(readEntries[i].value, entries[i].value);
+    }
+}
+
+void ParameterCacheFileTest::_writeSortsEntries_test()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString fileName = tempDir.filePath(QStringLiteral("1_1.v3"));
+
+    ParameterCacheFile::Entries entries = testEntries();
+    std::reverse(entries.begin(), entries.end());
+    QVERIFY(ParameterCacheFile::write(fileName, entries));
+
+    ParameterCacheFile::Entries readEntries;
+    QVERIFY(ParameterCacheFile::read(fileName, readEntries));
+    QCOMPARE(readEntries.count(), 3);
+    QCOMPARE(readEntries[0].name, QStringLiteral("BAT1_V_CHARGED"));
+    QCOMPARE(readEntries[2].name, QStringLiteral("SYS_AUTOSTART"));
+}
+
+void ParameterCacheFileTest::_journalUpdatesExisting_test()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString fileName = tempDir.filePath(QStringLiteral("1_1.v3"));
+
+    QVERIFY(ParameterCacheFile::write(fileName, testEntries()));
+    const qint64 baseSize = QFileInfo(fileName).size();
+
+    QVERIFY(ParameterCacheFile::append(fileName, QStringLiteral("MPC_XY_VEL_MAX"), floatValue(8.f)));
+    QVERIFY(ParameterCacheFile::append(fileName, QStringLiteral("MPC_XY_VEL_MAX"), floatValue(9.f)));
+
+    // Records are small and fixed by name length and type, not by the number of parameters
+    QCOMPARE(QFileInfo(fileName).size(), baseSize + (2 * (3 + 14 + 4)));
+
+    ParameterCacheFile::Entries readEntries;
+    qsizetype journalRecords = 0;
+    QVERIFY(ParameterCacheFile::read(fileName, readEntries, &journalRecords));
+    QCOMPARE(journalRecords, 2);
+    QCOMPARE(readEntries.count(), 3);
+
+    const ParameterCacheFile::Entry *const entry = findEntry(readEntries, QStringLiteral("MPC_XY_VEL_MAX"));
+    QVERIFY(entry);
+    QCOMPARE(entry->value, floatValue(9.f));
+}
+
+void ParameterCacheFileTest::_journalAddsNewName_test()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString fileName = tempDir.filePath(QStringLiteral("1_1.v3"));
+
+    QVERIFY(ParameterCacheFile::write(fileName, testEntries()));
+    QVERIFY(ParameterCacheFile::append(fileName, QStringLiteral("COM_ARM_WO_GPS"), int32Value(1)));
+
+    ParameterCacheFile::Entries readEntries;
+    QVERIFY(ParameterCacheFile::read(fileName, readEntries));
+    QCOMPARE(readEntries.count(), 4);
+
+    // New names are merged into name order, which the _HASH_CHECK crc depends on
+    QCOMPARE(readEntries[1].name, QStringLiteral("COM_ARM_WO_GPS"));
+    QCOMPARE(readEntries[1].value, int32Value(1));
+}
+
+void ParameterCacheFileTest::_journalTornRecordIgnored_test()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString fileName = tempDir.filePath(QStringLiteral("1_1.v3"));
+
+    QVERIFY(ParameterCacheFile::write(fileName, testEntries()));
+    QVERIFY(ParameterCacheFile::append(fileName, QStringLiteral("SYS_AUTOSTART"), int32Value(4010)));
+    QVERIFY(ParameterCacheFile::append(fileName, QStringLiteral("BAT1_V_CHARGED"), floatValue(4.35f)));
+
+    // Cut the last record short as a crash mid append would
+    QFile file(fileName);
+    QVERIFY(file.resize(file.size() - 2));
+
+    ParameterCacheFile::Entries readEntries;
+    qsizetype journalRecords = 0;
+    QVERIFY(ParameterCacheFile::read(fileName, readEntries, &journalRecords));
+    QCOMPARE(journalRecords, 1);
+    QCOMPARE(findEntry(readEntries, QStringLiteral("SYS_AUTOSTART"))->value, int32Value(4010));
+    QCOMPARE(findEntry(readEntries, QStringLiteral("BAT1_V_CHARGED"))->value, floatValue(4.2f));
+}
+
+void ParameterCacheFileTest::_writeCompactsJournal_test()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString fileName = tempDir.filePath(QStringLiteral("1_1.v3"));
+
+    QVERIFY(ParameterCacheFile::write(fileName, testEntries()));
+    const qint64 baseSize = QFileInfo(fileName).size();
+    for (int i = 0; i < 10; i++) {
+        QVERIFY(ParameterCacheFile::append(fileName, QStringLiteral("SYS_AUTOSTART"), int32Value(i)));
+    }
+
+    ParameterCacheFile::Entries readEntries;
+    QVERIFY(ParameterCacheFile::read(fileName, readEntries));
+    QVERIFY(ParameterCacheFile::write(fileName, readEntries));
+    QCOMPARE(QFileInfo(fileName).size(), baseSize);
+
+    qsizetype journalRecords = -1;
+    QVERIFY(ParameterCacheFile::read(fileName, readEntries, &journalRecords));
+    QCOMPARE(journalRecords, 0);
+    QCOMPARE(findEntry(readEntries, QStringLiteral("SYS_AUTOSTART"))->value, int32Value(9));
+}
+
+void ParameterCacheFileTest::_appendRequiresBaseImage_test()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString fileName = tempDir.filePath(QStringLiteral("1_1.v3"));
+
+    QVERIFY(!ParameterCacheFile::append(fileName, QStringLiteral("SYS_AUTOSTART"), int32Value(1)));
+    QVERIFY(!QFile::exists(fileName));
+
+    ParameterCacheFile::Entries readEntries;
+    QVERIFY(!ParameterCacheFile::read(fileName, readEntries));
+}
+
+void ParameterCacheFileTest::_badMagicRejected_test()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString fileName = tempDir.filePath(QStringLiteral("1_1.v3"));
+
+    QVERIFY(ParameterCacheFile::write(fileName, testEntries()));
+
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QCOMPARE(file.write("XXXX", 4), static_cast<qint64>(4));
+    file.close();
+
+    ParameterCacheFile::Entries readEntries;
+    QVERIFY(!ParameterCacheFile::read(fileName, readEntries));
+    QVERIFY(readEntries.isEmpty());
+}
+
+UT_REGISTER_TEST(ParameterCacheFileTest, TestLabel::Unit)
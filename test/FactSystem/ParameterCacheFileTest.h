@@ -0,0 +1,19 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class ParameterCacheFileTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _valueVariantRoundTrip_test();
+    void _writeReadRoundTrip_test();
+    void _writeSortsEntries_test();
+    void _journalUpdatesExisting_test();
+    void _journalAddsNewName_test();
+    void _journalTornRecordIgnored_test();
+    void _writeCompactsJournal_test();
+    void _appendRequiresBaseImage_test();
+    void _badMagicRejected_test();
+};
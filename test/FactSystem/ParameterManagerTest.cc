@@ -1,15 +1,22 @@
 #include "ParameterManagerTest.h"
 
+#include <QtCore/QDataStream>
+#include <QtCore/QDir>
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
 #include <QtCore/QRegularExpression>
+#include <QtCore/QTemporaryDir>
 #include <QtTest/QSignalSpy>
 
 #include <cmath>
 #include <limits>
 
+#include "Benchmarking.h"
 #include "BulkRefreshJob.h"
 #include "MockLinkFTP.h"
 #include "MultiVehicleManager.h"
+#include "ParameterCacheFile.h"
 #include "ParameterManager.h"
 #include "QGCMath.h"
 #include "Vehicle.h"
@@ -130,6 +137,58 @@ void ParameterManagerTest::_requestListMissingParamFail()
     verifyExpectedLogMessage();
 }
 
+void ParameterManagerTest::_requestListLossyLink_data()
+{
+    QTest::addColumn<int>("lossPercent");
+
+    QTest::newRow("10% loss") << 10;
+    QTest::newRow("30% loss") << 30;
+}
+
+// MockLink drops PARAM_VALUEs like a lossy telemetry radio. The gaps in the PARAM_REQUEST_LIST stream must be
+// filled by the pipelined index re-requests well within a bound, without giving up on any param.
+void ParameterManagerTest::_requestListLossyLink()
+{
+    QFETCH(int, lossPercent);
+
+    // Without a cache file the _HASH_CHECK misses and the full stream is requested
+    const QDir cacheDir = ParameterManager::parameterCacheDir();
+    for (const QString &file : cacheDir.entryList(QStringList() << QStringLiteral("*.v3"), QDir::Files)) {
+        (void) QFile::remove(cacheDir.filePath(file));
+    }
+
+    QVERIFY2(!_mockLink, "MockLink already connected");
+    _mockLink = MockLink::startPX4MockLink(MockConfiguration::OptionNone, MockConfiguration::FailNone);
+    _mockLink->setParamValueLossPercent(lossPercent);
+    MultiVehicleManager *const vehicleMgr = MultiVehicleManager::instance();
+    QVERIFY(vehicleMgr);
+    QSignalSpy spyVehicle(vehicleMgr, &MultiVehicleManager::activeVehicleAvailableChanged);
+    QSignalSpy spyParamsReady(vehicleMgr, &MultiVehicleManager::parameterReadyVehicleAvailableChanged);
+    QVERIFY_SIGNAL_WAIT(spyVehicle, TestTimeout::mediumMs());
+    QElapsedTimer loadTimer;
+    loadTimer.start();
+    Vehicle *const vehicle = vehicleMgr->activeVehicle();
+    QVERIFY(vehicle);
+
+    QVERIFY_SIGNAL_WAIT(spyParamsReady, TestTimeout::longMs());
+    const qint64 loadMs = loadTimer.elapsed();
+    QCOMPARE(spyParamsReady.takeFirst().at(0).toBool(), true);
+    QVERIFY(!vehicle->parameterManager()->missingParameters());
+
+    const int lossCount = _mockLink->paramValueLossCount();
+    const int requestReadCount = _mockLink->receivedMavlinkMessageCount(MAVLINK_MSG_ID_PARAM_REQUEST_READ) - _mockLink->hashCheckRequestCount();
+    QVERIFY(lossCount > 0);
+
+    // Every dropped PARAM_VALUE costs one re-request, the rest are timeouts which fired before a late response
+    QVERIFY2(requestReadCount <= ((2 * lossCount) + 20), qPrintable(QStringLiteral("%1% loss: %2 re-requests for %3 drops").arg(lossPercent).arg(requestReadCount).arg(lossCount)));
+
+    // The stream itself takes 2 seconds (1000 params at MockLink's 500 Hz) and one 500 ms stall timeout detects its end.
+    // Filling the gaps and loading metadata must fit in the medium timeout on top of that.
+    const int loadBoundMs = 2000 + 500 + TestTimeout::mediumMs();
+    QVERIFY2(loadMs < loadBoundMs, qPrintable(QStringLiteral("%1% loss: load took %2 ms, bound %3 ms, %4 re-requests for %5 drops")
+                                             .arg(lossPercent).arg(loadMs).arg(loadBoundMs).arg(requestReadCount).arg(lossCount)));
+}
+
 void ParameterManagerTest::_paramWriteNoAckRetry()
 {
     // BAT1_V_CHARGED requires a vehicle reboot, so writing it pops the reboot
@@ -425,6 +484,32 @@ void ParameterManagerTest::_FTPnoFailure()
     QCOMPARE(batt2MonFact->rawValue().toInt(), 4);
 }
 
+void ParameterManagerTest::_FTPNotAdvertised()
+{
+    // ArduPilot without MAV_PROTOCOL_CAPABILITY_FTP must not be asked for param.pck
+    QVERIFY2(!_mockLink, "MockLink already connected");
+    _mockLink = MockLink::startAPMArduPlaneMockLink(MockConfiguration::OptionNoFtpCapability);
+
+    MultiVehicleManager* vehicleMgr = MultiVehicleManager::instance();
+    QVERIFY(vehicleMgr);
+
+    QSignalSpy spyVehicle(vehicleMgr, &MultiVehicleManager::activeVehicleAvailableChanged);
+    QVERIFY_SIGNAL_WAIT(spyVehicle, TestTimeout::mediumMs());
+    QCOMPARE(spyVehicle.takeFirst().at(0).toBool(), true);
+
+    Vehicle* vehicle = vehicleMgr->activeVehicle();
+    QVERIFY(vehicle);
+
+    QSignalSpy spyParamsReady(vehicleMgr, &MultiVehicleManager::parameterReadyVehicleAvailableChanged);
+    QVERIFY_SIGNAL_WAIT(spyParamsReady, TestTimeout::longMs());
+    QCOMPARE(spyParamsReady.takeFirst().at(0).toBool(), true);
+
+    QVERIFY(!(vehicle->capabilityBits() & MAV_PROTOCOL_CAPABILITY_FTP));
+    QVERIFY(_mockLink->receivedMavlinkMessageCount(MAVLINK_MSG_ID_PARAM_REQUEST_LIST) > 0);
+    QVERIFY(!vehicle->parameterManager()->missingParameters());
+    QVERIFY(vehicle->parameterManager()->parameterExists(MAV_COMP_ID_AUTOPILOT1, QStringLiteral("BATT_LOW_VOLT")));
+}
+
 void ParameterManagerTest::_FTPChangeParam()
 {
     // Test that parameter set works after APM FTP param download
@@ -460,6 +545,176 @@ void ParameterManagerTest::_FTPChangeParam()
     QCOMPARE(fact->rawValue().toFloat(), testValue);
 }
 
+void ParameterManagerTest::_paramCacheJournal()
+{
+    // A PARAM_SET after the initial load lands in the cache journal instead of rewriting the cache
+    _connectMockLink(MAV_AUTOPILOT_PX4);
+    QVERIFY(_vehicle);
+    ParameterManager *const paramManager = _vehicle->parameterManager();
+
+    const QString cacheFileName = ParameterManager::parameterCacheFile(_vehicle->id(), MAV_COMP_ID_AUTOPILOT1);
+    ParameterCacheFile::Entries entries;
+    qsizetype journalRecords = -1;
+    QVERIFY(ParameterCacheFile::read(cacheFileName, entries, &journalRecords));
+    QCOMPARE(journalRecords, 0);
+    QCOMPARE(entries.count(), paramManager->parameterNames(MAV_COMP_ID_AUTOPILOT1).count());
+
+    Fact *const fact = paramManager->getParameter(MAV_COMP_ID_AUTOPILOT1, QStringLiteral("BAT1_V_CHARGED"));
+    QVERIFY(fact);
+    const float testValue = fact->rawValue().toFloat() + 0.1f;
+
+    QSignalSpy spyVehicleUpdated(fact, &Fact::vehicleUpdated);
+    fact->setRawValue(QVariant(testValue));
+    QVERIFY_SIGNAL_WAIT(spyVehicleUpdated, TestTimeout::mediumMs());
+
+    QVERIFY(ParameterCacheFile::read(cacheFileName, entries, &journalRecords));
+    QVERIFY(journalRecords >= 1);
+
+    bool found = false;
+    for (const ParameterCacheFile::Entry &entry : entries) {
+        if (entry.name == fact->name()) {
+            QCOMPARE(entry.value.type, FactMetaData::valueTypeFloat);
+            QCOMPARE(entry.value.f32, testValue);
+            found = true;
+        }
+    }
+    QVERIFY(found);
+
+    _disconnectMockLink();
+}
+
+void ParameterManagerTest::_paramCacheRemovesLegacyFile()
+{
+    // Rewriting the compact cache removes the old format file for the same vehicle and component
+    _connectMockLink(MAV_AUTOPILOT_PX4);
+    QVERIFY(_vehicle);
+    ParameterManager *const paramManager = _vehicle->parameterManager();
+
+    const QString cacheFileName = ParameterManager::parameterCacheFile(_vehicle->id(), MAV_COMP_ID_AUTOPILOT1);
+    const QString legacyFileName = ParameterManager::parameterCacheDir().filePath(
+        QStringLiteral("%1_%2.v2").arg(_vehicle->id()).arg(MAV_COMP_ID_AUTOPILOT1));
+    QFile legacyFile(legacyFileName);
+    QVERIFY(legacyFile.open(QIODevice::WriteOnly));
+    QVERIFY(legacyFile.write("legacy") > 0);
+    legacyFile.close();
+
+    // Without a cache file to append to, the next update rewrites the whole cache
+    QVERIFY(QFile::remove(cacheFileName));
+
+    Fact *const fact = paramManager->getParameter(MAV_COMP_ID_AUTOPILOT1, QStringLiteral("BAT1_V_CHARGED"));
+    QVERIFY(fact);
+    QSignalSpy spyVehicleUpdated(fact, &Fact::vehicleUpdated);
+    fact->setRawValue(QVariant(fact->rawValue().toFloat() + 0.1f));
+    QVERIFY_SIGNAL_WAIT(spyVehicleUpdated, TestTimeout::mediumMs());
+
+    QVERIFY(QFile::exists(cacheFileName));
+    QVERIFY(!QFile::exists(legacyFileName));
+
+    _disconnectMockLink();
+}
+
+void ParameterManagerTest::_paramCacheColdLoad()
+{
+    // Cache load cost for a PX4 sized configuration, old QDataStream format against the compact one.
+    // Both produce the _HASH_CHECK crc and the raw value variants handed to the facts.
+    constexpr int kParamCount = 1500;
+
+    typedef QPair<int, QVariant> LegacyTypeVal;
+    typedef QMap<QString, LegacyTypeVal> LegacyCacheMap;
+
+    ParameterCacheFile::Entries entries;
+    LegacyCacheMap legacyMap;
+    for (int i = 0; i < kParamCount; i++) {
+        ParameterCacheFile::Value value;
+        switch (i % 4) {
+        case 0:
+        case 1:
+            value.type = FactMetaData::valueTypeFloat;
+            value.f32 = i * 0.25f;
+            break;
+        case 2:
+            value.type = FactMetaData::valueTypeInt32;
+            value.i32 = -i;
+            break;
+        default:
+            value.type = FactMetaData::valueTypeUint8;
+            value.u8 = static_cast<quint8>(i);
+            break;
+        }
+        const QString name = QStringLiteral("PARAM_%1").arg(i, 4, 10, QLatin1Char('0'));
+        entries.append({ name, value });
+        legacyMap[name] = LegacyTypeVal(value.type, value.toVariant());
+    }
+
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString cacheFileName = tempDir.filePath(QStringLiteral("1_1.v3"));
+    const QString legacyFileName = tempDir.filePath(QStringLiteral("1_1.v2"));
+    QVERIFY(ParameterCacheFile::write(cacheFileName, entries));
+    {
+        QFile legacyFile(legacyFileName);
+        QVERIFY(legacyFile.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        QDataStream ds(&legacyFile);
+        ds << legacyMap;
+    }
+
+    QVariantList rawValues;
+    rawValues.reserve(kParamCount);
+
+    const auto legacyLoad = [&]() -> quint32 {
+        LegacyCacheMap cacheMap;
+        QFile cacheFile(legacyFileName);
+        (void) cacheFile.open(QIODevice::ReadOnly);
+        QDataStream ds(&cacheFile);
+        ds >> cacheMap;
+
+        quint32 crc = 0;
+        rawValues.clear();
+        for (const QString &name : cacheMap.keys()) {
+            const LegacyTypeVal &typeVal = cacheMap[name];
+            const size_t size = FactMetaData::typeToSize(static_cast<FactMetaData::ValueType_t>(typeVal.first));
+            crc = QGC::crc32(reinterpret_cast<const uint8_t *>(qPrintable(name)), name.length(), crc);
+            crc = QGC::crc32(static_cast<const uint8_t *>(typeVal.second.constData()), size, crc);
+            rawValues.append(typeVal.second);
+        }
+        return crc;
+    };
+
+    const auto compactLoad = [&]() -> quint32 {
+        ParameterCacheFile::Entries cacheEntries;
+        (void) ParameterCacheFile::read(cacheFileName, cacheEntries);
+
+        quint32 crc = 0;
+        rawValues.clear();
+        for (const ParameterCacheFile::Entry &entry : cacheEntries) {
+            crc = QGC::crc32(reinterpret_cast<const uint8_t *>(qPrintable(entry.name)), entry.name.length(), crc);
+            crc = QGC::crc32(static_cast<const uint8_t *>(entry.value.data()), entry.value.size(), crc);
+            rawValues.append(entry.value.toVariant());
+        }
+        return crc;
+    };
+
+    const quint32 compactCrc = compactLoad();
+    QCOMPARE(rawValues.count(), kParamCount);
+    const quint32 legacyCrc = legacyLoad();
+    QCOMPARE(rawValues.count(), kParamCount);
+
+    QCOMPARE(compactCrc, legacyCrc);
+    QVERIFY(QFileInfo(cacheFileName).size() < QFileInfo(legacyFileName).size());
+
+    // Load times are reported by the benchmark, single timings are too noisy to gate on
+    auto bench = qgc::bench::ciConfig();
+    bench.title("Parameter cache load, 1500 params").relative(true);
+
+    bench.run("QDataStream QMap", [&] {
+        ankerl::nanobench::doNotOptimizeAway(legacyLoad());
+    });
+
+    bench.run("ParameterCacheFile", [&] {
+        ankerl::nanobench::doNotOptimizeAway(compactLoad());
+    });
+}
+
 UT_REGISTER_TEST(ParameterManagerTest, TestLabel::Integration, TestLabel::Vehicle, TestLabel::Serial)
 
 // ---------------------------------------------------------------------------
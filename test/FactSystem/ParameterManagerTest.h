@@ -13,6 +13,8 @@ private slots:
     void _requestListNoResponse();
     void _requestListMissingParamSuccess();
     void _requestListMissingParamFail();
+    void _requestListLossyLink_data();
+    void _requestListLossyLink();
     void _paramWriteNoAckRetry();
     void _paramWriteNoAckPermanent();
     void _paramWriteUInt8();
@@ -23,6 +25,10 @@ private slots:
     void _paramReadParamError();
     void _FTPnoFailure();
     void _FTPChangeParam();
+    void _FTPNotAdvertised();
+    void _paramCacheJournal();
+    void _paramCacheRemovesLegacyFile();
+    void _paramCacheColdLoad();
     void _bulkRefreshExactNamesAllSucceed();
     void _bulkRefreshPrefixExpansion();
     void _bulkRefreshUnknownNameSkipped();
@@ -0,0 +1,215 @@
+#include "ParameterRequestWindowTest.h"
+
+#include "ParameterRequestWindow.h"
+
+namespace {
+
+constexpr int kComponentId = 1;
+
+ParameterRequestWindow::Config testConfig()
+{
+    ParameterRequestWindow::Config config;
+    config.initialTimeoutMs = 1000;
+    config.minTimeoutMs = 100;
+    config.maxTimeoutMs = 4000;
+    config.initialWindow = 4;
+    config.maxWindow = 32;
+    return config;
+}
+
+/// Sends requests for the next indices until the window is full
+int fillWindow(ParameterRequestWindow &window, int &nextIndex, qint64 nowMs)
+{
+    int sent = 0;
+    while (window.canSend()) {
+        window.requestSent(kComponentId, nextIndex++, nowMs, false /* retransmit */);
+        sent++;
+    }
+    return sent;
+}
+
+} // namespace
+
+void ParameterRequestWindowTest::_slowStartGrowth_test()
+{
+    ParameterRequestWindow window(testConfig());
+    int nextIndex = 0;
+
+    QCOMPARE(fillWindow(window, nextIndex, 0), 4);
+    QVERIFY(!window.canSend());
+
+    // Each response opens the window by one, so a full window of responses doubles it
+    for (int i = 0; i < 4; i++) {
+        QVERIFY(window.responseReceived(kComponentId, i, 10));
+    }
+    QCOMPARE(window.window(), 8);
+    QCOMPARE(fillWindow(window, nextIndex, 10), 8);
+
+    for (int i = 4; i < 12; i++) {
+        QVERIFY(window.responseReceived(kComponentId, i, 20));
+    }
+    QCOMPARE(window.window(), 16);
+
+    // Responses to requests which are not outstanding are ignored
+    QVERIFY(!window.responseReceived(kComponentId, 0, 30));
+    QCOMPARE(window.window(), 16);
+    QCOMPARE(window.stats().responses, quint64(12));
+}
+
+void ParameterRequestWindowTest::_congestionAvoidanceGrowth_test()
+{
+    ParameterRequestWindow window(testConfig());
+    int nextIndex = 0;
+
+    (void) fillWindow(window, nextIndex, 0);
+    QCOMPARE(window.takeExpired(1000).count(), 4);
+    QCOMPARE(window.window(), 2);
+    QCOMPARE(window.slowStartThreshold(), 2);
+
+    // At the threshold a full window of responses only adds one
+    (void) fillWindow(window, nextIndex, 1000);
+    QVERIFY(window.responseReceived(kComponentId, 4, 1010));
+    QVERIFY(window.responseReceived(kComponentId, 5, 1010));
+    QCOMPARE(window.window(), 2);
+
+    (void) fillWindow(window, nextIndex, 1010);
+    QVERIFY(window.responseReceived(kComponentId, 6, 1020));
+    QVERIFY(window.responseReceived(kComponentId, 7, 1020));
+    QCOMPARE(window.window(), 3);
+}
+
+void ParameterRequestWindowTest::_timeoutShrinksWindowOncePerWindow_test()
+{
+    ParameterRequestWindow window(testConfig());
+    int nextIndex = 0;
+
+    (void) fillWindow(window, nextIndex, 0);
+    for (int i = 0; i < 4; i++) {
+        QVERIFY(window.responseReceived(kComponentId, i, 10));
+    }
+    QCOMPARE(window.window(), 8);
+
+    // The whole window is sent at once, then only the first half expires
+    (void) fillWindow(window, nextIndex, 10);
+    const int timeoutMs = window.timeoutMs();
+    const QList<ParameterRequestWindow::Request> expired = window.takeExpired(10 + timeoutMs);
+    QCOMPARE(expired.count(), 8);
+    QVERIFY(expired.contains(ParameterRequestWindow::Request(kComponentId, 4)));
+    QCOMPARE(window.window(), 4);
+    QCOMPARE(window.outstandingCount(), 0);
+    QCOMPARE(window.stats().timeouts, quint64(8));
+
+    // Losses of requests sent before the window was shrunk are not charged again
+    window.requestSent(kComponentId, 100, 10 + timeoutMs - 1, false /* retransmit */);
+    QCOMPARE(window.takeExpired(10 + (2 * timeoutMs) + 100).count(), 1);
+    QCOMPARE(window.window(), 4);
+
+    // A loss from the new window is
+    window.requestSent(kComponentId, 101, 20000, false /* retransmit */);
+    QCOMPARE(window.takeExpired(30000).count(), 1);
+    QCOMPARE(window.window(), 2);
+}
+
+void ParameterRequestWindowTest::_timeoutFromRoundTrip_test()
+{
+    ParameterRequestWindow window(testConfig());
+
+    QCOMPARE(window.timeoutMs(), 1000);
+    QCOMPARE(window.smoothedRttMs(), -1.);
+
+    // First sample: srtt = 200, rttvar = 100, timeout = srtt + 4 * rttvar
+    window.requestSent(kComponentId, 0, 0, false /* retransmit */);
+    QVERIFY(window.responseReceived(kComponentId, 0, 200));
+    QCOMPARE(window.smoothedRttMs(), 200.);
+    QCOMPARE(window.timeoutMs(), 600);
+
+    // Steady samples pull the variance down: rttvar = 100 + 0.25 * (0 - 100) = 75
+    window.requestSent(kComponentId, 1, 1000, false /* retransmit */);
+    QVERIFY(window.responseReceived(kComponentId, 1, 1200));
+    QCOMPARE(window.smoothedRttMs(), 200.);
+    QCOMPARE(window.timeoutMs(), 500);
+
+    // Fast links are held at the minimum timeout
+    for (int i = 2; i < 40; i++) {
+        window.requestSent(kComponentId, i, i * 100, false /* retransmit */);
+        QVERIFY(window.responseReceived(kComponentId, i, (i * 100) + 2));
+    }
+    QCOMPARE(window.timeoutMs(), 100);
+}
+
+void ParameterRequestWindowTest::_retransmitNotSampled_test()
+{
+    ParameterRequestWindow window(testConfig());
+
+    window.requestSent(kComponentId, 0, 0, false /* retransmit */);
+    QVERIFY(window.responseReceived(kComponentId, 0, 200));
+    QCOMPARE(window.smoothedRttMs(), 200.);
+
+    // The response may belong to the first request, so the round trip is unknown
+    window.requestSent(kComponentId, 1, 1000, true /* retransmit */);
+    QVERIFY(window.responseReceived(kComponentId, 1, 1900));
+    QCOMPARE(window.smoothedRttMs(), 200.);
+    QCOMPARE(window.stats().retransmits, quint64(1));
+}
+
+void ParameterRequestWindowTest::_consecutiveTimeoutsBackOff_test()
+{
+    ParameterRequestWindow window(testConfig());
+    qint64 nowMs = 0;
+
+    // The first timeout may be a plain loss and does not back off
+    window.requestSent(kComponentId, 0, nowMs, false /* retransmit */);
+    nowMs += 1000;
+    QCOMPARE(window.takeExpired(nowMs).count(), 1);
+    QCOMPARE(window.timeoutMs(), 1000);
+
+    // Each further timeout without a response in between doubles the timeout
+    window.requestSent(kComponentId, 0, nowMs, true /* retransmit */);
+    nowMs += 1000;
+    QCOMPARE(window.takeExpired(nowMs).count(), 1);
+    QCOMPARE(window.timeoutMs(), 2000);
+
+    window.requestSent(kComponentId, 0, nowMs, true /* retransmit */);
+    nowMs += 1999;
+    QVERIFY(window.takeExpired(nowMs).isEmpty());
+    nowMs += 1;
+    QCOMPARE(window.takeExpired(nowMs).count(), 1);
+    QCOMPARE(window.timeoutMs(), 4000);
+
+    // Capped at the maximum
+    window.requestSent(kComponentId, 0, nowMs, true /* retransmit */);
+    nowMs += 4000;
+    QCOMPARE(window.takeExpired(nowMs).count(), 1);
+    QCOMPARE(window.timeoutMs(), 4000);
+
+    // A response ends the backoff
+    window.requestSent(kComponentId, 1, nowMs, true /* retransmit */);
+    QVERIFY(window.responseReceived(kComponentId, 1, nowMs + 10));
+    QCOMPARE(window.timeoutMs(), 1000);
+}
+
+void ParameterRequestWindowTest::_nextExpiry_test()
+{
+    ParameterRequestWindow window(testConfig());
+
+    QCOMPARE(window.msecsToNextExpiry(0), qint64(-1));
+
+    window.requestSent(kComponentId, 0, 100, false /* retransmit */);
+    window.requestSent(2, 0, 300, false /* retransmit */);
+    QVERIFY(window.isOutstanding(kComponentId, 0));
+    QVERIFY(window.isOutstanding(2, 0));
+    QVERIFY(!window.isOutstanding(kComponentId, 1));
+
+    QCOMPARE(window.msecsToNextExpiry(100), qint64(1000));
+    QCOMPARE(window.msecsToNextExpiry(1200), qint64(0));
+
+    const QList<ParameterRequestWindow::Request> expired = window.takeExpired(1200);
+    QCOMPARE(expired.count(), 1);
+    QCOMPARE(expired.first(), ParameterRequestWindow::Request(kComponentId, 0));
+    QCOMPARE(window.msecsToNextExpiry(1200), qint64(100));
+
+    QVERIFY(window.responseReceived(2, 0, 1250));
+    QCOMPARE(window.msecsToNextExpiry(1250), qint64(-1));
+}
+
+UT_REGISTER_TEST(ParameterRequestWindowTest, TestLabel::Unit)
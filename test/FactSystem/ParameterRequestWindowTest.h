@@ -0,0 +1,17 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class ParameterRequestWindowTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _slowStartGrowth_test();
+    void _congestionAvoidanceGrowth_test();
+    void _timeoutShrinksWindowOncePerWindow_test();
+    void _timeoutFromRoundTrip_test();
+    void _retransmitNotSampled_test();
+    void _consecutiveTimeoutsBackOff_test();
+    void _nextExpiry_test();
+};
@@ -16,6 +16,10 @@ ElevationTilePyramid::Grid makeGrid(float height, int size = 4)
     return grid;
 }
 
+/// Budget holding exactly kCapTiles default-sized grids
+constexpr int kCapTiles = 128;
+const qint64 kCapBudgetBytes = kCapTiles * ElevationTilePyramid::gridBytes(makeGrid(0.0f));
+
 }  // namespace
 
 void ElevationTilePyramidTest::_emptyPyramidHasNoView()
@@ -154,26 +158,51 @@ void ElevationTilePyramidTest::_insertReplacesTile()
 
 void ElevationTilePyramidTest::_lruEvictionAtCap()
 {
-    ElevationTilePyramid pyramid;
-    for (int i = 0; i < ElevationTilePyramid::kMaxTiles; i++) {
+    ElevationTilePyramid pyramid(kCapBudgetBytes);
+    for (int i = 0; i < kCapTiles; i++) {
         QVERIFY(pyramid.insertTile(TileMath::TileKey{i, 0, 8}, makeGrid(float(i))));
     }
-    QCOMPARE(pyramid.tileCount(), ElevationTilePyramid::kMaxTiles);
+    QCOMPARE(pyramid.tileCount(), kCapTiles);
 
     // Touch the oldest tile so it is no longer least-recently-used
     QVERIFY(pyramid.bestTileFor(TileMath::TileKey{0, 0, 8}).isValid());
 
     // Inserting past the cap evicts the least-recently-used tile ({1,0,8})
     QVERIFY(pyramid.insertTile(TileMath::TileKey{200, 0, 8}, makeGrid(1.0f)));
-    QCOMPARE(pyramid.tileCount(), ElevationTilePyramid::kMaxTiles);
+    QCOMPARE(pyramid.tileCount(), kCapTiles);
     QVERIFY(pyramid.hasTile(TileMath::TileKey{0, 0, 8}));
     QVERIFY(!pyramid.hasTile(TileMath::TileKey{1, 0, 8}));
     QVERIFY(pyramid.hasTile(TileMath::TileKey{200, 0, 8}));
 
     // Replacing an existing key stays at the cap without evicting others
     QVERIFY(pyramid.insertTile(TileMath::TileKey{200, 0, 8}, makeGrid(2.0f)));
-    QCOMPARE(pyramid.tileCount(), ElevationTilePyramid::kMaxTiles);
+    QCOMPARE(pyramid.tileCount(), kCapTiles);
     QVERIFY(pyramid.hasTile(TileMath::TileKey{2, 0, 8}));
+    QCOMPARE(pyramid.byteCount(), kCapBudgetBytes);
+}
+
+void ElevationTilePyramidTest::_byteBudgetEvictsBySize()
+{
+    // The budget counts samples, not tiles: one large grid displaces as many
+    // small least-recently-used grids as it needs room for
+    ElevationTilePyramid pyramid(kCapBudgetBytes);
+    for (int i = 0; i < kCapTiles; i++) {
+        QVERIFY(pyramid.insertTile(TileMath::TileKey{i, 0, 8}, makeGrid(1.0f)));
+    }
+
+    QList<TileMath::TileKey> evicted;
+    QVERIFY(pyramid.insertTile(TileMath::TileKey{200, 0, 8}, makeGrid(2.0f, 8), &evicted));
+    const QList<TileMath::TileKey> expected{{0, 0, 8}, {1, 0, 8}, {2, 0, 8}, {3, 0, 8}};
+    QCOMPARE(evicted, expected);
+    QCOMPARE(pyramid.tileCount(), kCapTiles - 3);
+    QCOMPARE(pyramid.byteCount(), kCapBudgetBytes);
+
+    // A tile larger than the whole budget is still stored, alone
+    evicted.clear();
+    QVERIFY(pyramid.insertTile(TileMath::TileKey{201, 0, 8}, makeGrid(3.0f, 64), &evicted));
+    QCOMPARE(pyramid.tileCount(), 1);
+    QCOMPARE(evicted.count(), kCapTiles - 3);
+    QVERIFY(pyramid.hasTile(TileMath::TileKey{201, 0, 8}));
 }
 
 void ElevationTilePyramidTest::_pinnedTilesSurviveEviction()
@@ -181,8 +210,8 @@ void ElevationTilePyramidTest::_pinnedTilesSurviveEviction()
     // Pinned tiles back rendered patches (and the ancestors resolving them):
     // evicting them yanks data out from under a visible mesh, so LRU pressure
     // must fall on unpinned tiles only — regardless of recency
-    ElevationTilePyramid pyramid;
-    for (int i = 0; i < ElevationTilePyramid::kMaxTiles; i++) {
+    ElevationTilePyramid pyramid(kCapBudgetBytes);
+    for (int i = 0; i < kCapTiles; i++) {
         QVERIFY(pyramid.insertTile(TileMath::TileKey{i, 0, 8}, makeGrid(float(i))));
     }
 
@@ -191,26 +220,33 @@ void ElevationTilePyramidTest::_pinnedTilesSurviveEviction()
 
     QVERIFY(pyramid.insertTile(TileMath::TileKey{200, 0, 8}, makeGrid(1.0f)));
     QVERIFY(pyramid.insertTile(TileMath::TileKey{201, 0, 8}, makeGrid(1.0f)));
-    QCOMPARE(pyramid.tileCount(), ElevationTilePyramid::kMaxTiles);
+    QCOMPARE(pyramid.tileCount(), kCapTiles);
     QVERIFY(pyramid.hasTile(TileMath::TileKey{0, 0, 8}));
     QVERIFY(pyramid.hasTile(TileMath::TileKey{1, 0, 8}));
     QVERIFY(!pyramid.hasTile(TileMath::TileKey{2, 0, 8}));
     QVERIFY(!pyramid.hasTile(TileMath::TileKey{3, 0, 8}));
 
-    // Unpinning makes them ordinary LRU victims again
+    // Unpinning makes them ordinary LRU victims again. They were in use while
+    // pinned, so they go once the rest of the working set has turned over
     pyramid.setPinnedKeys({});
     QVERIFY(pyramid.insertTile(TileMath::TileKey{202, 0, 8}, makeGrid(1.0f)));
+    QVERIFY(pyramid.hasTile(TileMath::TileKey{0, 0, 8}));
+    QVERIFY(!pyramid.hasTile(TileMath::TileKey{4, 0, 8}));
+    for (int i = 0; i < kCapTiles; i++) {
+        QVERIFY(pyramid.insertTile(TileMath::TileKey{i, 1, 8}, makeGrid(1.0f)));
+    }
     QVERIFY(!pyramid.hasTile(TileMath::TileKey{0, 0, 8}));
+    QVERIFY(!pyramid.hasTile(TileMath::TileKey{1, 0, 8}));
 }
 
 void ElevationTilePyramidTest::_allPinnedGrowsPastCap()
 {
-    // kMaxTiles is a soft cap: when every resident tile is pinned, inserts
+    // The budget is a soft cap: when every resident tile is pinned, inserts
     // must still succeed (grow past the cap) rather than break a rendered
     // patch — the alternative is a cliff
-    ElevationTilePyramid pyramid;
+    ElevationTilePyramid pyramid(kCapBudgetBytes);
     QSet<TileMath::TileKey> pinned;
-    for (int i = 0; i < ElevationTilePyramid::kMaxTiles; i++) {
+    for (int i = 0; i < kCapTiles; i++) {
         const TileMath::TileKey key{i, 0, 8};
         QVERIFY(pyramid.insertTile(key, makeGrid(1.0f)));
         pinned.insert(key);
@@ -218,20 +254,20 @@ void ElevationTilePyramidTest::_allPinnedGrowsPastCap()
     pyramid.setPinnedKeys(pinned);
 
     QVERIFY(pyramid.insertTile(TileMath::TileKey{200, 0, 8}, makeGrid(1.0f)));
-    QCOMPARE(pyramid.tileCount(), ElevationTilePyramid::kMaxTiles + 1);
-    for (int i = 0; i < ElevationTilePyramid::kMaxTiles; i++) {
+    QCOMPARE(pyramid.tileCount(), kCapTiles + 1);
+    for (int i = 0; i < kCapTiles; i++) {
         QVERIFY(pyramid.hasTile(TileMath::TileKey{i, 0, 8}));
     }
 
     // Pressure releases once pins clear: the next insert trims back via LRU
     pyramid.setPinnedKeys({});
     QVERIFY(pyramid.insertTile(TileMath::TileKey{201, 0, 8}, makeGrid(1.0f)));
-    QCOMPARE_LE(pyramid.tileCount(), ElevationTilePyramid::kMaxTiles + 1);
+    QCOMPARE_LE(pyramid.tileCount(), kCapTiles + 1);
 }
 
 void ElevationTilePyramidTest::_descendantTracking()
 {
-    ElevationTilePyramid pyramid;
+    ElevationTilePyramid pyramid(kCapBudgetBytes);
 
     // {20,24,5} sits under {5,6,3} via {10,12,4}: every ancestor sees it
     QVERIFY(pyramid.insertTile(TileMath::TileKey{20, 24, 5}, makeGrid(1.0f)));
@@ -248,14 +284,54 @@ void ElevationTilePyramidTest::_descendantTracking()
 
     // Evicting the whole {0,0,1} subtree clears its descendant marks: fill
     // the cap under {0,0,1}, then displace it all with the {1,1,1} subtree
-    for (int i = 0; i < ElevationTilePyramid::kMaxTiles; i++) {
+    for (int i = 0; i < kCapTiles; i++) {
         QVERIFY(pyramid.insertTile(TileMath::TileKey{i, 0, 8}, makeGrid(1.0f)));
     }
-    for (int i = 0; i < ElevationTilePyramid::kMaxTiles; i++) {
+    for (int i = 0; i < kCapTiles; i++) {
         QVERIFY(pyramid.insertTile(TileMath::TileKey{128 + i, 128, 8}, makeGrid(1.0f)));
     }
     QVERIFY(!pyramid.hasDescendant(TileMath::TileKey{0, 0, 1}));
     QVERIFY(pyramid.hasDescendant(TileMath::TileKey{1, 1, 1}));
 }
 
+void ElevationTilePyramidTest::_benchmarkInsertEvict()
+{
+    // Steep-pitch working set: 4096 resident 256x256 tiles, a quarter of them
+    // pinned by rendered patches, under a stream of inserts that each evict
+    constexpr int kResidentTiles = 4096;
+    constexpr int kPinnedTiles = kResidentTiles / 4;
+    constexpr int kInserts = 4 * kResidentTiles;
+    constexpr int kGridSize = 256;
+
+    // Tiles share the samples of one grid: the budget is charged per tile,
+    // the test process is not
+    const ElevationTilePyramid::Grid grid = makeGrid(1.0f, kGridSize);
+    ElevationTilePyramid pyramid(kResidentTiles * ElevationTilePyramid::gridBytes(grid));
+
+    // Keys spread over zoom 14 rows so ancestor bookkeeping is exercised too
+    const auto keyAt = [](int index) { return TileMath::TileKey{index % 1024, index / 1024, 14}; };
+
+    QSet<TileMath::TileKey> pinned;
+    for (int i = 0; i < kResidentTiles; i++) {
+        QVERIFY(pyramid.insertTile(keyAt(i), grid));
+        if (i < kPinnedTiles) {
+            pinned.insert(keyAt(i));
+        }
+    }
+    pyramid.setPinnedKeys(pinned);
+
+    int next = kResidentTiles;
+    QBENCHMARK {
+        for (int i = 0; i < kInserts; i++) {
+            (void) pyramid.insertTile(keyAt(next++), grid);
+            (void) pyramid.bestTileFor(keyAt(next - (kResidentTiles / 2)));
+        }
+    }
+
+    QCOMPARE(pyramid.tileCount(), kResidentTiles);
+    for (const TileMath::TileKey& key : std::as_const(pinned)) {
+        QVERIFY(pyramid.hasTile(key));
+    }
+}
+
 UT_REGISTER_TEST_LIGHTWEIGHT(ElevationTilePyramidTest, TestLabel::Unit)
@@ -17,7 +17,9 @@ private slots:
     void _subWindowDeepZoom();
     void _insertReplacesTile();
     void _lruEvictionAtCap();
+    void _byteBudgetEvictsBySize();
     void _pinnedTilesSurviveEviction();
     void _allPinnedGrowsPastCap();
     void _descendantTracking();
+    void _benchmarkInsertEvict();
 };
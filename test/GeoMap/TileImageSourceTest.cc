@@ -12,6 +12,7 @@
 #include <cstring>
 
 #include "QGCMapUrlEngine.h"
+#include "QGCTileImageCache.h"
 #include "QGeoFileTileCacheQGC.h"
 #include "TileImageSource.h"
 #include "TileMath.h"
@@ -122,6 +123,14 @@ QByteArray pngBody()
 
 }  // namespace
 
+void TileImageSourceTest::init()
+{
+    UnitTest::init();
+
+    // Decoded images outlive a test: start every test from the tile database
+    QGCTileImageCache::instance()->clear();
+}
+
 void TileImageSourceTest::_tileDelivered()
 {
     const QString type = mapType();
@@ -225,7 +234,8 @@ void TileImageSourceTest::_networkFallbackDeliversAndCaches()
 
     // Two forced generator misses: the first request must fall back to the
     // network; the second must be served by the write-back cached tile (the
-    // DB hit precedes the generator, so the second miss stays unconsumed)
+    // decoded image cache and the DB hit precede the generator, so the second
+    // miss stays unconsumed)
     UnitTestTileGenerator::setForcedMissCount(2);
     const auto guard = qScopeGuard([] { UnitTestTileGenerator::setForcedMissCount(0); });
 
@@ -408,4 +418,41 @@ void TileImageSourceTest::_cancelAbortsNetworkFetch()
     QVERIFY(failedSpy.isEmpty());
 }
 
+void TileImageSourceTest::_decodedImageCacheServesAndPins()
+{
+    const QString type = mapType();
+    QVERIFY2(!type.isEmpty(), "no non-elevation map provider registered");
+    const TileMath::TileKey key{kKey.x + 20, kKey.y, kKey.zoom};
+    const QGCTileImageCache::Key cacheKey{UrlFactory::getQtMapIdFromProviderType(type), key.x, key.y, key.zoom};
+
+    TileImageSource source(type);
+    QSignalSpy readySpy(&source, &TileImageSource::tileImageReady);
+    QVERIFY(!source.pinTile(key));  // nothing decoded yet
+
+    source.requestTileImage(key);
+    QTRY_COMPARE_WITH_TIMEOUT(readySpy.count(), 1, 5000);
+    const QImage delivered = readySpy.first().at(1).value<QImage>();
+    QCOMPARE(QGCTileImageCache::instance()->image(cacheKey).cacheKey(), delivered.cacheKey());
+
+    // Another consumer gets the same pixels without a lookup or network fetch
+    MockNam nam;
+    nam.error = QNetworkReply::ContentNotFoundError;
+    TileImageSource other(type, nullptr, &nam);
+    QSignalSpy otherReadySpy(&other, &TileImageSource::tileImageReady);
+    const int requestId = other.requestTileImage(key);
+    QCOMPARE(other.pendingCount(), 1);  // still delivered asynchronously
+    QTRY_COMPARE_WITH_TIMEOUT(otherReadySpy.count(), 1, 5000);
+    QCOMPARE(otherReadySpy.first().at(0).toInt(), requestId);
+    QCOMPARE(otherReadySpy.first().at(1).value<QImage>().cacheKey(), delivered.cacheKey());
+    QCOMPARE(nam.requestCount, 0);
+
+    // A pinned tile survives the cache being trimmed
+    QVERIFY(source.pinTile(key));
+    QGCTileImageCache::instance()->clear();
+    QVERIFY(!QGCTileImageCache::instance()->image(cacheKey).isNull());
+    source.unpinTile(key);
+    QGCTileImageCache::instance()->clear();
+    QVERIFY(QGCTileImageCache::instance()->image(cacheKey).isNull());
+}
+
 UT_REGISTER_TEST(TileImageSourceTest, TestLabel::Integration)
@@ -6,6 +6,9 @@ class TileImageSourceTest : public UnitTest
 {
     Q_OBJECT
 
+protected slots:
+    void init() override;
+
 private slots:
     void _tileDelivered();
     void _cancelledRequestSilent();
@@ -18,4 +21,5 @@ private slots:
     void _bingPlaceholderNotDelivered();
     void _cachedUnusableTileFallsBackToNetwork();
     void _cancelAbortsNetworkFetch();
+    void _decodedImageCacheServesAndPins();
 };
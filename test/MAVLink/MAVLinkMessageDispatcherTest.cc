@@ -0,0 +1,129 @@
+#include "MAVLinkMessageDispatcherTest.h"
+
+#include "MAVLinkLib.h"
+#include "MAVLinkMessageDispatcher.h"
+
+static mavlink_message_t _makeMessage(uint32_t msgId)
+{
+    mavlink_message_t message{};
+    message.msgid = msgId;
+    return message;
+}
+
+void MAVLinkMessageDispatcherTest::_routesByMsgId_test()
+{
+    MAVLinkMessageDispatcher dispatcher;
+    int heartbeatCount = 0;
+    int attitudeCount = 0;
+
+    (void) dispatcher.subscribe({MAVLINK_MSG_ID_HEARTBEAT}, [&heartbeatCount](const mavlink_message_t &) { heartbeatCount++; });
+    (void) dispatcher.subscribe({MAVLINK_MSG_ID_ATTITUDE, MAVLINK_MSG_ID_ATTITUDE_QUATERNION}, [&attitudeCount](const mavlink_message_t &) { attitudeCount++; });
+
+    dispatcher.dispatch(_makeMessage(MAVLINK_MSG_ID_HEARTBEAT));
+    dispatcher.dispatch(_makeMessage(MAVLINK_MSG_ID_ATTITUDE));
+    dispatcher.dispatch(_makeMessage(MAVLINK_MSG_ID_ATTITUDE_QUATERNION));
+    dispatcher.dispatch(_makeMessage(MAVLINK_MSG_ID_VFR_HUD));
+
+    QCOMPARE(heartbeatCount, 1);
+    QCOMPARE(attitudeCount, 2);
+    QCOMPARE(dispatcher.handlerCount(MAVLINK_MSG_ID_VFR_HUD), 0);
+    QCOMPARE(dispatcher.handlerCount(MAVLINK_MSG_ID_ATTITUDE), 1);
+}
+
+void MAVLinkMessageDispatcherTest::_wildcardKeepsSubscriptionOrder_test()
+{
+    MAVLinkMessageDispatcher dispatcher;
+    QStringList calls;
+
+    (void) dispatcher.subscribe({MAVLINK_MSG_ID_ATTITUDE}, [&calls](const mavlink_message_t &) { calls.append(QStringLiteral("first")); });
+    (void) dispatcher.subscribe({}, [&calls](const mavlink_message_t &) { calls.append(QStringLiteral("wildcard")); });
+    (void) dispatcher.subscribe({MAVLINK_MSG_ID_ATTITUDE}, [&calls](const mavlink_message_t &) { calls.append(QStringLiteral("last")); });
+
+    dispatcher.dispatch(_makeMessage(MAVLINK_MSG_ID_ATTITUDE));
+    QCOMPARE(calls, QStringList({QStringLiteral("first"), QStringLiteral("wildcard"), QStringLiteral("last")}));
+
+    calls.clear();
+    dispatcher.dispatch(_makeMessage(MAVLINK_MSG_ID_HEARTBEAT));
+    QCOMPARE(calls, QStringList({QStringLiteral("wildcard")}));
+}
+
+void MAVLinkMessageDispatcherTest::_unsubscribe_test()
+{
+    MAVLinkMessageDispatcher dispatcher;
+    int count = 0;
+
+    const MAVLinkMessageDispatcher::HandlerId handlerId = dispatcher.subscribe({MAVLINK_MSG_ID_HEARTBEAT}, [&count](const mavlink_message_t &) { count++; });
+    dispatcher.dispatch(_makeMessage(MAVLINK_MSG_ID_HEARTBEAT));
+    QCOMPARE(count, 1);
+
+    dispatcher.unsubscribe(handlerId);
+    dispatcher.dispatch(_makeMessage(MAVLINK_MSG_ID_HEARTBEAT));
+    QCOMPARE(count, 1);
+    QCOMPARE(dispatcher.handlerCount(MAVLINK_MSG_ID_HEARTBEAT), 0);
+}
+
+void MAVLinkMessageDispatcherTest::_unsubscribeDuringDispatch_test()
+{
+    MAVLinkMessageDispatcher dispatcher;
+    int secondCount = 0;
+    MAVLinkMessageDispatcher::HandlerId secondId = 0;
+
+    (void) dispatcher.subscribe({MAVLINK_MSG_ID_HEARTBEAT}, [&dispatcher, &secondId](const mavlink_message_t &) { dispatcher.unsubscribe(secondId); });
+    secondId = dispatcher.subscribe({MAVLINK_MSG_ID_HEARTBEAT}, [&secondCount](const mavlink_message_t &) { secondCount++; });
+
+    dispatcher.dispatch(_makeMessage(MAVLINK_MSG_ID_HEARTBEAT));
+    QCOMPARE(secondCount, 0);
+    QCOMPARE(dispatcher.handlerCount(MAVLINK_MSG_ID_HEARTBEAT), 1);
+}
+
+void MAVLinkMessageDispatcherTest::_subscribeDuringDispatch_test()
+{
+    MAVLinkMessageDispatcher dispatcher;
+    int lateCount = 0;
+    bool subscribed = false;
+
+    (void) dispatcher.subscribe({MAVLINK_MSG_ID_HEARTBEAT}, [&](const mavlink_message_t &) {
+        if (!subscribed) {
+            subscribed = true;
+            (void) dispatcher.subscribe({MAVLINK_MSG_ID_HEARTBEAT}, [&lateCount](const mavlink_message_t &) { lateCount++; });
+        }
+    });
+
+    dispatcher.dispatch(_makeMessage(MAVLINK_MSG_ID_HEARTBEAT));
+    QCOMPARE(lateCount, 0);
+
+    dispatcher.dispatch(_makeMessage(MAVLINK_MSG_ID_HEARTBEAT));
+    QCOMPARE(lateCount, 1);
+}
+
+void MAVLinkMessageDispatcherTest::_nestedDispatch_test()
+{
+    MAVLinkMessageDispatcher dispatcher;
+    int innerCount = 0;
+
+    // Resolving a new msgid from within a handler must not disturb the list being iterated
+    (void) dispatcher.subscribe({MAVLINK_MSG_ID_HEARTBEAT}, [&dispatcher](const mavlink_message_t &) {
+        for (uint32_t msgId = MAVLINK_MSG_ID_SYS_STATUS; msgId < MAVLINK_MSG_ID_SYS_STATUS + 64; msgId++) {
+            dispatcher.dispatch(_makeMessage(msgId));
+        }
+    });
+    (void) dispatcher.subscribe({}, [&innerCount](const mavlink_message_t &) { innerCount++; });
+
+    dispatcher.dispatch(_makeMessage(MAVLINK_MSG_ID_HEARTBEAT));
+    QCOMPARE(innerCount, 65);
+}
+
+void MAVLinkMessageDispatcherTest::_largeMsgId_test()
+{
+    MAVLinkMessageDispatcher dispatcher;
+    constexpr uint32_t largeMsgId = 0xFFFFFF;
+    int count = 0;
+
+    (void) dispatcher.subscribe({largeMsgId}, [&count](const mavlink_message_t &) { count++; });
+    dispatcher.dispatch(_makeMessage(largeMsgId));
+    dispatcher.dispatch(_makeMessage(MAVLINK_MSG_ID_HEARTBEAT));
+
+    QCOMPARE(count, 1);
+}
+
+UT_REGISTER_TEST(MAVLinkMessageDispatcherTest, TestLabel::Unit)
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class MAVLinkMessageDispatcherTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _routesByMsgId_test();
+    void _wildcardKeepsSubscriptionOrder_test();
+    void _unsubscribe_test();
+    void _unsubscribeDuringDispatch_test();
+    void _subscribeDuringDispatch_test();
+    void _nestedDispatch_test();
+    void _largeMsgId_test();
+};
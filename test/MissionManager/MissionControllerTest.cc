@@ -17,6 +17,7 @@
 #include "MultiSignalSpy.h"
 
 #include <QtCore/QRegularExpression>
+#include <QtTest/QSignalSpy>
 #include <QtCore/QTemporaryDir>
 using namespace TestFixtures;
 
@@ -133,6 +134,66 @@ void MissionControllerTest::_testInsertValidityHomePositionGating()
     QCOMPARE(boolProperty("flyThroughCommandsAllowed"), true);
 }
 
+void MissionControllerTest::_testIncrementalFlightPathRecalc()
+{
+    _initForFirmwareType(MAV_AUTOPILOT_PX4);
+    const int cWaypoints = 10;
+    const QList<QGeoCoordinate> waypoints = Coord::waypointPath(Coord::zurich(), cWaypoints);
+    for (int i = 0; i < waypoints.count(); ++i) {
+        _missionController->insertSimpleMissionItem(waypoints[i], i + 1);
+    }
+    QmlObjectListModel* visualItems = _missionController->visualItems();
+    QmlObjectListModel* segments = _missionController->simpleFlightPathSegments();
+    QVERIFY_TRUE_WAIT(segments->count() == cWaypoints - 1 && _missionController->missionTotalDistance() > 0, TestTimeout::mediumMs());
+
+    QList<QObject*> segmentsBefore;
+    for (int i = 0; i < segments->count(); i++) {
+        segmentsBefore.append(segments->get(i));
+    }
+    const double totalDistanceBefore = _missionController->missionTotalDistance();
+
+    QSignalSpy resetSpy(segments, &QAbstractItemModel::modelReset);
+    QSignalSpy removedSpy(segments, &QAbstractItemModel::rowsRemoved);
+    QSignalSpy insertedSpy(segments, &QAbstractItemModel::rowsInserted);
+
+    // Move a single waypoint near the end of the mission
+    const int movedIndex = cWaypoints - 1;
+    VisualMissionItem* movedItem = visualItems->value<VisualMissionItem*>(movedIndex);
+    movedItem->setCoordinate(movedItem->coordinate().atDistanceAndAzimuth(500, 90));
+    QVERIFY_TRUE_WAIT(!qFuzzyCompare(_missionController->missionTotalDistance(), totalDistanceBefore), TestTimeout::mediumMs());
+
+    // Segments are updated in place, the models are neither reset nor rebuilt
+    QCOMPARE(segments->count(), segmentsBefore.count());
+    for (int i = 0; i < segments->count(); i++) {
+        QCOMPARE(segments->get(i), segmentsBefore[i]);
+    }
+    QCOMPARE(resetSpy.count(), 0);
+    QCOMPARE(removedSpy.count(), 0);
+    QCOMPARE(insertedSpy.count(), 0);
+
+    // Incremental totals must match what a full walk produces
+    double expectedDistance = 0;
+    for (int i = 2; i < visualItems->count(); i++) {
+        VisualMissionItem* prevItem = visualItems->value<VisualMissionItem*>(i - 1);
+        VisualMissionItem* item = visualItems->value<VisualMissionItem*>(i);
+        const double distance = prevItem->exitCoordinate().distanceTo(item->entryCoordinate());
+        expectedDistance += distance;
+        QVERIFY(qAbs(item->distance() - distance) < kCoordToleranceMeters);
+        QVERIFY(qAbs(item->distanceFromStart() - expectedDistance) < kCoordToleranceMeters);
+    }
+    QVERIFY(qAbs(_missionController->missionTotalDistance() - expectedDistance) < kCoordToleranceMeters);
+
+    // Removing an item replaces only the segments touching it
+    const int removedIndex = movedIndex - 1;
+    _missionController->removeVisualItem(removedIndex);
+    QVERIFY_TRUE_WAIT(segments->count() == cWaypoints - 2, TestTimeout::mediumMs());
+    for (int i = 0; i < removedIndex - 2; i++) {
+        QCOMPARE(segments->get(i), segmentsBefore[i]);
+    }
+    QVERIFY(segments->get(removedIndex - 2) != segmentsBefore[removedIndex - 2]);
+    QCOMPARE(segments->get(segments->count() - 1), segmentsBefore.last());
+}
+
 void MissionControllerTest::_testGimbalRecalc()
 {
     _initForFirmwareType(MAV_AUTOPILOT_PX4);
@@ -336,4 +336,50 @@ void SurveyComplexItemTest::_testMaxTransectCount()
     }
 }
 
+void SurveyComplexItemTest::_testBackgroundTransectBuild()
+{
+    // Reference result for the final settings, built synchronously
+    _surveyItem->gridAngle()->setRawValue(45);
+    const QVariantList expectedPoints = _surveyItem->visualTransectPoints();
+    const int expectedTransectCount = _surveyItem->_transectCount();
+    _surveyItem->gridAngle()->setRawValue(0);
+
+    _surveyItem->_setBackgroundTransectBuild(true);
+    QSignalSpy pointsSpy(_surveyItem, &TransectStyleComplexItem::visualTransectPointsChanged);
+
+    // Every edit supersedes the build started by the previous one
+    _surveyItem->gridAngle()->setRawValue(10);
+    _surveyItem->gridAngle()->setRawValue(30);
+    _surveyItem->gridAngle()->setRawValue(45);
+    QVERIFY(_surveyItem->transectBuildPending());
+    QCOMPARE(pointsSpy.count(), 0);
+
+    QVERIFY_TRUE_WAIT(!_surveyItem->transectBuildPending(), TestTimeout::mediumMs());
+
+    // Only the latest build is applied
+    QCOMPARE(pointsSpy.count(), 1);
+    QCOMPARE(_surveyItem->_transectCount(), expectedTransectCount);
+    QCOMPARE(_surveyItem->visualTransectPoints(), expectedPoints);
+}
+
+void SurveyComplexItemTest::_testBackgroundTransectBuildWait()
+{
+    _surveyItem->_setBackgroundTransectBuild(true);
+    _surveyItem->turnAroundDistance()->setRawValue(_surveyItem->turnAroundDistance()->rawValue().toDouble() + 10);
+    QVERIFY(_surveyItem->transectBuildPending());
+
+    // Mission item generation must see the latest settings, so it applies the pending build right away
+    QList<MissionItem*> items;
+    _surveyItem->appendMissionItems(items, this);
+    QVERIFY(!_surveyItem->transectBuildPending());
+    QCOMPARE(_surveyItem->_transectCount(), _expectedTransectCount);
+    QCOMPARE(items.count() - 1, _surveyItem->lastSequenceNumber());
+    QCOMPARE(items.first()->command(), MAV_CMD_NAV_WAYPOINT);
+
+    // The finished signal of the applied build is ignored
+    QSignalSpy pointsSpy(_surveyItem, &TransectStyleComplexItem::visualTransectPointsChanged);
+    QTest::qWait(TestTimeout::shortMs());
+    QCOMPARE(pointsSpy.count(), 0);
+}
+
 UT_REGISTER_TEST(SurveyComplexItemTest, TestLabel::Unit, TestLabel::MissionManager)
@@ -30,6 +30,8 @@ private slots:
     void _testItemCount();
     void _testHoverCaptureItemGeneration();
     void _testMaxTransectCount();
+    void _testBackgroundTransectBuild();
+    void _testBackgroundTransectBuildWait();
 
 private:
     double _clampGridAngle180(double gridAngle);
@@ -1,5 +1,6 @@
 #include "QGCCacheWorkerTest.h"
 
+#include <QtCore/QPointer>
 #include <QtCore/QTemporaryDir>
 #include <QtPositioning/QGeoCoordinate>
 #include <QtTest/QTest>
@@ -108,7 +109,7 @@ void QGCCacheWorkerTest::_testSaveAndFetchTile()
         new QGCCacheTile(QStringLiteral("h1"), QByteArray("tile_data"), QStringLiteral("png"), kTestProviderType);
     QVERIFY(worker.enqueueTask(new QGCSaveTileTask(tile)));
 
-    // Fetch — FIFO guarantees save completes first
+    // Fetch — served from the queued save if it has not been committed yet
     auto* fetchTask = new QGCFetchTileTask(QStringLiteral("h1"));
     QGCCacheTile* fetched = nullptr;
     bool fetchError = false;
@@ -132,6 +133,96 @@ void QGCCacheWorkerTest::_testSaveAndFetchTile()
     worker.wait(TestTimeout::mediumMs());
 }
 
+void QGCCacheWorkerTest::_testSaveTileBatch()
+{
+    QTemporaryDir tempDir;
+    QGCCacheWorker worker;
+    worker.setDatabaseFile(tempDir.filePath("save_batch.db"));
+    QVERIFY(_startWorker(worker));
+
+    // Queued saves are drained into shared transactions; each task still reports its own result
+    constexpr int tileCount = 300;
+    int saveErrors = 0;
+    for (int i = 0; i < tileCount; i++) {
+        auto* tile = new QGCCacheTile(QStringLiteral("batch_%1").arg(i), QByteArray(50, 'B'), QStringLiteral("png"),
+                                      kTestProviderType);
+        auto* saveTask = new QGCSaveTileTask(tile);
+        connect(
+            saveTask, &QGCMapTask::error, this, [&](QGCMapTask::TaskType, const QString&) { saveErrors++; },
+            Qt::QueuedConnection);
+        QVERIFY(worker.enqueueTask(saveTask));
+    }
+
+    for (const int i : { 0, tileCount - 1 }) {
+        auto* fetchTask = new QGCFetchTileTask(QStringLiteral("batch_%1").arg(i));
+        QGCCacheTile* fetched = nullptr;
+        bool fetchError = false;
+        connect(
+            fetchTask, &QGCFetchTileTask::tileFetched, this, [&](QGCCacheTile* t) { fetched = t; }, Qt::QueuedConnection);
+        connect(
+            fetchTask, &QGCMapTask::error, this, [&](QGCMapTask::TaskType, const QString&) { fetchError = true; },
+            Qt::QueuedConnection);
+
+        QVERIFY(worker.enqueueTask(fetchTask));
+        QTRY_VERIFY_WITH_TIMEOUT(fetched || fetchError, TestTimeout::mediumMs());
+
+        QVERIFY2(fetched != nullptr, "Expected batched tile to be fetched");
+        QCOMPARE(fetched->hash, QStringLiteral("batch_%1").arg(i));
+        delete fetched;
+    }
+    QCOMPARE(saveErrors, 0);
+
+    worker.stop();
+    worker.wait(TestTimeout::mediumMs());
+}
+
+void QGCCacheWorkerTest::_testFetchNotBlockedBySaves()
+{
+    QTemporaryDir tempDir;
+    QGCCacheWorker worker;
+    worker.setDatabaseFile(tempDir.filePath("fetch_during_saves.db"));
+    QVERIFY(_startWorker(worker));
+
+    auto* tile =
+        new QGCCacheTile(QStringLiteral("early"), QByteArray("early_data"), QStringLiteral("png"), kTestProviderType);
+    QVERIFY(worker.enqueueTask(new QGCSaveTileTask(tile)));
+    bool totalsReceived = false;
+    auto totalsConn =
+        connect(&worker, &QGCCacheWorker::updateTotals, this, [&]() { totalsReceived = true; }, Qt::QueuedConnection);
+    QVERIFY(worker.enqueueTask(new QGCMapTask(QGCMapTask::TaskType::taskInit)));
+    QTRY_VERIFY_WITH_TIMEOUT(totalsReceived, TestTimeout::mediumMs());
+    disconnect(totalsConn);
+
+    // Queue far more saves than one batch, the fetch behind them must not wait for their transactions
+    constexpr int tileCount = 10000;
+    QPointer<QGCMapTask> lastSave;
+    for (int i = 0; i < tileCount; i++) {
+        auto* saveTile = new QGCCacheTile(QStringLiteral("flood_%1").arg(i), QByteArray(2048, 'F'),
+                                          QStringLiteral("png"), kTestProviderType);
+        lastSave = new QGCSaveTileTask(saveTile);
+        QVERIFY(worker.enqueueTask(lastSave));
+    }
+
+    auto* fetchTask = new QGCFetchTileTask(QStringLiteral("early"));
+    QGCCacheTile* fetched = nullptr;
+    bool fetchError = false;
+    connect(
+        fetchTask, &QGCFetchTileTask::tileFetched, this, [&](QGCCacheTile* t) { fetched = t; }, Qt::QueuedConnection);
+    connect(
+        fetchTask, &QGCMapTask::error, this, [&](QGCMapTask::TaskType, const QString&) { fetchError = true; },
+        Qt::QueuedConnection);
+    QVERIFY(worker.enqueueTask(fetchTask));
+    QTRY_VERIFY_WITH_TIMEOUT(fetched || fetchError, TestTimeout::mediumMs());
+
+    QVERIFY2(fetched != nullptr, "Expected committed tile to be fetched");
+    QCOMPARE(fetched->img, QByteArray("early_data"));
+    delete fetched;
+    QVERIFY2(!lastSave.isNull(), "Fetch only finished after every queued save was written");
+
+    worker.stop();
+    worker.wait(TestTimeout::longMs());
+}
+
 void QGCCacheWorkerTest::_testFetchTileNotFound()
 {
     QTemporaryDir tempDir;
@@ -14,6 +14,8 @@ private slots:
     void _testEnqueueBeforeInit();
     void _testUpdateTotalsOnInit();
     void _testSaveAndFetchTile();
+    void _testSaveTileBatch();
+    void _testFetchNotBlockedBySaves();
     void _testFetchTileNotFound();
     void _testFetchMapTileMissServesFakeTile();
     void _testFetchElevationTileMissServesSyntheticTerrain();
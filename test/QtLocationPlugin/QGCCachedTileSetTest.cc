@@ -1,8 +1,85 @@
 #include "QGCCachedTileSetTest.h"
 #include "PropertyTestHelper.h"
+#include <QtCore/QScopeGuard>
+#include <QtCore/QSharedPointer>
+#include <QtNetwork/QTcpServer>
+#include <QtNetwork/QTcpSocket>
 #include <QtTest/QSignalSpy>
 
+#include <memory>
+
+#include "AppSettings.h"
+#include "Fact.h"
+#include "LocalHttpTestServer.h"
 #include "QGCCachedTileSet.h"
+#include "QGCMapEngine.h"
+#include "QGCMapTasks.h"
+#include "QGCMapUrlEngine.h"
+#include "QGCTileSet.h"
+#include "SettingsManager.h"
+
+namespace {
+
+const QString kCustomProviderType = QStringLiteral("CustomURL Custom");
+constexpr int kTestZoom = 12;
+constexpr double kTestAreaSizeDeg = 0.2;
+
+/// Enough of a PNG for the tile format to be recognized
+const QByteArray kTilePayload = QByteArrayLiteral("\x89PNG\r\n\x1a\n" "tile");
+
+} // namespace
+
+QGCCachedTileSet *QGCCachedTileSetTest::_createTileSet(const QString &name, double topleftLat)
+{
+    constexpr double topleftLon = 8.0;
+    const double bottomRightLat = topleftLat - kTestAreaSizeDeg;
+    const double bottomRightLon = topleftLon + kTestAreaSizeDeg;
+    const QGCTileSet tileCount = UrlFactory::getTileCount(kTestZoom, topleftLon, topleftLat, bottomRightLon, bottomRightLat, kCustomProviderType);
+
+    QGCCachedTileSet *const tileSet = new QGCCachedTileSet(name);
+    tileSet->setMapTypeStr(kCustomProviderType);
+    tileSet->setType(kCustomProviderType);
+    tileSet->setTopleftLat(topleftLat);
+    tileSet->setTopleftLon(topleftLon);
+    tileSet->setBottomRightLat(bottomRightLat);
+    tileSet->setBottomRightLon(bottomRightLon);
+    tileSet->setMinZoom(kTestZoom);
+    tileSet->setMaxZoom(kTestZoom);
+    tileSet->setTotalTileCount(static_cast<quint32>(tileCount.tileCount));
+
+    QGCCreateTileSetTask *const task = new QGCCreateTileSetTask(tileSet);
+    QGCCachedTileSet *savedSet = nullptr;
+    (void) connect(task, &QGCCreateTileSetTask::tileSetSaved, this, [&savedSet](QGCCachedTileSet *set) { savedSet = set; }, Qt::QueuedConnection);
+    if (!getQGCMapEngine()->addTask(task)) {
+        return nullptr;
+    }
+    if (!UnitTest::waitForCondition([&savedSet]() { return savedSet != nullptr; }, TestTimeout::mediumMs(), QStringLiteral("tileSetSaved"))) {
+        return nullptr;
+    }
+
+    return savedSet;
+}
+
+int QGCCachedTileSetTest::_remainingDownloads(quint64 setID)
+{
+    QGCUpdateTileDownloadStateTask *const resetTask = new QGCUpdateTileDownloadStateTask(setID, QGCTile::StatePending, QStringLiteral("*"));
+    if (!getQGCMapEngine()->addTask(resetTask)) {
+        return -1;
+    }
+
+    QGCGetTileDownloadListTask *const listTask = new QGCGetTileDownloadListTask(setID, 10000);
+    int remaining = -1;
+    (void) connect(listTask, &QGCGetTileDownloadListTask::tileListFetched, this, [&remaining](QQueue<QGCTile*> tiles) {
+        remaining = static_cast<int>(tiles.size());
+        qDeleteAll(tiles);
+    }, Qt::QueuedConnection);
+    if (!getQGCMapEngine()->addTask(listTask)) {
+        return -1;
+    }
+    (void) UnitTest::waitForCondition([&remaining]() { return remaining >= 0; }, TestTimeout::mediumMs(), QStringLiteral("tileListFetched"));
+
+    return remaining;
+}
 
 void QGCCachedTileSetTest::_testConstructorSetsName()
 {
@@ -245,4 +322,80 @@ void QGCCachedTileSetTest::_testSetSelectedEmitsSignal()
     QVERIFY(!ts.selected());
 }
 
+void QGCCachedTileSetTest::_testCancelAndResumeDownload()
+{
+    TestFixtures::LocalHttpTestServer server;
+    QVERIFY(server.listen());
+    server.installHttpResponder(kTilePayload, 200, "image/png");
+
+    Fact *const customURL = SettingsManager::instance()->appSettings()->customURL();
+    const QVariant savedURL = customURL->rawValue();
+    customURL->setRawValue(server.url(QStringLiteral("/{z}/{x}/{y}.png")));
+    const auto restoreURL = qScopeGuard([customURL, savedURL]() { customURL->setRawValue(savedURL); });
+
+    QGCCachedTileSet *const tileSet = _createTileSet(QStringLiteral("Cancel Resume"), 47.0);
+    QVERIFY(tileSet);
+    const auto deleteSet = qScopeGuard([tileSet]() { delete tileSet; });
+    const quint32 totalTiles = tileSet->totalTileCount();
+    QVERIFY(totalTiles > 1);
+
+    // Cancelled before the first batch arrives: the batch goes back to pending and nothing is downloaded
+    tileSet->createDownloadTask();
+    QVERIFY(tileSet->downloading());
+    tileSet->cancelDownloadTask();
+    QTRY_VERIFY_WITH_TIMEOUT(!tileSet->downloading(), TestTimeout::mediumMs());
+    QCOMPARE(tileSet->savedTileCount(), 0u);
+    QCOMPARE(_remainingDownloads(tileSet->id()), static_cast<int>(totalTiles));
+
+    tileSet->resumeDownloadTask();
+    QTRY_VERIFY_WITH_TIMEOUT(!tileSet->downloading(), TestTimeout::longMs());
+    QCOMPARE(tileSet->errorCount(), 0u);
+    QCOMPARE(tileSet->savedTileCount(), totalTiles);
+    QCOMPARE(_remainingDownloads(tileSet->id()), 0);
+}
+
+void QGCCachedTileSetTest::_testDestroyFlushesTileStates()
+{
+    // Serves the first tile and leaves every later request hanging, so the set is destroyed mid download
+    QTcpServer server;
+    QVERIFY(server.listen(QHostAddress::LocalHost));
+    int connections = 0;
+    (void) connect(&server, &QTcpServer::newConnection, this, [&server, &connections]() {
+        while (server.hasPendingConnections()) {
+            QTcpSocket *const socket = server.nextPendingConnection();
+            if (connections++ > 0) {
+                continue;
+            }
+            const auto request = QSharedPointer<QByteArray>::create();
+            (void) connect(socket, &QTcpSocket::readyRead, socket, [socket, request]() {
+                request->append(socket->readAll());
+                if (!request->contains("\r\n\r\n")) {
+                    return;
+                }
+                (void) socket->write(QByteArrayLiteral("HTTP/1.1 200 OK\r\nContent-Type: image/png\r\nConnection: close\r\nContent-Length: ")
+                                     + QByteArray::number(kTilePayload.size()) + QByteArrayLiteral("\r\n\r\n") + kTilePayload);
+                socket->disconnectFromHost();
+            });
+        }
+    });
+
+    Fact *const customURL = SettingsManager::instance()->appSettings()->customURL();
+    const QVariant savedURL = customURL->rawValue();
+    customURL->setRawValue(QStringLiteral("http://127.0.0.1:%1/{z}/{x}/{y}.png").arg(server.serverPort()));
+    const auto restoreURL = qScopeGuard([customURL, savedURL]() { customURL->setRawValue(savedURL); });
+
+    std::unique_ptr<QGCCachedTileSet> tileSet(_createTileSet(QStringLiteral("Destroy Flush"), 46.0));
+    QVERIFY(tileSet);
+    const quint64 setID = tileSet->id();
+    const int totalTiles = static_cast<int>(tileSet->totalTileCount());
+    QVERIFY(totalTiles > 1);
+
+    tileSet->createDownloadTask();
+    QTRY_VERIFY_WITH_TIMEOUT(tileSet->savedTileCount() == 1, TestTimeout::mediumMs());
+
+    // The completed tile is only recorded in memory until the next flush, destroying the set must write it
+    tileSet.reset();
+    QCOMPARE(_remainingDownloads(setID), totalTiles - 1);
+}
+
 UT_REGISTER_TEST(QGCCachedTileSetTest, TestLabel::Unit)
@@ -22,4 +22,12 @@ private slots:
     void _testCompleteWhenDefaultSet();
     void _testCompleteWhenAllSaved();
     void _testSetSelectedEmitsSignal();
+    void _testCancelAndResumeDownload();
+    void _testDestroyFlushesTileStates();
+
+private:
+    /// Creates a CustomURL set around a fixed area in the map engine database
+    QGCCachedTileSet *_createTileSet(const QString &name, double topleftLat);
+    /// Number of tiles of the set still to be downloaded, resets interrupted downloads to pending first
+    int _remainingDownloads(quint64 setID);
 };
@@ -334,6 +334,44 @@ void QGCTileCacheDatabaseTest::_testUpdateTileDownloadState()
     }
 }
 
+void QGCTileCacheDatabaseTest::_testUpdateTileDownloadStatesBatch()
+{
+    QTemporaryDir tempDir;
+    auto db = _createInitializedDB(tempDir);
+
+    const auto defaultSetID = db->findTileSetID(QStringLiteral("Default Tile Set"));
+    QVERIFY(defaultSetID.has_value());
+
+    // More hashes than fit in one IN clause batch
+    constexpr int tileCount = 600;
+    QStringList hashes;
+    for (int i = 0; i < tileCount; i++) {
+        hashes.append(QStringLiteral("batch_dl_%1").arg(i));
+        _insertDownloadRecord(db.get(), defaultSetID.value(), hashes.last(), QGCTile::StateDownloading);
+    }
+
+    const auto countInState = [&db](int state) {
+        QSqlQuery query(db->database());
+        if (!query.prepare(QStringLiteral("SELECT COUNT(*) FROM TilesDownload WHERE state = ?"))) {
+            return -1;
+        }
+        query.addBindValue(state);
+        return (query.exec() && query.next()) ? query.value(0).toInt() : -1;
+    };
+
+    QVERIFY(db->updateTileDownloadStates(defaultSetID.value(), QGCTile::StateError, hashes.mid(0, 400)));
+    QCOMPARE(countInState(QGCTile::StateError), 400);
+    QCOMPARE(countInState(QGCTile::StateDownloading), tileCount - 400);
+
+    QVERIFY(db->updateTileDownloadStates(defaultSetID.value(), QGCTile::StateComplete, hashes.mid(100)));
+    QSqlQuery query(db->database());
+    QVERIFY(query.exec(QStringLiteral("SELECT COUNT(*) FROM TilesDownload")) && query.next());
+    QCOMPARE(query.value(0).toInt(), 100);
+    QCOMPARE(countInState(QGCTile::StateError), 100);
+
+    QVERIFY(db->updateTileDownloadStates(defaultSetID.value(), QGCTile::StatePending, QStringList()));
+}
+
 void QGCTileCacheDatabaseTest::_testExportImportReplace()
 {
     QTemporaryDir tempDir;
@@ -1362,4 +1400,71 @@ void QGCTileCacheDatabaseTest::_testForeignKeyCascadeDelete()
     }
 }
 
+void QGCTileCacheDatabaseTest::_testSaveTilesBatch()
+{
+    QTemporaryDir tempDir;
+    auto db = _createInitializedDB(tempDir);
+    QVERIFY(db);
+
+    const QGCCacheTile tile1(QStringLiteral("batch1"), QByteArray(10, 'A'), QStringLiteral("png"), kFixedProviderType);
+    const QGCCacheTile tile2(QStringLiteral("batch2"), QByteArray(10, 'B'), QStringLiteral("jpg"), kFixedProviderType);
+    const QGCCacheTile tile1Dup(QStringLiteral("batch1"), QByteArray(10, 'C'), QStringLiteral("png"), kFixedProviderType);
+
+    const QList<bool> saved = db->saveTiles({ &tile1, &tile2, &tile1Dup });
+    QCOMPARE(saved, QList<bool>({ true, true, true }));
+
+    auto fetched = db->getTile(QStringLiteral("batch1"));
+    QVERIFY(fetched != nullptr);
+    QCOMPARE(fetched->img, tile1.img);
+    fetched = db->getTile(QStringLiteral("batch2"));
+    QVERIFY(fetched != nullptr);
+    QCOMPARE(fetched->format, QStringLiteral("jpg"));
+
+    QSqlQuery query(db->database());
+    QVERIFY(query.exec("SELECT COUNT(*) FROM Tiles") && query.next());
+    QCOMPARE(query.value(0).toInt(), 2);
+    QVERIFY(query.exec("SELECT COUNT(*) FROM SetTiles") && query.next());
+    QCOMPARE(query.value(0).toInt(), 2);
+
+    QVERIFY(db->saveTiles({}).isEmpty());
+}
+
+void QGCTileCacheDatabaseTest::_testGetTileDuringWriteTransaction()
+{
+    QTemporaryDir tempDir;
+    auto db = _createInitializedDB(tempDir);
+    QVERIFY(db);
+
+    QVERIFY(db->saveTile(QStringLiteral("committed"), QStringLiteral("png"), QByteArray(10, 'W'), kFixedProviderType,
+                         QGCTileCacheDatabase::kInvalidTileSet));
+
+    QSqlDatabase writeDb = db->database();
+    {
+        QSqlQuery query(writeDb);
+        QVERIFY(query.exec("PRAGMA journal_mode") && query.next());
+        QCOMPARE(query.value(0).toString().toLower(), QStringLiteral("wal"));
+    }
+
+    QVERIFY(writeDb.transaction());
+    {
+        QSqlQuery query(writeDb);
+        QVERIFY(query.prepare("INSERT INTO Tiles(hash, format, tile, size, type, date) VALUES(?, ?, ?, ?, ?, ?)"));
+        query.addBindValue(QStringLiteral("uncommitted"));
+        query.addBindValue(QStringLiteral("png"));
+        query.addBindValue(QByteArray(10, 'U'));
+        query.addBindValue(10);
+        query.addBindValue(UrlFactory::getQtMapIdFromProviderType(kFixedProviderType));
+        query.addBindValue(QDateTime::currentSecsSinceEpoch());
+        QVERIFY(query.exec());
+    }
+
+    // Lookups use their own read-only connection, so they are not blocked by the open write
+    // transaction and only see committed tiles
+    QVERIFY(db->getTile(QStringLiteral("committed")) != nullptr);
+    QVERIFY(db->getTile(QStringLiteral("uncommitted")) == nullptr);
+
+    QVERIFY(writeDb.commit());
+    QVERIFY(db->getTile(QStringLiteral("uncommitted")) != nullptr);
+}
+
 UT_REGISTER_TEST(QGCTileCacheDatabaseTest, TestLabel::Unit)
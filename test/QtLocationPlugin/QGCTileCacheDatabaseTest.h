@@ -27,6 +27,7 @@ private slots:
     void _testComputeSetTotalsDefault();
     void _testPruneCache();
     void _testUpdateTileDownloadState();
+    void _testUpdateTileDownloadStatesBatch();
     void _testExportImportReplace();
     void _testGetTileDownloadList();
     void _testImportSetsMerge();
@@ -54,6 +55,8 @@ private slots:
     void _testTilesDownloadTableColumns();
     void _testIndexesExist();
     void _testForeignKeyCascadeDelete();
+    void _testSaveTilesBatch();
+    void _testGetTileDuringWriteTransaction();
 
 private:
     std::unique_ptr<QGCTileCacheDatabase> _createInitializedDB(QTemporaryDir &tempDir);
@@ -0,0 +1,162 @@
+#include "QGCTileDownloadEngineTest.h"
+#include "LocalHttpTestServer.h"
+#include "QGCTileDownloadEngine.h"
+
+#include <QtCore/QSet>
+#include <QtCore/QUrl>
+#include <QtNetwork/QNetworkAccessManager>
+#include <QtTest/QSignalSpy>
+#include <QtTest/QTest>
+
+namespace {
+
+QNetworkRequest tileRequest(const TestFixtures::LocalHttpTestServer &server, int index)
+{
+    return QNetworkRequest(QUrl(server.url(QStringLiteral("/tiles/%1.png").arg(index))));
+}
+
+QString tileHash(int index)
+{
+    return QStringLiteral("tile_%1").arg(index);
+}
+
+} // namespace
+
+void QGCTileDownloadEngineTest::_testDownloadsAllTiles()
+{
+    TestFixtures::LocalHttpTestServer server;
+    QVERIFY2(server.listen(), "Could not start local test HTTP server");
+    const QByteArray tileData(512, 'T');
+    server.installHttpResponder(tileData, 200, "image/png");
+
+    QNetworkAccessManager networkManager;
+    QGCTileDownloadEngine engine(&networkManager);
+    QSignalSpy downloadedSpy(&engine, &QGCTileDownloadEngine::tileDownloaded);
+    QSignalSpy failedSpy(&engine, &QGCTileDownloadEngine::tileFailed);
+
+    constexpr int tileCount = 40;
+    for (int i = 0; i < tileCount; i++) {
+        engine.enqueue(tileHash(i), tileRequest(server, i));
+    }
+    QCOMPARE(engine.pendingCount(), qsizetype(tileCount));
+
+    QTRY_COMPARE_WITH_TIMEOUT(downloadedSpy.count(), tileCount, TestTimeout::longMs());
+    QCOMPARE(failedSpy.count(), 0);
+    QCOMPARE(engine.pendingCount(), qsizetype(0));
+
+    QSet<QString> hashes;
+    for (const QList<QVariant> &args : downloadedSpy) {
+        (void) hashes.insert(args.at(0).toString());
+        QCOMPARE(args.at(1).toByteArray(), tileData);
+    }
+    QCOMPARE(hashes.count(), tileCount);
+
+    const QGCTileDownloadEngine::Stats stats = engine.stats();
+    QCOMPARE(stats.tilesDownloaded, quint64(tileCount));
+    QCOMPARE(stats.tilesFailed, quint64(0));
+    QCOMPARE(stats.bytesDownloaded, quint64(tileCount * tileData.size()));
+    QCOMPARE(stats.inFlight, qsizetype(0));
+    QCOMPARE(stats.queued, qsizetype(0));
+    QVERIFY(stats.tilesPerSecond > 0.);
+    QVERIFY(stats.bytesPerSecond > 0.);
+}
+
+void QGCTileDownloadEngineTest::_testConcurrencyGrowsOnHealthyHost()
+{
+    TestFixtures::LocalHttpTestServer server;
+    QVERIFY2(server.listen(), "Could not start local test HTTP server");
+    server.installHttpResponder(QByteArray(64, 'T'), 200, "image/png");
+
+    QNetworkAccessManager networkManager;
+    QGCTileDownloadEngine engine(&networkManager);
+    engine.setMaxConcurrency(8);
+    engine.setInitialConcurrency(2);
+    QSignalSpy downloadedSpy(&engine, &QGCTileDownloadEngine::tileDownloaded);
+
+    const QString host = QUrl(server.url()).host();
+    QCOMPARE(engine.concurrencyLimit(host), 2);
+
+    constexpr int tileCount = 120;
+    for (int i = 0; i < tileCount; i++) {
+        engine.enqueue(tileHash(i), tileRequest(server, i));
+    }
+    QVERIFY(engine.stats().inFlight <= 2);
+
+    QTRY_COMPARE_WITH_TIMEOUT(downloadedSpy.count(), tileCount, TestTimeout::longMs());
+
+    const int limit = engine.concurrencyLimit(host);
+    QVERIFY2(limit > 2, qPrintable(QStringLiteral("limit %1").arg(limit)));
+    QVERIFY(limit <= 8);
+}
+
+void QGCTileDownloadEngineTest::_testServerErrorsShrinkConcurrency()
+{
+    TestFixtures::LocalHttpTestServer server;
+    QVERIFY2(server.listen(), "Could not start local test HTTP server");
+    server.installHttpResponder(QByteArray("busy"), 500, "text/plain");
+
+    QNetworkAccessManager networkManager;
+    QGCTileDownloadEngine engine(&networkManager);
+    engine.setInitialConcurrency(6);
+    QSignalSpy failedSpy(&engine, &QGCTileDownloadEngine::tileFailed);
+
+    constexpr int tileCount = 12;
+    for (int i = 0; i < tileCount; i++) {
+        engine.enqueue(tileHash(i), tileRequest(server, i));
+    }
+
+    QTRY_COMPARE_WITH_TIMEOUT(failedSpy.count(), tileCount, TestTimeout::longMs());
+
+    QCOMPARE(engine.concurrencyLimit(QUrl(server.url()).host()), QGCTileDownloadEngine::kMinConcurrency);
+    QCOMPARE(engine.stats().tilesFailed, quint64(tileCount));
+    QCOMPARE(engine.stats().tilesDownloaded, quint64(0));
+    QCOMPARE(engine.pendingCount(), qsizetype(0));
+}
+
+void QGCTileDownloadEngineTest::_testMissingTilesDoNotShrinkConcurrency()
+{
+    TestFixtures::LocalHttpTestServer server;
+    QVERIFY2(server.listen(), "Could not start local test HTTP server");
+    server.installHttpResponder(QByteArray("missing"), 404, "text/plain");
+
+    QNetworkAccessManager networkManager;
+    QGCTileDownloadEngine engine(&networkManager);
+    engine.setInitialConcurrency(4);
+    QSignalSpy failedSpy(&engine, &QGCTileDownloadEngine::tileFailed);
+
+    for (int i = 0; i < 4; i++) {
+        engine.enqueue(tileHash(i), tileRequest(server, i));
+    }
+
+    QTRY_COMPARE_WITH_TIMEOUT(failedSpy.count(), 4, TestTimeout::longMs());
+    QCOMPARE(engine.concurrencyLimit(QUrl(server.url()).host()), 4);
+}
+
+void QGCTileDownloadEngineTest::_testClearQueued()
+{
+    TestFixtures::LocalHttpTestServer server;
+    QVERIFY2(server.listen(), "Could not start local test HTTP server");
+    server.installHttpResponder(QByteArray(64, 'T'), 200, "image/png");
+
+    QNetworkAccessManager networkManager;
+    QGCTileDownloadEngine engine(&networkManager);
+    engine.setInitialConcurrency(1);
+    QSignalSpy downloadedSpy(&engine, &QGCTileDownloadEngine::tileDownloaded);
+
+    constexpr int tileCount = 5;
+    for (int i = 0; i < tileCount; i++) {
+        engine.enqueue(tileHash(i), tileRequest(server, i));
+    }
+
+    // Only the first tile has started, the rest are handed back
+    const QStringList dropped = engine.clearQueued();
+    QCOMPARE(dropped.count(), tileCount - 1);
+    QVERIFY(!dropped.contains(tileHash(0)));
+    QCOMPARE(engine.pendingCount(), qsizetype(1));
+
+    QTRY_COMPARE_WITH_TIMEOUT(downloadedSpy.count(), 1, TestTimeout::longMs());
+    QCOMPARE(downloadedSpy.first().at(0).toString(), tileHash(0));
+    QCOMPARE(engine.pendingCount(), qsizetype(0));
+}
+
+UT_REGISTER_TEST(QGCTileDownloadEngineTest, TestLabel::Unit)
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class QGCTileDownloadEngineTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testDownloadsAllTiles();
+    void _testConcurrencyGrowsOnHealthyHost();
+    void _testServerErrorsShrinkConcurrency();
+    void _testMissingTilesDoNotShrinkConcurrency();
+    void _testClearQueued();
+};
@@ -0,0 +1,130 @@
+#include "QGCTileImageCacheTest.h"
+#include "QGCTileImageCache.h"
+
+#include <QtCore/QBuffer>
+#include <QtTest/QTest>
+
+namespace {
+
+constexpr int kTileSize = 256;
+
+QImage tileImage(Qt::GlobalColor color)
+{
+    QImage image(kTileSize, kTileSize, QImage::Format_ARGB32);
+    image.fill(color);
+    return image;
+}
+
+qint64 tileBytes()
+{
+    return tileImage(Qt::black).sizeInBytes();
+}
+
+} // namespace
+
+void QGCTileImageCacheTest::_testInsertAndLookup()
+{
+    QGCTileImageCache cache;
+    const QGCTileImageCache::Key key = { 1, 10, 20, 5 };
+
+    QVERIFY(cache.image(key).isNull());
+
+    cache.insert(key, tileImage(Qt::red));
+    const QImage image = cache.image(key);
+    QVERIFY(!image.isNull());
+    QCOMPARE(image.pixelColor(0, 0), QColor(Qt::red));
+
+    // Same tile of another provider is a different entry
+    QVERIFY(cache.image({ 2, 10, 20, 5 }).isNull());
+
+    // Replacing an image keeps the byte count of a single tile
+    cache.insert(key, tileImage(Qt::blue));
+    QCOMPARE(cache.image(key).pixelColor(0, 0), QColor(Qt::blue));
+
+    const QGCTileImageCache::Stats stats = cache.stats();
+    QCOMPARE(stats.hits, quint64(2));
+    QCOMPARE(stats.misses, quint64(2));
+    QCOMPARE(stats.images, qsizetype(1));
+    QCOMPARE(stats.bytes, tileBytes());
+}
+
+void QGCTileImageCacheTest::_testBudgetEvictsLeastRecentlyUsed()
+{
+    QGCTileImageCache cache(3 * tileBytes());
+
+    cache.insert({ 1, 0, 0, 1 }, tileImage(Qt::red));
+    cache.insert({ 1, 1, 0, 1 }, tileImage(Qt::green));
+    cache.insert({ 1, 0, 1, 1 }, tileImage(Qt::blue));
+
+    // Touch the oldest so the second tile becomes the eviction candidate
+    QVERIFY(!cache.image({ 1, 0, 0, 1 }).isNull());
+    cache.insert({ 1, 1, 1, 1 }, tileImage(Qt::yellow));
+
+    QVERIFY(!cache.image({ 1, 0, 0, 1 }).isNull());
+    QVERIFY(cache.image({ 1, 1, 0, 1 }).isNull());
+    QVERIFY(!cache.image({ 1, 0, 1, 1 }).isNull());
+    QVERIFY(!cache.image({ 1, 1, 1, 1 }).isNull());
+
+    const QGCTileImageCache::Stats stats = cache.stats();
+    QCOMPARE(stats.evictions, quint64(1));
+    QCOMPARE(stats.images, qsizetype(3));
+    QVERIFY(stats.bytes <= cache.budgetBytes());
+
+    cache.setBudgetBytes(tileBytes());
+    QCOMPARE(cache.stats().images, qsizetype(1));
+}
+
+void QGCTileImageCacheTest::_testPinnedTilesSurviveEviction()
+{
+    QGCTileImageCache cache(2 * tileBytes());
+    const QGCTileImageCache::Key pinnedKey = { 1, 0, 0, 1 };
+
+    QVERIFY(!cache.pin(pinnedKey));
+
+    cache.insert(pinnedKey, tileImage(Qt::red));
+    QVERIFY(cache.pin(pinnedKey));
+    QVERIFY(cache.pin(pinnedKey));
+
+    for (int x = 1; x <= 4; x++) {
+        cache.insert({ 1, x, 0, 1 }, tileImage(Qt::green));
+    }
+    QVERIFY(!cache.image(pinnedKey).isNull());
+    QCOMPARE(cache.stats().pinnedImages, qsizetype(1));
+
+    // Pins are counted, the tile stays pinned until the last unpin
+    cache.unpin(pinnedKey);
+    cache.clear();
+    QVERIFY(!cache.image(pinnedKey).isNull());
+    QCOMPARE(cache.stats().images, qsizetype(1));
+
+    cache.unpin(pinnedKey);
+    QCOMPARE(cache.stats().pinnedImages, qsizetype(0));
+    cache.clear();
+    QVERIFY(cache.image(pinnedKey).isNull());
+    QCOMPARE(cache.stats().bytes, qint64(0));
+
+    expectLogMessage("QtLocationPlugin.QGCTileImageCache", QtWarningMsg, QRegularExpression(QStringLiteral("not pinned")));
+    cache.unpin(pinnedKey);
+    verifyExpectedLogMessage();
+}
+
+void QGCTileImageCacheTest::_testDecode()
+{
+    QGCTileImageCache cache;
+    const QGCTileImageCache::Key key = { 1, 3, 4, 5 };
+
+    QVERIFY(cache.decode(key, QByteArrayLiteral("not an image")).isNull());
+    QCOMPARE(cache.stats().images, qsizetype(0));
+
+    QByteArray data;
+    QBuffer buffer(&data);
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    QVERIFY(tileImage(Qt::cyan).save(&buffer, "PNG"));
+
+    const QImage decoded = cache.decode(key, data);
+    QVERIFY(!decoded.isNull());
+    QCOMPARE(decoded.size(), QSize(kTileSize, kTileSize));
+    QCOMPARE(cache.image(key).pixelColor(0, 0), QColor(Qt::cyan));
+}
+
+UT_REGISTER_TEST(QGCTileImageCacheTest, TestLabel::Unit)
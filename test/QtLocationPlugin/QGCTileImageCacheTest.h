@@ -0,0 +1,14 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class QGCTileImageCacheTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testInsertAndLookup();
+    void _testBudgetEvictsLeastRecentlyUsed();
+    void _testPinnedTilesSurviveEviction();
+    void _testDecode();
+};
@@ -0,0 +1,197 @@
+#include "TerrainTileCacheTest.h"
+#include "TerrainTile.h"
+#include "TerrainTileCache.h"
+#include "TerrainTileTest.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QTemporaryDir>
+#include <QtPositioning/QGeoCoordinate>
+
+namespace {
+
+const QGeoCoordinate kTileCenter(-48.875, -123.395);
+
+/// Serialized 10x10 tile around kTileCenter filled with @p elevation
+QByteArray tilePayload(int16_t elevation)
+{
+    return TerrainTileTest::_createValidTileData(-48.88, -123.40, -48.87, -123.39, elevation, elevation, elevation, 10, 10, elevation);
+}
+
+} // namespace
+
+void TerrainTileCacheTest::_testMemoryHit()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    TerrainTileCache cache(dir.path(), TerrainTileCache::kDefaultMemoryBudgetBytes, TerrainTileCache::kDefaultDiskBudgetBytes);
+
+    const std::shared_ptr<const TerrainTile> inserted = cache.insert(QStringLiteral("a"), tilePayload(10));
+    QVERIFY(inserted);
+    QCOMPARE(cache.tile(QStringLiteral("a")).get(), inserted.get());
+    QVERIFY(!cache.tile(QStringLiteral("b")));
+
+    const TerrainTileCache::Stats stats = cache.stats();
+    QCOMPARE(stats.memoryHits, 1ULL);
+    QCOMPARE(stats.diskHits, 0ULL);
+    QCOMPARE(stats.misses, 1ULL);
+    QCOMPARE(stats.memoryTiles, 1);
+    QCOMPARE(stats.memoryBytes, inserted->memoryBytes());
+    QCOMPARE(stats.diskTiles, 1);
+}
+
+void TerrainTileCacheTest::_testInvalidPayload()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    TerrainTileCache cache(dir.path(), TerrainTileCache::kDefaultMemoryBudgetBytes, TerrainTileCache::kDefaultDiskBudgetBytes);
+
+    expectLogMessage("Terrain.terraintile", QtWarningMsg, QRegularExpression("too small for TileInfo_t header"));
+    QVERIFY(!cache.insert(QStringLiteral("a"), QByteArrayLiteral("junk")));
+    verifyExpectedLogMessage();
+
+    const TerrainTileCache::Stats stats = cache.stats();
+    QCOMPARE(stats.memoryTiles, 0);
+    QCOMPARE(stats.diskTiles, 0);
+}
+
+void TerrainTileCacheTest::_testMemoryBudgetEviction()
+{
+    const qint64 tileBytes = TerrainTile(tilePayload(0)).memoryBytes();
+    TerrainTileCache cache(QString(), 2 * tileBytes, TerrainTileCache::kDefaultDiskBudgetBytes);
+
+    (void) cache.insert(QStringLiteral("a"), tilePayload(1));
+    const std::shared_ptr<const TerrainTile> b = cache.insert(QStringLiteral("b"), tilePayload(2));
+    QVERIFY(cache.tile(QStringLiteral("a")));
+
+    // b is now the least recently used
+    (void) cache.insert(QStringLiteral("c"), tilePayload(3));
+    QVERIFY(cache.tile(QStringLiteral("a")));
+    QVERIFY(cache.tile(QStringLiteral("c")));
+    QVERIFY(!cache.tile(QStringLiteral("b")));
+
+    const TerrainTileCache::Stats stats = cache.stats();
+    QCOMPARE(stats.evictions, 1ULL);
+    QCOMPARE(stats.memoryTiles, 2);
+    QCOMPARE(stats.memoryBytes, 2 * tileBytes);
+
+    // Evicted tiles held by a caller stay usable
+    QCOMPARE(b->elevation(kTileCenter), 2.0);
+
+    cache.setMemoryBudgetBytes(0);
+    QCOMPARE(cache.stats().memoryTiles, 1);
+}
+
+void TerrainTileCacheTest::_testDiskPersistence()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    {
+        TerrainTileCache cache(dir.path(), TerrainTileCache::kDefaultMemoryBudgetBytes, TerrainTileCache::kDefaultDiskBudgetBytes);
+        QVERIFY(cache.insert(QStringLiteral("a"), tilePayload(10)));
+        QVERIFY(cache.insert(QStringLiteral("b"), tilePayload(20)));
+    }
+
+    // A new session starts with an empty memory level and finds the stored payloads
+    TerrainTileCache cache(dir.path(), TerrainTileCache::kDefaultMemoryBudgetBytes, TerrainTileCache::kDefaultDiskBudgetBytes);
+    QCOMPARE(cache.stats().diskTiles, 2);
+    QCOMPARE(cache.stats().memoryTiles, 0);
+
+    const std::shared_ptr<const TerrainTile> a = cache.tile(QStringLiteral("a"));
+    QVERIFY(a);
+    QCOMPARE(a->elevation(kTileCenter), 10.0);
+    QCOMPARE(cache.tile(QStringLiteral("a")).get(), a.get());
+
+    cache.clearMemory();
+    QCOMPARE(cache.tile(QStringLiteral("b"))->elevation(kTileCenter), 20.0);
+
+    const TerrainTileCache::Stats stats = cache.stats();
+    QCOMPARE(stats.diskHits, 2ULL);
+    QCOMPARE(stats.memoryHits, 1ULL);
+    QCOMPARE(stats.misses, 0ULL);
+}
+
+void TerrainTileCacheTest::_testDiskBudgetEviction()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const qint64 payloadBytes = tilePayload(0).size();
+
+    {
+        TerrainTileCache cache(dir.path(), TerrainTileCache::kDefaultMemoryBudgetBytes, 2 * payloadBytes);
+        (void) cache.insert(QStringLiteral("a"), tilePayload(1));
+        (void) cache.insert(QStringLiteral("b"), tilePayload(2));
+        (void) cache.insert(QStringLiteral("c"), tilePayload(3));
+        QCOMPARE(cache.stats().diskTiles, 2);
+        QCOMPARE(cache.stats().diskBytes, 2 * payloadBytes);
+    }
+
+    QVERIFY(!QFile::exists(dir.filePath(QStringLiteral("a.tile"))));
+
+    TerrainTileCache cache(dir.path(), TerrainTileCache::kDefaultMemoryBudgetBytes, 2 * payloadBytes);
+    QVERIFY(!cache.tile(QStringLiteral("a")));
+    QVERIFY(cache.tile(QStringLiteral("b")));
+    QVERIFY(cache.tile(QStringLiteral("c")));
+}
+
+void TerrainTileCacheTest::_testCorruptStoredTile()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    QFile file(dir.filePath(QStringLiteral("x.tile")));
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    (void) file.write("junk");
+    file.close();
+
+    TerrainTileCache cache(dir.path(), TerrainTileCache::kDefaultMemoryBudgetBytes, TerrainTileCache::kDefaultDiskBudgetBytes);
+    QCOMPARE(cache.stats().diskTiles, 1);
+
+    expectLogMessage("Terrain.terraintile", QtWarningMsg, QRegularExpression("too small for TileInfo_t header"));
+    expectLogMessage("Terrain.TerrainTileCache", QtWarningMsg, QRegularExpression("Removing invalid stored tile"));
+    QVERIFY(!cache.tile(QStringLiteral("x")));
+    verifyExpectedLogMessage();
+    verifyExpectedLogMessage();
+
+    QCOMPARE(cache.stats().diskTiles, 0);
+    QCOMPARE(cache.stats().misses, 1ULL);
+    QVERIFY(!file.exists());
+}
+
+void TerrainTileCacheTest::_testMemoryOnly()
+{
+    TerrainTileCache cache(QString(), TerrainTileCache::kDefaultMemoryBudgetBytes, TerrainTileCache::kDefaultDiskBudgetBytes);
+
+    QVERIFY(cache.insert(QStringLiteral("a"), tilePayload(10)));
+    QCOMPARE(cache.stats().diskTiles, 0);
+
+    cache.clearMemory();
+    QVERIFY(!cache.tile(QStringLiteral("a")));
+    QCOMPARE(cache.stats().misses, 1ULL);
+}
+
+void TerrainTileCacheTest::_testReadOnlyStore()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString filePath = dir.filePath(QStringLiteral("a.tile"));
+
+    {
+        TerrainTileCache cache(dir.path(), TerrainTileCache::kDefaultMemoryBudgetBytes, TerrainTileCache::kDefaultDiskBudgetBytes);
+        QVERIFY(cache.insert(QStringLiteral("a"), tilePayload(10)));
+    }
+    QVERIFY(QFile::setPermissions(filePath, QFileDevice::ReadOwner | QFileDevice::ReadUser));
+
+    // Reading a stored tile never needs write access and never removes it
+    TerrainTileCache cache(dir.path(), TerrainTileCache::kDefaultMemoryBudgetBytes, TerrainTileCache::kDefaultDiskBudgetBytes);
+    const std::shared_ptr<const TerrainTile> a = cache.tile(QStringLiteral("a"));
+    QVERIFY(a);
+    QCOMPARE(a->elevation(kTileCenter), 10.0);
+    QCOMPARE(cache.stats().diskHits, 1ULL);
+    QCOMPARE(cache.stats().diskTiles, 1);
+    QVERIFY(QFile::exists(filePath));
+
+    QVERIFY(QFile::setPermissions(filePath, QFileDevice::ReadOwner | QFileDevice::WriteOwner));
+}
+
+UT_REGISTER_TEST(TerrainTileCacheTest, TestLabel::Unit, TestLabel::Terrain)
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class TerrainTileCacheTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testMemoryHit();
+    void _testInvalidPayload();
+    void _testMemoryBudgetEviction();
+    void _testDiskPersistence();
+    void _testDiskBudgetEviction();
+    void _testCorruptStoredTile();
+    void _testMemoryOnly();
+    void _testReadOnlyStore();
+};
@@ -0,0 +1,166 @@
+#include "TerrainTileFetchSchedulerTest.h"
+#include "LocalHttpTestServer.h"
+#include "TerrainTileFetchScheduler.h"
+
+#include <QtNetwork/QNetworkAccessManager>
+#include <QtNetwork/QNetworkReply>
+#include <QtNetwork/QNetworkRequest>
+#include <QtTest/QTest>
+
+namespace {
+
+/// Fetches tiles from the local test server and reports back to the scheduler
+class HttpTileBackend
+{
+public:
+    explicit HttpTileBackend(TestFixtures::LocalHttpTestServer &server)
+        : _server(server)
+    {
+    }
+
+    TerrainTileFetchScheduler::FetchFunction fetchFunction(TerrainTileFetchScheduler *&scheduler)
+    {
+        return [this, &scheduler](const TerrainTileFetchScheduler::TileKey &key) {
+            requestedHashes.append(key.hash);
+            maxInFlight = qMax(maxInFlight, scheduler->metrics().tilesInFlight);
+
+            QNetworkReply *reply = _networkManager.get(QNetworkRequest(QUrl(_server.url(QStringLiteral("/") + key.hash))));
+            const QString hash = key.hash;
+            (void) QObject::connect(reply, &QNetworkReply::finished, reply, [reply, hash, &scheduler]() {
+                reply->deleteLater();
+                scheduler->finished(hash, reply->error() == QNetworkReply::NoError);
+            });
+        };
+    }
+
+    QStringList requestedHashes;
+    qsizetype maxInFlight = 0;
+
+private:
+    TestFixtures::LocalHttpTestServer &_server;
+    QNetworkAccessManager _networkManager;
+};
+
+TerrainTileFetchScheduler::TileKey tileKey(int x, int y)
+{
+    return { QStringLiteral("%1_%2").arg(x).arg(y), x, y, 0 };
+}
+
+} // namespace
+
+void TerrainTileFetchSchedulerTest::_testCoalescing()
+{
+    TestFixtures::LocalHttpTestServer server;
+    QVERIFY2(server.listen(), "Could not start local test HTTP server");
+    server.installHttpResponder(QByteArray(64, 'T'));
+
+    HttpTileBackend backend(server);
+    TerrainTileFetchScheduler *schedulerPtr = nullptr;
+    TerrainTileFetchScheduler scheduler(TerrainTileFetchScheduler::kDefaultMaxConcurrentFetches, backend.fetchFunction(schedulerPtr));
+    schedulerPtr = &scheduler;
+
+    // Three queries which overlap on the same tiles
+    for (int query = 0; query < 3; query++) {
+        for (int x = 0; x < 3; x++) {
+            const bool scheduled = scheduler.request(tileKey(x, 0));
+            QCOMPARE(scheduled, query == 0);
+        }
+    }
+    QVERIFY(scheduler.isPending(tileKey(0, 0).hash));
+
+    QTRY_COMPARE_WITH_TIMEOUT(scheduler.metrics().tilesFetched, 3ULL, TestTimeout::mediumMs());
+
+    const TerrainTileFetchScheduler::Metrics metrics = scheduler.metrics();
+    QCOMPARE(backend.requestedHashes.count(), 3);
+    QCOMPARE(metrics.coalescedRequests, 6ULL);
+    QCOMPARE(metrics.tilesFailed, 0ULL);
+    QCOMPARE(metrics.tilesInFlight, qsizetype(0));
+    QCOMPARE(metrics.tilesWaiting, qsizetype(0));
+    QVERIFY(metrics.maxFetchMs <= metrics.totalFetchMs);
+    QVERIFY(!scheduler.isPending(tileKey(0, 0).hash));
+
+    // A finished tile is fetched again if requested again
+    QVERIFY(scheduler.request(tileKey(0, 0)));
+    QTRY_COMPARE_WITH_TIMEOUT(scheduler.metrics().tilesFetched, 4ULL, TestTimeout::mediumMs());
+}
+
+void TerrainTileFetchSchedulerTest::_testConcurrencyCap()
+{
+    TestFixtures::LocalHttpTestServer server;
+    QVERIFY2(server.listen(), "Could not start local test HTTP server");
+    server.installHttpResponder(QByteArray(64, 'T'));
+
+    HttpTileBackend backend(server);
+    TerrainTileFetchScheduler *schedulerPtr = nullptr;
+    TerrainTileFetchScheduler scheduler(2, backend.fetchFunction(schedulerPtr));
+    schedulerPtr = &scheduler;
+
+    constexpr int tileCount = 8;
+    for (int x = 0; x < tileCount; x++) {
+        QVERIFY(scheduler.request(tileKey(x, 1)));
+    }
+
+    TerrainTileFetchScheduler::Metrics metrics = scheduler.metrics();
+    QCOMPARE(metrics.tilesInFlight, qsizetype(2));
+    QCOMPARE(metrics.tilesWaiting, qsizetype(tileCount - 2));
+
+    QTRY_COMPARE_WITH_TIMEOUT(scheduler.metrics().tilesFetched, static_cast<quint64>(tileCount), TestTimeout::mediumMs());
+
+    metrics = scheduler.metrics();
+    QCOMPARE(backend.requestedHashes.count(), tileCount);
+    QVERIFY(backend.maxInFlight <= 2);
+    QCOMPARE(metrics.tilesWaiting, qsizetype(0));
+
+    // Waiting tiles are started in request order
+    for (int x = 0; x < tileCount; x++) {
+        QCOMPARE(backend.requestedHashes[x], tileKey(x, 1).hash);
+    }
+}
+
+void TerrainTileFetchSchedulerTest::_testFailedFetch()
+{
+    TestFixtures::LocalHttpTestServer server;
+    QVERIFY2(server.listen(), "Could not start local test HTTP server");
+    server.installHttpResponder(QByteArray("unavailable"), 500, "text/plain");
+
+    HttpTileBackend backend(server);
+    TerrainTileFetchScheduler *schedulerPtr = nullptr;
+    TerrainTileFetchScheduler scheduler(1, backend.fetchFunction(schedulerPtr));
+    schedulerPtr = &scheduler;
+
+    QVERIFY(scheduler.request(tileKey(0, 2)));
+    QVERIFY(scheduler.request(tileKey(1, 2)));
+
+    QTRY_COMPARE_WITH_TIMEOUT(scheduler.metrics().tilesFailed, 2ULL, TestTimeout::mediumMs());
+
+    // A failure frees the slot for the waiting tile and allows the tile to be retried
+    const TerrainTileFetchScheduler::Metrics metrics = scheduler.metrics();
+    QCOMPARE(metrics.tilesFetched, 0ULL);
+    QCOMPARE(metrics.tilesInFlight, qsizetype(0));
+    QVERIFY(!scheduler.isPending(tileKey(0, 2).hash));
+    QVERIFY(scheduler.request(tileKey(0, 2)));
+}
+
+void TerrainTileFetchSchedulerTest::_testFinishedNotInFlight()
+{
+    int fetchCount = 0;
+    TerrainTileFetchScheduler scheduler(1, [&fetchCount](const TerrainTileFetchScheduler::TileKey &) { fetchCount++; });
+
+    QVERIFY(scheduler.request(tileKey(0, 3)));
+    QVERIFY(scheduler.request(tileKey(1, 3)));
+    QCOMPARE(fetchCount, 1);
+
+    // Waiting tiles have not been started, so they can not finish
+    expectLogMessage("Terrain.TerrainTileFetchScheduler", QtWarningMsg, QRegularExpression("not in flight"));
+    scheduler.finished(tileKey(1, 3).hash, true);
+    verifyExpectedLogMessage();
+    QCOMPARE(fetchCount, 1);
+    QCOMPARE(scheduler.metrics().tilesFetched, 0ULL);
+
+    scheduler.finished(tileKey(0, 3).hash, true);
+    QCOMPARE(fetchCount, 2);
+    QCOMPARE(scheduler.metrics().tilesFetched, 1ULL);
+    QCOMPARE(scheduler.metrics().tilesInFlight, qsizetype(1));
+}
+
+UT_REGISTER_TEST(TerrainTileFetchSchedulerTest, TestLabel::Unit, TestLabel::Terrain)
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class TerrainTileFetchSchedulerTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testCoalescing();
+    void _testConcurrencyCap();
+    void _testFailedFetch();
+    void _testFinishedNotInFlight();
+};
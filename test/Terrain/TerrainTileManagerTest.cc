@@ -0,0 +1,58 @@
+#include "TerrainTileManagerTest.h"
+
+#include <QtTest/QSignalSpy>
+
+#include "TerrainQueryInterface.h"
+#include "TerrainTileManager.h"
+
+// Uses its own TerrainTileManager so the tile memory cache starts empty. Tile fetches go through
+// the map tile cache worker, which serves synthetic tiles (see UnitTestTileGenerator).
+
+void TerrainTileManagerTest::_testConcurrentQueriesShareTileFetch()
+{
+    TerrainTileManager manager;
+    TerrainQueryInterface query1;
+    TerrainQueryInterface query2;
+    QSignalSpy spy1(&query1, &TerrainQueryInterface::coordinateHeightsReceived);
+    QSignalSpy spy2(&query2, &TerrainQueryInterface::coordinateHeightsReceived);
+    QVERIFY(spy1.isValid());
+    QVERIFY(spy2.isValid());
+
+    // Both coordinates lie in the same elevation tile
+    const QGeoCoordinate center = flat10Region().center();
+    const QGeoCoordinate nearCenter(center.latitude() + UnitTestTerrainData::oneSecondDeg, center.longitude() + UnitTestTerrainData::oneSecondDeg);
+    manager.addCoordinateQuery(&query1, {center});
+    manager.addCoordinateQuery(&query2, {nearCenter});
+
+    // The tile is not resident yet, so both queries wait on a single fetch
+    TerrainTileManager::QueryMetrics metrics = manager.queryMetrics();
+    QCOMPARE(metrics.queuedRequests, qsizetype(2));
+    QCOMPARE(metrics.tileFetches.tilesInFlight + metrics.tileFetches.tilesWaiting, qsizetype(1));
+    QCOMPARE(metrics.tileFetches.coalescedRequests, quint64(1));
+    QCOMPARE(spy1.count(), 0);
+    QCOMPARE(spy2.count(), 0);
+
+    QTRY_VERIFY_WITH_TIMEOUT((spy1.count() == 1) && (spy2.count() == 1), TestTimeout::mediumMs());
+
+    for (QSignalSpy *const spy : {&spy1, &spy2}) {
+        const QVariantList arguments = spy->takeFirst();
+        QVERIFY(arguments.at(0).toBool());
+        const QList<double> heights = qvariant_cast<QList<double>>(arguments.at(1));
+        QCOMPARE(heights.size(), 1);
+        QCOMPARE(heights.at(0), UnitTestTerrainData::Flat10Region::amslElevation);
+    }
+
+    metrics = manager.queryMetrics();
+    QCOMPARE(metrics.queuedRequests, qsizetype(0));
+    QCOMPARE(metrics.resolvedRequests, quint64(2));
+    QCOMPARE(metrics.tileFetches.tilesFetched, quint64(1));
+    QCOMPARE(metrics.tileFetches.tilesFailed, quint64(0));
+    QCOMPARE(metrics.tileFetches.tilesInFlight, qsizetype(0));
+
+    // A later query for the same tile is answered from the cache without another fetch
+    manager.addCoordinateQuery(&query1, {center});
+    QCOMPARE(spy1.count(), 1);
+    QCOMPARE(manager.queryMetrics().tileFetches.tilesFetched, quint64(1));
+}
+
+UT_REGISTER_TEST(TerrainTileManagerTest, TestLabel::Integration, TestLabel::Terrain)
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "BaseClasses/TerrainTest.h"
+
+class TerrainTileManagerTest : public TerrainTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testConcurrentQueriesShareTileFetch();
+};
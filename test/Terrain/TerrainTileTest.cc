@@ -1,5 +1,15 @@
 #include "TerrainTileTest.h"
 
+#include <vector>
+
+namespace {
+
+constexpr double kSwLat = -48.88;
+constexpr double kSwLon = -123.40;
+constexpr double kCellSize = 0.001;
+
+} // namespace
+
 QByteArray TerrainTileTest::_createValidTileData(double swLat, double swLon, double neLat, double neLon,
                                                  int16_t minElev, int16_t maxElev, double avgElev, int16_t gridSizeLat,
                                                  int16_t gridSizeLon, int16_t fillElevation)
@@ -24,6 +34,18 @@ QByteArray TerrainTileTest::_createValidTileData(double swLat, double swLon, dou
     return result;
 }
 
+QByteArray TerrainTileTest::_createGradientTileData()
+{
+    QByteArray result = _createValidTileData(kSwLat, kSwLon, kSwLat + (10 * kCellSize), kSwLon + (10 * kCellSize), 0, 99, 49.5, 10, 10, 0);
+    int16_t* elevData = reinterpret_cast<int16_t*>(result.data() + sizeof(TerrainTile::TileInfo_t));
+    for (int row = 0; row < 10; ++row) {
+        for (int col = 0; col < 10; ++col) {
+            elevData[(row * 10) + col] = static_cast<int16_t>((row * 10) + col);
+        }
+    }
+    return result;
+}
+
 void TerrainTileTest::_testValidTile()
 {
     const QByteArray tileData = _createValidTileData(-48.88, -123.40, -48.87, -123.39, 10, 100, 55.0, 10, 10, 50);
@@ -186,4 +208,60 @@ void TerrainTileTest::_testInvalidTileElevation()
     QVERIFY(qIsNaN(tile.avgElevation()));
 }
 
+void TerrainTileTest::_testRowMajorGrid()
+{
+    TerrainTile tile(_createGradientTileData());
+    QVERIFY(tile.isValid());
+
+    // Cell centers return the value of their cell
+    QCOMPARE(tile.elevation(QGeoCoordinate(kSwLat + (3.5 * kCellSize), kSwLon + (4.5 * kCellSize))), 34.0);
+    QCOMPARE(tile.elevation(QGeoCoordinate(kSwLat + (9.5 * kCellSize), kSwLon + (0.5 * kCellSize))), 90.0);
+    QCOMPARE(tile.elevation(QGeoCoordinate(kSwLat + (0.5 * kCellSize), kSwLon + (9.5 * kCellSize))), 9.0);
+}
+
+void TerrainTileTest::_testBatchElevations()
+{
+    TerrainTile tile(_createGradientTileData());
+    QVERIFY(tile.isValid());
+
+    const std::vector<double> lat{
+        kSwLat + (3.5 * kCellSize),
+        kSwLat + (3.25 * kCellSize),
+        kSwLat + (9.5 * kCellSize),
+        kSwLat + (0.5 * kCellSize),
+    };
+    const std::vector<double> lon{
+        kSwLon + (4.5 * kCellSize),
+        kSwLon + (4.0 * kCellSize),
+        kSwLon + (9.5 * kCellSize),
+        kSwLon + (0.5 * kCellSize),
+    };
+    std::vector<double> elevations(lat.size());
+    QCOMPARE(tile.elevations(QGCGeo::GeoSpan{ lat, lon, {} }, elevations), qsizetype(0));
+
+    // The gradient is linear, so bilinear interpolation reproduces it exactly away from the last row/column
+    QVERIFY(qAbs(elevations[0] - 39.5) < 1e-6);
+    QVERIFY(qAbs(elevations[1] - 36.5) < 1e-6);
+    // Last row and column have no northern/eastern neighbor
+    QVERIFY(qAbs(elevations[2] - 99.0) < 1e-6);
+    QVERIFY(qAbs(elevations[3] - 5.5) < 1e-6);
+}
+
+void TerrainTileTest::_testBatchElevationsOutsideBounds()
+{
+    TerrainTile tile(_createGradientTileData());
+    QVERIFY(tile.isValid());
+
+    const std::vector<double> lat{ kSwLat + (5.5 * kCellSize), -50.0, kSwLat + (10.5 * kCellSize) };
+    const std::vector<double> lon{ kSwLon + (5.5 * kCellSize), -125.0, kSwLon + (5.5 * kCellSize) };
+    std::vector<double> elevations(lat.size());
+    expectLogMessage("Terrain.terraintile", QtWarningMsg, QRegularExpression("outside tile bounds"));
+    QCOMPARE(tile.elevations(QGCGeo::GeoSpan{ lat, lon, {} }, elevations), qsizetype(2));
+    verifyExpectedLogMessage();
+
+    QVERIFY(!qIsNaN(elevations[0]));
+    QVERIFY(qIsNaN(elevations[1]));
+    QVERIFY(qIsNaN(elevations[2]));
+}
+
 UT_REGISTER_TEST(TerrainTileTest, TestLabel::Unit, TestLabel::Terrain)
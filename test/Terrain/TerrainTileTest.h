@@ -20,9 +20,17 @@ private slots:
     void _testDataTooSmallForElevation();
     void _testElevationOutsideBounds();
     void _testInvalidTileElevation();
+    void _testRowMajorGrid();
+    void _testBatchElevations();
+    void _testBatchElevationsOutsideBounds();
 
-private:
+public:
+    /// Also used by the terrain tile cache tests
     static QByteArray _createValidTileData(double swLat, double swLon, double neLat, double neLon, int16_t minElev,
                                            int16_t maxElev, double avgElev, int16_t gridSizeLat, int16_t gridSizeLon,
                                            int16_t fillElevation);
+
+private:
+    /// 10x10 cell tile where the elevation at row, col is (row * 10) + col
+    static QByteArray _createGradientTileData();
 };
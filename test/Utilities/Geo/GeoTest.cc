@@ -6,11 +6,41 @@
 #include "PropertyTesting.h"
 #include "QGCGeo.h"
 
+#include <vector>
+
 static bool compareDoubles(double actual, double expected, double epsilon = 0.00001)
 {
     return (qAbs(actual - expected) <= epsilon);
 }
 
+namespace {
+
+/// Structure-of-arrays track around an origin, long enough to span several kernel blocks plus an odd tail
+struct BatchTrack
+{
+    std::vector<double> latitude;
+    std::vector<double> longitude;
+    std::vector<double> altitude;
+
+    QGCGeo::GeoSpan span() const { return QGCGeo::GeoSpan{ latitude, longitude, altitude }; }
+    QGeoCoordinate coordinate(size_t i) const { return QGeoCoordinate(latitude[i], longitude[i], altitude[i]); }
+    size_t size() const { return latitude.size(); }
+};
+
+BatchTrack makeBatchTrack(const QGeoCoordinate &origin, int count)
+{
+    BatchTrack track;
+    for (int i = 0; i < count; i++) {
+        // Lawnmower-like sweep a few kilometers across
+        track.latitude.push_back(origin.latitude() + (((i % 40) - 20) * 0.001));
+        track.longitude.push_back(origin.longitude() + (((i / 40) - 5) * 0.002));
+        track.altitude.push_back(50.0 + (i % 7) * 10.0);
+    }
+    return track;
+}
+
+} // namespace
+
 void GeoTest::_convertGeoToNed_test()
 {
     const QGeoCoordinate coord(47.364869, 8.594398, 0.0);
@@ -354,6 +384,106 @@ void GeoTest::_interpolateAtDistance_test()
     QCOMPARE(same, m_origin);
 }
 
+void GeoTest::_convertGeoToNedBatch_test()
+{
+    const BatchTrack track = makeBatchTrack(m_origin, 601);
+    std::vector<double> x(track.size()), y(track.size()), z(track.size());
+    QGCGeo::convertGeoToNed(track.span(), m_origin, x, y, z);
+
+    for (size_t i = 0; i < track.size(); i++) {
+        double expectedX, expectedY, expectedZ;
+        QGCGeo::convertGeoToNed(track.coordinate(i), m_origin, expectedX, expectedY, expectedZ);
+        QVERIFY(compareDoubles(x[i], expectedX, 1e-6));
+        QVERIFY(compareDoubles(y[i], expectedY, 1e-6));
+        QVERIFY(compareDoubles(z[i], expectedZ, 1e-6));
+    }
+
+    // Missing altitudes are at sea level
+    const QGCGeo::GeoSpan noAltitude{ track.latitude, track.longitude, {} };
+    QGCGeo::convertGeoToNed(noAltitude, m_origin, x, y, z);
+    double expectedX, expectedY, expectedZ;
+    QGCGeo::convertGeoToNed(QGeoCoordinate(track.latitude[3], track.longitude[3]), m_origin, expectedX, expectedY, expectedZ);
+    QVERIFY(compareDoubles(x[3], expectedX, 1e-6));
+    QVERIFY(compareDoubles(y[3], expectedY, 1e-6));
+    QVERIFY(compareDoubles(z[3], expectedZ, 1e-6));
+}
+
+void GeoTest::_convertNedToGeoBatch_test()
+{
+    const BatchTrack track = makeBatchTrack(m_origin, 301);
+    std::vector<double> x(track.size()), y(track.size()), z(track.size());
+    QGCGeo::convertGeoToNed(track.span(), m_origin, x, y, z);
+
+    std::vector<double> lat(track.size()), lon(track.size()), alt(track.size());
+    QGCGeo::convertNedToGeo(x, y, z, m_origin, lat, lon, alt);
+
+    for (size_t i = 0; i < track.size(); i++) {
+        QGeoCoordinate expected;
+        QGCGeo::convertNedToGeo(x[i], y[i], z[i], m_origin, expected);
+        QCOMPARE(lat[i], expected.latitude());
+        QCOMPARE(lon[i], expected.longitude());
+        QCOMPARE(alt[i], expected.altitude());
+        QVERIFY(compareDoubles(lat[i], track.latitude[i], 1e-9));
+        QVERIFY(compareDoubles(lon[i], track.longitude[i], 1e-9));
+        QVERIFY(compareDoubles(alt[i], track.altitude[i], 1e-6));
+    }
+}
+
+void GeoTest::_convertGpsToEnuBatch_test()
+{
+    const QGeoCoordinate ref(47.3764, 8.5481, 400.0);
+    const BatchTrack track = makeBatchTrack(ref, 301);
+    std::vector<double> east(track.size()), north(track.size()), up(track.size());
+    QGCGeo::convertGpsToEnu(track.span(), ref, east, north, up);
+
+    for (size_t i = 0; i < track.size(); i++) {
+        // The single point version works in float
+        const QVector3D expected = QGCGeo::convertGpsToEnu(track.coordinate(i), ref);
+        QVERIFY(compareDoubles(east[i], expected.x(), 0.01));
+        QVERIFY(compareDoubles(north[i], expected.y(), 0.01));
+        QVERIFY(compareDoubles(up[i], expected.z(), 0.01));
+    }
+}
+
+void GeoTest::_geodesicDistanceBatch_test()
+{
+    const BatchTrack track = makeBatchTrack(m_origin, 101);
+    std::vector<double> distances(track.size() - 1);
+    QGCGeo::geodesicDistance(track.span(), distances);
+
+    QList<QGeoCoordinate> path;
+    double total = 0.0;
+    for (size_t i = 0; i < track.size(); i++) {
+        path.append(track.coordinate(i));
+        if (i > 0) {
+            QCOMPARE(distances[i - 1], QGCGeo::geodesicDistance(track.coordinate(i - 1), track.coordinate(i)));
+            total += distances[i - 1];
+        }
+    }
+    QVERIFY(compareDoubles(total, QGCGeo::pathLength(path), 1e-6));
+}
+
+void GeoTest::_convertGeoToUTMBatch_test()
+{
+    const std::vector<double> lat{ 47.3764, -33.8688, 90.0, 91.0 };
+    const std::vector<double> lon{ 8.5481, 151.2093, 0.0, 8.5481 };
+    std::vector<double> easting(lat.size()), northing(lat.size());
+    std::vector<int> zones(lat.size());
+    QGCGeo::convertGeoToUTM(QGCGeo::GeoSpan{ lat, lon, {} }, easting, northing, zones);
+
+    for (size_t i = 0; i < lat.size(); i++) {
+        double expectedEasting = 0., expectedNorthing = 0.;
+        const int expectedZone = QGCGeo::convertGeoToUTM(QGeoCoordinate(lat[i], lon[i]), expectedEasting, expectedNorthing);
+        QCOMPARE(zones[i], expectedZone);
+        if (expectedZone != 0) {
+            QCOMPARE(easting[i], expectedEasting);
+            QCOMPARE(northing[i], expectedNorthing);
+        }
+    }
+    QCOMPARE(zones[0], 32);
+    QCOMPARE(zones[3], 0);
+}
+
 void GeoTest::_distanceProperties_test()
 {
     RC_QT_PROP("distance is always non-negative", [] {
@@ -461,6 +591,100 @@ void GeoTest::_benchmarkCoordinateConversions()
     });
 }
 
+void GeoTest::_benchmarkBatchConversions()
+{
+    constexpr int kPoints = 1000;
+    const BatchTrack track = makeBatchTrack(m_origin, kPoints);
+    QList<QGeoCoordinate> coords;
+    for (size_t i = 0; i < track.size(); i++) {
+        coords.append(track.coordinate(i));
+    }
+
+    std::vector<double> a(track.size()), b(track.size()), c(track.size());
+    std::vector<int> zones(track.size());
+
+    {
+        auto bench = qgc::bench::ciConfig();
+        bench.title("GeoToNed").relative(true).batch(kPoints).unit("point");
+        bench.run("convertGeoToNed (per point)", [&] {
+            for (qsizetype i = 0; i < coords.size(); i++) {
+                QGCGeo::convertGeoToNed(coords[i], m_origin, a[i], b[i], c[i]);
+            }
+            ankerl::nanobench::doNotOptimizeAway(a.data());
+        });
+        bench.run("convertGeoToNed (batch)", [&] {
+            QGCGeo::convertGeoToNed(track.span(), m_origin, a, b, c);
+            ankerl::nanobench::doNotOptimizeAway(a.data());
+        });
+    }
+
+    {
+        const std::vector<double> x = a, y = b, z = c;
+        auto bench = qgc::bench::ciConfig();
+        bench.title("NedToGeo").relative(true).batch(kPoints).unit("point");
+        bench.run("convertNedToGeo (per point)", [&] {
+            QGeoCoordinate result;
+            for (size_t i = 0; i < x.size(); i++) {
+                QGCGeo::convertNedToGeo(x[i], y[i], z[i], m_origin, result);
+                a[i] = result.latitude();
+            }
+            ankerl::nanobench::doNotOptimizeAway(a.data());
+        });
+        bench.run("convertNedToGeo (batch)", [&] {
+            QGCGeo::convertNedToGeo(x, y, z, m_origin, a, b, c);
+            ankerl::nanobench::doNotOptimizeAway(a.data());
+        });
+    }
+
+    {
+        auto bench = qgc::bench::ciConfig();
+        bench.title("GpsToEnu").relative(true).batch(kPoints).unit("point");
+        bench.run("convertGpsToEnu (per point)", [&] {
+            for (qsizetype i = 0; i < coords.size(); i++) {
+                const QVector3D enu = QGCGeo::convertGpsToEnu(coords[i], m_origin);
+                a[i] = enu.x();
+                b[i] = enu.y();
+                c[i] = enu.z();
+            }
+            ankerl::nanobench::doNotOptimizeAway(a.data());
+        });
+        bench.run("convertGpsToEnu (batch)", [&] {
+            QGCGeo::convertGpsToEnu(track.span(), m_origin, a, b, c);
+            ankerl::nanobench::doNotOptimizeAway(a.data());
+        });
+    }
+
+    {
+        auto bench = qgc::bench::ciConfig();
+        bench.title("geodesicDistance").relative(true).batch(kPoints - 1).unit("segment");
+        bench.run("geodesicDistance (per point)", [&] {
+            for (qsizetype i = 1; i < coords.size(); i++) {
+                a[i - 1] = QGCGeo::geodesicDistance(coords[i - 1], coords[i]);
+            }
+            ankerl::nanobench::doNotOptimizeAway(a.data());
+        });
+        bench.run("geodesicDistance (batch)", [&] {
+            QGCGeo::geodesicDistance(track.span(), a);
+            ankerl::nanobench::doNotOptimizeAway(a.data());
+        });
+    }
+
+    {
+        auto bench = qgc::bench::ciConfig();
+        bench.title("GeoToUTM").relative(true).batch(kPoints).unit("point");
+        bench.run("convertGeoToUTM (per point)", [&] {
+            for (qsizetype i = 0; i < coords.size(); i++) {
+                zones[i] = QGCGeo::convertGeoToUTM(coords[i], a[i], b[i]);
+            }
+            ankerl::nanobench::doNotOptimizeAway(zones.data());
+        });
+        bench.run("convertGeoToUTM (batch)", [&] {
+            QGCGeo::convertGeoToUTM(track.span(), a, b, zones);
+            ankerl::nanobench::doNotOptimizeAway(zones.data());
+        });
+    }
+}
+
 void GeoTest::_qbenchmarkGeodesicDistance()
 {
     const QGeoCoordinate coord(47.364869, 8.594398, 100.0);
@@ -38,12 +38,19 @@ private slots:
     void _interpolatePath_test();
     void _interpolateAtDistance_test();
 
+    void _convertGeoToNedBatch_test();
+    void _convertNedToGeoBatch_test();
+    void _convertGpsToEnuBatch_test();
+    void _geodesicDistanceBatch_test();
+    void _convertGeoToUTMBatch_test();
+
     // Property-based tests
     void _distanceProperties_test();
     void _nedRoundtripProperty_test();
 
     // Benchmarks (nanobench)
     void _benchmarkCoordinateConversions();
+    void _benchmarkBatchConversions();
 
     // Benchmarks (QBENCHMARK)
     void _qbenchmarkGeodesicDistance();
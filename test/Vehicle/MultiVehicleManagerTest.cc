@@ -3,6 +3,7 @@
 #include <QtCore/QRegularExpression>
 #include <QtTest/QSignalSpy>
 
+#include "MAVLinkProtocol.h"
 #include "MockLink.h"
 #include "MultiVehicleManager.h"
 #include "Vehicle.h"
@@ -53,4 +54,58 @@ void MultiVehicleManagerTest::_testDuplicateAllLinksRemoved()
     settleEventLoopForCleanup();
 }
 
+void MultiVehicleManagerTest::_testMessageRoutingBySysId()
+{
+    // Messages from this component id are ours, MockLink never sends from it
+    constexpr uint8_t kTestCompId = MAV_COMP_ID_USER1;
+
+    Vehicle* vehicle = this->vehicle();
+    QVERIFY(vehicle);
+
+    int namedValueCount = 0;
+    int radioStatusCount = 0;
+    (void) connect(vehicle, &Vehicle::mavlinkMessageReceived, this, [&](const mavlink_message_t& message) {
+        if (message.compid != kTestCompId) {
+            return;
+        }
+        if (message.msgid == MAVLINK_MSG_ID_NAMED_VALUE_FLOAT) {
+            namedValueCount++;
+        } else if (message.msgid == MAVLINK_MSG_ID_RADIO_STATUS) {
+            radioStatusCount++;
+        }
+    });
+
+    // Messages are emitted straight from MAVLinkProtocol, so pack them without touching any channel state
+    const auto routeNamedValue = [this](uint8_t sysid) {
+        const char name[MAVLINK_MSG_NAMED_VALUE_FLOAT_FIELD_NAME_LEN] = "test";
+        mavlink_status_t packStatus{};
+        mavlink_message_t message{};
+        (void) mavlink_msg_named_value_float_pack_status(sysid, kTestCompId, &packStatus, &message, 0, name, 1.0f);
+        emit MAVLinkProtocol::instance()->messageReceived(mockLink(), message);
+    };
+    const auto routeRadioStatus = [](LinkInterface* link) {
+        mavlink_status_t packStatus{};
+        mavlink_message_t message{};
+        (void) mavlink_msg_radio_status_pack_status('3', kTestCompId, &packStatus, &message, 200, 190, 100, 10, 10, 0, 0);
+        emit MAVLinkProtocol::instance()->messageReceived(link, message);
+    };
+
+    routeNamedValue(static_cast<uint8_t>(vehicle->id()));
+    QCOMPARE(namedValueCount, 1);
+
+    // Broadcast sysid reaches every vehicle
+    routeNamedValue(0);
+    QCOMPARE(namedValueCount, 2);
+
+    // Unknown sysid is dropped
+    routeNamedValue(static_cast<uint8_t>(vehicle->id() + 1));
+    QCOMPARE(namedValueCount, 2);
+
+    // RADIO_STATUS from a link the vehicle uses passes through regardless of sysid, otherwise it is dropped
+    routeRadioStatus(mockLink());
+    QCOMPARE(radioStatusCount, 1);
+    routeRadioStatus(nullptr);
+    QCOMPARE(radioStatusCount, 1);
+}
+
 UT_REGISTER_TEST(MultiVehicleManagerTest, TestLabel::Integration, TestLabel::Vehicle)
@@ -13,4 +13,5 @@ class MultiVehicleManagerTest : public VehicleTest
 
 private slots:
     void _testDuplicateAllLinksRemoved();
+    void _testMessageRoutingBySysId();
 };